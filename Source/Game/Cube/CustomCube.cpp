@@ -25,5 +25,5 @@ void CustomCube::Update(
 	XMMATRIX translate = XMMatrixTranslation(0.0f, 0.0f, -7.0f);
 	XMMATRIX scale = XMMatrixScaling(0.5f, 0.5f, 0.5f);
 
-	m_world = rotate * scale * xSpin * ySpin * translate * orbit;
+	setWorldMatrix(rotate * scale * xSpin * ySpin * translate * orbit);
 }
@@ -21,6 +21,6 @@ void OrbitCube::Update(
 	XMMATRIX translate = XMMatrixTranslation(-4.0f, 0.0f, 0.0f);
 	XMMATRIX scale = XMMatrixScaling(0.3f, 0.3f, 0.3f);
 
-	m_world = scale * spin * translate * orbit;
+	setWorldMatrix(scale * spin * translate * orbit);
 }
 
@@ -16,5 +16,5 @@ void RotatingCube::Update(_In_ FLOAT deltaTime)
     XMMATRIX mTranslate = XMMatrixTranslation(0.0f, 0.0f, -5.0f);
     XMMATRIX mScale = XMMatrixScaling(0.3f, 0.3f, 0.3f);
 
-    m_world = mScale * mSpin * mTranslate * mOrbit;
+    setWorldMatrix(mScale * mSpin * mTranslate * mOrbit);
 }
\ No newline at end of file
@@ -28,7 +28,7 @@ RotatingPointLight::RotatingPointLight(
   Args:     FLOAT deltaTime
 
   Modifies: [m_position, m_eye, m_eye, m_at,
-            m_view].
+            m_view, m_uVersion].
 M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
 void RotatingPointLight::Update(
@@ -45,4 +45,6 @@ void RotatingPointLight::Update(
     m_at = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
     m_up = DEFAULT_UP;
     m_view = XMMatrixLookAtLH(m_eye, m_at, m_up);
+
+    invalidate();
 }
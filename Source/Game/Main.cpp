@@ -23,6 +23,9 @@
 #include "Renderer/Skybox.h"
 #include "Scene/Scene.h"
 #include "Scene/Voxel.h"
+#include "Shader/CrowdVertexShader.h"
+#include "Shader/PackedVertexShader.h"
+#include "Shader/SkinningVertexShader.h"
 #include "Shader/SkyMapVertexShader.h"
 
 /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -217,6 +220,12 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    // Phong of the packed vertices of models
+    std::shared_ptr<library::PackedVertexShader> packedPhongVertexShader = std::make_shared<library::PackedVertexShader>(L"Shaders/PhongShaders.fxh", "VSPhongPacked", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"PackedPhongShader", packedPhongVertexShader)))
+    {
+        return 0;
+    }
     // Voxel
     std::shared_ptr<library::VertexShader> voxelVertexShader = std::make_shared<library::VertexShader>(L"Shaders/VoxelShaders.fxh", "VSVoxel", "vs_5_0");
     if (FAILED(mainScene->AddVertexShader(L"VoxelShader", voxelVertexShader)))
@@ -247,6 +256,18 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    // Crowd
+    std::shared_ptr<library::CrowdVertexShader> crowdVertexShader = std::make_shared<library::CrowdVertexShader>(L"Shaders/SkinningShaders.fxh", "VSCrowd", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"CrowdShader", crowdVertexShader)))
+    {
+        return 0;
+    }
+    // Skinning with dual quaternions
+    std::shared_ptr<library::SkinningVertexShader> dualQuaternionSkinningVertexShader = std::make_shared<library::SkinningVertexShader>(L"Shaders/SkinningShaders.fxh", "VSPhongDualQuaternion", "vs_5_0");
+    if (FAILED(mainScene->AddVertexShader(L"DualQuaternionSkinningShader", dualQuaternionSkinningVertexShader)))
+    {
+        return 0;
+    }
 
     // Phong
     std::shared_ptr<library::PixelShader> phongPixelShader = std::make_shared<library::PixelShader>(L"Shaders/PhongShaders.fxh", "PSPhong", "ps_5_0");
@@ -284,6 +305,12 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
+    // Skinning
+    std::shared_ptr<library::PixelShader> skinningPixelShader = std::make_shared<library::PixelShader>(L"Shaders/SkinningShaders.fxh", "PSPhong", "ps_5_0");
+    if (FAILED(mainScene->AddPixelShader(L"SkinningShader", skinningPixelShader)))
+    {
+        return 0;
+    }
 
     if (FAILED(mainScene->SetVertexShaderOfVoxel(L"VoxelShader")))
     {
@@ -310,7 +337,7 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     {
         return 0;
     }
-    if (FAILED(mainScene->SetVertexShaderOfModel(L"Nanosuit", L"PhongShader")))
+    if (FAILED(mainScene->SetVertexShaderOfModel(L"Nanosuit", L"PackedPhongShader")))
     {
         return 0;
     }
@@ -319,6 +346,59 @@ INT WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return 0;
     }
 
+    // A grid of guards playing the same clip out of step, the MD5 model is Z up
+    constexpr const UINT NUM_CROWD_ROWS = 4u;
+    constexpr const UINT NUM_CROWD_COLUMNS = 4u;
+    std::vector<library::CrowdInstanceData> aCrowdInstances;
+    aCrowdInstances.reserve(NUM_CROWD_ROWS * NUM_CROWD_COLUMNS);
+    for (UINT uRow = 0u; uRow < NUM_CROWD_ROWS; ++uRow)
+    {
+        for (UINT uColumn = 0u; uColumn < NUM_CROWD_COLUMNS; ++uColumn)
+        {
+            aCrowdInstances.push_back(
+                library::CrowdInstanceData
+                {
+                    .Transformation = XMMatrixRotationX(-XM_PIDIV2) * XMMatrixScaling(0.2f, 0.2f, 0.2f)
+                        * XMMatrixTranslation(-30.0f + 8.0f * static_cast<FLOAT>(uColumn), 0.0f, 20.0f + 8.0f * static_cast<FLOAT>(uRow)),
+                    .TimeOffset = 0.37f * static_cast<FLOAT>(uRow * NUM_CROWD_COLUMNS + uColumn),
+                    .uClipIndex = 0u
+                }
+            );
+        }
+    }
+
+    std::shared_ptr<library::Crowd> guards = std::make_shared<library::Crowd>(L"Content/BobLampClean/boblampclean.md5mesh", std::move(aCrowdInstances));
+    if (FAILED(mainScene->AddCrowd(L"Guards", guards)))
+    {
+        return 0;
+    }
+    if (FAILED(mainScene->SetVertexShaderOfCrowd(L"Guards", L"CrowdShader")))
+    {
+        return 0;
+    }
+    if (FAILED(mainScene->SetPixelShaderOfCrowd(L"Guards", L"SkinningShader")))
+    {
+        return 0;
+    }
+
+    // A guard in front of the crowd, skinned with dual quaternions so its twisting joints keep their volume
+    std::shared_ptr<library::Model> guard = std::make_shared<library::Model>(L"Content/BobLampClean/boblampclean.md5mesh", library::eSkinningMode::DUAL_QUATERNION);
+    guard->RotateX(-XM_PIDIV2);
+    guard->Scale(0.2f, 0.2f, 0.2f);
+    guard->Translate(XMVectorSet(-18.0f, 0.0f, 12.0f, 1.0f));
+    if (FAILED(mainScene->AddModel(L"Guard", guard)))
+    {
+        return 0;
+    }
+    if (FAILED(mainScene->SetVertexShaderOfModel(L"Guard", L"DualQuaternionSkinningShader")))
+    {
+        return 0;
+    }
+    if (FAILED(mainScene->SetPixelShaderOfModel(L"Guard", L"SkinningShader")))
+    {
+        return 0;
+    }
+
     std::shared_ptr<library::Material> voxelMaterial = std::make_shared<library::Material>(L"VoxelMaterial");
     voxelMaterial->pDiffuse = std::make_shared<library::Texture>("Content/Cube/diffuse.png");
     voxelMaterial->pNormal = std::make_shared<library::Texture>("Content/Cube/normal.png");
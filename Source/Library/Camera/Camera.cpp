@@ -9,8 +9,8 @@ namespace library
 
       Modifies: [m_yaw, m_pitch, m_moveLeftRight, m_moveBackForward,
                  m_moveUpDown, m_travelSpeed, m_rotationSpeed, 
-                 m_padding, m_cameraForward, m_cameraRight, m_cameraUp, 
-                 m_eye, m_at, m_up, m_rotation, m_view].
+                 m_padding, m_uVersion, m_cameraForward, m_cameraRight,
+                 m_cameraUp, m_eye, m_at, m_up, m_rotation, m_view].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     Camera::Camera(
@@ -30,6 +30,8 @@ namespace library
 
         , m_padding()
 
+        , m_uVersion(1u)
+
         , m_cameraForward(DEFAULT_FORWARD)
         , m_cameraRight(DEFAULT_RIGHT)
         , m_cameraUp(DEFAULT_UP)
@@ -114,6 +116,21 @@ namespace library
         return m_cbChangeOnCameraMovement;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Camera::GetVersion
+
+      Summary:  Returns the counter that is bumped whenever the eye or
+                the view matrix changes
+
+      Returns:  UINT64
+                  Version of the view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT64 Camera::GetVersion() const
+    {
+        return m_uVersion;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Camera::HandleInput
 
@@ -224,7 +241,8 @@ namespace library
 
       Modifies: [m_rotation, m_at, m_cameraRight, m_cameraUp, 
                  m_cameraForward, m_eye, m_moveLeftRight, 
-                 m_moveBackForward, m_moveUpDown, m_up, m_view].
+                 m_moveBackForward, m_moveUpDown, m_up, m_view,
+                 m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Camera::Update(
@@ -252,6 +270,14 @@ namespace library
         m_moveBackForward = 0.0f;
         m_moveUpDown = 0.0f;
         
-        m_view = XMMatrixLookAtLH(m_eye, m_at, m_up);
+        XMMATRIX view = XMMatrixLookAtLH(m_eye, m_at, m_up);
+
+        // Without input the view stays the same and its constant buffer is not uploaded again
+        if (XMVector4NotEqual(view.r[0], m_view.r[0]) || XMVector4NotEqual(view.r[1], m_view.r[1])
+            || XMVector4NotEqual(view.r[2], m_view.r[2]) || XMVector4NotEqual(view.r[3], m_view.r[3]))
+        {
+            m_view = view;
+            ++m_uVersion;
+        }
     }
 }
\ No newline at end of file
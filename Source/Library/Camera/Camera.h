@@ -33,6 +33,9 @@ namespace library
                   Getter for the view transform matrix
                 GetConstantBuffer
                   Get the constant buffer containing the view transform
+                GetVersion
+                  Getter for the counter bumped whenever the view
+                  changes
                 HandleInput
                   Handles the keyboard / mouse input
                 Initialize
@@ -60,6 +63,7 @@ namespace library
         const XMVECTOR& GetUp() const;
         const XMMATRIX& GetView() const;
         ComPtr<ID3D11Buffer>& GetConstantBuffer();
+        UINT64 GetVersion() const;
 
         virtual void HandleInput(_In_ const DirectionsInput& directions, _In_ const MouseRelativeMovement& mouseRelativeMovement, _In_ FLOAT deltaTime);
         virtual HRESULT Initialize(_In_ ID3D11Device* device);
@@ -83,6 +87,8 @@ namespace library
 
         BYTE m_padding[12]; // struct alignment
 
+        UINT64 m_uVersion;
+
         XMVECTOR m_cameraForward;
         XMVECTOR m_cameraRight;
         XMVECTOR m_cameraUp;
@@ -30,6 +30,8 @@
 #include <d3d11_4.h>
 #include <d3dcompiler.h>
 #include <directxcolors.h>
+#include <DirectXCollision.h>
+#include <DirectXPackedVector.h>
 
 #define _CRTDBG_MAP_ALLOC
 #include <stdlib.h>
@@ -50,7 +52,7 @@ constexpr LPCWSTR PSZ_COURSE_TITLE = L"Game Graphics Programming";
 using namespace Microsoft::WRL;
 using namespace DirectX;
 
-#define ASSIMP_LOAD_FLAGS (aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices | aiProcess_ConvertToLeftHanded | aiProcess_CalcTangentSpace)
+#define ASSIMP_LOAD_FLAGS (aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices | aiProcess_ConvertToLeftHanded)
 
 namespace library
 {
@@ -16,7 +16,7 @@ namespace library
                 FLOAT attenuationDistance
                   Attenuation distance
 
-      Modifies: [m_position, m_color, m_attenuationDistance].
+      Modifies: [m_position, m_color, m_attenuationDistance, m_uVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     PointLight::PointLight(
@@ -32,6 +32,7 @@ namespace library
         , m_view(XMMatrixIdentity())
         , m_projection(XMMatrixIdentity())
         , m_attenuationDistance(attenuationDistance)
+        , m_uVersion(1u)
     {
     }
 
@@ -103,6 +104,21 @@ namespace library
         return m_attenuationDistance;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PointLight::GetVersion
+
+      Summary:  Returns the counter that is bumped whenever the
+                position, view or projection of the light changes
+
+      Returns:  UINT64
+                  Version of the light
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT64 PointLight::GetVersion() const
+    {
+        return m_uVersion;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   PointLight::Initialize
 
@@ -111,7 +127,7 @@ namespace library
       Args:     UINT uWidth
                 UINT uHeight
 
-      Modifies: [m_projection]
+      Modifies: [m_projection, m_uVersion]
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void PointLight::Initialize(
@@ -121,6 +137,7 @@ namespace library
     {
         // Initialize the projection matrix
         m_projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, static_cast<FLOAT>(uWidth) / static_cast<FLOAT>(uHeight), 0.01f, 1000.0f);
+        invalidate();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -138,4 +155,18 @@ namespace library
     {
         UNREFERENCED_PARAMETER(deltaTime);
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   PointLight::invalidate
+
+      Summary:  Bumps the version after the light was changed, so the
+                light constant buffer is uploaded again
+
+      Modifies: [m_uVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void PointLight::invalidate()
+    {
+        ++m_uVersion;
+    }
 }
\ No newline at end of file
@@ -27,6 +27,8 @@ namespace library
                   Returns the position of the light
                 GetColor
                   Returns the color of the light
+                GetVersion
+                  Returns the counter bumped whenever the light changes
                 Update
                   Updates the light
                 PointLight
@@ -51,10 +53,14 @@ namespace library
         const XMMATRIX& GetViewMatrix() const;
         const XMMATRIX& GetProjectionMatrix() const;
         FLOAT GetAttenuationDistance() const;
+        UINT64 GetVersion() const;
 
         virtual void Initialize(_In_ UINT uWidth, _In_ UINT uHeight);
         virtual void Update(_In_ FLOAT deltaTime);
 
+    protected:
+        void invalidate();
+
     protected:
         XMFLOAT4 m_position;
         XMFLOAT4 m_color;
@@ -64,6 +70,7 @@ namespace library
         XMMATRIX m_view;
         XMMATRIX m_projection;
         FLOAT m_attenuationDistance;
+        UINT64 m_uVersion;
 
         static constexpr const XMVECTORF32 DEFAULT_UP = { 0.0f, 1.0f, 0.0f, 0.0f };
     };
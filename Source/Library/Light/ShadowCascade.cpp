@@ -0,0 +1,220 @@
+#include "Light/ShadowCascade.h"
+
+namespace library
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: ComputeCascadeSplits
+
+      Summary:  Computes the view space split distances of the cascades
+                by blending the logarithmic and the uniform split
+                schemes. The near plane is read from the camera
+                projection, the far plane is clamped to the shadow
+                distance.
+
+      Args:     const XMMATRIX& cameraProjection
+                  Left-handed perspective projection of the camera
+                FLOAT lambda
+                  Blend factor, 0 is uniform and 1 is logarithmic
+                FLOAT shadowDistance
+                  Maximum view distance that receives shadows
+                UINT uNumCascades
+                  Number of cascades
+                FLOAT* aSplits
+                  uNumCascades + 1 split distances, aSplits[0] is the
+                  near plane
+    -----------------------------------------------------------------F-F*/
+
+    void ComputeCascadeSplits(
+        _In_ const XMMATRIX& cameraProjection,
+        _In_ FLOAT lambda,
+        _In_ FLOAT shadowDistance,
+        _In_ UINT uNumCascades,
+        _Out_writes_(uNumCascades + 1) FLOAT* aSplits
+    )
+    {
+        XMFLOAT4X4 projection;
+        XMStoreFloat4x4(&projection, cameraProjection);
+
+        // _33 = f / (f - n), _43 = -n * f / (f - n)
+        const FLOAT nearZ = -projection._43 / projection._33;
+        const FLOAT farZ = fminf(projection._43 / (1.0f - projection._33), shadowDistance);
+
+        aSplits[0] = nearZ;
+        for (UINT i = 1u; i <= uNumCascades; ++i)
+        {
+            const FLOAT ratio = static_cast<FLOAT>(i) / static_cast<FLOAT>(uNumCascades);
+            const FLOAT logSplit = nearZ * powf(farZ / nearZ, ratio);
+            const FLOAT uniformSplit = nearZ + (farZ - nearZ) * ratio;
+
+            aSplits[i] = lambda * logSplit + (1.0f - lambda) * uniformSplit;
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: FitShadowCascade
+
+      Summary:  Fits the light projection of a cascade around the
+                smallest sphere enclosing the camera frustum slice. The
+                sphere only depends on the split distances, so the size
+                of a shadow texel stays constant while the camera moves
+                and rotates. The light view has a fixed orientation and
+                the center is snapped to whole texels so that the
+                rasterized shadow edges do not shimmer.
+
+      Args:     const XMMATRIX& cameraView
+                  View matrix of the camera
+                const XMMATRIX& cameraProjection
+                  Perspective projection of the camera
+                FLOAT splitNear
+                  View space near distance of the slice
+                FLOAT splitFar
+                  View space far distance of the slice
+                FXMVECTOR lightDirection
+                  Normalized direction the light travels in
+                UINT uResolution
+                  Width and height of the cascade shadow map
+                ShadowCascade& cascade
+                  Fitted cascade, its projection is built by
+                  FinalizeShadowCascade
+    -----------------------------------------------------------------F-F*/
+
+    void FitShadowCascade(
+        _In_ const XMMATRIX& cameraView,
+        _In_ const XMMATRIX& cameraProjection,
+        _In_ FLOAT splitNear,
+        _In_ FLOAT splitFar,
+        _In_ FXMVECTOR lightDirection,
+        _In_ UINT uResolution,
+        _Out_ ShadowCascade& cascade
+    )
+    {
+        XMFLOAT4X4 projection;
+        XMStoreFloat4x4(&projection, cameraProjection);
+
+        // Squared slope of the frustum corner rays
+        const FLOAT tanHalfFovX = 1.0f / projection._11;
+        const FLOAT tanHalfFovY = 1.0f / projection._22;
+        const FLOAT cornerSlopeSquared = tanHalfFovX * tanHalfFovX + tanHalfFovY * tanHalfFovY;
+
+        // Equidistant to the near and far corners, or the far plane center when the slice is wide
+        FLOAT centerZ = 0.5f * (splitNear + splitFar) * (1.0f + cornerSlopeSquared);
+        FLOAT radius = 0.0f;
+        if (centerZ >= splitFar)
+        {
+            centerZ = splitFar;
+            radius = splitFar * sqrtf(cornerSlopeSquared);
+        }
+        else
+        {
+            radius = sqrtf((splitFar - centerZ) * (splitFar - centerZ) + splitFar * splitFar * cornerSlopeSquared);
+        }
+
+        XMMATRIX inverseView = XMMatrixInverse(nullptr, cameraView);
+        XMVECTOR center = XMVector3TransformCoord(XMVectorSet(0.0f, 0.0f, centerZ, 1.0f), inverseView);
+
+        XMVECTOR up = XMVectorGetY(XMVectorAbs(lightDirection)) > 0.99f ? XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+        cascade.View = XMMatrixLookToLH(XMVectorZero(), lightDirection, up);
+
+        // Snap the center to the texel grid of the light view
+        XMVECTOR texelSize = XMVectorReplicate(2.0f * radius / static_cast<FLOAT>(uResolution));
+        XMVECTOR lightSpaceCenter = XMVector3TransformCoord(center, cascade.View);
+        XMVECTOR snappedCenter = XMVectorMultiply(XMVectorFloor(XMVectorDivide(lightSpaceCenter, texelSize)), texelSize);
+        lightSpaceCenter = XMVectorSelect(lightSpaceCenter, snappedCenter, g_XMSelect1100);
+
+        XMVECTOR extent = XMVectorReplicate(radius);
+        XMStoreFloat3(&cascade.BoundsMin, XMVectorSubtract(lightSpaceCenter, extent));
+        XMStoreFloat3(&cascade.BoundsMax, XMVectorAdd(lightSpaceCenter, extent));
+
+        cascade.SplitNear = splitNear;
+        cascade.SplitFar = splitFar;
+        cascade.Projection = XMMatrixIdentity();
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: AddShadowCaster
+
+      Summary:  Tests a caster against the cascade and pulls the near
+                plane towards the light so that casters in front of
+                the cascade are not clipped
+
+      Args:     ShadowCascade& cascade
+                  Fitted cascade
+                const BoundingSphere& caster
+                  World space bounds of the caster
+
+      Returns:  BOOL
+                  Whether the caster throws shadows into the cascade
+    -----------------------------------------------------------------F-F*/
+
+    BOOL AddShadowCaster(
+        _Inout_ ShadowCascade& cascade,
+        _In_ const BoundingSphere& caster
+    )
+    {
+        if (!IsCasterInShadowCascade(cascade, caster))
+        {
+            return FALSE;
+        }
+
+        XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&caster.Center), cascade.View);
+        cascade.BoundsMin.z = fminf(cascade.BoundsMin.z, XMVectorGetZ(center) - caster.Radius);
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: IsCasterInShadowCascade
+
+      Summary:  Tests whether the caster overlaps the light space bounds
+                of the cascade. Only the far plane limits the depth,
+                casters between the light and the cascade still throw
+                shadows into it.
+
+      Args:     const ShadowCascade& cascade
+                  Fitted cascade
+                const BoundingSphere& caster
+                  World space bounds of the caster
+
+      Returns:  BOOL
+                  Whether the caster throws shadows into the cascade
+    -----------------------------------------------------------------F-F*/
+
+    BOOL IsCasterInShadowCascade(
+        _In_ const ShadowCascade& cascade,
+        _In_ const BoundingSphere& caster
+    )
+    {
+        XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&caster.Center), cascade.View);
+        XMVECTOR radius = XMVectorReplicate(caster.Radius);
+
+        XMVECTOR casterMin = XMVectorSubtract(center, radius);
+        XMVECTOR casterMax = XMVectorAdd(center, radius);
+
+        return XMVector3LessOrEqual(casterMin, XMLoadFloat3(&cascade.BoundsMax))
+            && XMVector2GreaterOrEqual(casterMax, XMLoadFloat3(&cascade.BoundsMin));
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: FinalizeShadowCascade
+
+      Summary:  Builds the orthographic light projection from the
+                bounds of the cascade
+
+      Args:     ShadowCascade& cascade
+                  Fitted cascade
+    -----------------------------------------------------------------F-F*/
+
+    void FinalizeShadowCascade(
+        _Inout_ ShadowCascade& cascade
+    )
+    {
+        cascade.Projection = XMMatrixOrthographicOffCenterLH(
+            cascade.BoundsMin.x,
+            cascade.BoundsMax.x,
+            cascade.BoundsMin.y,
+            cascade.BoundsMax.y,
+            cascade.BoundsMin.z,
+            cascade.BoundsMax.z
+        );
+    }
+}
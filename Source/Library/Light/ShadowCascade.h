@@ -0,0 +1,58 @@
+/*+===================================================================
+  File:      SHADOWCASCADE.H
+
+  Summary:   ShadowCascade header file contains declarations of the
+             functions that fit the cascades of the directional light
+             cascaded shadow maps.
+
+  Functions: ComputeCascadeSplits, FitShadowCascade,
+             AddShadowCaster, IsCasterInShadowCascade,
+             FinalizeShadowCascade
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ShadowCascade
+
+      Summary:  Light space view, projection and bounds of a single
+                cascade. The bounds are expressed in the light view
+                space and the projection is built from them.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ShadowCascade
+    {
+        XMMATRIX View;
+        XMMATRIX Projection;
+        XMFLOAT3 BoundsMin;
+        FLOAT SplitNear;
+        XMFLOAT3 BoundsMax;
+        FLOAT SplitFar;
+    };
+
+    void ComputeCascadeSplits(
+        _In_ const XMMATRIX& cameraProjection,
+        _In_ FLOAT lambda,
+        _In_ FLOAT shadowDistance,
+        _In_ UINT uNumCascades,
+        _Out_writes_(uNumCascades + 1) FLOAT* aSplits
+    );
+
+    void FitShadowCascade(
+        _In_ const XMMATRIX& cameraView,
+        _In_ const XMMATRIX& cameraProjection,
+        _In_ FLOAT splitNear,
+        _In_ FLOAT splitFar,
+        _In_ FXMVECTOR lightDirection,
+        _In_ UINT uResolution,
+        _Out_ ShadowCascade& cascade
+    );
+
+    BOOL AddShadowCaster(_Inout_ ShadowCascade& cascade, _In_ const BoundingSphere& caster);
+    BOOL IsCasterInShadowCascade(_In_ const ShadowCascade& cascade, _In_ const BoundingSphere& caster);
+    void FinalizeShadowCascade(_Inout_ ShadowCascade& cascade);
+}
@@ -0,0 +1,371 @@
+#include "Light/SphericalHarmonics.h"
+
+#include <algorithm>
+#include <execution>
+#include <fstream>
+#include <numeric>
+
+namespace library
+{
+    // Normalization constants of the real basis functions, Y = K * P(x, y, z)
+    static constexpr const FLOAT SH_BASIS_CONSTANTS[NUM_SH_COEFFICIENTS] =
+    {
+        0.282095f,
+        0.488603f, 0.488603f, 0.488603f,
+        1.092548f, 1.092548f, 0.315392f, 1.092548f, 0.546274f
+    };
+
+    // Clamped cosine convolution divided by pi, so that the result is the Lambertian exit radiance
+    static constexpr const FLOAT SH_COSINE_LOBE[NUM_SH_COEFFICIENTS] =
+    {
+        1.0f,
+        2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f,
+        0.25f, 0.25f, 0.25f, 0.25f, 0.25f
+    };
+
+    // "SH9C"
+    static constexpr const UINT IRRADIANCE_CACHE_MAGIC = 0x43394853u;
+    static constexpr const UINT IRRADIANCE_CACHE_VERSION = 1u;
+
+    struct IrradianceCacheHeader
+    {
+        UINT uMagic;
+        UINT uVersion;
+        UINT64 uSourceHash;
+    };
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: EvaluateBasisPolynomials
+
+      Summary:  Evaluates the polynomial part of the nine basis
+                functions in the order the shader consumes them
+
+      Args:     const XMFLOAT3& d
+                  Normalized direction
+                FLOAT* aBasis
+                  1, y, z, x, xy, yz, 3z^2 - 1, xz, x^2 - y^2
+    -----------------------------------------------------------------F-F*/
+
+    static void EvaluateBasisPolynomials(
+        _In_ const XMFLOAT3& d,
+        _Out_writes_(NUM_SH_COEFFICIENTS) FLOAT* aBasis
+    )
+    {
+        aBasis[0] = 1.0f;
+        aBasis[1] = d.y;
+        aBasis[2] = d.z;
+        aBasis[3] = d.x;
+        aBasis[4] = d.x * d.y;
+        aBasis[5] = d.y * d.z;
+        aBasis[6] = 3.0f * d.z * d.z - 1.0f;
+        aBasis[7] = d.x * d.z;
+        aBasis[8] = d.x * d.x - d.y * d.y;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: ProjectIrradianceSH9
+
+      Summary:  Projects the radiance of a cube map onto the first nine
+                spherical harmonics and convolves it with the clamped
+                cosine lobe. The faces are projected in parallel, each
+                texel is weighted by its solid angle. The basis
+                constants are folded into the coefficients, so that
+                the irradiance is a sum of the coefficients times the
+                basis polynomials.
+
+      Args:     const CubeMapData& cubeMap
+                  Decoded cube map
+                XMFLOAT4* aCoefficients
+                  Irradiance coefficients, divided by pi
+    -----------------------------------------------------------------F-F*/
+
+    void ProjectIrradianceSH9(
+        _In_ const CubeMapData& cubeMap,
+        _Out_writes_(NUM_SH_COEFFICIENTS) XMFLOAT4* aCoefficients
+    )
+    {
+        XMFLOAT4 aFaceSums[NUM_CUBE_FACES][NUM_SH_COEFFICIENTS];
+        FLOAT aFaceWeights[NUM_CUBE_FACES];
+
+        UINT aFaces[NUM_CUBE_FACES];
+        std::iota(std::begin(aFaces), std::end(aFaces), 0u);
+
+        std::for_each(
+            std::execution::par,
+            std::begin(aFaces),
+            std::end(aFaces),
+            [&](UINT uFace)
+            {
+                XMVECTOR aSums[NUM_SH_COEFFICIENTS];
+                for (UINT i = 0u; i < NUM_SH_COEFFICIENTS; ++i)
+                {
+                    aSums[i] = XMVectorZero();
+                }
+                FLOAT weight = 0.0f;
+
+                const FLOAT invSize = 1.0f / static_cast<FLOAT>(cubeMap.uSize);
+                const XMFLOAT4* pTexel = cubeMap.aFaces[uFace].data();
+                for (UINT y = 0u; y < cubeMap.uSize; ++y)
+                {
+                    for (UINT x = 0u; x < cubeMap.uSize; ++x, ++pTexel)
+                    {
+                        XMFLOAT3 direction;
+                        XMStoreFloat3(
+                            &direction,
+                            GetCubeMapTexelDirection(uFace, (static_cast<FLOAT>(x) + 0.5f) * invSize, (static_cast<FLOAT>(y) + 0.5f) * invSize)
+                        );
+                        const FLOAT solidAngle = GetCubeMapTexelSolidAngle(cubeMap.uSize, x, y);
+
+                        FLOAT aBasis[NUM_SH_COEFFICIENTS];
+                        EvaluateBasisPolynomials(direction, aBasis);
+
+                        const XMVECTOR radiance = XMLoadFloat4(pTexel);
+                        for (UINT i = 0u; i < NUM_SH_COEFFICIENTS; ++i)
+                        {
+                            aSums[i] = XMVectorMultiplyAdd(radiance, XMVectorReplicate(aBasis[i] * solidAngle), aSums[i]);
+                        }
+                        weight += solidAngle;
+                    }
+                }
+
+                for (UINT i = 0u; i < NUM_SH_COEFFICIENTS; ++i)
+                {
+                    XMStoreFloat4(&aFaceSums[uFace][i], aSums[i]);
+                }
+                aFaceWeights[uFace] = weight;
+            }
+        );
+
+        // The solid angles do not sum to exactly 4 pi, normalize the discretization error away
+        FLOAT weight = 0.0f;
+        for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+        {
+            weight += aFaceWeights[uFace];
+        }
+        const FLOAT normalization = XM_PI * 4.0f / weight;
+
+        for (UINT i = 0u; i < NUM_SH_COEFFICIENTS; ++i)
+        {
+            XMVECTOR sum = XMVectorZero();
+            for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+            {
+                sum = XMVectorAdd(sum, XMLoadFloat4(&aFaceSums[uFace][i]));
+            }
+
+            const FLOAT scale = normalization * SH_BASIS_CONSTANTS[i] * SH_BASIS_CONSTANTS[i] * SH_COSINE_LOBE[i];
+            XMStoreFloat4(&aCoefficients[i], XMVectorSetW(XMVectorScale(sum, scale), 0.0f));
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: EvaluateIrradianceSH9
+
+      Summary:  Evaluates the irradiance coefficients towards a normal,
+                the same way the shaders do
+
+      Args:     const XMFLOAT4* aCoefficients
+                  Irradiance coefficients
+                FXMVECTOR normal
+                  Normalized direction
+
+      Returns:  XMVECTOR
+                  Irradiance divided by pi
+    -----------------------------------------------------------------F-F*/
+
+    XMVECTOR EvaluateIrradianceSH9(
+        _In_reads_(NUM_SH_COEFFICIENTS) const XMFLOAT4* aCoefficients,
+        _In_ FXMVECTOR normal
+    )
+    {
+        XMFLOAT3 direction;
+        XMStoreFloat3(&direction, normal);
+
+        FLOAT aBasis[NUM_SH_COEFFICIENTS];
+        EvaluateBasisPolynomials(direction, aBasis);
+
+        XMVECTOR irradiance = XMVectorZero();
+        for (UINT i = 0u; i < NUM_SH_COEFFICIENTS; ++i)
+        {
+            irradiance = XMVectorMultiplyAdd(XMLoadFloat4(&aCoefficients[i]), XMVectorReplicate(aBasis[i]), irradiance);
+        }
+
+        return irradiance;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: IntegrateIrradiance
+
+      Summary:  Integrates the cosine weighted radiance over every texel
+                of the cube map. It is the reference the projection is
+                validated against, and is too slow for anything else.
+
+      Args:     const CubeMapData& cubeMap
+                  Decoded cube map
+                const XMFLOAT3* aNormals
+                  Normalized directions
+                UINT uNumNormals
+                  Number of directions
+                XMFLOAT3* aIrradiance
+                  Irradiance divided by pi towards every direction
+    -----------------------------------------------------------------F-F*/
+
+    void IntegrateIrradiance(
+        _In_ const CubeMapData& cubeMap,
+        _In_reads_(uNumNormals) const XMFLOAT3* aNormals,
+        _In_ UINT uNumNormals,
+        _Out_writes_(uNumNormals) XMFLOAT3* aIrradiance
+    )
+    {
+        std::vector<XMFLOAT3> aFaceSums[NUM_CUBE_FACES];
+        FLOAT aFaceWeights[NUM_CUBE_FACES];
+
+        UINT aFaces[NUM_CUBE_FACES];
+        std::iota(std::begin(aFaces), std::end(aFaces), 0u);
+
+        std::for_each(
+            std::execution::par,
+            std::begin(aFaces),
+            std::end(aFaces),
+            [&](UINT uFace)
+            {
+                std::vector<XMFLOAT3>& aSums = aFaceSums[uFace];
+                aSums.assign(uNumNormals, XMFLOAT3(0.0f, 0.0f, 0.0f));
+                FLOAT weight = 0.0f;
+
+                const FLOAT invSize = 1.0f / static_cast<FLOAT>(cubeMap.uSize);
+                const XMFLOAT4* pTexel = cubeMap.aFaces[uFace].data();
+                for (UINT y = 0u; y < cubeMap.uSize; ++y)
+                {
+                    for (UINT x = 0u; x < cubeMap.uSize; ++x, ++pTexel)
+                    {
+                        const XMVECTOR direction = GetCubeMapTexelDirection(uFace, (static_cast<FLOAT>(x) + 0.5f) * invSize, (static_cast<FLOAT>(y) + 0.5f) * invSize);
+                        const FLOAT solidAngle = GetCubeMapTexelSolidAngle(cubeMap.uSize, x, y);
+                        const XMVECTOR radiance = XMLoadFloat4(pTexel);
+
+                        for (UINT i = 0u; i < uNumNormals; ++i)
+                        {
+                            const FLOAT cosine = XMVectorGetX(XMVector3Dot(XMLoadFloat3(&aNormals[i]), direction));
+                            if (cosine > 0.0f)
+                            {
+                                XMStoreFloat3(&aSums[i], XMVectorMultiplyAdd(radiance, XMVectorReplicate(cosine * solidAngle), XMLoadFloat3(&aSums[i])));
+                            }
+                        }
+                        weight += solidAngle;
+                    }
+                }
+                aFaceWeights[uFace] = weight;
+            }
+        );
+
+        FLOAT weight = 0.0f;
+        for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+        {
+            weight += aFaceWeights[uFace];
+        }
+        const FLOAT scale = 4.0f / weight;
+
+        for (UINT i = 0u; i < uNumNormals; ++i)
+        {
+            XMVECTOR sum = XMVectorZero();
+            for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+            {
+                sum = XMVectorAdd(sum, XMLoadFloat3(&aFaceSums[uFace][i]));
+            }
+            XMStoreFloat3(&aIrradiance[i], XMVectorScale(sum, scale));
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: LoadIrradianceCache
+
+      Summary:  Reads irradiance coefficients baked from a source file
+                with the given hash
+
+      Args:     const std::filesystem::path& cacheFilePath
+                  Path to the cache file
+                UINT64 uSourceHash
+                  Hash of the source cube map file
+                XMFLOAT4* aCoefficients
+                  Cached irradiance coefficients
+
+      Returns:  HRESULT
+                  Status code, fails when the cache is missing or was
+                  baked from a different source
+    -----------------------------------------------------------------F-F*/
+
+    HRESULT LoadIrradianceCache(
+        _In_ const std::filesystem::path& cacheFilePath,
+        _In_ UINT64 uSourceHash,
+        _Out_writes_(NUM_SH_COEFFICIENTS) XMFLOAT4* aCoefficients
+    )
+    {
+        std::ifstream file(cacheFilePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        IrradianceCacheHeader header = {};
+        file.read(reinterpret_cast<CHAR*>(&header), sizeof(header));
+        if (!file
+            || header.uMagic != IRRADIANCE_CACHE_MAGIC
+            || header.uVersion != IRRADIANCE_CACHE_VERSION
+            || header.uSourceHash != uSourceHash)
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+
+        file.read(reinterpret_cast<CHAR*>(aCoefficients), sizeof(XMFLOAT4) * NUM_SH_COEFFICIENTS);
+        if (!file)
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SaveIrradianceCache
+
+      Summary:  Writes irradiance coefficients along with the hash of
+                the file they were baked from
+
+      Args:     const std::filesystem::path& cacheFilePath
+                  Path to the cache file
+                UINT64 uSourceHash
+                  Hash of the source cube map file
+                const XMFLOAT4* aCoefficients
+                  Irradiance coefficients
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+
+    HRESULT SaveIrradianceCache(
+        _In_ const std::filesystem::path& cacheFilePath,
+        _In_ UINT64 uSourceHash,
+        _In_reads_(NUM_SH_COEFFICIENTS) const XMFLOAT4* aCoefficients
+    )
+    {
+        std::ofstream file(cacheFilePath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return HRESULT_FROM_WIN32(ERROR_ACCESS_DENIED);
+        }
+
+        const IrradianceCacheHeader header =
+        {
+            .uMagic = IRRADIANCE_CACHE_MAGIC,
+            .uVersion = IRRADIANCE_CACHE_VERSION,
+            .uSourceHash = uSourceHash
+        };
+        file.write(reinterpret_cast<const CHAR*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const CHAR*>(aCoefficients), sizeof(XMFLOAT4) * NUM_SH_COEFFICIENTS);
+        if (!file)
+        {
+            return HRESULT_FROM_WIN32(ERROR_WRITE_FAULT);
+        }
+
+        return S_OK;
+    }
+}
@@ -0,0 +1,52 @@
+/*+===================================================================
+  File:      SPHERICALHARMONICS.H
+
+  Summary:   SphericalHarmonics header file contains declarations of
+             the functions that project a cube map into the order 2
+             spherical harmonics irradiance used for diffuse ambient
+             lighting.
+
+  Functions: ProjectIrradianceSH9, EvaluateIrradianceSH9,
+             IntegrateIrradiance, LoadIrradianceCache,
+             SaveIrradianceCache
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Texture/CubeMapData.h"
+
+namespace library
+{
+    void ProjectIrradianceSH9(
+        _In_ const CubeMapData& cubeMap,
+        _Out_writes_(NUM_SH_COEFFICIENTS) XMFLOAT4* aCoefficients
+    );
+
+    XMVECTOR EvaluateIrradianceSH9(
+        _In_reads_(NUM_SH_COEFFICIENTS) const XMFLOAT4* aCoefficients,
+        _In_ FXMVECTOR normal
+    );
+
+    void IntegrateIrradiance(
+        _In_ const CubeMapData& cubeMap,
+        _In_reads_(uNumNormals) const XMFLOAT3* aNormals,
+        _In_ UINT uNumNormals,
+        _Out_writes_(uNumNormals) XMFLOAT3* aIrradiance
+    );
+
+    HRESULT LoadIrradianceCache(
+        _In_ const std::filesystem::path& cacheFilePath,
+        _In_ UINT64 uSourceHash,
+        _Out_writes_(NUM_SH_COEFFICIENTS) XMFLOAT4* aCoefficients
+    );
+
+    HRESULT SaveIrradianceCache(
+        _In_ const std::filesystem::path& cacheFilePath,
+        _In_ UINT64 uSourceHash,
+        _In_reads_(NUM_SH_COEFFICIENTS) const XMFLOAT4* aCoefficients
+    );
+}
@@ -0,0 +1,605 @@
+#include "Model/AnimationClip.h"
+
+namespace library
+{
+    static constexpr const FLOAT INV_SQRT2 = 0.70710678f;
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::AnimationClip
+
+      Summary:  Constructor
+
+      Modifies: [m_aChannels, m_aSamples, m_uNumFrames, m_uFrameStride,
+                 m_frameTicks, m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    AnimationClip::AnimationClip()
+        : m_aChannels(std::vector<ChannelTracks>())
+        , m_aSamples(std::vector<UINT16>())
+        , m_uNumFrames(0u)
+        , m_uFrameStride(0u)
+        , m_frameTicks(0.0f)
+        , m_stats()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::Initialize
+
+      Summary:  Finds the constant tracks, quantizes the others and
+                measures the error of the result
+
+      Args:     UINT uNumChannels
+                  Number of animated nodes
+                UINT uNumFrames
+                  Number of samples of every channel
+                FLOAT frameTicks
+                  Time between two samples
+                const std::vector<XMFLOAT3>& aTranslations
+                  Translations of every channel, frame after frame
+                const std::vector<XMFLOAT4>& aRotations
+                  Rotation quaternions of every channel, frame after
+                  frame
+                const std::vector<XMFLOAT3>& aScales
+                  Scales of every channel, frame after frame
+
+      Modifies: [m_aChannels, m_aSamples, m_uNumFrames, m_uFrameStride,
+                 m_frameTicks, m_stats].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT AnimationClip::Initialize(
+        _In_ UINT uNumChannels,
+        _In_ UINT uNumFrames,
+        _In_ FLOAT frameTicks,
+        _In_ const std::vector<XMFLOAT3>& aTranslations,
+        _In_ const std::vector<XMFLOAT4>& aRotations,
+        _In_ const std::vector<XMFLOAT3>& aScales
+    )
+    {
+        const size_t uNumSamples = static_cast<size_t>(uNumChannels) * uNumFrames;
+        if (uNumFrames == 0u || aTranslations.size() != uNumSamples || aRotations.size() != uNumSamples || aScales.size() != uNumSamples)
+        {
+            return E_INVALIDARG;
+        }
+
+        m_uNumFrames = uNumFrames;
+        m_frameTicks = frameTicks;
+        m_uFrameStride = 0u;
+        m_stats = AnimationClipStats();
+        m_aChannels.resize(uNumChannels);
+
+        // Constant tracks take no room in the frames
+        for (UINT i = 0u; i < uNumChannels; ++i)
+        {
+            initRangeTrack(m_aChannels[i].Translation, aTranslations, i, TRANSLATION_TOLERANCE);
+            initRotationTrack(m_aChannels[i].Rotation, aRotations, i);
+            initRangeTrack(m_aChannels[i].Scaling, aScales, i, SCALING_TOLERANCE);
+        }
+
+        m_aSamples.assign(static_cast<size_t>(m_uFrameStride) * m_uNumFrames, 0u);
+
+        for (UINT i = 0u; i < uNumChannels; ++i)
+        {
+            quantizeRange(m_aChannels[i].Translation, aTranslations, i);
+            quantizeRotation(m_aChannels[i].Rotation, aRotations, i);
+            quantizeRange(m_aChannels[i].Scaling, aScales, i);
+        }
+
+        m_stats.uNumBytes = m_aSamples.size() * sizeof(m_aSamples[0]) + m_aChannels.size() * sizeof(m_aChannels[0]);
+        m_stats.uNumAnimatedTracks = m_uFrameStride / 3u;
+        m_stats.uNumConstantTracks = uNumChannels * 3u - m_stats.uNumAnimatedTracks;
+
+        measureError(aTranslations, aRotations, aScales);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::FindFrame
+
+      Summary:  Returns the frame right before the given time and how
+                far the time is towards the next frame
+
+      Args:     FLOAT animationTimeTicks
+                  Animation time
+                UINT& uOutFrame
+                  Frame right before the time
+                FLOAT& outFactor
+                  Blend factor towards the next frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationClip::FindFrame(
+        _In_ FLOAT animationTimeTicks,
+        _Out_ UINT& uOutFrame,
+        _Out_ FLOAT& outFactor
+    ) const
+    {
+        if (m_uNumFrames < 2u || m_frameTicks <= 0.0f)
+        {
+            uOutFrame = 0u;
+            outFactor = 0.0f;
+            return;
+        }
+
+        FLOAT frame = fmaxf(animationTimeTicks / m_frameTicks, 0.0f);
+        uOutFrame = static_cast<UINT>(frame);
+        if (uOutFrame >= m_uNumFrames - 1u)
+        {
+            uOutFrame = m_uNumFrames - 2u;
+            outFactor = 1.0f;
+            return;
+        }
+
+        outFactor = frame - static_cast<FLOAT>(uOutFrame);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::Sample
+
+      Summary:  Decodes the transform of a channel between a frame and
+                the next one
+
+      Args:     UINT uChannelIndex
+                  Index of the channel
+                UINT uFrame
+                  Frame found by FindFrame
+                FLOAT factor
+                  Blend factor found by FindFrame
+                XMVECTOR& outScale
+                  Scaling vector
+                XMVECTOR& outRotation
+                  Rotation quaternion
+                XMVECTOR& outTranslation
+                  Translation vector
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationClip::Sample(
+        _In_ UINT uChannelIndex,
+        _In_ UINT uFrame,
+        _In_ FLOAT factor,
+        _Out_ XMVECTOR& outScale,
+        _Out_ XMVECTOR& outRotation,
+        _Out_ XMVECTOR& outTranslation
+    ) const
+    {
+        const ChannelTracks& channel = m_aChannels[uChannelIndex];
+        const UINT uNextFrame = uFrame + 1u < m_uNumFrames ? uFrame + 1u : uFrame;
+
+        outScale = XMVectorLerp(decodeRange(channel.Scaling, uFrame), decodeRange(channel.Scaling, uNextFrame), factor);
+        outTranslation = XMVectorLerp(decodeRange(channel.Translation, uFrame), decodeRange(channel.Translation, uNextFrame), factor);
+
+        XMVECTOR rotation = decodeRotation(channel.Rotation, uFrame);
+        XMVECTOR nextRotation = decodeRotation(channel.Rotation, uNextFrame);
+
+        // q and -q are the same rotation, blend along the shorter arc
+        if (XMVectorGetX(XMVector4Dot(rotation, nextRotation)) < 0.0f)
+        {
+            nextRotation = XMVectorNegate(nextRotation);
+        }
+        outRotation = XMQuaternionNormalize(XMVectorLerp(rotation, nextRotation, factor));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::Save
+
+      Summary:  Appends the tracks and the quantized samples to a model
+                cache, so the clip doesn't need to be resampled again
+
+      Args:     ModelCacheWriter& writer
+                  Cache being written
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationClip::Save(
+        _Inout_ ModelCacheWriter& writer
+    ) const
+    {
+        writer.Write(m_uNumFrames);
+        writer.Write(m_uFrameStride);
+        writer.Write(m_frameTicks);
+        writer.Write(m_stats);
+        writer.WriteArray(m_aChannels);
+        writer.WriteArray(m_aSamples);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::Load
+
+      Summary:  Reads the tracks and the quantized samples written by
+                Save
+
+      Args:     ModelCacheReader& reader
+                  Cache being read
+
+      Modifies: [m_aChannels, m_aSamples, m_uNumFrames, m_uFrameStride,
+                 m_frameTicks, m_stats].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT AnimationClip::Load(
+        _Inout_ ModelCacheReader& reader
+    )
+    {
+        reader.Read(m_uNumFrames);
+        reader.Read(m_uFrameStride);
+        reader.Read(m_frameTicks);
+        reader.Read(m_stats);
+        reader.ReadArray(m_aChannels);
+        reader.ReadArray(m_aSamples);
+
+        if (reader.HasFailed() || m_aSamples.size() != static_cast<size_t>(m_uNumFrames) * m_uFrameStride)
+        {
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetNumChannels
+
+      Summary:  Returns the number of channels
+
+      Returns:  UINT
+                  Number of channels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT AnimationClip::GetNumChannels() const
+    {
+        return static_cast<UINT>(m_aChannels.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::GetStats
+
+      Summary:  Returns the size and the error of the clip
+
+      Returns:  const AnimationClipStats&
+                  Statistics of the clip
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const AnimationClipStats& AnimationClip::GetStats() const
+    {
+        return m_stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::decodeRange
+
+      Summary:  Decodes a translation or a scaling sample
+
+      Args:     const Track& track
+                  Track to decode
+                UINT uFrame
+                  Frame of the sample
+
+      Returns:  XMVECTOR
+                  Decoded vector
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    XMVECTOR AnimationClip::decodeRange(
+        _In_ const Track& track,
+        _In_ UINT uFrame
+    ) const
+    {
+        XMVECTOR minimum = XMLoadFloat4(&track.Value);
+        if (track.uOffset == CONSTANT_TRACK)
+        {
+            return minimum;
+        }
+
+        const UINT16* pSample = &m_aSamples[static_cast<size_t>(uFrame) * m_uFrameStride + track.uOffset];
+        XMVECTOR quantized = XMVectorSet(
+            static_cast<FLOAT>(pSample[0]),
+            static_cast<FLOAT>(pSample[1]),
+            static_cast<FLOAT>(pSample[2]),
+            0.0f
+        );
+
+        return XMVectorMultiplyAdd(quantized, XMLoadFloat3(&track.Step), minimum);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::decodeRotation
+
+      Summary:  Rebuilds a rotation from its smallest three components.
+                The index of the dropped component is kept in the two
+                highest bits, the dropped component is positive.
+
+      Args:     const Track& track
+                  Track to decode
+                UINT uFrame
+                  Frame of the sample
+
+      Returns:  XMVECTOR
+                  Unit quaternion
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    XMVECTOR AnimationClip::decodeRotation(
+        _In_ const Track& track,
+        _In_ UINT uFrame
+    ) const
+    {
+        if (track.uOffset == CONSTANT_TRACK)
+        {
+            return XMLoadFloat4(&track.Value);
+        }
+
+        const UINT16* pSample = &m_aSamples[static_cast<size_t>(uFrame) * m_uFrameStride + track.uOffset];
+        const UINT64 uPacked = static_cast<UINT64>(pSample[0])
+            | (static_cast<UINT64>(pSample[1]) << 16u)
+            | (static_cast<UINT64>(pSample[2]) << 32u);
+
+        const UINT uLargest = static_cast<UINT>(uPacked >> 45u) & 0x3u;
+        const FLOAT scale = 2.0f * INV_SQRT2 / static_cast<FLOAT>(NUM_ROTATION_STEPS);
+
+        FLOAT aComponents[4];
+        FLOAT sumOfSquares = 0.0f;
+        for (UINT i = 0u, uSmall = 0u; i < 4u; ++i)
+        {
+            if (i == uLargest)
+            {
+                continue;
+            }
+
+            const UINT uQuantized = static_cast<UINT>(uPacked >> (30u - 15u * uSmall)) & NUM_ROTATION_STEPS;
+            aComponents[i] = static_cast<FLOAT>(uQuantized) * scale - INV_SQRT2;
+            sumOfSquares += aComponents[i] * aComponents[i];
+            ++uSmall;
+        }
+        aComponents[uLargest] = sqrtf(fmaxf(1.0f - sumOfSquares, 0.0f));
+
+        return XMVectorSet(aComponents[0], aComponents[1], aComponents[2], aComponents[3]);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::initRangeTrack
+
+      Summary:  Finds the range of a translation or a scaling track and
+                reserves room in the frames unless it is constant
+
+      Args:     Track& track
+                  Track to initialize
+                const std::vector<XMFLOAT3>& aValues
+                  Resampled values of every channel
+                UINT uChannelIndex
+                  Index of the channel
+                FLOAT tolerance
+                  Largest change of a constant track
+
+      Modifies: [m_uFrameStride].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationClip::initRangeTrack(
+        _Out_ Track& track,
+        _In_ const std::vector<XMFLOAT3>& aValues,
+        _In_ UINT uChannelIndex,
+        _In_ FLOAT tolerance
+    )
+    {
+        const XMFLOAT3* pValues = &aValues[static_cast<size_t>(uChannelIndex) * m_uNumFrames];
+
+        XMVECTOR minimum = XMLoadFloat3(&pValues[0]);
+        XMVECTOR maximum = minimum;
+        for (UINT uFrame = 1u; uFrame < m_uNumFrames; ++uFrame)
+        {
+            XMVECTOR value = XMLoadFloat3(&pValues[uFrame]);
+            minimum = XMVectorMin(minimum, value);
+            maximum = XMVectorMax(maximum, value);
+        }
+
+        XMVECTOR extent = XMVectorSubtract(maximum, minimum);
+        if (XMVector3LessOrEqual(extent, XMVectorReplicate(tolerance)))
+        {
+            XMStoreFloat4(&track.Value, XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f));
+            track.Step = XMFLOAT3(0.0f, 0.0f, 0.0f);
+            track.uOffset = CONSTANT_TRACK;
+            return;
+        }
+
+        XMStoreFloat4(&track.Value, minimum);
+        XMStoreFloat3(&track.Step, XMVectorScale(extent, 1.0f / static_cast<FLOAT>(NUM_RANGE_STEPS)));
+        track.uOffset = m_uFrameStride;
+        m_uFrameStride += 3u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::initRotationTrack
+
+      Summary:  Reserves room in the frames for a rotation track unless
+                every sample is the same rotation
+
+      Args:     Track& track
+                  Track to initialize
+                const std::vector<XMFLOAT4>& aRotations
+                  Resampled rotations of every channel
+                UINT uChannelIndex
+                  Index of the channel
+
+      Modifies: [m_uFrameStride].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationClip::initRotationTrack(
+        _Out_ Track& track,
+        _In_ const std::vector<XMFLOAT4>& aRotations,
+        _In_ UINT uChannelIndex
+    )
+    {
+        const XMFLOAT4* pRotations = &aRotations[static_cast<size_t>(uChannelIndex) * m_uNumFrames];
+
+        XMVECTOR first = XMQuaternionNormalize(XMLoadFloat4(&pRotations[0]));
+        XMStoreFloat4(&track.Value, first);
+        track.Step = XMFLOAT3(0.0f, 0.0f, 0.0f);
+        track.uOffset = CONSTANT_TRACK;
+
+        for (UINT uFrame = 1u; uFrame < m_uNumFrames; ++uFrame)
+        {
+            XMVECTOR rotation = XMQuaternionNormalize(XMLoadFloat4(&pRotations[uFrame]));
+            if (fabsf(XMVectorGetX(XMVector4Dot(first, rotation))) < 1.0f - ROTATION_TOLERANCE)
+            {
+                track.uOffset = m_uFrameStride;
+                m_uFrameStride += 3u;
+                return;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::quantizeRange
+
+      Summary:  Writes a translation or a scaling track to the frames
+
+      Args:     const Track& track
+                  Initialized track
+                const std::vector<XMFLOAT3>& aValues
+                  Resampled values of every channel
+                UINT uChannelIndex
+                  Index of the channel
+
+      Modifies: [m_aSamples].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationClip::quantizeRange(
+        _In_ const Track& track,
+        _In_ const std::vector<XMFLOAT3>& aValues,
+        _In_ UINT uChannelIndex
+    )
+    {
+        if (track.uOffset == CONSTANT_TRACK)
+        {
+            return;
+        }
+
+        const XMFLOAT3* pValues = &aValues[static_cast<size_t>(uChannelIndex) * m_uNumFrames];
+        const FLOAT* aMinimum = &track.Value.x;
+        const FLOAT* aStep = &track.Step.x;
+
+        for (UINT uFrame = 0u; uFrame < m_uNumFrames; ++uFrame)
+        {
+            const FLOAT* aValue = &pValues[uFrame].x;
+            UINT16* pSample = &m_aSamples[static_cast<size_t>(uFrame) * m_uFrameStride + track.uOffset];
+
+            for (UINT i = 0u; i < 3u; ++i)
+            {
+                FLOAT quantized = aStep[i] > 0.0f ? (aValue[i] - aMinimum[i]) / aStep[i] : 0.0f;
+                pSample[i] = static_cast<UINT16>(fminf(fmaxf(quantized + 0.5f, 0.0f), static_cast<FLOAT>(NUM_RANGE_STEPS)));
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::quantizeRotation
+
+      Summary:  Writes a rotation track to the frames. The largest
+                component is dropped and the quaternion negated so
+                that it is positive, the other three lie within
+                [-1/sqrt(2), 1/sqrt(2)] and take 15 bits each.
+
+      Args:     const Track& track
+                  Initialized track
+                const std::vector<XMFLOAT4>& aRotations
+                  Resampled rotations of every channel
+                UINT uChannelIndex
+                  Index of the channel
+
+      Modifies: [m_aSamples].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationClip::quantizeRotation(
+        _In_ const Track& track,
+        _In_ const std::vector<XMFLOAT4>& aRotations,
+        _In_ UINT uChannelIndex
+    )
+    {
+        if (track.uOffset == CONSTANT_TRACK)
+        {
+            return;
+        }
+
+        const XMFLOAT4* pRotations = &aRotations[static_cast<size_t>(uChannelIndex) * m_uNumFrames];
+        const FLOAT scale = static_cast<FLOAT>(NUM_ROTATION_STEPS) / (2.0f * INV_SQRT2);
+
+        for (UINT uFrame = 0u; uFrame < m_uNumFrames; ++uFrame)
+        {
+            XMFLOAT4 rotation;
+            XMStoreFloat4(&rotation, XMQuaternionNormalize(XMLoadFloat4(&pRotations[uFrame])));
+            const FLOAT* aComponents = &rotation.x;
+
+            UINT uLargest = 0u;
+            for (UINT i = 1u; i < 4u; ++i)
+            {
+                if (fabsf(aComponents[i]) > fabsf(aComponents[uLargest]))
+                {
+                    uLargest = i;
+                }
+            }
+            const FLOAT sign = aComponents[uLargest] < 0.0f ? -1.0f : 1.0f;
+
+            UINT64 uPacked = static_cast<UINT64>(uLargest) << 45u;
+            for (UINT i = 0u, uSmall = 0u; i < 4u; ++i)
+            {
+                if (i == uLargest)
+                {
+                    continue;
+                }
+
+                FLOAT quantized = (sign * aComponents[i] + INV_SQRT2) * scale + 0.5f;
+                UINT uQuantized = static_cast<UINT>(fminf(fmaxf(quantized, 0.0f), static_cast<FLOAT>(NUM_ROTATION_STEPS)));
+                uPacked |= static_cast<UINT64>(uQuantized) << (30u - 15u * uSmall);
+                ++uSmall;
+            }
+
+            UINT16* pSample = &m_aSamples[static_cast<size_t>(uFrame) * m_uFrameStride + track.uOffset];
+            pSample[0] = static_cast<UINT16>(uPacked);
+            pSample[1] = static_cast<UINT16>(uPacked >> 16u);
+            pSample[2] = static_cast<UINT16>(uPacked >> 32u);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationClip::measureError
+
+      Summary:  Decodes every sample and keeps the largest distance to
+                the resampled source
+
+      Args:     const std::vector<XMFLOAT3>& aTranslations
+                  Resampled translations
+                const std::vector<XMFLOAT4>& aRotations
+                  Resampled rotations
+                const std::vector<XMFLOAT3>& aScales
+                  Resampled scales
+
+      Modifies: [m_stats].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationClip::measureError(
+        _In_ const std::vector<XMFLOAT3>& aTranslations,
+        _In_ const std::vector<XMFLOAT4>& aRotations,
+        _In_ const std::vector<XMFLOAT3>& aScales
+    )
+    {
+        for (UINT uChannel = 0u; uChannel < m_aChannels.size(); ++uChannel)
+        {
+            const ChannelTracks& channel = m_aChannels[uChannel];
+
+            for (UINT uFrame = 0u; uFrame < m_uNumFrames; ++uFrame)
+            {
+                const size_t uIndex = static_cast<size_t>(uChannel) * m_uNumFrames + uFrame;
+
+                XMVECTOR translationError = XMVector3Length(XMVectorSubtract(decodeRange(channel.Translation, uFrame), XMLoadFloat3(&aTranslations[uIndex])));
+                m_stats.maxTranslationError = fmaxf(m_stats.maxTranslationError, XMVectorGetX(translationError));
+
+                XMVECTOR scalingError = XMVector3Length(XMVectorSubtract(decodeRange(channel.Scaling, uFrame), XMLoadFloat3(&aScales[uIndex])));
+                m_stats.maxScalingError = fmaxf(m_stats.maxScalingError, XMVectorGetX(scalingError));
+
+                XMVECTOR source = XMQuaternionNormalize(XMLoadFloat4(&aRotations[uIndex]));
+                FLOAT cosHalfAngle = fminf(fabsf(XMVectorGetX(XMVector4Dot(decodeRotation(channel.Rotation, uFrame), source))), 1.0f);
+                m_stats.maxRotationError = fmaxf(m_stats.maxRotationError, XMConvertToDegrees(2.0f * acosf(cosHalfAngle)));
+            }
+        }
+    }
+}
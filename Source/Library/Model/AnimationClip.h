@@ -0,0 +1,160 @@
+/*+===================================================================
+  File:      ANIMATIONCLIP.H
+
+  Summary:   AnimationClip header file contains declarations of
+             AnimationClip class that stores a skeletal animation
+             resampled at a uniform rate with quantized tracks.
+
+  Classes: AnimationClip
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Model/ModelCache.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   AnimationClipStats
+
+      Summary:  Size of the compressed clip and the largest error of
+                its decoded samples against the uniformly resampled
+                source. Rotation errors are in degrees.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct AnimationClipStats
+    {
+        size_t uNumBytes;
+        UINT uNumConstantTracks;
+        UINT uNumAnimatedTracks;
+        FLOAT maxTranslationError;
+        FLOAT maxRotationError;
+        FLOAT maxScalingError;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    AnimationClip
+
+      Summary:  Animation sampled at a uniform rate. Tracks that do not
+                change are kept as a single value, the others are
+                quantized to 16 bits per component, with rotations
+                stored as the smallest three components. The samples
+                of every animated track of a frame are contiguous, so
+                a pose reads two short rows.
+
+      Methods:  Initialize
+                  Quantizes the uniformly resampled channels
+                FindFrame
+                  Returns the frame and the blend factor at a time
+                Sample
+                  Decodes the transform of a channel
+                Save
+                  Appends the quantized clip to a model cache
+                Load
+                  Reads the quantized clip back from a model cache
+                GetNumChannels
+                  Returns the number of channels
+                GetStats
+                  Returns the size and the error of the clip
+                AnimationClip
+                  Constructor.
+                ~AnimationClip
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class AnimationClip
+    {
+    public:
+        static constexpr const UINT CONSTANT_TRACK = (0xFFFFFFFF);
+
+    public:
+        AnimationClip();
+        AnimationClip(const AnimationClip& other) = delete;
+        AnimationClip(AnimationClip&& other) = delete;
+        AnimationClip& operator=(const AnimationClip& other) = delete;
+        AnimationClip& operator=(AnimationClip&& other) = delete;
+        virtual ~AnimationClip() = default;
+
+        HRESULT Initialize(
+            _In_ UINT uNumChannels,
+            _In_ UINT uNumFrames,
+            _In_ FLOAT frameTicks,
+            _In_ const std::vector<XMFLOAT3>& aTranslations,
+            _In_ const std::vector<XMFLOAT4>& aRotations,
+            _In_ const std::vector<XMFLOAT3>& aScales
+        );
+
+        void FindFrame(_In_ FLOAT animationTimeTicks, _Out_ UINT& uOutFrame, _Out_ FLOAT& outFactor) const;
+        void Sample(
+            _In_ UINT uChannelIndex,
+            _In_ UINT uFrame,
+            _In_ FLOAT factor,
+            _Out_ XMVECTOR& outScale,
+            _Out_ XMVECTOR& outRotation,
+            _Out_ XMVECTOR& outTranslation
+        ) const;
+
+        void Save(_Inout_ ModelCacheWriter& writer) const;
+        HRESULT Load(_Inout_ ModelCacheReader& reader);
+
+        UINT GetNumChannels() const;
+        const AnimationClipStats& GetStats() const;
+
+    protected:
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   Track
+
+          Summary:  Constant value, or the minimum and the quantization
+                    step of a range quantized track, and the offset of
+                    its samples in a frame
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct Track
+        {
+            XMFLOAT4 Value;
+            XMFLOAT3 Step;
+            UINT uOffset;
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   ChannelTracks
+
+          Summary:  Tracks of a single animated node
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct ChannelTracks
+        {
+            Track Translation;
+            Track Rotation;
+            Track Scaling;
+        };
+
+        XMVECTOR decodeRange(_In_ const Track& track, _In_ UINT uFrame) const;
+        XMVECTOR decodeRotation(_In_ const Track& track, _In_ UINT uFrame) const;
+        void initRangeTrack(_Out_ Track& track, _In_ const std::vector<XMFLOAT3>& aValues, _In_ UINT uChannelIndex, _In_ FLOAT tolerance);
+        void initRotationTrack(_Out_ Track& track, _In_ const std::vector<XMFLOAT4>& aRotations, _In_ UINT uChannelIndex);
+        void quantizeRange(_In_ const Track& track, _In_ const std::vector<XMFLOAT3>& aValues, _In_ UINT uChannelIndex);
+        void quantizeRotation(_In_ const Track& track, _In_ const std::vector<XMFLOAT4>& aRotations, _In_ UINT uChannelIndex);
+        void measureError(
+            _In_ const std::vector<XMFLOAT3>& aTranslations,
+            _In_ const std::vector<XMFLOAT4>& aRotations,
+            _In_ const std::vector<XMFLOAT3>& aScales
+        );
+
+    protected:
+        static constexpr const FLOAT TRANSLATION_TOLERANCE = 1e-4f;
+        static constexpr const FLOAT SCALING_TOLERANCE = 1e-5f;
+        static constexpr const FLOAT ROTATION_TOLERANCE = 1e-7f;
+        static constexpr const UINT NUM_RANGE_STEPS = 65535u;
+        static constexpr const UINT NUM_ROTATION_STEPS = 32767u;
+
+    protected:
+        std::vector<ChannelTracks> m_aChannels;
+        std::vector<UINT16> m_aSamples;
+
+        UINT m_uNumFrames;
+        UINT m_uFrameStride;
+        FLOAT m_frameTicks;
+
+        AnimationClipStats m_stats;
+    };
+}
@@ -0,0 +1,189 @@
+#include "Model/AnimationLod.h"
+
+namespace library
+{
+    const AnimationLod AnimationLodSelector::sm_aLods[static_cast<size_t>(eAnimationLod::COUNT)] =
+    {
+        { .Level = eAnimationLod::FULL, .uUpdateInterval = 1u, .bSkipLeafBones = FALSE },
+        { .Level = eAnimationLod::HALF_RATE, .uUpdateInterval = 2u, .bSkipLeafBones = FALSE },
+        { .Level = eAnimationLod::QUARTER_RATE, .uUpdateInterval = 4u, .bSkipLeafBones = FALSE },
+        { .Level = eAnimationLod::QUARTER_RATE_NO_LEAVES, .uUpdateInterval = 4u, .bSkipLeafBones = TRUE },
+        { .Level = eAnimationLod::FROZEN, .uUpdateInterval = 0u, .bSkipLeafBones = TRUE },
+    };
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodSelector::GetLod
+
+      Summary:  Returns the settings of a level of detail
+
+      Args:     eAnimationLod level
+                  Level of detail
+
+      Returns:  const AnimationLod&
+                  Update interval and leaf bones of the level
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const AnimationLod& AnimationLodSelector::GetLod(
+        _In_ eAnimationLod level
+    )
+    {
+        assert(level < eAnimationLod::COUNT);
+        return sm_aLods[static_cast<size_t>(level)];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodSelector::AnimationLodSelector
+
+      Summary:  Constructor, every sphere gets the full level of detail
+                until a viewpoint is set
+
+      Modifies: [m_frustum, m_eye, m_projectionScale, m_bHasViewpoint].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    AnimationLodSelector::AnimationLodSelector()
+        : m_frustum()
+        , m_eye(0.0f, 0.0f, 0.0f)
+        , m_projectionScale(1.0f)
+        , m_bHasViewpoint(FALSE)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodSelector::SetViewpoint
+
+      Summary:  Sets the camera the levels are selected for and builds
+                its frustum in world space
+
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                const XMMATRIX& view
+                  View matrix of the camera
+                const XMMATRIX& projection
+                  Perspective projection matrix of the camera
+
+      Modifies: [m_frustum, m_eye, m_projectionScale, m_bHasViewpoint].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationLodSelector::SetViewpoint(
+        _In_ const XMVECTOR& eye,
+        _In_ const XMMATRIX& view,
+        _In_ const XMMATRIX& projection
+    )
+    {
+        BoundingFrustum viewFrustum(projection);
+        viewFrustum.Transform(m_frustum, XMMatrixInverse(nullptr, view));
+
+        XMStoreFloat3(&m_eye, eye);
+
+        // Cotangent of half the vertical field of view, a sphere of radius r at distance d
+        // covers r * scale / d of the screen height
+        m_projectionScale = XMVectorGetY(projection.r[1]);
+        m_bHasViewpoint = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodSelector::Select
+
+      Summary:  Returns the level of detail of a bounding sphere from
+                the fraction of the screen height it covers
+
+      Args:     const BoundingSphere& boundingSphere
+                  Bounding sphere in world space
+
+      Returns:  const AnimationLod&
+                  Level of detail of the sphere
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const AnimationLod& AnimationLodSelector::Select(
+        _In_ const BoundingSphere& boundingSphere
+    ) const
+    {
+        if (!m_bHasViewpoint)
+        {
+            return GetLod(eAnimationLod::FULL);
+        }
+
+        if (m_frustum.Contains(boundingSphere) == DISJOINT)
+        {
+            return GetLod(eAnimationLod::FROZEN);
+        }
+
+        const FLOAT distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&boundingSphere.Center), XMLoadFloat3(&m_eye))));
+        if (distance <= boundingSphere.Radius)
+        {
+            return GetLod(eAnimationLod::FULL);
+        }
+
+        const FLOAT screenSize = boundingSphere.Radius * m_projectionScale / distance;
+        if (screenSize >= HALF_RATE_SCREEN_SIZE)
+        {
+            return GetLod(eAnimationLod::FULL);
+        }
+        if (screenSize >= QUARTER_RATE_SCREEN_SIZE)
+        {
+            return GetLod(eAnimationLod::HALF_RATE);
+        }
+        if (screenSize >= NO_LEAVES_SCREEN_SIZE)
+        {
+            return GetLod(eAnimationLod::QUARTER_RATE);
+        }
+
+        return GetLod(eAnimationLod::QUARTER_RATE_NO_LEAVES);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   AnimationLodSelector::Benchmark
+
+      Summary:  Selects the level of detail of every sphere repeatedly
+                and prints the selections per second and the number of
+                spheres of every level
+
+      Args:     const std::vector<BoundingSphere>& aBoundingSpheres
+                  Bounding spheres in world space, such as the
+                  instances of a crowd
+                UINT uNumIterations
+                  Number of times every sphere is selected
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void AnimationLodSelector::Benchmark(
+        _In_ const std::vector<BoundingSphere>& aBoundingSpheres,
+        _In_ UINT uNumIterations
+    ) const
+    {
+        UINT auNumSpheres[static_cast<size_t>(eAnimationLod::COUNT)] = { 0u, };
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        for (UINT i = 0u; i < uNumIterations; ++i)
+        {
+            for (const BoundingSphere& boundingSphere : aBoundingSpheres)
+            {
+                ++auNumSpheres[static_cast<size_t>(Select(boundingSphere).Level)];
+            }
+        }
+
+        QueryPerformanceCounter(&endTime);
+
+        const FLOAT seconds = static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) / static_cast<FLOAT>(frequency.QuadPart);
+        const FLOAT numSelections = static_cast<FLOAT>(aBoundingSpheres.size()) * static_cast<FLOAT>(uNumIterations);
+        const UINT uDivisor = uNumIterations > 0u ? uNumIterations : 1u;
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Animation LOD of %zu spheres: %.3g selections/s, full %u, half rate %u, quarter rate %u, no leaves %u, frozen %u\n",
+            aBoundingSpheres.size(),
+            numSelections / fmaxf(seconds, FLT_MIN),
+            auNumSpheres[static_cast<size_t>(eAnimationLod::FULL)] / uDivisor,
+            auNumSpheres[static_cast<size_t>(eAnimationLod::HALF_RATE)] / uDivisor,
+            auNumSpheres[static_cast<size_t>(eAnimationLod::QUARTER_RATE)] / uDivisor,
+            auNumSpheres[static_cast<size_t>(eAnimationLod::QUARTER_RATE_NO_LEAVES)] / uDivisor,
+            auNumSpheres[static_cast<size_t>(eAnimationLod::FROZEN)] / uDivisor
+        );
+        OutputDebugString(szMessage);
+    }
+}
@@ -0,0 +1,107 @@
+/*+===================================================================
+  File:      ANIMATIONLOD.H
+
+  Summary:   AnimationLod header file contains declarations of
+             AnimationLodSelector class that picks how often and how
+             much of the skeleton of a model is evaluated from its
+             size on screen.
+
+  Classes: AnimationLodSelector
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eAnimationLod
+
+        Summary:  Enumeration of the animation levels of detail, from
+                  the full skeleton every frame to a frozen pose
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eAnimationLod : UINT
+    {
+        FULL = 0,
+        HALF_RATE,
+        QUARTER_RATE,
+        QUARTER_RATE_NO_LEAVES,
+        FROZEN,
+        COUNT,
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   AnimationLod
+
+      Summary:  How a model evaluates its pose. The pose is evaluated
+                every uUpdateInterval frames and blended in between,
+                an interval of 0 keeps the last pose. Leaf bones that
+                are skipped keep their bind pose relative to their
+                parent instead of being sampled from the clip.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct AnimationLod
+    {
+        eAnimationLod Level;
+        UINT uUpdateInterval;
+        BOOL bSkipLeafBones;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    AnimationLodSelector
+
+      Summary:  Picks the animation level of detail of a bounding
+                sphere from the fraction of the screen height it
+                covers. Spheres outside of the view frustum are frozen.
+                The selection only reads the viewpoint and runs on the
+                CPU, so the models can select their level from the job
+                threads.
+
+      Methods:  SetViewpoint
+                  Sets the camera the levels are selected for
+                Select
+                  Returns the level of detail of a bounding sphere
+                Benchmark
+                  Prints the selection throughput and the number of
+                  spheres of every level
+                GetLod
+                  Returns the settings of a level of detail
+                AnimationLodSelector
+                  Constructor.
+                ~AnimationLodSelector
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class AnimationLodSelector
+    {
+    public:
+        static const AnimationLod& GetLod(_In_ eAnimationLod level);
+
+    public:
+        AnimationLodSelector();
+        AnimationLodSelector(const AnimationLodSelector& other) = delete;
+        AnimationLodSelector(AnimationLodSelector&& other) = delete;
+        AnimationLodSelector& operator=(const AnimationLodSelector& other) = delete;
+        AnimationLodSelector& operator=(AnimationLodSelector&& other) = delete;
+        virtual ~AnimationLodSelector() = default;
+
+        void SetViewpoint(_In_ const XMVECTOR& eye, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection);
+
+        const AnimationLod& Select(_In_ const BoundingSphere& boundingSphere) const;
+        void Benchmark(_In_ const std::vector<BoundingSphere>& aBoundingSpheres, _In_ UINT uNumIterations) const;
+
+    protected:
+        // Fraction of the screen height covered by the diameter of the bounding sphere
+        static constexpr const FLOAT HALF_RATE_SCREEN_SIZE = 0.4f;
+        static constexpr const FLOAT QUARTER_RATE_SCREEN_SIZE = 0.15f;
+        static constexpr const FLOAT NO_LEAVES_SCREEN_SIZE = 0.05f;
+
+        static const AnimationLod sm_aLods[static_cast<size_t>(eAnimationLod::COUNT)];
+
+    protected:
+        BoundingFrustum m_frustum;
+        XMFLOAT3 m_eye;
+        FLOAT m_projectionScale;
+        BOOL m_bHasViewpoint;
+    };
+}
@@ -0,0 +1,290 @@
+#include "Model/BakedAnimation.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::BakedAnimation
+
+      Summary:  Constructor
+
+      Args:     UINT uNumBones
+                  Number of bones of a palette
+                FLOAT frameRate
+                  Number of frames baked per second
+
+      Modifies: [m_paletteBuffer, m_paletteView, m_aPalettes, m_aClips,
+                 m_uNumBones, m_frameRate].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BakedAnimation::BakedAnimation(
+        _In_ UINT uNumBones,
+        _In_ FLOAT frameRate
+    )
+        : m_paletteBuffer(nullptr)
+        , m_paletteView(nullptr)
+        , m_aPalettes(std::vector<XMFLOAT4>())
+        , m_aClips(std::vector<BakedClip>())
+        , m_uNumBones(uNumBones)
+        , m_frameRate(frameRate)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::Initialize
+
+      Summary:  Creates the immutable buffer holding the palettes and
+                its shader resource view
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer
+
+      Modifies: [m_paletteBuffer, m_paletteView].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT BakedAnimation::Initialize(
+        _In_ ID3D11Device* pDevice
+    )
+    {
+        if (m_aPalettes.empty())
+        {
+            return E_FAIL;
+        }
+
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = static_cast<UINT>(sizeof(XMFLOAT4) * m_aPalettes.size()),
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = m_aPalettes.data(),
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+
+        HRESULT hr = pDevice->CreateBuffer(&bd, &initData, m_paletteBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc =
+        {
+            .Format = DXGI_FORMAT_R32G32B32A32_FLOAT,
+            .ViewDimension = D3D11_SRV_DIMENSION_BUFFER,
+            .Buffer =
+            {
+                .FirstElement = 0u,
+                .NumElements = static_cast<UINT>(m_aPalettes.size())
+            }
+        };
+
+        return pDevice->CreateShaderResourceView(m_paletteBuffer.Get(), &srvDesc, m_paletteView.GetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::AddClip
+
+      Summary:  Appends the frames of a new clip, initialized to the
+                identity
+
+      Args:     UINT uNumFrames
+                  Number of frames of the clip
+                UINT& uOutClipIndex
+                  Index of the new clip
+
+      Modifies: [m_aPalettes, m_aClips].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT BakedAnimation::AddClip(
+        _In_ UINT uNumFrames,
+        _Out_ UINT& uOutClipIndex
+    )
+    {
+        uOutClipIndex = static_cast<UINT>(m_aClips.size());
+
+        if (uNumFrames == 0u || m_aClips.size() >= MAX_NUM_BAKED_CLIPS)
+        {
+            return E_INVALIDARG;
+        }
+
+        const UINT uFirstFrame = m_aClips.empty() ? 0u : m_aClips.back().uFirstFrame + m_aClips.back().uNumFrames;
+        m_aClips.push_back(BakedClip{ .uFirstFrame = uFirstFrame, .uNumFrames = uNumFrames });
+
+        const XMFLOAT4 aIdentity[NUM_ROWS_PER_BONE] =
+        {
+            XMFLOAT4(1.0f, 0.0f, 0.0f, 0.0f),
+            XMFLOAT4(0.0f, 1.0f, 0.0f, 0.0f),
+            XMFLOAT4(0.0f, 0.0f, 1.0f, 0.0f)
+        };
+
+        const size_t uNumBones = static_cast<size_t>(uNumFrames) * m_uNumBones;
+        m_aPalettes.reserve(m_aPalettes.size() + uNumBones * NUM_ROWS_PER_BONE);
+        for (size_t i = 0u; i < uNumBones; ++i)
+        {
+            m_aPalettes.insert(m_aPalettes.end(), aIdentity, aIdentity + NUM_ROWS_PER_BONE);
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::SetPalette
+
+      Summary:  Stores the bone transforms of a frame
+
+      Args:     UINT uClipIndex
+                  Clip of the frame
+                UINT uFrame
+                  Frame in the clip
+                const XMFLOAT3X4A* aBoneTransforms
+                  Bone transforms, as uploaded for skinning
+
+      Modifies: [m_aPalettes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void BakedAnimation::SetPalette(
+        _In_ UINT uClipIndex,
+        _In_ UINT uFrame,
+        _In_ const XMFLOAT3X4A* aBoneTransforms
+    )
+    {
+        static_assert(sizeof(XMFLOAT3X4A) == NUM_ROWS_PER_BONE * sizeof(XMFLOAT4));
+        assert(uFrame < m_aClips[uClipIndex].uNumFrames);
+
+        XMFLOAT4* pRows = &m_aPalettes[(static_cast<size_t>(m_aClips[uClipIndex].uFirstFrame) + uFrame) * m_uNumBones * NUM_ROWS_PER_BONE];
+        memcpy(pRows, aBoneTransforms, sizeof(XMFLOAT3X4A) * m_uNumBones);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetBoneTransform
+
+      Summary:  Rebuilds a stored bone transform the way the vertex
+                shader does
+
+      Args:     UINT uClipIndex
+                  Clip of the frame
+                UINT uFrame
+                  Frame in the clip
+                UINT uBoneIndex
+                  Bone in the palette
+
+      Returns:  XMMATRIX
+                  Transposed bone transform
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    XMMATRIX BakedAnimation::GetBoneTransform(
+        _In_ UINT uClipIndex,
+        _In_ UINT uFrame,
+        _In_ UINT uBoneIndex
+    ) const
+    {
+        const size_t uOffset = ((static_cast<size_t>(m_aClips[uClipIndex].uFirstFrame) + uFrame) * m_uNumBones + uBoneIndex) * NUM_ROWS_PER_BONE;
+
+        return XMMATRIX(
+            XMLoadFloat4(&m_aPalettes[uOffset]),
+            XMLoadFloat4(&m_aPalettes[uOffset + 1u]),
+            XMLoadFloat4(&m_aPalettes[uOffset + 2u]),
+            g_XMIdentityR3
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetPaletteView
+
+      Summary:  Returns the view of the palette buffer
+
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  Palette buffer view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ComPtr<ID3D11ShaderResourceView>& BakedAnimation::GetPaletteView()
+    {
+        return m_paletteView;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetClip
+
+      Summary:  Returns the frames of a clip
+
+      Args:     UINT uClipIndex
+                  Index of the clip
+
+      Returns:  const BakedClip&
+                  First frame and number of frames
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const BakedClip& BakedAnimation::GetClip(
+        _In_ UINT uClipIndex
+    ) const
+    {
+        return m_aClips[uClipIndex];
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetNumClips
+
+      Summary:  Returns the number of clips
+
+      Returns:  UINT
+                  Number of clips
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT BakedAnimation::GetNumClips() const
+    {
+        return static_cast<UINT>(m_aClips.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetNumBones
+
+      Summary:  Returns the number of bones of a palette
+
+      Returns:  UINT
+                  Number of bones
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT BakedAnimation::GetNumBones() const
+    {
+        return m_uNumBones;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetFrameRate
+
+      Summary:  Returns the number of frames baked per second
+
+      Returns:  FLOAT
+                  Frame rate
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT BakedAnimation::GetFrameRate() const
+    {
+        return m_frameRate;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BakedAnimation::GetNumBytes
+
+      Summary:  Returns the size of the palettes
+
+      Returns:  size_t
+                  Size in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    size_t BakedAnimation::GetNumBytes() const
+    {
+        return m_aPalettes.size() * sizeof(XMFLOAT4);
+    }
+}
@@ -0,0 +1,102 @@
+/*+===================================================================
+  File:      BAKEDANIMATION.H
+
+  Summary:   BakedAnimation header file contains declarations of
+             BakedAnimation class that stores the bone palettes of
+             animation clips sampled at a fixed frame rate.
+
+  Classes: BakedAnimation
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   BakedClip
+
+      Summary:  Frames of a clip in the baked palettes
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct BakedClip
+    {
+        UINT uFirstFrame;
+        UINT uNumFrames;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    BakedAnimation
+
+      Summary:  Bone palettes of every frame of every clip, filled on
+                the CPU and uploaded once into a buffer the vertex
+                shader reads by (clip, frame, bone). A bone takes the
+                three first rows of its transposed transform, the last
+                row of an affine transform is implied.
+
+      Methods:  Initialize
+                  Creates the buffer and its view from the palettes
+                AddClip
+                  Reserves the frames of a new clip
+                SetPalette
+                  Stores the bone transforms of a frame of a clip
+                GetBoneTransform
+                  Returns a stored bone transform
+                GetPaletteView
+                  Returns the view of the palette buffer
+                GetClip
+                  Returns the frames of a clip
+                GetNumClips
+                  Returns the number of clips
+                GetNumBones
+                  Returns the number of bones of a palette
+                GetFrameRate
+                  Returns the number of frames per second
+                GetNumBytes
+                  Returns the size of the palettes
+                BakedAnimation
+                  Constructor.
+                ~BakedAnimation
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class BakedAnimation
+    {
+    public:
+        static constexpr const UINT NUM_ROWS_PER_BONE = 3u;
+
+    public:
+        BakedAnimation() = delete;
+        BakedAnimation(_In_ UINT uNumBones, _In_ FLOAT frameRate);
+        BakedAnimation(const BakedAnimation& other) = delete;
+        BakedAnimation(BakedAnimation&& other) = delete;
+        BakedAnimation& operator=(const BakedAnimation& other) = delete;
+        BakedAnimation& operator=(BakedAnimation&& other) = delete;
+        virtual ~BakedAnimation() = default;
+
+        HRESULT Initialize(_In_ ID3D11Device* pDevice);
+
+        HRESULT AddClip(_In_ UINT uNumFrames, _Out_ UINT& uOutClipIndex);
+        void SetPalette(_In_ UINT uClipIndex, _In_ UINT uFrame, _In_ const XMFLOAT3X4A* aBoneTransforms);
+        XMMATRIX GetBoneTransform(_In_ UINT uClipIndex, _In_ UINT uFrame, _In_ UINT uBoneIndex) const;
+
+        ComPtr<ID3D11ShaderResourceView>& GetPaletteView();
+        const BakedClip& GetClip(_In_ UINT uClipIndex) const;
+        UINT GetNumClips() const;
+        UINT GetNumBones() const;
+        FLOAT GetFrameRate() const;
+        size_t GetNumBytes() const;
+
+    protected:
+        ComPtr<ID3D11Buffer> m_paletteBuffer;
+        ComPtr<ID3D11ShaderResourceView> m_paletteView;
+
+        std::vector<XMFLOAT4> m_aPalettes;
+        std::vector<BakedClip> m_aClips;
+
+        UINT m_uNumBones;
+        FLOAT m_frameRate;
+    };
+}
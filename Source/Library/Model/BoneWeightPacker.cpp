@@ -0,0 +1,123 @@
+#include "Model/BoneWeightPacker.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   BoneWeightPacker::PackBoneData
+
+      Summary:  Keeps the heaviest influences of a vertex, renormalises
+                their weights and quantizes them to 8 bits so that they
+                still sum to exactly one
+
+      Args:     const VertexBoneData& boneData
+                  Every influence gathered for the vertex at import
+                FLOAT& outDroppedWeight
+                  Share of the total weight left out of the packed
+                  influences
+                FLOAT& outQuantizationError
+                  Largest difference between a renormalised weight and
+                  its quantized value
+
+      Returns:  AnimationData
+                  Packed bone indices and weights
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    AnimationData BoneWeightPacker::PackBoneData(
+        _In_ const VertexBoneData& boneData,
+        _Out_ FLOAT& outDroppedWeight,
+        _Out_ FLOAT& outQuantizationError
+    )
+    {
+        outDroppedWeight = 0.0f;
+        outQuantizationError = 0.0f;
+
+        UINT aOrder[MAX_NUM_BONES_PER_VERTEX];
+        FLOAT totalWeight = 0.0f;
+        for (UINT i = 0u; i < boneData.uNumBones; ++i)
+        {
+            aOrder[i] = i;
+            totalWeight += fmaxf(boneData.aWeights[i], 0.0f);
+        }
+
+        // Heaviest first, ties keep the import order
+        std::stable_sort(
+            aOrder,
+            aOrder + boneData.uNumBones,
+            [&boneData](UINT uLeft, UINT uRight) { return boneData.aWeights[uLeft] > boneData.aWeights[uRight]; }
+        );
+
+        const UINT uNumPacked = boneData.uNumBones < NUM_PACKED_INFLUENCES ? boneData.uNumBones : NUM_PACKED_INFLUENCES;
+
+        FLOAT packedWeight = 0.0f;
+        for (UINT k = 0u; k < uNumPacked; ++k)
+        {
+            packedWeight += fmaxf(boneData.aWeights[aOrder[k]], 0.0f);
+        }
+
+        AnimationData packed = {};
+        if (packedWeight <= 0.0f)
+        {
+            return packed;
+        }
+
+        outDroppedWeight = (totalWeight - packedWeight) / totalWeight;
+
+        UINT aBoneIndices[NUM_PACKED_INFLUENCES] = { 0u, };
+        FLOAT aWeights[NUM_PACKED_INFLUENCES] = { 0.0f, };
+        UINT aQuantizedWeights[NUM_PACKED_INFLUENCES] = { 0u, };
+        FLOAT aRemainders[NUM_PACKED_INFLUENCES] = { 0.0f, };
+
+        UINT uSum = 0u;
+        for (UINT k = 0u; k < uNumPacked; ++k)
+        {
+            aBoneIndices[k] = boneData.aBoneIds[aOrder[k]];
+            assert(aBoneIndices[k] < MAX_NUM_BONES);
+
+            aWeights[k] = fmaxf(boneData.aWeights[aOrder[k]], 0.0f) / packedWeight;
+
+            const FLOAT scaledWeight = aWeights[k] * 255.0f;
+            aQuantizedWeights[k] = static_cast<UINT>(floorf(scaledWeight));
+            aRemainders[k] = scaledWeight - static_cast<FLOAT>(aQuantizedWeights[k]);
+            uSum += aQuantizedWeights[k];
+        }
+
+        // Hand the missing steps to the weights that were rounded down the most
+        while (uSum < 255u)
+        {
+            UINT uLargest = 0u;
+            for (UINT k = 1u; k < uNumPacked; ++k)
+            {
+                if (aRemainders[k] > aRemainders[uLargest])
+                {
+                    uLargest = k;
+                }
+            }
+
+            ++aQuantizedWeights[uLargest];
+            aRemainders[uLargest] = -1.0f;
+            ++uSum;
+        }
+
+        for (UINT k = 0u; k < uNumPacked; ++k)
+        {
+            outQuantizationError = fmaxf(outQuantizationError, fabsf(static_cast<FLOAT>(aQuantizedWeights[k]) / 255.0f - aWeights[k]));
+        }
+
+        packed.aBoneIndices = PackedVector::XMUBYTE4(
+            static_cast<BYTE>(aBoneIndices[0]),
+            static_cast<BYTE>(aBoneIndices[1]),
+            static_cast<BYTE>(aBoneIndices[2]),
+            static_cast<BYTE>(aBoneIndices[3])
+        );
+        packed.aBoneWeights = PackedVector::XMUBYTEN4(
+            static_cast<BYTE>(aQuantizedWeights[0]),
+            static_cast<BYTE>(aQuantizedWeights[1]),
+            static_cast<BYTE>(aQuantizedWeights[2]),
+            static_cast<BYTE>(aQuantizedWeights[3])
+        );
+
+        return packed;
+    }
+}
@@ -0,0 +1,78 @@
+/*+===================================================================
+  File:      BONEWEIGHTPACKER.H
+
+  Summary:   BoneWeightPacker header file contains declarations of
+             VertexBoneData struct that gathers the bone influences of
+             a vertex and BoneWeightPacker class that packs them into
+             the vertex stream.
+
+  Classes: BoneWeightPacker
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VertexBoneData
+
+      Summary:  Every bone influence of a vertex, in the order the
+                importer hands them over
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VertexBoneData
+    {
+        VertexBoneData()
+            : aBoneIds{ 0u, }
+            , aWeights{ 0.0f, }
+            , uNumBones(0u)
+        {
+            ZeroMemory(aBoneIds, ARRAYSIZE(aBoneIds) * sizeof(aBoneIds[0]));
+            ZeroMemory(aWeights, ARRAYSIZE(aWeights) * sizeof(aWeights[0]));
+        }
+
+        void AddBoneData(_In_ UINT uBoneId, _In_ FLOAT weight)
+        {
+            assert(uNumBones < ARRAYSIZE(aBoneIds));
+
+            aBoneIds[uNumBones] = uBoneId;
+            aWeights[uNumBones] = weight;
+            ++uNumBones;
+        }
+
+        UINT aBoneIds[MAX_NUM_BONES_PER_VERTEX];
+        FLOAT aWeights[MAX_NUM_BONES_PER_VERTEX];
+        UINT uNumBones;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    BoneWeightPacker
+
+      Summary:  Packs the influences of a vertex into the four 8 bit
+                bone indices and the four 8 bit normalized weights the
+                skinning vertex shaders read
+
+      Methods:  PackBoneData
+                  Keeps the heaviest influences of a vertex and
+                  quantizes their weights to 8 bits
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class BoneWeightPacker
+    {
+    public:
+        static constexpr const UINT NUM_PACKED_INFLUENCES = 4u;
+
+        static AnimationData PackBoneData(_In_ const VertexBoneData& boneData, _Out_ FLOAT& outDroppedWeight, _Out_ FLOAT& outQuantizationError);
+
+    public:
+        BoneWeightPacker() = delete;
+        BoneWeightPacker(const BoneWeightPacker& other) = delete;
+        BoneWeightPacker(BoneWeightPacker&& other) = delete;
+        BoneWeightPacker& operator=(const BoneWeightPacker& other) = delete;
+        BoneWeightPacker& operator=(BoneWeightPacker&& other) = delete;
+        virtual ~BoneWeightPacker() = default;
+    };
+}
@@ -0,0 +1,555 @@
+#include "Model/CpuSkinning.h"
+
+#include <intrin.h>
+#include <immintrin.h>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::MeasureError
+
+      Summary:  Returns the largest difference of a component of two
+                skinning results of the same vertices
+
+      Args:     const SkinnedVertices& a
+                  First result
+                const SkinnedVertices& b
+                  Second result
+
+      Returns:  FLOAT
+                  Largest absolute difference
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT CpuSkinning::MeasureError(
+        _In_ const SkinnedVertices& a,
+        _In_ const SkinnedVertices& b
+    )
+    {
+        const std::vector<FLOAT>* aaStreamsA[] = { &a.aPositionsX, &a.aPositionsY, &a.aPositionsZ, &a.aNormalsX, &a.aNormalsY, &a.aNormalsZ };
+        const std::vector<FLOAT>* aaStreamsB[] = { &b.aPositionsX, &b.aPositionsY, &b.aPositionsZ, &b.aNormalsX, &b.aNormalsY, &b.aNormalsZ };
+
+        FLOAT maxError = 0.0f;
+        for (UINT uStream = 0u; uStream < ARRAYSIZE(aaStreamsA); ++uStream)
+        {
+            assert(aaStreamsA[uStream]->size() == aaStreamsB[uStream]->size());
+
+            for (size_t i = 0u; i < aaStreamsA[uStream]->size(); ++i)
+            {
+                maxError = fmaxf(maxError, fabsf((*aaStreamsA[uStream])[i] - (*aaStreamsB[uStream])[i]));
+            }
+        }
+
+        return maxError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::CpuSkinning
+
+      Summary:  Constructor, splits the bind pose and the bone
+                influences into streams
+
+      Args:     const std::vector<SimpleVertex>& aVertices
+                  Vertices in the bind pose
+                const std::vector<AnimationData>& aAnimationData
+                  Bone indices and weights of every vertex
+
+      Modifies: [m_aPositionsX, m_aPositionsY, m_aPositionsZ,
+                 m_aNormalsX, m_aNormalsY, m_aNormalsZ,
+                 m_aaBoneIndices, m_aaBoneWeights, m_uNumVertices,
+                 m_bHasAvx2].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    CpuSkinning::CpuSkinning(
+        _In_ const std::vector<SimpleVertex>& aVertices,
+        _In_ const std::vector<AnimationData>& aAnimationData
+    )
+        : m_aPositionsX(aVertices.size())
+        , m_aPositionsY(aVertices.size())
+        , m_aPositionsZ(aVertices.size())
+        , m_aNormalsX(aVertices.size())
+        , m_aNormalsY(aVertices.size())
+        , m_aNormalsZ(aVertices.size())
+        , m_aaBoneIndices()
+        , m_aaBoneWeights()
+        , m_uNumVertices(static_cast<UINT>(aVertices.size()))
+        , m_bHasAvx2(isAvx2Supported())
+    {
+        assert(aAnimationData.size() == aVertices.size());
+
+        for (UINT k = 0u; k < NUM_INFLUENCES; ++k)
+        {
+            m_aaBoneIndices[k].resize(m_uNumVertices);
+            m_aaBoneWeights[k].resize(m_uNumVertices);
+        }
+
+        for (UINT i = 0u; i < m_uNumVertices; ++i)
+        {
+            m_aPositionsX[i] = aVertices[i].Position.x;
+            m_aPositionsY[i] = aVertices[i].Position.y;
+            m_aPositionsZ[i] = aVertices[i].Position.z;
+            m_aNormalsX[i] = aVertices[i].Normal.x;
+            m_aNormalsY[i] = aVertices[i].Normal.y;
+            m_aNormalsZ[i] = aVertices[i].Normal.z;
+
+            const UINT aBoneIndices[NUM_INFLUENCES] =
+            {
+                aAnimationData[i].aBoneIndices.x,
+                aAnimationData[i].aBoneIndices.y,
+                aAnimationData[i].aBoneIndices.z,
+                aAnimationData[i].aBoneIndices.w
+            };
+            XMFLOAT4 boneWeights;
+            XMStoreFloat4(&boneWeights, PackedVector::XMLoadUByteN4(&aAnimationData[i].aBoneWeights));
+
+            const FLOAT aBoneWeights[NUM_INFLUENCES] = { boneWeights.x, boneWeights.y, boneWeights.z, boneWeights.w };
+
+            for (UINT k = 0u; k < NUM_INFLUENCES; ++k)
+            {
+                assert(aBoneIndices[k] < MAX_NUM_BONES);
+
+                m_aaBoneIndices[k][i] = aBoneIndices[k];
+                m_aaBoneWeights[k][i] = aBoneWeights[k];
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::Skin
+
+      Summary:  Skins every vertex with the widest SIMD kernel the CPU
+                supports, one range of vertices per job
+
+      Args:     const XMFLOAT3X4A* aBoneTransforms
+                  Bone transforms, as uploaded for skinning
+                SkinnedVertices& outVertices
+                  Skinned positions and normals
+                JobSystem* pJobSystem
+                  Job system spreading the ranges, or nullptr to skin
+                  on the calling thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void CpuSkinning::Skin(
+        _In_ const XMFLOAT3X4A* aBoneTransforms,
+        _Out_ SkinnedVertices& outVertices,
+        _In_opt_ JobSystem* pJobSystem
+    ) const
+    {
+        resize(outVertices);
+
+        const FLOAT* pPalette = reinterpret_cast<const FLOAT*>(aBoneTransforms);
+        const UINT uNumRanges = (m_uNumVertices + RANGE_SIZE - 1u) / RANGE_SIZE;
+
+        auto skinRange = [this, pPalette, &outVertices](UINT uRange)
+        {
+            const UINT uBegin = uRange * RANGE_SIZE;
+            const UINT uEnd = uBegin + RANGE_SIZE < m_uNumVertices ? uBegin + RANGE_SIZE : m_uNumVertices;
+
+            if (m_bHasAvx2)
+            {
+                skinRangeAvx2(pPalette, uBegin, uEnd, outVertices);
+            }
+            else
+            {
+                skinRangeSse(pPalette, uBegin, uEnd, outVertices);
+            }
+        };
+
+        if (pJobSystem)
+        {
+            pJobSystem->ParallelFor(uNumRanges, skinRange);
+        }
+        else
+        {
+            for (UINT uRange = 0u; uRange < uNumRanges; ++uRange)
+            {
+                skinRange(uRange);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::SkinReference
+
+      Summary:  Skins every vertex one at a time on the calling thread
+
+      Args:     const XMFLOAT3X4A* aBoneTransforms
+                  Bone transforms, as uploaded for skinning
+                SkinnedVertices& outVertices
+                  Skinned positions and normals
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void CpuSkinning::SkinReference(
+        _In_ const XMFLOAT3X4A* aBoneTransforms,
+        _Out_ SkinnedVertices& outVertices
+    ) const
+    {
+        resize(outVertices);
+        skinRangeReference(reinterpret_cast<const FLOAT*>(aBoneTransforms), 0u, m_uNumVertices, outVertices);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::Benchmark
+
+      Summary:  Skins the vertices repeatedly with the reference, the
+                SIMD kernel on the calling thread and the SIMD kernel
+                on the job system, and prints the vertices skinned per
+                second of each and the error of the SIMD kernel
+
+      Args:     const XMFLOAT3X4A* aBoneTransforms
+                  Bone transforms, as uploaded for skinning
+                UINT uNumIterations
+                  Number of times every variant skins the vertices
+                JobSystem* pJobSystem
+                  Job system of the parallel variant, or nullptr to
+                  skip it
+
+      Returns:  FLOAT
+                  Largest difference between the SIMD kernel and the
+                  reference
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT CpuSkinning::Benchmark(
+        _In_ const XMFLOAT3X4A* aBoneTransforms,
+        _In_ UINT uNumIterations,
+        _In_opt_ JobSystem* pJobSystem
+    ) const
+    {
+        SkinnedVertices reference;
+        SkinnedVertices simd;
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+
+        const UINT uNumVariants = pJobSystem ? 3u : 2u;
+        FLOAT aSeconds[3] = { 0.0f, };
+        for (UINT uVariant = 0u; uVariant < uNumVariants; ++uVariant)
+        {
+            QueryPerformanceCounter(&startTime);
+            for (UINT i = 0u; i < uNumIterations; ++i)
+            {
+                switch (uVariant)
+                {
+                case 0u:
+                    SkinReference(aBoneTransforms, reference);
+                    break;
+                case 1u:
+                    Skin(aBoneTransforms, simd, nullptr);
+                    break;
+                default:
+                    Skin(aBoneTransforms, simd, pJobSystem);
+                    break;
+                }
+            }
+            QueryPerformanceCounter(&endTime);
+
+            aSeconds[uVariant] = static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) / static_cast<FLOAT>(frequency.QuadPart);
+        }
+
+        const FLOAT maxError = MeasureError(reference, simd);
+        const FLOAT numVertices = static_cast<FLOAT>(m_uNumVertices) * static_cast<FLOAT>(uNumIterations);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"CPU skinning of %u vertices: reference %.3g vertices/s, %s %.3g vertices/s, %s on %u threads %.3g vertices/s, max error %g\n",
+            m_uNumVertices,
+            numVertices / fmaxf(aSeconds[0], FLT_MIN),
+            m_bHasAvx2 ? L"AVX2" : L"SSE",
+            numVertices / fmaxf(aSeconds[1], FLT_MIN),
+            m_bHasAvx2 ? L"AVX2" : L"SSE",
+            pJobSystem ? pJobSystem->GetNumThreads() : 1u,
+            pJobSystem ? numVertices / fmaxf(aSeconds[2], FLT_MIN) : 0.0f,
+            maxError
+        );
+        OutputDebugString(szMessage);
+
+        return maxError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::GetNumVertices
+
+      Summary:  Returns the number of vertices
+
+      Returns:  UINT
+                  Number of vertices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT CpuSkinning::GetNumVertices() const
+    {
+        return m_uNumVertices;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::HasAvx2
+
+      Summary:  Returns whether the AVX2 kernel is used
+
+      Returns:  BOOL
+                  TRUE if the CPU and the OS support AVX2
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL CpuSkinning::HasAvx2() const
+    {
+        return m_bHasAvx2;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::isAvx2Supported
+
+      Summary:  Checks that the CPU has AVX2 and FMA and that the OS
+                saves the YMM registers
+
+      Returns:  BOOL
+                  TRUE if the AVX2 kernel can run
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL CpuSkinning::isAvx2Supported()
+    {
+        INT aCpuInfo[4] = { 0, };
+
+        __cpuid(aCpuInfo, 0);
+        if (aCpuInfo[0] < 7)
+        {
+            return FALSE;
+        }
+
+        __cpuid(aCpuInfo, 1);
+        const BOOL bOsXSave = (aCpuInfo[2] & (1 << 27)) != 0;
+        const BOOL bFma = (aCpuInfo[2] & (1 << 12)) != 0;
+        if (!bOsXSave || !bFma || (_xgetbv(0) & 0x6) != 0x6)
+        {
+            return FALSE;
+        }
+
+        __cpuidex(aCpuInfo, 7, 0);
+        return (aCpuInfo[1] & (1 << 5)) != 0;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::resize
+
+      Summary:  Sizes the output streams to the number of vertices
+
+      Args:     SkinnedVertices& vertices
+                  Skinned positions and normals
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void CpuSkinning::resize(
+        _Inout_ SkinnedVertices& vertices
+    ) const
+    {
+        vertices.aPositionsX.resize(m_uNumVertices);
+        vertices.aPositionsY.resize(m_uNumVertices);
+        vertices.aPositionsZ.resize(m_uNumVertices);
+        vertices.aNormalsX.resize(m_uNumVertices);
+        vertices.aNormalsY.resize(m_uNumVertices);
+        vertices.aNormalsZ.resize(m_uNumVertices);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::skinRangeAvx2
+
+      Summary:  Skins eight vertices at a time. Every lane gathers the
+                rows of its own bones, the vertices left over are
+                skinned by the reference.
+
+      Args:     const FLOAT* pPalette
+                  Transposed bone transforms, 12 floats per bone
+                UINT uBegin
+                  First vertex of the range
+                UINT uEnd
+                  One past the last vertex of the range
+                SkinnedVertices& vertices
+                  Skinned positions and normals
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void CpuSkinning::skinRangeAvx2(
+        _In_ const FLOAT* pPalette,
+        _In_ UINT uBegin,
+        _In_ UINT uEnd,
+        _Inout_ SkinnedVertices& vertices
+    ) const
+    {
+        UINT i = uBegin;
+        for (; i + 8u <= uEnd; i += 8u)
+        {
+            const __m256 positionX = _mm256_loadu_ps(&m_aPositionsX[i]);
+            const __m256 positionY = _mm256_loadu_ps(&m_aPositionsY[i]);
+            const __m256 positionZ = _mm256_loadu_ps(&m_aPositionsZ[i]);
+            const __m256 normalX = _mm256_loadu_ps(&m_aNormalsX[i]);
+            const __m256 normalY = _mm256_loadu_ps(&m_aNormalsY[i]);
+            const __m256 normalZ = _mm256_loadu_ps(&m_aNormalsZ[i]);
+
+            __m256 aPositions[3] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+            __m256 aNormals[3] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+
+            for (UINT k = 0u; k < NUM_INFLUENCES; ++k)
+            {
+                const __m256i boneIndices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&m_aaBoneIndices[k][i]));
+                const __m256i boneOffsets = _mm256_mullo_epi32(boneIndices, _mm256_set1_epi32(static_cast<INT>(NUM_FLOATS_PER_BONE)));
+                const __m256 weight = _mm256_loadu_ps(&m_aaBoneWeights[k][i]);
+
+                for (UINT uRow = 0u; uRow < 3u; ++uRow)
+                {
+                    const __m256i rowOffsets = _mm256_add_epi32(boneOffsets, _mm256_set1_epi32(static_cast<INT>(uRow * 4u)));
+                    const __m256 m0 = _mm256_i32gather_ps(pPalette, rowOffsets, 4);
+                    const __m256 m1 = _mm256_i32gather_ps(pPalette + 1, rowOffsets, 4);
+                    const __m256 m2 = _mm256_i32gather_ps(pPalette + 2, rowOffsets, 4);
+                    const __m256 m3 = _mm256_i32gather_ps(pPalette + 3, rowOffsets, 4);
+
+                    const __m256 position = _mm256_fmadd_ps(m0, positionX, _mm256_fmadd_ps(m1, positionY, _mm256_fmadd_ps(m2, positionZ, m3)));
+                    const __m256 normal = _mm256_fmadd_ps(m0, normalX, _mm256_fmadd_ps(m1, normalY, _mm256_mul_ps(m2, normalZ)));
+
+                    aPositions[uRow] = _mm256_fmadd_ps(weight, position, aPositions[uRow]);
+                    aNormals[uRow] = _mm256_fmadd_ps(weight, normal, aNormals[uRow]);
+                }
+            }
+
+            const __m256 lengthSq = _mm256_fmadd_ps(aNormals[0], aNormals[0], _mm256_fmadd_ps(aNormals[1], aNormals[1], _mm256_mul_ps(aNormals[2], aNormals[2])));
+            const __m256 length = _mm256_max_ps(_mm256_sqrt_ps(lengthSq), _mm256_set1_ps(FLT_MIN));
+
+            _mm256_storeu_ps(&vertices.aPositionsX[i], aPositions[0]);
+            _mm256_storeu_ps(&vertices.aPositionsY[i], aPositions[1]);
+            _mm256_storeu_ps(&vertices.aPositionsZ[i], aPositions[2]);
+            _mm256_storeu_ps(&vertices.aNormalsX[i], _mm256_div_ps(aNormals[0], length));
+            _mm256_storeu_ps(&vertices.aNormalsY[i], _mm256_div_ps(aNormals[1], length));
+            _mm256_storeu_ps(&vertices.aNormalsZ[i], _mm256_div_ps(aNormals[2], length));
+        }
+
+        skinRangeReference(pPalette, i, uEnd, vertices);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::skinRangeReference
+
+      Summary:  Skins the vertices one at a time
+
+      Args:     const FLOAT* pPalette
+                  Transposed bone transforms, 12 floats per bone
+                UINT uBegin
+                  First vertex of the range
+                UINT uEnd
+                  One past the last vertex of the range
+                SkinnedVertices& vertices
+                  Skinned positions and normals
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void CpuSkinning::skinRangeReference(
+        _In_ const FLOAT* pPalette,
+        _In_ UINT uBegin,
+        _In_ UINT uEnd,
+        _Inout_ SkinnedVertices& vertices
+    ) const
+    {
+        for (UINT i = uBegin; i < uEnd; ++i)
+        {
+            FLOAT aPosition[3] = { 0.0f, };
+            FLOAT aNormal[3] = { 0.0f, };
+
+            for (UINT k = 0u; k < NUM_INFLUENCES; ++k)
+            {
+                const FLOAT* pBone = pPalette + m_aaBoneIndices[k][i] * NUM_FLOATS_PER_BONE;
+                const FLOAT weight = m_aaBoneWeights[k][i];
+
+                for (UINT uRow = 0u; uRow < 3u; ++uRow)
+                {
+                    const FLOAT* pRow = pBone + uRow * 4u;
+                    aPosition[uRow] += weight * (pRow[0] * m_aPositionsX[i] + pRow[1] * m_aPositionsY[i] + pRow[2] * m_aPositionsZ[i] + pRow[3]);
+                    aNormal[uRow] += weight * (pRow[0] * m_aNormalsX[i] + pRow[1] * m_aNormalsY[i] + pRow[2] * m_aNormalsZ[i]);
+                }
+            }
+
+            const FLOAT length = fmaxf(sqrtf(aNormal[0] * aNormal[0] + aNormal[1] * aNormal[1] + aNormal[2] * aNormal[2]), FLT_MIN);
+
+            vertices.aPositionsX[i] = aPosition[0];
+            vertices.aPositionsY[i] = aPosition[1];
+            vertices.aPositionsZ[i] = aPosition[2];
+            vertices.aNormalsX[i] = aNormal[0] / length;
+            vertices.aNormalsY[i] = aNormal[1] / length;
+            vertices.aNormalsZ[i] = aNormal[2] / length;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   CpuSkinning::skinRangeSse
+
+      Summary:  Skins four vertices at a time. SSE has no gather, the
+                rows of the bones of the four lanes are loaded one by
+                one, the vertices left over are skinned by the
+                reference.
+
+      Args:     const FLOAT* pPalette
+                  Transposed bone transforms, 12 floats per bone
+                UINT uBegin
+                  First vertex of the range
+                UINT uEnd
+                  One past the last vertex of the range
+                SkinnedVertices& vertices
+                  Skinned positions and normals
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void CpuSkinning::skinRangeSse(
+        _In_ const FLOAT* pPalette,
+        _In_ UINT uBegin,
+        _In_ UINT uEnd,
+        _Inout_ SkinnedVertices& vertices
+    ) const
+    {
+        UINT i = uBegin;
+        for (; i + 4u <= uEnd; i += 4u)
+        {
+            const __m128 positionX = _mm_loadu_ps(&m_aPositionsX[i]);
+            const __m128 positionY = _mm_loadu_ps(&m_aPositionsY[i]);
+            const __m128 positionZ = _mm_loadu_ps(&m_aPositionsZ[i]);
+            const __m128 normalX = _mm_loadu_ps(&m_aNormalsX[i]);
+            const __m128 normalY = _mm_loadu_ps(&m_aNormalsY[i]);
+            const __m128 normalZ = _mm_loadu_ps(&m_aNormalsZ[i]);
+
+            __m128 aPositions[3] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+            __m128 aNormals[3] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+
+            for (UINT k = 0u; k < NUM_INFLUENCES; ++k)
+            {
+                const FLOAT* apBones[4] =
+                {
+                    pPalette + m_aaBoneIndices[k][i] * NUM_FLOATS_PER_BONE,
+                    pPalette + m_aaBoneIndices[k][i + 1u] * NUM_FLOATS_PER_BONE,
+                    pPalette + m_aaBoneIndices[k][i + 2u] * NUM_FLOATS_PER_BONE,
+                    pPalette + m_aaBoneIndices[k][i + 3u] * NUM_FLOATS_PER_BONE
+                };
+                const __m128 weight = _mm_loadu_ps(&m_aaBoneWeights[k][i]);
+
+                for (UINT uRow = 0u; uRow < 3u; ++uRow)
+                {
+                    // Transposing the rows of the four lanes gives one register per column
+                    __m128 m0 = _mm_loadu_ps(apBones[0] + uRow * 4u);
+                    __m128 m1 = _mm_loadu_ps(apBones[1] + uRow * 4u);
+                    __m128 m2 = _mm_loadu_ps(apBones[2] + uRow * 4u);
+                    __m128 m3 = _mm_loadu_ps(apBones[3] + uRow * 4u);
+                    _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+
+                    const __m128 position = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, positionX), _mm_mul_ps(m1, positionY)), _mm_add_ps(_mm_mul_ps(m2, positionZ), m3));
+                    const __m128 normal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, normalX), _mm_mul_ps(m1, normalY)), _mm_mul_ps(m2, normalZ));
+
+                    aPositions[uRow] = _mm_add_ps(aPositions[uRow], _mm_mul_ps(weight, position));
+                    aNormals[uRow] = _mm_add_ps(aNormals[uRow], _mm_mul_ps(weight, normal));
+                }
+            }
+
+            const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(aNormals[0], aNormals[0]), _mm_mul_ps(aNormals[1], aNormals[1])), _mm_mul_ps(aNormals[2], aNormals[2]));
+            const __m128 length = _mm_max_ps(_mm_sqrt_ps(lengthSq), _mm_set1_ps(FLT_MIN));
+
+            _mm_storeu_ps(&vertices.aPositionsX[i], aPositions[0]);
+            _mm_storeu_ps(&vertices.aPositionsY[i], aPositions[1]);
+            _mm_storeu_ps(&vertices.aPositionsZ[i], aPositions[2]);
+            _mm_storeu_ps(&vertices.aNormalsX[i], _mm_div_ps(aNormals[0], length));
+            _mm_storeu_ps(&vertices.aNormalsY[i], _mm_div_ps(aNormals[1], length));
+            _mm_storeu_ps(&vertices.aNormalsZ[i], _mm_div_ps(aNormals[2], length));
+        }
+
+        skinRangeReference(pPalette, i, uEnd, vertices);
+    }
+}
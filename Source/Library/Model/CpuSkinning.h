@@ -0,0 +1,113 @@
+/*+===================================================================
+  File:      CPUSKINNING.H
+
+  Summary:   CpuSkinning header file contains declarations of
+             CpuSkinning class that skins the vertices of a model on
+             the CPU with the same bones and weights as the skinning
+             vertex shader.
+
+  Classes: CpuSkinning
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Scene/JobSystem.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SkinnedVertices
+
+      Summary:  Skinned positions and normals, one stream per component
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SkinnedVertices
+    {
+        std::vector<FLOAT> aPositionsX;
+        std::vector<FLOAT> aPositionsY;
+        std::vector<FLOAT> aPositionsZ;
+        std::vector<FLOAT> aNormalsX;
+        std::vector<FLOAT> aNormalsY;
+        std::vector<FLOAT> aNormalsZ;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    CpuSkinning
+
+      Summary:  Copy of the bind pose and the bone influences of a model
+                split into one stream per component, so that a SIMD
+                register holds the same component of consecutive
+                vertices. Vertices are skinned eight at a time with
+                AVX2 when the CPU has it, four at a time with SSE
+                otherwise, and the ranges of vertices are spread over
+                the job system. The scalar reference skins one vertex
+                at a time and is the ground truth of the SIMD kernels.
+
+      Methods:  Skin
+                  Skins every vertex with the SIMD kernel
+                SkinReference
+                  Skins every vertex one at a time
+                Benchmark
+                  Prints the throughput and the error of the kernels
+                MeasureError
+                  Returns the largest difference of two results
+                GetNumVertices
+                  Returns the number of vertices
+                HasAvx2
+                  Returns whether the AVX2 kernel is used
+                CpuSkinning
+                  Constructor.
+                ~CpuSkinning
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class CpuSkinning
+    {
+    public:
+        static FLOAT MeasureError(_In_ const SkinnedVertices& a, _In_ const SkinnedVertices& b);
+
+    public:
+        CpuSkinning() = delete;
+        CpuSkinning(_In_ const std::vector<SimpleVertex>& aVertices, _In_ const std::vector<AnimationData>& aAnimationData);
+        CpuSkinning(const CpuSkinning& other) = delete;
+        CpuSkinning(CpuSkinning&& other) = delete;
+        CpuSkinning& operator=(const CpuSkinning& other) = delete;
+        CpuSkinning& operator=(CpuSkinning&& other) = delete;
+        virtual ~CpuSkinning() = default;
+
+        void Skin(_In_ const XMFLOAT3X4A* aBoneTransforms, _Out_ SkinnedVertices& outVertices, _In_opt_ JobSystem* pJobSystem) const;
+        void SkinReference(_In_ const XMFLOAT3X4A* aBoneTransforms, _Out_ SkinnedVertices& outVertices) const;
+        FLOAT Benchmark(_In_ const XMFLOAT3X4A* aBoneTransforms, _In_ UINT uNumIterations, _In_opt_ JobSystem* pJobSystem) const;
+
+        UINT GetNumVertices() const;
+        BOOL HasAvx2() const;
+
+    protected:
+        static BOOL isAvx2Supported();
+
+        void resize(_Inout_ SkinnedVertices& vertices) const;
+        void skinRangeAvx2(_In_ const FLOAT* pPalette, _In_ UINT uBegin, _In_ UINT uEnd, _Inout_ SkinnedVertices& vertices) const;
+        void skinRangeReference(_In_ const FLOAT* pPalette, _In_ UINT uBegin, _In_ UINT uEnd, _Inout_ SkinnedVertices& vertices) const;
+        void skinRangeSse(_In_ const FLOAT* pPalette, _In_ UINT uBegin, _In_ UINT uEnd, _Inout_ SkinnedVertices& vertices) const;
+
+    protected:
+        static constexpr const UINT NUM_INFLUENCES = 4u;
+        static constexpr const UINT NUM_FLOATS_PER_BONE = 12u;
+        static constexpr const UINT RANGE_SIZE = 1024u;
+
+    protected:
+        std::vector<FLOAT> m_aPositionsX;
+        std::vector<FLOAT> m_aPositionsY;
+        std::vector<FLOAT> m_aPositionsZ;
+        std::vector<FLOAT> m_aNormalsX;
+        std::vector<FLOAT> m_aNormalsY;
+        std::vector<FLOAT> m_aNormalsZ;
+        std::vector<UINT> m_aaBoneIndices[NUM_INFLUENCES];
+        std::vector<FLOAT> m_aaBoneWeights[NUM_INFLUENCES];
+
+        UINT m_uNumVertices;
+        BOOL m_bHasAvx2;
+    };
+}
@@ -0,0 +1,290 @@
+#include "Model/Crowd.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::Crowd
+
+      Summary:  Constructor
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the model to load
+                std::vector<CrowdInstanceData>&& aInstanceData
+                  Transform, time offset and clip of every instance
+
+      Modifies: [m_instanceBuffer, m_bakedAnimationConstantBuffer,
+                 m_aInstanceData, m_aInstanceBoundingSpheres,
+                 m_bakedAnimation].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    Crowd::Crowd(
+        _In_ const std::filesystem::path& filePath,
+        _In_ std::vector<CrowdInstanceData>&& aInstanceData
+    )
+        : Model(filePath)
+        , m_instanceBuffer(nullptr)
+        , m_bakedAnimationConstantBuffer(nullptr)
+        , m_aInstanceData(std::move(aInstanceData))
+        , m_aInstanceBoundingSpheres()
+        , m_bakedAnimation()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::Initialize
+
+      Summary:  Loads or shares the model, bakes its animation unless
+                another crowd of the same file already did, and creates
+                the instance and baked animation buffers
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Modifies: [m_bakedAnimation, m_bakedAnimationConstantBuffer].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Crowd::Initialize(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext
+    )
+    {
+        HRESULT hr = Model::Initialize(pDevice, pImmediateContext);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = bakeAnimation(pDevice, BAKE_FRAME_RATE);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        const BakedAnimation& bakedAnimation = *m_asset->pBakedAnimation;
+        for (const CrowdInstanceData& instanceData : m_aInstanceData)
+        {
+            if (instanceData.uClipIndex >= bakedAnimation.GetNumClips())
+            {
+                return E_INVALIDARG;
+            }
+        }
+
+        hr = initializeInstance(pDevice);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_bakedAnimation = CBBakedAnimation
+        {
+            .AnimationTime = m_timeSinceLoaded,
+            .FrameRate = bakedAnimation.GetFrameRate(),
+            .NumBones = bakedAnimation.GetNumBones(),
+            .Padding = 0u
+        };
+        for (UINT i = 0u; i < bakedAnimation.GetNumClips(); ++i)
+        {
+            m_bakedAnimation.Clips[i] = XMUINT4(bakedAnimation.GetClip(i).uFirstFrame, bakedAnimation.GetClip(i).uNumFrames, 0u, 0u);
+        }
+
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = sizeof(CBBakedAnimation),
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = &m_bakedAnimation,
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+
+        return pDevice->CreateBuffer(&bd, &initData, m_bakedAnimationConstantBuffer.GetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::Update
+
+      Summary:  Advances the animation time. The poses are read from
+                the baked palettes on the GPU, so no bone is evaluated
+                on the CPU.
+
+      Args:     FLOAT deltaTime
+                  Time difference of a frame
+
+      Modifies: [m_timeSinceLoaded, m_bakedAnimation,
+                 m_uBoneTransformsVersion].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Crowd::Update(
+        _In_ FLOAT deltaTime
+    )
+    {
+        m_timeSinceLoaded += deltaTime;
+        m_bakedAnimation.AnimationTime = m_timeSinceLoaded;
+        ++m_uBoneTransformsVersion;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::GetInstanceBuffer
+
+      Summary:  Returns the instance buffer
+
+      Returns:  ComPtr<ID3D11Buffer>&
+                  Instance buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ComPtr<ID3D11Buffer>& Crowd::GetInstanceBuffer()
+    {
+        return m_instanceBuffer;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::GetBakedAnimationConstantBuffer
+
+      Summary:  Returns the constant buffer of the baked animation
+
+      Returns:  ComPtr<ID3D11Buffer>&
+                  Baked animation constant buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ComPtr<ID3D11Buffer>& Crowd::GetBakedAnimationConstantBuffer()
+    {
+        return m_bakedAnimationConstantBuffer;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::GetBakedAnimation
+
+      Summary:  Returns the constants of the baked animation, changed
+                when the bone transforms version changes
+
+      Returns:  const CBBakedAnimation&
+                  Baked animation constants
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const CBBakedAnimation& Crowd::GetBakedAnimation() const
+    {
+        return m_bakedAnimation;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::GetPaletteView
+
+      Summary:  Returns the view of the baked palettes
+
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  Palette buffer view
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ComPtr<ID3D11ShaderResourceView>& Crowd::GetPaletteView()
+    {
+        return m_asset->pBakedAnimation->GetPaletteView();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::GetNumInstances
+
+      Summary:  Returns the number of instances
+
+      Returns:  UINT
+                  Number of instances
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT Crowd::GetNumInstances() const
+    {
+        return static_cast<UINT>(m_aInstanceData.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::GetInstanceBoundingSpheres
+
+      Summary:  Returns the bounding sphere of every instance
+
+      Returns:  const std::vector<BoundingSphere>&
+                  Bounding spheres in world space
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const std::vector<BoundingSphere>& Crowd::GetInstanceBoundingSpheres() const
+    {
+        return m_aInstanceBoundingSpheres;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Crowd::initializeInstance
+
+      Summary:  Creates the instance buffer, keeps the bounding sphere
+                of every instance and grows the bounding sphere to
+                enclose them all
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer
+
+      Modifies: [m_instanceBuffer, m_aInstanceBoundingSpheres,
+                 m_boundingSphere].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Crowd::initializeInstance(
+        _In_ ID3D11Device* pDevice
+    )
+    {
+        if (m_aInstanceData.empty())
+        {
+            return E_FAIL;
+        }
+
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = static_cast<UINT>(sizeof(CrowdInstanceData) * m_aInstanceData.size()),
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = m_aInstanceData.data(),
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+
+        HRESULT hr = pDevice->CreateBuffer(&bd, &initData, m_instanceBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        XMVECTOR boundsMin = g_XMFltMax;
+        XMVECTOR boundsMax = XMVectorNegate(g_XMFltMax);
+        XMVECTOR radius = XMVectorReplicate(m_boundingSphere.Radius);
+        m_aInstanceBoundingSpheres.resize(m_aInstanceData.size());
+        for (size_t i = 0u; i < m_aInstanceData.size(); ++i)
+        {
+            const CrowdInstanceData& instanceData = m_aInstanceData[i];
+            m_boundingSphere.Transform(m_aInstanceBoundingSpheres[i], instanceData.Transformation);
+
+            XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&m_boundingSphere.Center), instanceData.Transformation);
+            boundsMin = XMVectorMin(boundsMin, XMVectorSubtract(center, radius));
+            boundsMax = XMVectorMax(boundsMax, XMVectorAdd(center, radius));
+        }
+
+        BoundingBox boundingBox;
+        BoundingBox::CreateFromPoints(boundingBox, boundsMin, boundsMax);
+        BoundingSphere::CreateFromBoundingBox(m_boundingSphere, boundingBox);
+
+        return hr;
+    }
+}
@@ -0,0 +1,86 @@
+/*+===================================================================
+  File:      CROWD.H
+
+  Summary:   Crowd header file contains declarations of Crowd class
+             that draws many instances of an animated model from its
+             baked bone palettes.
+
+  Classes: Crowd
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Model/Model.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    Crowd
+
+      Summary:  Instances of an animated model drawn in a single
+                instanced draw per mesh. The animation is baked once
+                per model file, every instance plays a clip with its
+                own time offset and the only data uploaded each frame
+                is the animation time.
+
+      Methods:  Initialize
+                  Loads the model, bakes its animation and creates the
+                  instance buffer
+                Update
+                  Advances the animation time
+                GetInstanceBuffer
+                  Returns the instance buffer
+                GetBakedAnimationConstantBuffer
+                  Returns the constant buffer of the baked animation
+                GetBakedAnimation
+                  Returns the constants of the baked animation
+                GetPaletteView
+                  Returns the view of the baked palettes
+                GetNumInstances
+                  Returns the number of instances
+                GetInstanceBoundingSpheres
+                  Returns the bounding sphere of every instance
+                Crowd
+                  Constructor.
+                ~Crowd
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class Crowd : public Model
+    {
+    public:
+        Crowd() = delete;
+        Crowd(_In_ const std::filesystem::path& filePath, _In_ std::vector<CrowdInstanceData>&& aInstanceData);
+        Crowd(const Crowd& other) = delete;
+        Crowd(Crowd&& other) = delete;
+        Crowd& operator=(const Crowd& other) = delete;
+        Crowd& operator=(Crowd&& other) = delete;
+        virtual ~Crowd() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext) override;
+        virtual void Update(_In_ FLOAT deltaTime) override;
+
+        ComPtr<ID3D11Buffer>& GetInstanceBuffer();
+        ComPtr<ID3D11Buffer>& GetBakedAnimationConstantBuffer();
+        const CBBakedAnimation& GetBakedAnimation() const;
+        ComPtr<ID3D11ShaderResourceView>& GetPaletteView();
+        UINT GetNumInstances() const;
+        const std::vector<BoundingSphere>& GetInstanceBoundingSpheres() const;
+
+    protected:
+        HRESULT initializeInstance(_In_ ID3D11Device* pDevice);
+
+    protected:
+        static constexpr const FLOAT BAKE_FRAME_RATE = 30.0f;
+
+    protected:
+        ComPtr<ID3D11Buffer> m_instanceBuffer;
+        ComPtr<ID3D11Buffer> m_bakedAnimationConstantBuffer;
+
+        std::vector<CrowdInstanceData> m_aInstanceData;
+        std::vector<BoundingSphere> m_aInstanceBoundingSpheres;
+        CBBakedAnimation m_bakedAnimation;
+    };
+}
@@ -0,0 +1,114 @@
+#include "Model/MeshLod.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshLodSelector::MeshLodSelector
+
+      Summary:  Constructor, every sphere gets the imported meshes
+                until a viewpoint is set
+
+      Modifies: [m_frustum, m_eye, m_projectionScale, m_bHasViewpoint].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    MeshLodSelector::MeshLodSelector()
+        : m_frustum()
+        , m_eye(0.0f, 0.0f, 0.0f)
+        , m_projectionScale(1.0f)
+        , m_bHasViewpoint(FALSE)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshLodSelector::SetViewpoint
+
+      Summary:  Sets the camera the levels are selected for and builds
+                its frustum in world space
+
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                const XMMATRIX& view
+                  View matrix of the camera
+                const XMMATRIX& projection
+                  Perspective projection matrix of the camera
+
+      Modifies: [m_frustum, m_eye, m_projectionScale, m_bHasViewpoint].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshLodSelector::SetViewpoint(
+        _In_ const XMVECTOR& eye,
+        _In_ const XMMATRIX& view,
+        _In_ const XMMATRIX& projection
+    )
+    {
+        BoundingFrustum viewFrustum(projection);
+        viewFrustum.Transform(m_frustum, XMMatrixInverse(nullptr, view));
+
+        XMStoreFloat3(&m_eye, eye);
+        m_projectionScale = XMVectorGetY(projection.r[1]);
+        m_bHasViewpoint = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshLodSelector::Select
+
+      Summary:  Returns the level of detail of a bounding sphere from
+                the fraction of the screen height it covers. The level
+                only becomes coarser once the size is HYSTERESIS below
+                the threshold of the current level, and finer once it
+                is HYSTERESIS above the threshold of the finer level.
+
+      Args:     const BoundingSphere& boundingSphere
+                  Bounding sphere in world space
+                UINT uCurrentLod
+                  Level of detail drawn in the last frame
+
+      Returns:  UINT
+                  Level of detail of the sphere, 0 for the imported
+                  meshes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT MeshLodSelector::Select(
+        _In_ const BoundingSphere& boundingSphere,
+        _In_ UINT uCurrentLod
+    ) const
+    {
+        assert(uCurrentLod < NUM_LODS);
+
+        if (!m_bHasViewpoint)
+        {
+            return 0u;
+        }
+
+        // Nothing is drawn, switching now would only cause a pop when it comes back
+        if (m_frustum.Contains(boundingSphere) == DISJOINT)
+        {
+            return uCurrentLod;
+        }
+
+        const FLOAT distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&boundingSphere.Center), XMLoadFloat3(&m_eye))));
+        if (distance <= boundingSphere.Radius)
+        {
+            return 0u;
+        }
+
+        const FLOAT screenSize = boundingSphere.Radius * m_projectionScale / distance;
+
+        UINT uLod = 0u;
+        while (uLod < NUM_LODS - 1u && screenSize < LOD_SCREEN_SIZES[uLod])
+        {
+            ++uLod;
+        }
+
+        if (uLod > uCurrentLod && screenSize >= LOD_SCREEN_SIZES[uCurrentLod] * (1.0f - HYSTERESIS))
+        {
+            return uCurrentLod;
+        }
+        if (uLod < uCurrentLod && screenSize < LOD_SCREEN_SIZES[uCurrentLod - 1u] * (1.0f + HYSTERESIS))
+        {
+            return uCurrentLod;
+        }
+
+        return uLod;
+    }
+}
@@ -0,0 +1,67 @@
+/*+===================================================================
+  File:      MESHLOD.H
+
+  Summary:   MeshLod header file contains declarations of
+             MeshLodSelector class that picks which simplified level
+             of the meshes of a model is drawn from its size on screen.
+
+  Classes: MeshLodSelector
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MeshLodSelector
+
+      Summary:  Picks the mesh level of detail of a bounding sphere
+                from the fraction of the screen height it covers. Level
+                0 is the imported mesh, every next level has about half
+                of the triangles. A model only moves to another level
+                once its size is past the threshold by a margin, so it
+                does not switch back and forth at the threshold. Spheres
+                outside of the view frustum keep their level.
+
+      Methods:  SetViewpoint
+                  Sets the camera the levels are selected for
+                Select
+                  Returns the level of detail of a bounding sphere
+                MeshLodSelector
+                  Constructor.
+                ~MeshLodSelector
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MeshLodSelector
+    {
+    public:
+        static constexpr const UINT NUM_LODS = 4u;
+
+    public:
+        MeshLodSelector();
+        MeshLodSelector(const MeshLodSelector& other) = delete;
+        MeshLodSelector(MeshLodSelector&& other) = delete;
+        MeshLodSelector& operator=(const MeshLodSelector& other) = delete;
+        MeshLodSelector& operator=(MeshLodSelector&& other) = delete;
+        virtual ~MeshLodSelector() = default;
+
+        void SetViewpoint(_In_ const XMVECTOR& eye, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection);
+
+        UINT Select(_In_ const BoundingSphere& boundingSphere, _In_ UINT uCurrentLod) const;
+
+    protected:
+        // Fraction of the screen height covered by the diameter of the bounding sphere below which each next level is drawn
+        static constexpr const FLOAT LOD_SCREEN_SIZES[NUM_LODS - 1u] = { 0.3f, 0.15f, 0.075f };
+        // Relative margin past a threshold before the level changes
+        static constexpr const FLOAT HYSTERESIS = 0.2f;
+
+    protected:
+        BoundingFrustum m_frustum;
+        XMFLOAT3 m_eye;
+        FLOAT m_projectionScale;
+        BOOL m_bHasViewpoint;
+    };
+}
@@ -0,0 +1,407 @@
+#include "Model/MeshOptimizer.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshOptimizer::AnalyzeVertexCache
+
+      Summary:  Counts the misses of a FIFO cache of CACHE_SIZE entries
+                over the indices
+
+      Args:     const std::vector<UINT>& aIndices
+                  Indices of a triangle list
+                UINT uNumVertices
+                  Number of vertices the indices refer to
+
+      Returns:  VertexCacheStats
+                  Number of misses, triangles and used vertices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(
+        _In_ const std::vector<UINT>& aIndices,
+        _In_ UINT uNumVertices
+    )
+    {
+        VertexCacheStats stats =
+        {
+            .uNumMisses = 0u,
+            .uNumTriangles = static_cast<UINT>(aIndices.size() / 3u),
+            .uNumVertices = 0u
+        };
+
+        // Miss count at which each vertex entered the cache plus one, 0 when it never did
+        std::vector<UINT> aEntries(uNumVertices, 0u);
+        for (UINT uIndex : aIndices)
+        {
+            if (aEntries[uIndex] == 0u)
+            {
+                ++stats.uNumVertices;
+            }
+            else if (stats.uNumMisses + 1u - aEntries[uIndex] <= CACHE_SIZE)
+            {
+                continue;
+            }
+
+            ++stats.uNumMisses;
+            aEntries[uIndex] = stats.uNumMisses;
+        }
+
+        return stats;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshOptimizer::MeshOptimizer
+
+      Summary:  Constructor
+
+      Modifies: [m_aTriangleOffsets, m_aAdjacentTriangles,
+                 m_aNumLiveTriangles, m_aCacheTimestamps, m_aDeadEnds,
+                 m_aCandidates, m_aEmitted, m_aClusterStarts,
+                 m_aScratchIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    MeshOptimizer::MeshOptimizer()
+        : m_aTriangleOffsets()
+        , m_aAdjacentTriangles()
+        , m_aNumLiveTriangles()
+        , m_aCacheTimestamps()
+        , m_aDeadEnds()
+        , m_aCandidates()
+        , m_aEmitted()
+        , m_aClusterStarts()
+        , m_aScratchIndices()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshOptimizer::OptimizeVertexCache
+
+      Summary:  Reorders the triangles with Tipsify. The triangles
+                around a fanning vertex are emitted together, then the
+                next fanning vertex is the one among the vertices just
+                emitted that is the oldest still in the cache once its
+                remaining triangles are emitted. A cluster starts
+                wherever the next fanning vertex is out of the cache.
+
+      Args:     std::vector<UINT>& aIndices
+                  Indices of a triangle list, reordered in place
+                UINT uNumVertices
+                  Number of vertices the indices refer to
+
+      Modifies: [m_aTriangleOffsets, m_aAdjacentTriangles,
+                 m_aNumLiveTriangles, m_aCacheTimestamps, m_aDeadEnds,
+                 m_aCandidates, m_aEmitted, m_aClusterStarts,
+                 m_aScratchIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshOptimizer::OptimizeVertexCache(
+        _Inout_ std::vector<UINT>& aIndices,
+        _In_ UINT uNumVertices
+    )
+    {
+        const UINT uNumTriangles = static_cast<UINT>(aIndices.size() / 3u);
+
+        m_aClusterStarts.clear();
+        if (uNumTriangles == 0u || uNumVertices == 0u)
+        {
+            return;
+        }
+
+        // Triangles of every vertex, stored contiguously
+        m_aNumLiveTriangles.assign(uNumVertices, 0u);
+        for (UINT uIndex : aIndices)
+        {
+            ++m_aNumLiveTriangles[uIndex];
+        }
+
+        m_aTriangleOffsets.resize(static_cast<size_t>(uNumVertices) + 1u);
+        m_aTriangleOffsets[0] = 0u;
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            m_aTriangleOffsets[i + 1u] = m_aTriangleOffsets[i] + m_aNumLiveTriangles[i];
+        }
+
+        m_aAdjacentTriangles.resize(aIndices.size());
+        m_aScratchIndices.assign(m_aTriangleOffsets.begin(), m_aTriangleOffsets.end() - 1);
+        for (UINT i = 0u; i < static_cast<UINT>(aIndices.size()); ++i)
+        {
+            m_aAdjacentTriangles[m_aScratchIndices[aIndices[i]]++] = i / 3u;
+        }
+
+        m_aCacheTimestamps.assign(uNumVertices, 0u);
+        m_aEmitted.assign(uNumTriangles, FALSE);
+        m_aDeadEnds.clear();
+
+        std::vector<UINT> aOrderedIndices;
+        aOrderedIndices.reserve(aIndices.size());
+
+        UINT uTimestamp = CACHE_SIZE + 1u;
+        UINT uCursor = 0u;
+        UINT uFanningVertex = skipDeadEnd(uCursor, uNumVertices);
+        while (uFanningVertex != INVALID_VERTEX)
+        {
+            if (uTimestamp - m_aCacheTimestamps[uFanningVertex] > CACHE_SIZE)
+            {
+                m_aClusterStarts.push_back(static_cast<UINT>(aOrderedIndices.size() / 3u));
+            }
+
+            m_aCandidates.clear();
+            for (UINT i = m_aTriangleOffsets[uFanningVertex]; i < m_aTriangleOffsets[uFanningVertex + 1u]; ++i)
+            {
+                const UINT uTriangle = m_aAdjacentTriangles[i];
+                if (m_aEmitted[uTriangle])
+                {
+                    continue;
+                }
+
+                for (UINT uCorner = 0u; uCorner < 3u; ++uCorner)
+                {
+                    const UINT uVertex = aIndices[uTriangle * 3u + uCorner];
+                    aOrderedIndices.push_back(uVertex);
+                    m_aDeadEnds.push_back(uVertex);
+                    m_aCandidates.push_back(uVertex);
+                    --m_aNumLiveTriangles[uVertex];
+
+                    if (uTimestamp - m_aCacheTimestamps[uVertex] > CACHE_SIZE)
+                    {
+                        m_aCacheTimestamps[uVertex] = uTimestamp++;
+                    }
+                }
+                m_aEmitted[uTriangle] = TRUE;
+            }
+
+            uFanningVertex = getNextVertex(uTimestamp);
+            if (uFanningVertex == INVALID_VERTEX)
+            {
+                uFanningVertex = skipDeadEnd(uCursor, uNumVertices);
+            }
+        }
+
+        aIndices.swap(aOrderedIndices);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshOptimizer::OptimizeOverdraw
+
+      Summary:  Sorts the clusters of the last call to
+                OptimizeVertexCache on the same indices, those whose
+                normal points the most away from the center of the mesh
+                first. A cluster starts on a vertex out of the cache,
+                so moving it adds no cache miss.
+
+      Args:     std::vector<UINT>& aIndices
+                  Indices returned by OptimizeVertexCache, reordered in
+                  place
+                const SimpleVertex* aVertices
+                  Vertices of the mesh
+                UINT uNumVertices
+                  Number of vertices of the mesh
+
+      Modifies: [m_aClusterStarts, m_aScratchIndices].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshOptimizer::OptimizeOverdraw(
+        _Inout_ std::vector<UINT>& aIndices,
+        _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+        _In_ UINT uNumVertices
+    )
+    {
+        const UINT uNumTriangles = static_cast<UINT>(aIndices.size() / 3u);
+        if (m_aClusterStarts.size() < 2u || uNumVertices == 0u)
+        {
+            return;
+        }
+
+        XMVECTOR meshCenter = XMVectorZero();
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            meshCenter = XMVectorAdd(meshCenter, XMLoadFloat3(&aVertices[i].Position));
+        }
+        meshCenter = XMVectorScale(meshCenter, 1.0f / static_cast<FLOAT>(uNumVertices));
+
+        const UINT uNumClusters = static_cast<UINT>(m_aClusterStarts.size());
+        std::vector<FLOAT> aScores(uNumClusters, 0.0f);
+        for (UINT uCluster = 0u; uCluster < uNumClusters; ++uCluster)
+        {
+            const UINT uBegin = m_aClusterStarts[uCluster];
+            const UINT uEnd = uCluster + 1u < uNumClusters ? m_aClusterStarts[uCluster + 1u] : uNumTriangles;
+
+            // The vertex normals do not depend on the winding, unlike the face normals
+            XMVECTOR center = XMVectorZero();
+            XMVECTOR normal = XMVectorZero();
+            for (UINT i = uBegin * 3u; i < uEnd * 3u; ++i)
+            {
+                center = XMVectorAdd(center, XMLoadFloat3(&aVertices[aIndices[i]].Position));
+                normal = XMVectorAdd(normal, XMLoadFloat3(&aVertices[aIndices[i]].Normal));
+            }
+            center = XMVectorScale(center, 1.0f / static_cast<FLOAT>((uEnd - uBegin) * 3u));
+
+            aScores[uCluster] = XMVectorGetX(XMVector3Dot(XMVectorSubtract(center, meshCenter), XMVector3Normalize(normal)));
+        }
+
+        std::vector<UINT> aOrder(uNumClusters);
+        for (UINT i = 0u; i < uNumClusters; ++i)
+        {
+            aOrder[i] = i;
+        }
+        std::stable_sort(
+            aOrder.begin(),
+            aOrder.end(),
+            [&aScores](UINT uLeft, UINT uRight) { return aScores[uLeft] > aScores[uRight]; }
+        );
+
+        m_aScratchIndices.clear();
+        m_aScratchIndices.reserve(aIndices.size());
+        std::vector<UINT> aClusterStarts;
+        aClusterStarts.reserve(uNumClusters);
+        for (UINT uCluster : aOrder)
+        {
+            const UINT uBegin = m_aClusterStarts[uCluster];
+            const UINT uEnd = uCluster + 1u < uNumClusters ? m_aClusterStarts[uCluster + 1u] : uNumTriangles;
+
+            aClusterStarts.push_back(static_cast<UINT>(m_aScratchIndices.size() / 3u));
+            m_aScratchIndices.insert(m_aScratchIndices.end(), aIndices.begin() + uBegin * 3u, aIndices.begin() + uEnd * 3u);
+        }
+
+        aIndices.swap(m_aScratchIndices);
+        m_aClusterStarts.swap(aClusterStarts);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshOptimizer::OptimizeVertexFetch
+
+      Summary:  Renumbers the vertices in the order the indices first
+                use them, so that the vertex fetch walks the vertex
+                buffers forward. Unused vertices keep their order after
+                the used ones.
+
+      Args:     std::vector<UINT>& aIndices
+                  Indices, renumbered in place
+                UINT uNumVertices
+                  Number of vertices the indices refer to
+                std::vector<UINT>& aOutRemap
+                  New index of every vertex
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshOptimizer::OptimizeVertexFetch(
+        _Inout_ std::vector<UINT>& aIndices,
+        _In_ UINT uNumVertices,
+        _Out_ std::vector<UINT>& aOutRemap
+    )
+    {
+        aOutRemap.assign(uNumVertices, INVALID_VERTEX);
+
+        UINT uNextVertex = 0u;
+        for (UINT& uIndex : aIndices)
+        {
+            if (aOutRemap[uIndex] == INVALID_VERTEX)
+            {
+                aOutRemap[uIndex] = uNextVertex++;
+            }
+            uIndex = aOutRemap[uIndex];
+        }
+
+        for (UINT& uNewIndex : aOutRemap)
+        {
+            if (uNewIndex == INVALID_VERTEX)
+            {
+                uNewIndex = uNextVertex++;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshOptimizer::getNextVertex
+
+      Summary:  Returns the candidate with triangles left that is the
+                oldest in the cache while still being in the cache
+                after all of them are emitted, or any candidate with
+                triangles left when none stays in the cache
+
+      Args:     UINT uTimestamp
+                  Current cache time
+
+      Returns:  UINT
+                  Next fanning vertex, INVALID_VERTEX if no candidate
+                  has triangles left
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT MeshOptimizer::getNextVertex(
+        _In_ UINT uTimestamp
+    )
+    {
+        UINT uNextVertex = INVALID_VERTEX;
+        INT bestPriority = -1;
+        for (UINT uVertex : m_aCandidates)
+        {
+            if (m_aNumLiveTriangles[uVertex] == 0u)
+            {
+                continue;
+            }
+
+            // Fanning adds up to two vertices to the cache per remaining triangle
+            INT priority = 0;
+            const UINT uAge = uTimestamp - m_aCacheTimestamps[uVertex];
+            if (uAge + 2u * m_aNumLiveTriangles[uVertex] <= CACHE_SIZE)
+            {
+                priority = static_cast<INT>(uAge);
+            }
+
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                uNextVertex = uVertex;
+            }
+        }
+
+        return uNextVertex;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshOptimizer::skipDeadEnd
+
+      Summary:  Returns the most recently emitted vertex with triangles
+                left, or the next vertex in input order with triangles
+                left
+
+      Args:     UINT& uCursor
+                  Next vertex in input order to look at, advanced past
+                  the vertices without triangles left
+                UINT uNumVertices
+                  Number of vertices
+
+      Modifies: [m_aDeadEnds].
+
+      Returns:  UINT
+                  Next fanning vertex, INVALID_VERTEX once every
+                  triangle is emitted
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT MeshOptimizer::skipDeadEnd(
+        _Inout_ UINT& uCursor,
+        _In_ UINT uNumVertices
+    )
+    {
+        while (!m_aDeadEnds.empty())
+        {
+            const UINT uVertex = m_aDeadEnds.back();
+            m_aDeadEnds.pop_back();
+            if (m_aNumLiveTriangles[uVertex] > 0u)
+            {
+                return uVertex;
+            }
+        }
+
+        for (; uCursor < uNumVertices; ++uCursor)
+        {
+            if (m_aNumLiveTriangles[uCursor] > 0u)
+            {
+                return uCursor;
+            }
+        }
+
+        return INVALID_VERTEX;
+    }
+}
@@ -0,0 +1,102 @@
+/*+===================================================================
+  File:      MESHOPTIMIZER.H
+
+  Summary:   MeshOptimizer header file contains declarations of
+             MeshOptimizer class that reorders the triangles and the
+             vertices of a mesh for the post-transform vertex cache,
+             for less overdraw and for the vertex fetch.
+
+  Classes: MeshOptimizer
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VertexCacheStats
+
+      Summary:  Result of the simulation of a FIFO vertex cache. The
+                average cache miss ratio (ACMR) is the number of misses
+                per triangle, the average transform to vertex ratio
+                (ATVR) the number of misses per vertex, 1 at best.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VertexCacheStats
+    {
+        UINT uNumMisses;
+        UINT uNumTriangles;
+        UINT uNumVertices;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MeshOptimizer
+
+      Summary:  Reorders the indices of one mesh at a time, the indices
+                are relative to the first vertex of the mesh. The
+                triangles are first ordered with Tipsify, which fans
+                around the vertices still in the cache and splits the
+                order into clusters wherever it has to jump to a vertex
+                out of the cache. The clusters are then sorted so that
+                the ones facing away from the center of the mesh are
+                drawn first and occlude the others, which costs no
+                extra cache miss. Finally the vertices are renumbered
+                in the order they are first used. Every pass is
+                deterministic.
+
+      Methods:  OptimizeVertexCache
+                  Reorders the triangles for the vertex cache
+                OptimizeOverdraw
+                  Sorts the clusters of the last vertex cache pass
+                OptimizeVertexFetch
+                  Renumbers the vertices in the order they are used
+                AnalyzeVertexCache
+                  Simulates the vertex cache over indices
+                MeshOptimizer
+                  Constructor.
+                ~MeshOptimizer
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MeshOptimizer
+    {
+    public:
+        // Number of entries of the simulated FIFO cache, the size of the post-transform cache of most GPUs
+        static constexpr const UINT CACHE_SIZE = 16u;
+
+        static VertexCacheStats AnalyzeVertexCache(_In_ const std::vector<UINT>& aIndices, _In_ UINT uNumVertices);
+
+    public:
+        MeshOptimizer();
+        MeshOptimizer(const MeshOptimizer& other) = delete;
+        MeshOptimizer(MeshOptimizer&& other) = delete;
+        MeshOptimizer& operator=(const MeshOptimizer& other) = delete;
+        MeshOptimizer& operator=(MeshOptimizer&& other) = delete;
+        virtual ~MeshOptimizer() = default;
+
+        void OptimizeVertexCache(_Inout_ std::vector<UINT>& aIndices, _In_ UINT uNumVertices);
+        void OptimizeOverdraw(_Inout_ std::vector<UINT>& aIndices, _In_reads_(uNumVertices) const SimpleVertex* aVertices, _In_ UINT uNumVertices);
+        void OptimizeVertexFetch(_Inout_ std::vector<UINT>& aIndices, _In_ UINT uNumVertices, _Out_ std::vector<UINT>& aOutRemap);
+
+    protected:
+        UINT getNextVertex(_In_ UINT uTimestamp);
+        UINT skipDeadEnd(_Inout_ UINT& uCursor, _In_ UINT uNumVertices);
+
+    protected:
+        static constexpr const UINT INVALID_VERTEX = (0xFFFFFFFF);
+
+    protected:
+        std::vector<UINT> m_aTriangleOffsets;
+        std::vector<UINT> m_aAdjacentTriangles;
+        std::vector<UINT> m_aNumLiveTriangles;
+        std::vector<UINT> m_aCacheTimestamps;
+        std::vector<UINT> m_aDeadEnds;
+        std::vector<UINT> m_aCandidates;
+        std::vector<BOOL> m_aEmitted;
+        std::vector<UINT> m_aClusterStarts;
+        std::vector<UINT> m_aScratchIndices;
+    };
+}
@@ -0,0 +1,846 @@
+#include "Model/MeshSimplifier.h"
+
+#include <algorithm>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::MeshSimplifier
+
+      Summary:  Constructor
+
+      Modifies: [m_aPositions, m_aWeldedVertices, m_aNextWedges,
+                 m_aKinds, m_aQuadrics, m_aTriangleOffsets,
+                 m_aAdjacentTriangles, m_aCollapses, m_aCollapseTargets,
+                 m_aLocked].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    MeshSimplifier::MeshSimplifier()
+        : m_aPositions()
+        , m_aWeldedVertices()
+        , m_aNextWedges()
+        , m_aKinds()
+        , m_aQuadrics()
+        , m_aTriangleOffsets()
+        , m_aAdjacentTriangles()
+        , m_aCollapses()
+        , m_aCollapseTargets()
+        , m_aLocked()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::Simplify
+
+      Summary:  Collapses edges in passes until the mesh has no more
+                than the target number of indices, or until the next
+                collapse would move the surface by more than the
+                largest error. Every pass sorts the collapses of all
+                the edges by their error and applies the cheapest ones
+                whose triangles no earlier collapse of the pass touched.
+
+      Args:     std::vector<UINT>& aIndices
+                  Indices of a triangle list, simplified in place
+                const SimpleVertex* aVertices
+                  Vertices the indices refer to
+                const AnimationData* aAnimationData
+                  Bone weights of the vertices, or nullptr when the
+                  mesh is not skinned
+                UINT uNumVertices
+                  Number of vertices the indices refer to
+                UINT uTargetNumIndices
+                  Number of indices to reach
+                FLOAT maxError
+                  Largest distance a collapse may move the surface, as
+                  a fraction of the largest extent of the mesh
+
+      Modifies: [m_aPositions, m_aWeldedVertices, m_aNextWedges,
+                 m_aKinds, m_aQuadrics, m_aTriangleOffsets,
+                 m_aAdjacentTriangles, m_aCollapses, m_aCollapseTargets,
+                 m_aLocked].
+
+      Returns:  FLOAT
+                  Largest error of the collapses, as a fraction of the
+                  largest extent of the mesh
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT MeshSimplifier::Simplify(
+        _Inout_ std::vector<UINT>& aIndices,
+        _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+        _In_reads_opt_(uNumVertices) const AnimationData* aAnimationData,
+        _In_ UINT uNumVertices,
+        _In_ UINT uTargetNumIndices,
+        _In_ FLOAT maxError
+    )
+    {
+        if (aIndices.size() <= uTargetNumIndices || uNumVertices == 0u)
+        {
+            return 0.0f;
+        }
+
+        weldPositions(aVertices, uNumVertices);
+
+        // Triangles with two corners at the same position cover no pixel and have no adjacency
+        size_t uNumWritten = 0u;
+        for (size_t i = 0u; i + 2u < aIndices.size(); i += 3u)
+        {
+            const UINT uA = m_aWeldedVertices[aIndices[i]];
+            const UINT uB = m_aWeldedVertices[aIndices[i + 1u]];
+            const UINT uC = m_aWeldedVertices[aIndices[i + 2u]];
+            if (uA == uB || uB == uC || uA == uC)
+            {
+                continue;
+            }
+
+            aIndices[uNumWritten++] = aIndices[i];
+            aIndices[uNumWritten++] = aIndices[i + 1u];
+            aIndices[uNumWritten++] = aIndices[i + 2u];
+        }
+        aIndices.resize(uNumWritten);
+
+        computeQuadrics(aIndices, uNumVertices);
+
+        m_aCollapseTargets.assign(uNumVertices, INVALID_VERTEX);
+
+        const FLOAT maxSquaredError = maxError * maxError;
+        FLOAT largestSquaredError = 0.0f;
+        size_t uNumIndices = aIndices.size();
+
+        while (uNumIndices > uTargetNumIndices)
+        {
+            buildAdjacency(aIndices, uNumVertices);
+
+            // Both directions of every edge, the locks of the pass keep a single collapse per edge
+            m_aCollapses.clear();
+            for (size_t i = 0u; i < aIndices.size(); i += 3u)
+            {
+                for (UINT k = 0u; k < 3u; ++k)
+                {
+                    const UINT uA = m_aWeldedVertices[aIndices[i + k]];
+                    const UINT uB = m_aWeldedVertices[aIndices[i + (k + 1u) % 3u]];
+                    if (m_aKinds[uA] != LOCKED)
+                    {
+                        m_aCollapses.push_back({ .uFrom = uA, .uTo = uB, .Error = evaluateQuadric(m_aQuadrics[uA], m_aPositions[uB]) });
+                    }
+                    if (m_aKinds[uB] != LOCKED)
+                    {
+                        m_aCollapses.push_back({ .uFrom = uB, .uTo = uA, .Error = evaluateQuadric(m_aQuadrics[uB], m_aPositions[uA]) });
+                    }
+                }
+            }
+
+            std::sort(
+                m_aCollapses.begin(),
+                m_aCollapses.end(),
+                [](const Collapse& a, const Collapse& b)
+                {
+                    if (a.Error != b.Error)
+                    {
+                        return a.Error < b.Error;
+                    }
+                    return a.uFrom != b.uFrom ? a.uFrom < b.uFrom : a.uTo < b.uTo;
+                }
+            );
+
+            m_aLocked.assign(uNumVertices, FALSE);
+
+            UINT uNumApplied = 0u;
+            for (const Collapse& collapse : m_aCollapses)
+            {
+                if (uNumIndices <= uTargetNumIndices || collapse.Error > maxSquaredError)
+                {
+                    break;
+                }
+
+                if (m_aLocked[collapse.uFrom] || m_aLocked[collapse.uTo])
+                {
+                    continue;
+                }
+
+                UINT uNumRemovedTriangles = 0u;
+                if (!prepareCollapse(aIndices, aAnimationData, collapse.uFrom, collapse.uTo, uNumRemovedTriangles))
+                {
+                    continue;
+                }
+
+                if (isCollapseFlipping(aIndices, collapse.uFrom, collapse.uTo))
+                {
+                    resetCollapse(collapse.uFrom);
+                    continue;
+                }
+
+                addQuadric(m_aQuadrics[collapse.uTo], m_aQuadrics[collapse.uFrom]);
+
+                // Every triangle the collapse changes is left alone for the rest of the pass
+                for (UINT j = m_aTriangleOffsets[collapse.uFrom]; j < m_aTriangleOffsets[collapse.uFrom + 1u]; ++j)
+                {
+                    const size_t uTriangle = static_cast<size_t>(m_aAdjacentTriangles[j]) * 3u;
+                    m_aLocked[m_aWeldedVertices[aIndices[uTriangle]]] = TRUE;
+                    m_aLocked[m_aWeldedVertices[aIndices[uTriangle + 1u]]] = TRUE;
+                    m_aLocked[m_aWeldedVertices[aIndices[uTriangle + 2u]]] = TRUE;
+                }
+
+                uNumIndices -= static_cast<size_t>(uNumRemovedTriangles) * 3u;
+                largestSquaredError = fmaxf(largestSquaredError, collapse.Error);
+                ++uNumApplied;
+            }
+
+            if (uNumApplied == 0u)
+            {
+                break;
+            }
+
+            // Move the collapsed vertices and drop the triangles that lost their area
+            uNumWritten = 0u;
+            for (size_t i = 0u; i < aIndices.size(); i += 3u)
+            {
+                UINT auCorners[3];
+                for (UINT k = 0u; k < 3u; ++k)
+                {
+                    const UINT uIndex = aIndices[i + k];
+                    auCorners[k] = m_aCollapseTargets[uIndex] != INVALID_VERTEX ? m_aCollapseTargets[uIndex] : uIndex;
+                }
+
+                const UINT uA = m_aWeldedVertices[auCorners[0]];
+                const UINT uB = m_aWeldedVertices[auCorners[1]];
+                const UINT uC = m_aWeldedVertices[auCorners[2]];
+                if (uA == uB || uB == uC || uA == uC)
+                {
+                    continue;
+                }
+
+                aIndices[uNumWritten++] = auCorners[0];
+                aIndices[uNumWritten++] = auCorners[1];
+                aIndices[uNumWritten++] = auCorners[2];
+            }
+            aIndices.resize(uNumWritten);
+            uNumIndices = uNumWritten;
+
+            m_aCollapseTargets.assign(uNumVertices, INVALID_VERTEX);
+        }
+
+        return sqrtf(largestSquaredError);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::addPlane
+
+      Summary:  Adds the squared distance to a plane to a quadric
+
+      Args:     Quadric& quadric
+                  Quadric to add the plane to
+                FXMVECTOR normal
+                  Unit normal of the plane
+                FXMVECTOR point
+                  Point of the plane
+                FLOAT weight
+                  Weight of the plane
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshSimplifier::addPlane(
+        _Inout_ Quadric& quadric,
+        _In_ FXMVECTOR normal,
+        _In_ FXMVECTOR point,
+        _In_ FLOAT weight
+    )
+    {
+        XMFLOAT3 n;
+        XMStoreFloat3(&n, normal);
+        const FLOAT d = -XMVectorGetX(XMVector3Dot(normal, point));
+
+        quadric.A00 += weight * n.x * n.x;
+        quadric.A11 += weight * n.y * n.y;
+        quadric.A22 += weight * n.z * n.z;
+        quadric.A01 += weight * n.x * n.y;
+        quadric.A02 += weight * n.x * n.z;
+        quadric.A12 += weight * n.y * n.z;
+        quadric.B0 += weight * n.x * d;
+        quadric.B1 += weight * n.y * d;
+        quadric.B2 += weight * n.z * d;
+        quadric.C += weight * d * d;
+        quadric.Weight += weight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::addQuadric
+
+      Summary:  Adds the planes of a quadric to another
+
+      Args:     Quadric& quadric
+                  Quadric to add the planes to
+                const Quadric& other
+                  Quadric whose planes are added
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshSimplifier::addQuadric(
+        _Inout_ Quadric& quadric,
+        _In_ const Quadric& other
+    )
+    {
+        quadric.A00 += other.A00;
+        quadric.A11 += other.A11;
+        quadric.A22 += other.A22;
+        quadric.A01 += other.A01;
+        quadric.A02 += other.A02;
+        quadric.A12 += other.A12;
+        quadric.B0 += other.B0;
+        quadric.B1 += other.B1;
+        quadric.B2 += other.B2;
+        quadric.C += other.C;
+        quadric.Weight += other.Weight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::evaluateQuadric
+
+      Summary:  Returns the average squared distance of a position to
+                the planes of a quadric
+
+      Args:     const Quadric& quadric
+                  Planes to measure the distance to
+                const XMFLOAT3& position
+                  Position to measure
+
+      Returns:  FLOAT
+                  Squared distance, 0 for a quadric without planes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT MeshSimplifier::evaluateQuadric(
+        _In_ const Quadric& quadric,
+        _In_ const XMFLOAT3& position
+    )
+    {
+        if (quadric.Weight <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        const FLOAT x = position.x;
+        const FLOAT y = position.y;
+        const FLOAT z = position.z;
+        const FLOAT error = quadric.A00 * x * x + quadric.A11 * y * y + quadric.A22 * z * z
+            + 2.0f * (quadric.A01 * x * y + quadric.A02 * x * z + quadric.A12 * y * z)
+            + 2.0f * (quadric.B0 * x + quadric.B1 * y + quadric.B2 * z)
+            + quadric.C;
+
+        // The sum of squares only goes below zero through rounding
+        return fabsf(error) / quadric.Weight;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::measureSkinDifference
+
+      Summary:  Returns how differently two vertices follow the bones
+
+      Args:     const AnimationData& a
+                  Bone indices and weights of the first vertex
+                const AnimationData& b
+                  Bone indices and weights of the second vertex
+
+      Returns:  FLOAT
+                  Sum of the differences of the weight of every bone
+                  influencing either vertex, 0 when they are skinned
+                  alike and 2 when they share no bone
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT MeshSimplifier::measureSkinDifference(
+        _In_ const AnimationData& a,
+        _In_ const AnimationData& b
+    )
+    {
+        const BYTE* aBonesA = reinterpret_cast<const BYTE*>(&a.aBoneIndices);
+        const BYTE* aWeightsA = reinterpret_cast<const BYTE*>(&a.aBoneWeights);
+        const BYTE* aBonesB = reinterpret_cast<const BYTE*>(&b.aBoneIndices);
+        const BYTE* aWeightsB = reinterpret_cast<const BYTE*>(&b.aBoneWeights);
+
+        UINT uDifference = 0u;
+        for (UINT i = 0u; i < 4u; ++i)
+        {
+            if (aWeightsA[i] == 0u)
+            {
+                continue;
+            }
+
+            UINT uWeightB = 0u;
+            for (UINT j = 0u; j < 4u; ++j)
+            {
+                if (aBonesB[j] == aBonesA[i])
+                {
+                    uWeightB += aWeightsB[j];
+                }
+            }
+            uDifference += aWeightsA[i] > uWeightB ? aWeightsA[i] - uWeightB : uWeightB - aWeightsA[i];
+        }
+
+        // Bones of the second vertex only
+        for (UINT j = 0u; j < 4u; ++j)
+        {
+            BOOL bShared = FALSE;
+            for (UINT i = 0u; i < 4u; ++i)
+            {
+                bShared |= aWeightsA[i] != 0u && aBonesA[i] == aBonesB[j];
+            }
+            if (!bShared)
+            {
+                uDifference += aWeightsB[j];
+            }
+        }
+
+        return static_cast<FLOAT>(uDifference) / 255.0f;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::buildAdjacency
+
+      Summary:  Lists the triangles of every welded vertex, stored
+                contiguously in the order of the triangles
+
+      Args:     const std::vector<UINT>& aIndices
+                  Indices of a triangle list without degenerate
+                  triangles
+                UINT uNumVertices
+                  Number of vertices the indices refer to
+
+      Modifies: [m_aTriangleOffsets, m_aAdjacentTriangles].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshSimplifier::buildAdjacency(
+        _In_ const std::vector<UINT>& aIndices,
+        _In_ UINT uNumVertices
+    )
+    {
+        m_aTriangleOffsets.assign(static_cast<size_t>(uNumVertices) + 1u, 0u);
+        for (UINT uIndex : aIndices)
+        {
+            ++m_aTriangleOffsets[m_aWeldedVertices[uIndex]];
+        }
+
+        // Offsets past the triangles of every vertex, moved back to their start while filling
+        UINT uNumAdjacentTriangles = 0u;
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            uNumAdjacentTriangles += m_aTriangleOffsets[i];
+            m_aTriangleOffsets[i] = uNumAdjacentTriangles;
+        }
+        m_aTriangleOffsets[uNumVertices] = uNumAdjacentTriangles;
+
+        m_aAdjacentTriangles.resize(uNumAdjacentTriangles);
+        for (size_t i = aIndices.size(); i >= 3u; i -= 3u)
+        {
+            const UINT uTriangle = static_cast<UINT>(i / 3u) - 1u;
+            m_aAdjacentTriangles[--m_aTriangleOffsets[m_aWeldedVertices[aIndices[i - 3u]]]] = uTriangle;
+            m_aAdjacentTriangles[--m_aTriangleOffsets[m_aWeldedVertices[aIndices[i - 2u]]]] = uTriangle;
+            m_aAdjacentTriangles[--m_aTriangleOffsets[m_aWeldedVertices[aIndices[i - 1u]]]] = uTriangle;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::computeQuadrics
+
+      Summary:  Sums the planes of the triangles around every welded
+                vertex, weighted by their area, and classifies the
+                vertices. An edge whose opposite edge is missing among
+                the vertices is a border when it is also missing among
+                the welded vertices, and a texture seam or a hard edge
+                otherwise. Both add a plane through the edge across
+                the triangle, which keeps them on their line. A vertex
+                on two border edges is a border vertex, any other
+                number makes it a corner of the border and locks it.
+
+      Args:     const std::vector<UINT>& aIndices
+                  Indices of a triangle list without degenerate
+                  triangles
+                UINT uNumVertices
+                  Number of vertices the indices refer to
+
+      Modifies: [m_aQuadrics, m_aKinds].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshSimplifier::computeQuadrics(
+        _In_ const std::vector<UINT>& aIndices,
+        _In_ UINT uNumVertices
+    )
+    {
+        m_aQuadrics.assign(uNumVertices, Quadric());
+
+        std::unordered_set<UINT64> edges;
+        std::unordered_set<UINT64> weldedEdges;
+        edges.reserve(aIndices.size());
+        weldedEdges.reserve(aIndices.size());
+        for (size_t i = 0u; i < aIndices.size(); i += 3u)
+        {
+            for (UINT k = 0u; k < 3u; ++k)
+            {
+                const UINT uA = aIndices[i + k];
+                const UINT uB = aIndices[i + (k + 1u) % 3u];
+                edges.insert((static_cast<UINT64>(uA) << 32u) | uB);
+                weldedEdges.insert((static_cast<UINT64>(m_aWeldedVertices[uA]) << 32u) | m_aWeldedVertices[uB]);
+            }
+        }
+
+        std::vector<UINT> aNumBorderEdges(uNumVertices, 0u);
+        for (size_t i = 0u; i < aIndices.size(); i += 3u)
+        {
+            const UINT auCorners[3] =
+            {
+                m_aWeldedVertices[aIndices[i]],
+                m_aWeldedVertices[aIndices[i + 1u]],
+                m_aWeldedVertices[aIndices[i + 2u]],
+            };
+            const XMVECTOR aPositions[3] =
+            {
+                XMLoadFloat3(&m_aPositions[auCorners[0]]),
+                XMLoadFloat3(&m_aPositions[auCorners[1]]),
+                XMLoadFloat3(&m_aPositions[auCorners[2]]),
+            };
+
+            const XMVECTOR normal = XMVector3Cross(XMVectorSubtract(aPositions[1], aPositions[0]), XMVectorSubtract(aPositions[2], aPositions[0]));
+            const FLOAT doubleArea = XMVectorGetX(XMVector3Length(normal));
+            const BOOL bHasArea = doubleArea > 0.0f;
+            const XMVECTOR unitNormal = bHasArea ? XMVectorScale(normal, 1.0f / doubleArea) : XMVectorZero();
+
+            for (UINT k = 0u; k < 3u; ++k)
+            {
+                if (bHasArea)
+                {
+                    addPlane(m_aQuadrics[auCorners[k]], unitNormal, aPositions[0], doubleArea * 0.5f);
+                }
+
+                const UINT uA = aIndices[i + k];
+                const UINT uB = aIndices[i + (k + 1u) % 3u];
+                if (edges.contains((static_cast<UINT64>(uB) << 32u) | uA))
+                {
+                    continue;
+                }
+
+                const UINT uWeldedA = auCorners[k];
+                const UINT uWeldedB = auCorners[(k + 1u) % 3u];
+                if (!weldedEdges.contains((static_cast<UINT64>(uWeldedB) << 32u) | uWeldedA))
+                {
+                    ++aNumBorderEdges[uWeldedA];
+                    ++aNumBorderEdges[uWeldedB];
+                }
+
+                if (bHasArea)
+                {
+                    const XMVECTOR edge = XMVectorSubtract(aPositions[(k + 1u) % 3u], aPositions[k]);
+                    const XMVECTOR edgeNormal = XMVector3Normalize(XMVector3Cross(edge, unitNormal));
+                    const FLOAT weight = XMVectorGetX(XMVector3LengthSq(edge)) * BORDER_WEIGHT;
+                    addPlane(m_aQuadrics[uWeldedA], edgeNormal, aPositions[k], weight);
+                    addPlane(m_aQuadrics[uWeldedB], edgeNormal, aPositions[k], weight);
+                }
+            }
+        }
+
+        m_aKinds.resize(uNumVertices);
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            switch (aNumBorderEdges[i])
+            {
+            case 0u:
+                m_aKinds[i] = MANIFOLD;
+                break;
+            case 2u:
+                m_aKinds[i] = BORDER;
+                break;
+            default:
+                m_aKinds[i] = LOCKED;
+                break;
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::isCollapseFlipping
+
+      Summary:  Checks whether moving a welded vertex onto another
+                turns one of the triangles that remain too far away
+                from its normal
+
+      Args:     const std::vector<UINT>& aIndices
+                  Indices of a triangle list
+                UINT uFrom
+                  Welded vertex that moves
+                UINT uTo
+                  Welded vertex it moves onto
+
+      Returns:  BOOL
+                  TRUE if a triangle would flip
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL MeshSimplifier::isCollapseFlipping(
+        _In_ const std::vector<UINT>& aIndices,
+        _In_ UINT uFrom,
+        _In_ UINT uTo
+    ) const
+    {
+        const XMVECTOR target = XMLoadFloat3(&m_aPositions[uTo]);
+
+        for (UINT j = m_aTriangleOffsets[uFrom]; j < m_aTriangleOffsets[uFrom + 1u]; ++j)
+        {
+            const size_t uTriangle = static_cast<size_t>(m_aAdjacentTriangles[j]) * 3u;
+            const UINT auCorners[3] =
+            {
+                m_aWeldedVertices[aIndices[uTriangle]],
+                m_aWeldedVertices[aIndices[uTriangle + 1u]],
+                m_aWeldedVertices[aIndices[uTriangle + 2u]],
+            };
+
+            // Triangles on the collapsed edge disappear
+            if (auCorners[0] == uTo || auCorners[1] == uTo || auCorners[2] == uTo)
+            {
+                continue;
+            }
+
+            XMVECTOR aBefore[3];
+            XMVECTOR aAfter[3];
+            for (UINT k = 0u; k < 3u; ++k)
+            {
+                aBefore[k] = XMLoadFloat3(&m_aPositions[auCorners[k]]);
+                aAfter[k] = auCorners[k] == uFrom ? target : aBefore[k];
+            }
+
+            const XMVECTOR normalBefore = XMVector3Cross(XMVectorSubtract(aBefore[1], aBefore[0]), XMVectorSubtract(aBefore[2], aBefore[0]));
+            const XMVECTOR normalAfter = XMVector3Cross(XMVectorSubtract(aAfter[1], aAfter[0]), XMVectorSubtract(aAfter[2], aAfter[0]));
+            const FLOAT lengthBefore = XMVectorGetX(XMVector3Length(normalBefore));
+            if (lengthBefore <= 0.0f)
+            {
+                continue;
+            }
+
+            const FLOAT lengthAfter = XMVectorGetX(XMVector3Length(normalAfter));
+            if (XMVectorGetX(XMVector3Dot(normalBefore, normalAfter)) <= MIN_NORMAL_COSINE * lengthBefore * lengthAfter)
+            {
+                return TRUE;
+            }
+        }
+
+        return FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::prepareCollapse
+
+      Summary:  Pairs every vertex at the position of a welded vertex
+                with the vertex at the position of the other that it
+                shares a triangle with. The collapse is valid when
+                every vertex still used finds a single partner whose
+                bone weights are close, and when a border vertex moves
+                along a border edge. The partners of a valid collapse
+                are kept, the others are reset.
+
+      Args:     const std::vector<UINT>& aIndices
+                  Indices of a triangle list
+                const AnimationData* aAnimationData
+                  Bone weights of the vertices, or nullptr
+                UINT uFrom
+                  Welded vertex that moves
+                UINT uTo
+                  Welded vertex it moves onto
+                UINT& uOutNumRemovedTriangles
+                  Number of triangles on the collapsed edge
+
+      Modifies: [m_aCollapseTargets].
+
+      Returns:  BOOL
+                  TRUE if the collapse is valid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL MeshSimplifier::prepareCollapse(
+        _In_ const std::vector<UINT>& aIndices,
+        _In_opt_ const AnimationData* aAnimationData,
+        _In_ UINT uFrom,
+        _In_ UINT uTo,
+        _Out_ UINT& uOutNumRemovedTriangles
+    )
+    {
+        uOutNumRemovedTriangles = 0u;
+        if (m_aKinds[uFrom] == LOCKED || uFrom == uTo)
+        {
+            return FALSE;
+        }
+
+        for (UINT j = m_aTriangleOffsets[uFrom]; j < m_aTriangleOffsets[uFrom + 1u]; ++j)
+        {
+            const size_t uTriangle = static_cast<size_t>(m_aAdjacentTriangles[j]) * 3u;
+            UINT uWedge = INVALID_VERTEX;
+            UINT uTarget = INVALID_VERTEX;
+            for (UINT k = 0u; k < 3u; ++k)
+            {
+                const UINT uIndex = aIndices[uTriangle + k];
+                if (m_aWeldedVertices[uIndex] == uFrom)
+                {
+                    uWedge = uIndex;
+                }
+                else if (m_aWeldedVertices[uIndex] == uTo)
+                {
+                    uTarget = uIndex;
+                }
+            }
+
+            if (uTarget == INVALID_VERTEX)
+            {
+                continue;
+            }
+
+            ++uOutNumRemovedTriangles;
+            if (m_aCollapseTargets[uWedge] == INVALID_VERTEX)
+            {
+                m_aCollapseTargets[uWedge] = uTarget;
+            }
+            else if (m_aCollapseTargets[uWedge] != uTarget)
+            {
+                resetCollapse(uFrom);
+                return FALSE;
+            }
+        }
+
+        // A border vertex only slides along the border, where the edge has a single triangle
+        BOOL bValid = uOutNumRemovedTriangles > 0u && (m_aKinds[uFrom] != BORDER || uOutNumRemovedTriangles == 1u);
+
+        for (UINT j = m_aTriangleOffsets[uFrom]; j < m_aTriangleOffsets[uFrom + 1u] && bValid; ++j)
+        {
+            const size_t uTriangle = static_cast<size_t>(m_aAdjacentTriangles[j]) * 3u;
+            for (UINT k = 0u; k < 3u; ++k)
+            {
+                const UINT uIndex = aIndices[uTriangle + k];
+                if (m_aWeldedVertices[uIndex] == uFrom && m_aCollapseTargets[uIndex] == INVALID_VERTEX)
+                {
+                    bValid = FALSE;
+                }
+            }
+        }
+
+        if (aAnimationData)
+        {
+            UINT uWedge = uFrom;
+            do
+            {
+                const UINT uTarget = m_aCollapseTargets[uWedge];
+                if (uTarget != INVALID_VERTEX && measureSkinDifference(aAnimationData[uWedge], aAnimationData[uTarget]) > MAX_SKIN_WEIGHT_DIFFERENCE)
+                {
+                    bValid = FALSE;
+                }
+                uWedge = m_aNextWedges[uWedge];
+            } while (uWedge != uFrom && bValid);
+        }
+
+        if (!bValid)
+        {
+            resetCollapse(uFrom);
+        }
+
+        return bValid;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::resetCollapse
+
+      Summary:  Forgets the partners of the vertices at the position of
+                a welded vertex
+
+      Args:     UINT uFrom
+                  Welded vertex
+
+      Modifies: [m_aCollapseTargets].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshSimplifier::resetCollapse(
+        _In_ UINT uFrom
+    )
+    {
+        UINT uWedge = uFrom;
+        do
+        {
+            m_aCollapseTargets[uWedge] = INVALID_VERTEX;
+            uWedge = m_aNextWedges[uWedge];
+        } while (uWedge != uFrom);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshSimplifier::weldPositions
+
+      Summary:  Maps every vertex to the first vertex at the same
+                position and links the vertices of a position in a
+                circular list. The positions are scaled so that the
+                largest extent of the mesh is 1.
+
+      Args:     const SimpleVertex* aVertices
+                  Vertices of the mesh
+                UINT uNumVertices
+                  Number of vertices
+
+      Modifies: [m_aPositions, m_aWeldedVertices, m_aNextWedges].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshSimplifier::weldPositions(
+        _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+        _In_ UINT uNumVertices
+    )
+    {
+        BoundingBox bounds;
+        BoundingBox::CreateFromPoints(bounds, uNumVertices, &aVertices->Position, sizeof(SimpleVertex));
+
+        const FLOAT extent = fmaxf(bounds.Extents.x, fmaxf(bounds.Extents.y, bounds.Extents.z)) * 2.0f;
+        const XMVECTOR scale = XMVectorReplicate(extent > 0.0f ? 1.0f / extent : 1.0f);
+        const XMVECTOR minimum = XMVectorSubtract(XMLoadFloat3(&bounds.Center), XMLoadFloat3(&bounds.Extents));
+
+        m_aPositions.resize(uNumVertices);
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            XMStoreFloat3(&m_aPositions[i], XMVectorMultiply(XMVectorSubtract(XMLoadFloat3(&aVertices[i].Position), minimum), scale));
+        }
+
+        // Equal positions end up next to each other, the first of them in vertex order leads
+        std::vector<UINT> aOrder(uNumVertices);
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            aOrder[i] = i;
+        }
+        std::sort(
+            aOrder.begin(),
+            aOrder.end(),
+            [aVertices](UINT uA, UINT uB)
+            {
+                const XMFLOAT3& a = aVertices[uA].Position;
+                const XMFLOAT3& b = aVertices[uB].Position;
+                if (a.x != b.x)
+                {
+                    return a.x < b.x;
+                }
+                if (a.y != b.y)
+                {
+                    return a.y < b.y;
+                }
+                if (a.z != b.z)
+                {
+                    return a.z < b.z;
+                }
+                return uA < uB;
+            }
+        );
+
+        m_aWeldedVertices.resize(uNumVertices);
+        m_aNextWedges.resize(uNumVertices);
+        for (UINT uFirst = 0u; uFirst < uNumVertices;)
+        {
+            const XMFLOAT3& position = aVertices[aOrder[uFirst]].Position;
+            UINT uEnd = uFirst + 1u;
+            while (uEnd < uNumVertices
+                && aVertices[aOrder[uEnd]].Position.x == position.x
+                && aVertices[aOrder[uEnd]].Position.y == position.y
+                && aVertices[aOrder[uEnd]].Position.z == position.z)
+            {
+                ++uEnd;
+            }
+
+            for (UINT i = uFirst; i < uEnd; ++i)
+            {
+                m_aWeldedVertices[aOrder[i]] = aOrder[uFirst];
+                m_aNextWedges[aOrder[i]] = aOrder[i + 1u < uEnd ? i + 1u : uFirst];
+            }
+
+            uFirst = uEnd;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+/*+===================================================================
+  File:      MESHSIMPLIFIER.H
+
+  Summary:   MeshSimplifier header file contains declarations of
+             MeshSimplifier class that removes triangles from a mesh
+             with edge collapses ordered by the quadric error metric.
+
+  Classes: MeshSimplifier
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MeshSimplifier
+
+      Summary:  Simplifies the indices of one mesh at a time, the
+                indices are relative to the first vertex of the mesh.
+                A vertex is collapsed onto a neighbour, so no vertex is
+                created and the texture coordinates, normals and bone
+                weights of the remaining vertices are kept as they are.
+                Vertices sharing a position are welded and collapse
+                together, a texture seam or a hard edge only moves
+                along itself. Border vertices only collapse along the
+                border, and a collapse is rejected when it flips a
+                triangle or joins vertices whose bone weights differ
+                too much. The collapses of a pass are sorted by their
+                error and never touch the same triangles, so the result
+                is deterministic.
+
+      Methods:  Simplify
+                  Removes triangles until a number of indices or an
+                  error is reached
+                MeshSimplifier
+                  Constructor.
+                ~MeshSimplifier
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MeshSimplifier
+    {
+    public:
+        MeshSimplifier();
+        MeshSimplifier(const MeshSimplifier& other) = delete;
+        MeshSimplifier(MeshSimplifier&& other) = delete;
+        MeshSimplifier& operator=(const MeshSimplifier& other) = delete;
+        MeshSimplifier& operator=(MeshSimplifier&& other) = delete;
+        virtual ~MeshSimplifier() = default;
+
+        FLOAT Simplify(
+            _Inout_ std::vector<UINT>& aIndices,
+            _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+            _In_reads_opt_(uNumVertices) const AnimationData* aAnimationData,
+            _In_ UINT uNumVertices,
+            _In_ UINT uTargetNumIndices,
+            _In_ FLOAT maxError
+        );
+
+    protected:
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   Quadric
+
+          Summary:  Weighted sum of the squared distances to planes, as
+                    the upper half of the symmetric matrix A, the vector
+                    b and the constant c of x'Ax + 2b'x + c. The weight
+                    is kept to average the distances.
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct Quadric
+        {
+            FLOAT A00, A11, A22, A01, A02, A12;
+            FLOAT B0, B1, B2;
+            FLOAT C;
+            FLOAT Weight;
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   Collapse
+
+          Summary:  Candidate move of the welded vertex uFrom onto the
+                    welded vertex uTo, with the squared error it adds
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct Collapse
+        {
+            UINT uFrom;
+            UINT uTo;
+            FLOAT Error;
+        };
+
+        static void addPlane(_Inout_ Quadric& quadric, _In_ FXMVECTOR normal, _In_ FXMVECTOR point, _In_ FLOAT weight);
+        static void addQuadric(_Inout_ Quadric& quadric, _In_ const Quadric& other);
+        static FLOAT evaluateQuadric(_In_ const Quadric& quadric, _In_ const XMFLOAT3& position);
+        static FLOAT measureSkinDifference(_In_ const AnimationData& a, _In_ const AnimationData& b);
+
+        void buildAdjacency(_In_ const std::vector<UINT>& aIndices, _In_ UINT uNumVertices);
+        void computeQuadrics(_In_ const std::vector<UINT>& aIndices, _In_ UINT uNumVertices);
+        BOOL isCollapseFlipping(_In_ const std::vector<UINT>& aIndices, _In_ UINT uFrom, _In_ UINT uTo) const;
+        BOOL prepareCollapse(
+            _In_ const std::vector<UINT>& aIndices,
+            _In_opt_ const AnimationData* aAnimationData,
+            _In_ UINT uFrom,
+            _In_ UINT uTo,
+            _Out_ UINT& uOutNumRemovedTriangles
+        );
+        void resetCollapse(_In_ UINT uFrom);
+        void weldPositions(_In_reads_(uNumVertices) const SimpleVertex* aVertices, _In_ UINT uNumVertices);
+
+    protected:
+        // Edges of a border or a seam resist being moved off their line this many times more than a face of the same area
+        static constexpr const FLOAT BORDER_WEIGHT = 10.0f;
+        // Sum of the differences of the bone weights, from 0 to 2, above which two vertices are not joined
+        static constexpr const FLOAT MAX_SKIN_WEIGHT_DIFFERENCE = 0.5f;
+        // Cosine of the largest rotation of the normal of a triangle moved by a collapse
+        static constexpr const FLOAT MIN_NORMAL_COSINE = 0.25f;
+        static constexpr const UINT INVALID_VERTEX = (0xFFFFFFFF);
+
+        enum eVertexKind : BYTE
+        {
+            MANIFOLD = 0,
+            BORDER,
+            LOCKED,
+        };
+
+    protected:
+        std::vector<XMFLOAT3> m_aPositions;
+        std::vector<UINT> m_aWeldedVertices;
+        std::vector<UINT> m_aNextWedges;
+        std::vector<BYTE> m_aKinds;
+        std::vector<Quadric> m_aQuadrics;
+        std::vector<UINT> m_aTriangleOffsets;
+        std::vector<UINT> m_aAdjacentTriangles;
+        std::vector<Collapse> m_aCollapses;
+        std::vector<UINT> m_aCollapseTargets;
+        std::vector<BOOL> m_aLocked;
+    };
+}
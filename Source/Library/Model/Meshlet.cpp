@@ -0,0 +1,511 @@
+#include "Model/Meshlet.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshletBuilder::MeshletBuilder
+
+      Summary:  Constructor
+
+      Modifies: [m_aVertexMeshlets, m_aPoints].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    MeshletBuilder::MeshletBuilder()
+        : m_aVertexMeshlets()
+        , m_aPoints()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshletBuilder::Build
+
+      Summary:  Walks the triangles in their order and starts a new
+                meshlet whenever the next triangle does not fit in the
+                current one. Every vertex remembers the last meshlet it
+                was counted in, so a vertex shared with the previous
+                meshlet is counted again.
+
+      Args:     const std::vector<UINT>& aIndices
+                  Indices of a triangle list, relative to the first
+                  vertex of the mesh
+                const SimpleVertex* aVertices
+                  Vertices the indices refer to
+                UINT uNumVertices
+                  Number of vertices the indices refer to
+                std::vector<Meshlet>& aOutMeshlets
+                  Meshlets the meshlets of the mesh are appended to
+
+      Modifies: [m_aVertexMeshlets, m_aPoints].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshletBuilder::Build(
+        _In_ const std::vector<UINT>& aIndices,
+        _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+        _In_ UINT uNumVertices,
+        _Inout_ std::vector<Meshlet>& aOutMeshlets
+    )
+    {
+        m_aVertexMeshlets.assign(uNumVertices, INVALID_MESHLET);
+
+        const UINT uNumIndices = static_cast<UINT>(aIndices.size()) / 3u * 3u;
+        UINT uFirstIndex = 0u;
+        UINT uNumMeshletVertices = 0u;
+
+        for (UINT i = 0u; i < uNumIndices; i += 3u)
+        {
+            UINT uMeshlet = static_cast<UINT>(aOutMeshlets.size());
+
+            UINT uNumNewVertices = 0u;
+            for (UINT k = 0u; k < 3u; ++k)
+            {
+                const UINT uVertex = aIndices[i + k];
+                const BOOL bRepeated = (k > 0u && aIndices[i] == uVertex) || (k > 1u && aIndices[i + 1u] == uVertex);
+                if (m_aVertexMeshlets[uVertex] != uMeshlet && !bRepeated)
+                {
+                    ++uNumNewVertices;
+                }
+            }
+
+            if (uNumMeshletVertices + uNumNewVertices > MAX_VERTICES || i - uFirstIndex == MAX_TRIANGLES * 3u)
+            {
+                finishMeshlet(aIndices, uFirstIndex, i - uFirstIndex, aVertices, aOutMeshlets);
+                uMeshlet = static_cast<UINT>(aOutMeshlets.size());
+                uFirstIndex = i;
+                uNumMeshletVertices = 0u;
+            }
+
+            for (UINT k = 0u; k < 3u; ++k)
+            {
+                const UINT uVertex = aIndices[i + k];
+                if (m_aVertexMeshlets[uVertex] != uMeshlet)
+                {
+                    m_aVertexMeshlets[uVertex] = uMeshlet;
+                    ++uNumMeshletVertices;
+                }
+            }
+        }
+
+        if (uNumIndices > uFirstIndex)
+        {
+            finishMeshlet(aIndices, uFirstIndex, uNumIndices - uFirstIndex, aVertices, aOutMeshlets);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshletBuilder::Analyze
+
+      Summary:  Checks that the meshlets cover the indices of the mesh
+                in order, that they stay within the limits, that their
+                spheres hold their vertices and that their cones hold
+                the normals of their triangles. Then views the mesh
+                from outside of its bounding box along each axis and
+                counts the triangles the cone test culls, and the ones
+                among them that face the view, which must be none.
+
+      Args:     const Meshlet* aMeshlets
+                  Meshlets of the mesh
+                UINT uNumMeshlets
+                  Number of meshlets of the mesh
+                const std::vector<UINT>& aIndices
+                  Indices of the mesh, relative to its first vertex
+                const SimpleVertex* aVertices
+                  Vertices the indices refer to
+                UINT uNumVertices
+                  Number of vertices the indices refer to
+                MeshletStats& stats
+                  Statistics the mesh is added to
+
+      Modifies: [m_aVertexMeshlets].
+
+      Returns:  BOOL
+                  TRUE if the meshlets are valid
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL MeshletBuilder::Analyze(
+        _In_reads_(uNumMeshlets) const Meshlet* aMeshlets,
+        _In_ UINT uNumMeshlets,
+        _In_ const std::vector<UINT>& aIndices,
+        _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+        _In_ UINT uNumVertices,
+        _Inout_ MeshletStats& stats
+    )
+    {
+        m_aVertexMeshlets.assign(uNumVertices, INVALID_MESHLET);
+
+        XMVECTOR minimum = XMVectorReplicate(FLT_MAX);
+        XMVECTOR maximum = XMVectorReplicate(-FLT_MAX);
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            const XMVECTOR position = XMLoadFloat3(&aVertices[i].Position);
+            minimum = XMVectorMin(minimum, position);
+            maximum = XMVectorMax(maximum, position);
+        }
+
+        UINT uNextIndex = 0u;
+        for (UINT m = 0u; m < uNumMeshlets; ++m)
+        {
+            const Meshlet& meshlet = aMeshlets[m];
+            if (meshlet.uFirstIndex != uNextIndex
+                || meshlet.uNumIndices == 0u
+                || meshlet.uNumIndices % 3u != 0u
+                || meshlet.uNumIndices > MAX_TRIANGLES * 3u
+                || static_cast<size_t>(meshlet.uFirstIndex) + meshlet.uNumIndices > aIndices.size())
+            {
+                return FALSE;
+            }
+            uNextIndex += meshlet.uNumIndices;
+
+            const XMVECTOR center = XMLoadFloat3(&meshlet.Center);
+            const XMVECTOR axis = XMLoadFloat3(&meshlet.ConeAxis);
+            const FLOAT radius = meshlet.Radius * (1.0f + BOUNDS_TOLERANCE) + BOUNDS_TOLERANCE;
+            const FLOAT minCosine = meshlet.ConeCutoff < 1.0f ? sqrtf(1.0f - meshlet.ConeCutoff * meshlet.ConeCutoff) - BOUNDS_TOLERANCE : -1.0f;
+
+            UINT uNumMeshletVertices = 0u;
+            for (UINT i = meshlet.uFirstIndex; i < meshlet.uFirstIndex + meshlet.uNumIndices; i += 3u)
+            {
+                XMVECTOR aCorners[3];
+                for (UINT k = 0u; k < 3u; ++k)
+                {
+                    const UINT uVertex = aIndices[i + k];
+                    if (uVertex >= uNumVertices)
+                    {
+                        return FALSE;
+                    }
+                    if (m_aVertexMeshlets[uVertex] != m)
+                    {
+                        m_aVertexMeshlets[uVertex] = m;
+                        ++uNumMeshletVertices;
+                    }
+
+                    aCorners[k] = XMLoadFloat3(&aVertices[uVertex].Position);
+                    if (XMVectorGetX(XMVector3Length(XMVectorSubtract(aCorners[k], center))) > radius)
+                    {
+                        return FALSE;
+                    }
+                }
+
+                const XMVECTOR normal = XMVector3Cross(XMVectorSubtract(aCorners[1], aCorners[0]), XMVectorSubtract(aCorners[2], aCorners[0]));
+                const FLOAT length = XMVectorGetX(XMVector3Length(normal));
+                if (length > 0.0f && XMVectorGetX(XMVector3Dot(normal, axis)) < minCosine * length)
+                {
+                    return FALSE;
+                }
+            }
+
+            if (uNumMeshletVertices > MAX_VERTICES)
+            {
+                return FALSE;
+            }
+
+            ++stats.uNumMeshlets;
+            stats.uNumVertices += uNumMeshletVertices;
+            stats.uNumTriangles += meshlet.uNumIndices / 3u;
+            if (meshlet.ConeCutoff < 1.0f)
+            {
+                ++stats.uNumCones;
+            }
+        }
+
+        if (uNextIndex != aIndices.size() / 3u * 3u)
+        {
+            return FALSE;
+        }
+
+        const XMVECTOR boxCenter = XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f);
+        const FLOAT distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(maximum, minimum))) + 1.0f;
+        static constexpr const FLOAT VIEW_DIRECTIONS[6][3] =
+        {
+            { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+            { 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+            { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f },
+        };
+
+        for (UINT v = 0u; v < ARRAYSIZE(VIEW_DIRECTIONS); ++v)
+        {
+            const XMVECTOR eye = XMVectorMultiplyAdd(
+                XMVectorSet(VIEW_DIRECTIONS[v][0], VIEW_DIRECTIONS[v][1], VIEW_DIRECTIONS[v][2], 0.0f),
+                XMVectorReplicate(distance),
+                boxCenter
+            );
+
+            for (UINT m = 0u; m < uNumMeshlets; ++m)
+            {
+                const Meshlet& meshlet = aMeshlets[m];
+                stats.uNumViewedTriangles += meshlet.uNumIndices / 3u;
+                if (!MeshletCuller::IsBackFacing(meshlet, eye))
+                {
+                    continue;
+                }
+
+                stats.uNumCulledTriangles += meshlet.uNumIndices / 3u;
+                for (UINT i = meshlet.uFirstIndex; i < meshlet.uFirstIndex + meshlet.uNumIndices; i += 3u)
+                {
+                    const XMVECTOR p0 = XMLoadFloat3(&aVertices[aIndices[i]].Position);
+                    const XMVECTOR p1 = XMLoadFloat3(&aVertices[aIndices[i + 1u]].Position);
+                    const XMVECTOR p2 = XMLoadFloat3(&aVertices[aIndices[i + 2u]].Position);
+                    const XMVECTOR normal = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+                    const XMVECTOR toTriangle = XMVectorSubtract(p0, eye);
+
+                    // Front faces wind clockwise in the left handed space, their normal points to the eye
+                    const FLOAT tolerance = BOUNDS_TOLERANCE * XMVectorGetX(XMVector3Length(normal)) * XMVectorGetX(XMVector3Length(toTriangle));
+                    if (XMVectorGetX(XMVector3Dot(normal, toTriangle)) < -tolerance)
+                    {
+                        ++stats.uNumWronglyCulledTriangles;
+                    }
+                }
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshletBuilder::finishMeshlet
+
+      Summary:  Appends a meshlet with the sphere that bounds its
+                vertices and the cone around the average direction of
+                its triangles that holds all of their normals. The
+                cone is left out when a normal is 90 degrees or more
+                away from the average. Degenerate triangles have no
+                normal and are never drawn, they do not widen the cone.
+
+      Args:     const std::vector<UINT>& aIndices
+                  Indices of the mesh, relative to its first vertex
+                UINT uFirstIndex
+                  First index of the meshlet
+                UINT uNumIndices
+                  Number of indices of the meshlet
+                const SimpleVertex* aVertices
+                  Vertices the indices refer to
+                std::vector<Meshlet>& aOutMeshlets
+                  Meshlets the meshlet is appended to
+
+      Modifies: [m_aPoints].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshletBuilder::finishMeshlet(
+        _In_ const std::vector<UINT>& aIndices,
+        _In_ UINT uFirstIndex,
+        _In_ UINT uNumIndices,
+        _In_ const SimpleVertex* aVertices,
+        _Inout_ std::vector<Meshlet>& aOutMeshlets
+    )
+    {
+        m_aPoints.clear();
+
+        XMVECTOR normalSum = XMVectorZero();
+        for (UINT i = uFirstIndex; i < uFirstIndex + uNumIndices; i += 3u)
+        {
+            const XMFLOAT3& p0 = aVertices[aIndices[i]].Position;
+            const XMFLOAT3& p1 = aVertices[aIndices[i + 1u]].Position;
+            const XMFLOAT3& p2 = aVertices[aIndices[i + 2u]].Position;
+            m_aPoints.push_back(p0);
+            m_aPoints.push_back(p1);
+            m_aPoints.push_back(p2);
+
+            const XMVECTOR position0 = XMLoadFloat3(&p0);
+            const XMVECTOR normal = XMVector3Cross(XMVectorSubtract(XMLoadFloat3(&p1), position0), XMVectorSubtract(XMLoadFloat3(&p2), position0));
+            if (XMVectorGetX(XMVector3LengthSq(normal)) > 0.0f)
+            {
+                normalSum = XMVectorAdd(normalSum, XMVector3Normalize(normal));
+            }
+        }
+
+        BoundingSphere sphere;
+        BoundingSphere::CreateFromPoints(sphere, m_aPoints.size(), m_aPoints.data(), sizeof(XMFLOAT3));
+
+        Meshlet meshlet;
+        meshlet.Center = sphere.Center;
+        meshlet.Radius = sphere.Radius;
+        meshlet.ConeAxis = XMFLOAT3(0.0f, 0.0f, 0.0f);
+        meshlet.ConeCutoff = 1.0f;
+        meshlet.uFirstIndex = uFirstIndex;
+        meshlet.uNumIndices = uNumIndices;
+
+        if (XMVectorGetX(XMVector3LengthSq(normalSum)) > 0.0f)
+        {
+            const XMVECTOR axis = XMVector3Normalize(normalSum);
+
+            FLOAT minCosine = 1.0f;
+            for (UINT i = uFirstIndex; i < uFirstIndex + uNumIndices; i += 3u)
+            {
+                const XMVECTOR p0 = XMLoadFloat3(&aVertices[aIndices[i]].Position);
+                const XMVECTOR normal = XMVector3Cross(
+                    XMVectorSubtract(XMLoadFloat3(&aVertices[aIndices[i + 1u]].Position), p0),
+                    XMVectorSubtract(XMLoadFloat3(&aVertices[aIndices[i + 2u]].Position), p0)
+                );
+                if (XMVectorGetX(XMVector3LengthSq(normal)) > 0.0f)
+                {
+                    minCosine = fminf(minCosine, XMVectorGetX(XMVector3Dot(XMVector3Normalize(normal), axis)));
+                }
+            }
+
+            if (minCosine > 0.0f)
+            {
+                XMStoreFloat3(&meshlet.ConeAxis, axis);
+                meshlet.ConeCutoff = sqrtf(fmaxf(1.0f - minCosine * minCosine, 0.0f));
+            }
+        }
+
+        aOutMeshlets.push_back(meshlet);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshletCuller::IsBackFacing
+
+      Summary:  Returns whether every triangle of a meshlet faces away
+                from a point. A triangle faces away when the direction
+                from the point to it is within 90 degrees of its
+                normal. The direction to any point of the sphere is
+                within 90 degrees of every normal of the cone when its
+                projection on the axis is at least the sine of the
+                cone angle times its length, which is tested for the
+                worst point of the sphere.
+
+      Args:     const Meshlet& meshlet
+                  Meshlet to test
+                FXMVECTOR eye
+                  Point the meshlet is viewed from, in the space of the
+                  meshlet
+
+      Returns:  BOOL
+                  TRUE if no triangle of the meshlet can face the point
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL MeshletCuller::IsBackFacing(
+        _In_ const Meshlet& meshlet,
+        _In_ FXMVECTOR eye
+    )
+    {
+        if (meshlet.ConeCutoff >= 1.0f)
+        {
+            return FALSE;
+        }
+
+        const XMVECTOR toCenter = XMVectorSubtract(XMLoadFloat3(&meshlet.Center), eye);
+        const FLOAT distance = XMVectorGetX(XMVector3Length(toCenter));
+        const FLOAT projection = XMVectorGetX(XMVector3Dot(toCenter, XMLoadFloat3(&meshlet.ConeAxis)));
+
+        return projection >= meshlet.ConeCutoff * (distance + meshlet.Radius) + meshlet.Radius;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshletCuller::MeshletCuller
+
+      Summary:  Constructor, every mesh is drawn whole until a
+                viewpoint is set
+
+      Modifies: [m_frustum, m_eye, m_bHasViewpoint].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    MeshletCuller::MeshletCuller()
+        : m_frustum()
+        , m_eye(0.0f, 0.0f, 0.0f)
+        , m_bHasViewpoint(FALSE)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshletCuller::SetViewpoint
+
+      Summary:  Sets the camera the meshlets are culled for and builds
+                its frustum in world space
+
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                const XMMATRIX& view
+                  View matrix of the camera
+                const XMMATRIX& projection
+                  Perspective projection matrix of the camera
+
+      Modifies: [m_frustum, m_eye, m_bHasViewpoint].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshletCuller::SetViewpoint(
+        _In_ const XMVECTOR& eye,
+        _In_ const XMMATRIX& view,
+        _In_ const XMMATRIX& projection
+    )
+    {
+        BoundingFrustum viewFrustum(projection);
+        viewFrustum.Transform(m_frustum, XMMatrixInverse(nullptr, view));
+
+        XMStoreFloat3(&m_eye, eye);
+        m_bHasViewpoint = TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   MeshletCuller::Cull
+
+      Summary:  Appends the index ranges of the meshlets of a mesh that
+                are in the view frustum and not back facing. Meshlets
+                next to each other in the index stream share a range.
+                The whole mesh is appended when no viewpoint is set,
+                the mesh has no meshlets or the world matrix scales the
+                axes differently, which would skew the spheres and the
+                cones.
+
+      Args:     const Meshlet* aMeshlets
+                  Meshlets of the mesh
+                UINT uNumMeshlets
+                  Number of meshlets of the mesh
+                const BasicMeshEntry& mesh
+                  Mesh the meshlets index into
+                const XMMATRIX& world
+                  World matrix of the mesh, with a uniform scale
+                std::vector<BasicMeshEntry>& aOutVisibleMeshes
+                  Ranges the visible ranges are appended to
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void MeshletCuller::Cull(
+        _In_reads_(uNumMeshlets) const Meshlet* aMeshlets,
+        _In_ UINT uNumMeshlets,
+        _In_ const Renderable::BasicMeshEntry& mesh,
+        _In_ const XMMATRIX& world,
+        _Inout_ std::vector<Renderable::BasicMeshEntry>& aOutVisibleMeshes
+    ) const
+    {
+        const FLOAT scaleX = XMVectorGetX(XMVector3LengthSq(world.r[0]));
+        const FLOAT scaleY = XMVectorGetX(XMVector3LengthSq(world.r[1]));
+        const FLOAT scaleZ = XMVectorGetX(XMVector3LengthSq(world.r[2]));
+        const FLOAT maxScale = fmaxf(scaleX, fmaxf(scaleY, scaleZ));
+        const FLOAT minScale = fminf(scaleX, fminf(scaleY, scaleZ));
+
+        if (!m_bHasViewpoint || uNumMeshlets == 0u || minScale < maxScale * (1.0f - UNIFORM_SCALE_TOLERANCE))
+        {
+            aOutVisibleMeshes.push_back(mesh);
+            return;
+        }
+
+        const XMMATRIX inverseWorld = XMMatrixInverse(nullptr, world);
+        BoundingFrustum frustum;
+        m_frustum.Transform(frustum, inverseWorld);
+        const XMVECTOR eye = XMVector3Transform(XMLoadFloat3(&m_eye), inverseWorld);
+
+        const size_t uFirstRange = aOutVisibleMeshes.size();
+        for (UINT m = 0u; m < uNumMeshlets; ++m)
+        {
+            const Meshlet& meshlet = aMeshlets[m];
+            if (frustum.Contains(BoundingSphere(meshlet.Center, meshlet.Radius)) == DISJOINT || IsBackFacing(meshlet, eye))
+            {
+                continue;
+            }
+
+            const UINT uBaseIndex = mesh.uBaseIndex + meshlet.uFirstIndex;
+            if (aOutVisibleMeshes.size() > uFirstRange)
+            {
+                Renderable::BasicMeshEntry& lastRange = aOutVisibleMeshes.back();
+                if (lastRange.uBaseIndex + lastRange.uNumIndices == uBaseIndex)
+                {
+                    lastRange.uNumIndices += meshlet.uNumIndices;
+                    continue;
+                }
+            }
+
+            Renderable::BasicMeshEntry range = mesh;
+            range.uBaseIndex = uBaseIndex;
+            range.uNumIndices = meshlet.uNumIndices;
+            aOutVisibleMeshes.push_back(range);
+        }
+    }
+}
@@ -0,0 +1,188 @@
+/*+===================================================================
+  File:      MESHLET.H
+
+  Summary:   Meshlet header file contains declarations of
+             MeshletBuilder class that splits the triangles of a mesh
+             into small clusters with their bounds, and of
+             MeshletCuller class that keeps the clusters a camera can
+             see.
+
+  Classes: MeshletBuilder, MeshletCuller
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+#include "Renderer/Renderable.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   Meshlet
+
+      Summary:  Consecutive triangles of a mesh with the sphere that
+                bounds them and the cone that bounds their normals. The
+                cone cutoff is the sine of its half angle, 1 when the
+                normals are spread over more than a half sphere and the
+                cluster always has a triangle facing the camera. The
+                first index is relative to the first index of the mesh.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct Meshlet
+    {
+        XMFLOAT3 Center;
+        FLOAT Radius;
+        XMFLOAT3 ConeAxis;
+        FLOAT ConeCutoff;
+        UINT uFirstIndex;
+        UINT uNumIndices;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   MeshletStats
+
+      Summary:  Result of the checks of the meshlets of a mesh. The
+                culled triangles are counted over the six views from
+                outside of the mesh along the axes, a wrongly culled
+                triangle is one that faces such a view.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct MeshletStats
+    {
+        UINT uNumMeshlets;
+        UINT uNumVertices;
+        UINT uNumTriangles;
+        UINT uNumCones;
+        UINT uNumViewedTriangles;
+        UINT uNumCulledTriangles;
+        UINT uNumWronglyCulledTriangles;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MeshletBuilder
+
+      Summary:  Splits the indices of one mesh at a time, the indices
+                are relative to the first vertex of the mesh. The
+                triangles are taken in their order, which is already
+                sorted for the vertex cache, and a meshlet ends when
+                the next triangle would bring it past MAX_VERTICES
+                vertices or MAX_TRIANGLES triangles. The triangles are
+                not moved, every meshlet is a range of the indices of
+                the mesh.
+
+      Methods:  Build
+                  Appends the meshlets of a mesh
+                Analyze
+                  Checks the meshlets of a mesh and measures the cone
+                  culling
+                MeshletBuilder
+                  Constructor.
+                ~MeshletBuilder
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MeshletBuilder
+    {
+    public:
+        static constexpr const UINT MAX_VERTICES = 64u;
+        static constexpr const UINT MAX_TRIANGLES = 124u;
+
+    public:
+        MeshletBuilder();
+        MeshletBuilder(const MeshletBuilder& other) = delete;
+        MeshletBuilder(MeshletBuilder&& other) = delete;
+        MeshletBuilder& operator=(const MeshletBuilder& other) = delete;
+        MeshletBuilder& operator=(MeshletBuilder&& other) = delete;
+        virtual ~MeshletBuilder() = default;
+
+        void Build(
+            _In_ const std::vector<UINT>& aIndices,
+            _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+            _In_ UINT uNumVertices,
+            _Inout_ std::vector<Meshlet>& aOutMeshlets
+        );
+        BOOL Analyze(
+            _In_reads_(uNumMeshlets) const Meshlet* aMeshlets,
+            _In_ UINT uNumMeshlets,
+            _In_ const std::vector<UINT>& aIndices,
+            _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+            _In_ UINT uNumVertices,
+            _Inout_ MeshletStats& stats
+        );
+
+    protected:
+        void finishMeshlet(
+            _In_ const std::vector<UINT>& aIndices,
+            _In_ UINT uFirstIndex,
+            _In_ UINT uNumIndices,
+            _In_ const SimpleVertex* aVertices,
+            _Inout_ std::vector<Meshlet>& aOutMeshlets
+        );
+
+    protected:
+        static constexpr const UINT INVALID_MESHLET = (0xFFFFFFFF);
+        // Slack of the bounds checks for the rounding of the positions
+        static constexpr const FLOAT BOUNDS_TOLERANCE = 1e-4f;
+
+    protected:
+        std::vector<UINT> m_aVertexMeshlets;
+        std::vector<XMFLOAT3> m_aPoints;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    MeshletCuller
+
+      Summary:  Keeps the meshlets that are in the view frustum and
+                have a triangle that may face the camera. The camera is
+                moved into the space of the mesh instead of moving
+                every meshlet into the world, which holds for world
+                matrices with a uniform scale, other meshes are drawn
+                whole. The meshlets left are merged into as few index
+                ranges as possible.
+
+      Methods:  IsBackFacing
+                  Returns whether every triangle of a meshlet faces
+                  away from a point
+                SetViewpoint
+                  Sets the camera the meshlets are culled for
+                Cull
+                  Appends the index ranges of the visible meshlets of
+                  a mesh
+                MeshletCuller
+                  Constructor.
+                ~MeshletCuller
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class MeshletCuller
+    {
+    public:
+        static BOOL IsBackFacing(_In_ const Meshlet& meshlet, _In_ FXMVECTOR eye);
+
+    public:
+        MeshletCuller();
+        MeshletCuller(const MeshletCuller& other) = delete;
+        MeshletCuller(MeshletCuller&& other) = delete;
+        MeshletCuller& operator=(const MeshletCuller& other) = delete;
+        MeshletCuller& operator=(MeshletCuller&& other) = delete;
+        virtual ~MeshletCuller() = default;
+
+        void SetViewpoint(_In_ const XMVECTOR& eye, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection);
+
+        void Cull(
+            _In_reads_(uNumMeshlets) const Meshlet* aMeshlets,
+            _In_ UINT uNumMeshlets,
+            _In_ const Renderable::BasicMeshEntry& mesh,
+            _In_ const XMMATRIX& world,
+            _Inout_ std::vector<Renderable::BasicMeshEntry>& aOutVisibleMeshes
+        ) const;
+
+    protected:
+        // Relative difference of the squared scales of the world axes below which the scale counts as uniform
+        static constexpr const FLOAT UNIFORM_SCALE_TOLERANCE = 1e-3f;
+
+    protected:
+        BoundingFrustum m_frustum;
+        XMFLOAT3 m_eye;
+        BOOL m_bHasViewpoint;
+    };
+}
@@ -4,6 +4,10 @@
 #include "assimp/scene.h"		// output data structure
 #include "assimp/postprocess.h"	// post processing flags
 
+#include <psapi.h>
+
+#include <algorithm>
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -69,7 +73,238 @@ namespace library
         return XMLoadFloat4(&float4);
     }
 
-    std::unique_ptr<Assimp::Importer> Model::sm_pImporter = std::make_unique<Assimp::Importer>();
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: AdvanceKeyIndex
+
+      Summary:  Finds the last key at or before the animation time,
+                starting from the key found for the previous sample.
+                The channels are resampled in time order, so the key
+                only moves forward and every key is visited once.
+
+      Args:     const Key* aKeys
+                  Keys sorted by time
+                UINT uNumKeys
+                  Number of keys, at least two
+                FLOAT animationTimeTicks
+                  Animation time, not before the previous sample
+                UINT uKey
+                  Key found for the previous sample
+
+      Returns:  UINT
+                  Index of the key, the one before the last key when
+                  the time is past it
+    -----------------------------------------------------------------F-F*/
+
+    template <class Key>
+    static UINT AdvanceKeyIndex(
+        _In_reads_(uNumKeys) const Key* aKeys,
+        _In_ UINT uNumKeys,
+        _In_ FLOAT animationTimeTicks,
+        _In_ UINT uKey
+    )
+    {
+        while (uKey + 2u < uNumKeys && static_cast<FLOAT>(aKeys[uKey + 1u].mTime) <= animationTimeTicks)
+        {
+            ++uKey;
+        }
+
+        return uKey;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SampleVectorKeys
+
+      Summary:  Interpolates the position or scaling keys of a channel
+                linearly at the animation time
+
+      Args:     const aiVectorKey* aKeys
+                  Keys sorted by time
+                UINT uNumKeys
+                  Number of keys
+                FLOAT animationTimeTicks
+                  Animation time, not before the previous sample
+                UINT& uKey
+                  Key found for the previous sample, advanced to the
+                  key before the time
+
+      Returns:  XMFLOAT3
+                  Interpolated vector
+    -----------------------------------------------------------------F-F*/
+
+    static XMFLOAT3 SampleVectorKeys(
+        _In_reads_(uNumKeys) const aiVectorKey* aKeys,
+        _In_ UINT uNumKeys,
+        _In_ FLOAT animationTimeTicks,
+        _Inout_ UINT& uKey
+    )
+    {
+        assert(uNumKeys > 0u);
+
+        if (uNumKeys == 1u)
+        {
+            return ConvertVector3dToFloat3(aKeys[0].mValue);
+        }
+
+        uKey = AdvanceKeyIndex(aKeys, uNumKeys, animationTimeTicks, uKey);
+
+        const FLOAT t1 = static_cast<FLOAT>(aKeys[uKey].mTime);
+        const FLOAT t2 = static_cast<FLOAT>(aKeys[uKey + 1u].mTime);
+
+        // Times before the first key or after the last one hold that key
+        const FLOAT factor = fminf(fmaxf((animationTimeTicks - t1) / (t2 - t1), 0.0f), 1.0f);
+
+        const aiVector3D& start = aKeys[uKey].mValue;
+        const aiVector3D& end = aKeys[uKey + 1u].mValue;
+        return ConvertVector3dToFloat3(start + factor * (end - start));
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SampleQuaternionKeys
+
+      Summary:  Interpolates the rotation keys of a channel spherically
+                at the animation time
+
+      Args:     const aiQuatKey* aKeys
+                  Keys sorted by time
+                UINT uNumKeys
+                  Number of keys
+                FLOAT animationTimeTicks
+                  Animation time, not before the previous sample
+                UINT& uKey
+                  Key found for the previous sample, advanced to the
+                  key before the time
+
+      Returns:  XMVECTOR
+                  Normalized quaternion
+    -----------------------------------------------------------------F-F*/
+
+    static XMVECTOR SampleQuaternionKeys(
+        _In_reads_(uNumKeys) const aiQuatKey* aKeys,
+        _In_ UINT uNumKeys,
+        _In_ FLOAT animationTimeTicks,
+        _Inout_ UINT& uKey
+    )
+    {
+        assert(uNumKeys > 0u);
+
+        if (uNumKeys == 1u)
+        {
+            return ConvertQuaternionToVector(aKeys[0].mValue);
+        }
+
+        uKey = AdvanceKeyIndex(aKeys, uNumKeys, animationTimeTicks, uKey);
+
+        const FLOAT t1 = static_cast<FLOAT>(aKeys[uKey].mTime);
+        const FLOAT t2 = static_cast<FLOAT>(aKeys[uKey + 1u].mTime);
+
+        // Times before the first key or after the last one hold that key
+        const FLOAT factor = fminf(fmaxf((animationTimeTicks - t1) / (t2 - t1), 0.0f), 1.0f);
+
+        aiQuaternion rotation;
+        aiQuaternion::Interpolate(rotation, aKeys[uKey].mValue, aKeys[uKey + 1u].mValue, factor);
+        rotation.Normalize();
+        return ConvertQuaternionToVector(rotation);
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: FindSmallestKeyInterval
+
+      Summary:  Returns the shortest time between two consecutive keys
+
+      Args:     const Key* aKeys
+                  Keys sorted by time
+                UINT uNumKeys
+                  Number of keys
+                FLOAT interval
+                  Shortest time found so far
+
+      Returns:  FLOAT
+                  Shortest time between two keys
+    -----------------------------------------------------------------F-F*/
+
+    template <class Key>
+    static FLOAT FindSmallestKeyInterval(
+        _In_reads_(uNumKeys) const Key* aKeys,
+        _In_ UINT uNumKeys,
+        _In_ FLOAT interval
+    )
+    {
+        for (UINT i = 1u; i < uNumKeys; ++i)
+        {
+            FLOAT keyInterval = static_cast<FLOAT>(aKeys[i].mTime - aKeys[i - 1u].mTime);
+            if (keyInterval > 0.0f)
+            {
+                interval = fminf(interval, keyInterval);
+            }
+        }
+
+        return interval;
+    }
+
+    // Changes whenever a struct stored in the model cache changes size, which makes the old caches stale
+    static constexpr const UINT MODEL_CACHE_LAYOUT = static_cast<UINT>(
+        sizeof(SimpleVertex)
+        ^ (sizeof(NormalData) << 5)
+        ^ (sizeof(AnimationData) << 10)
+        ^ (sizeof(Renderable::BasicMeshEntry) << 15)
+        ^ (sizeof(SkeletonNode) << 20)
+        ^ (sizeof(Meshlet) << 25)
+    );
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: RemapVertices
+
+      Summary:  Moves the vertices of a mesh to their new positions
+
+      Args:     std::vector<Vertex>& aVertices
+                  Per-vertex data of every mesh
+                size_t uBaseVertex
+                  First vertex of the mesh
+                const std::vector<UINT>& aRemap
+                  New position of every vertex of the mesh, relative to
+                  its first vertex
+    -----------------------------------------------------------------F-F*/
+
+    template <class Vertex>
+    static void RemapVertices(
+        _Inout_ std::vector<Vertex>& aVertices,
+        _In_ size_t uBaseVertex,
+        _In_ const std::vector<UINT>& aRemap
+    )
+    {
+        std::vector<Vertex> aMeshVertices(aVertices.begin() + uBaseVertex, aVertices.begin() + uBaseVertex + aRemap.size());
+        for (size_t i = 0u; i < aRemap.size(); ++i)
+        {
+            aVertices[uBaseVertex + aRemap[i]] = aMeshVertices[i];
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetWorkingSetSize
+
+      Summary:  Returns the memory of the process resident in RAM
+
+      Returns:  size_t
+                  Working set in bytes, 0 if it could not be queried
+    -----------------------------------------------------------------F-F*/
+
+    static size_t GetWorkingSetSize()
+    {
+        PROCESS_MEMORY_COUNTERS counters = { .cb = sizeof(PROCESS_MEMORY_COUNTERS) };
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return 0u;
+        }
+
+        return counters.WorkingSetSize;
+    }
+
+    std::unordered_map<std::wstring, std::shared_future<std::weak_ptr<ModelAsset>>> Model::sm_assetCache;
+    std::mutex Model::sm_assetCacheMutex;
+    std::mutex Model::sm_immediateContextMutex;
+    std::mutex Model::sm_reportMutex;
+    FLOAT Model::sm_accumulatedUpdateTime = 0.0f;
+    UINT Model::sm_uNumUpdates = 0u;
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Model
@@ -78,49 +313,73 @@ namespace library
 
       Args:     const std::filesystem::path& filePath
                   Path to the model to load
-
-      Modifies: [m_filePath, m_animationBuffer, m_skinningConstantBuffer,
-                 m_skinningConstantBuffer, m_aVertices, m_aAnimationData,
-                 m_aIndices, m_aBoneData, m_aBoneInfo, m_aTransforms,
-                 m_aBoneInfo, m_aTransforms, m_boneNameToIndexMap,
-                 m_pScene, m_timeSinceLoaded, m_globalInverseTransform].
+                eSkinningMode skinningMode
+                  How the bones of a vertex are blended, it decides
+                  the layout of the bone transforms buffer
+
+      Modifies: [m_filePath, m_asset, m_pJobSystem,
+                 m_boneTransformsBuffer, m_boneTransformsView,
+                 m_aBoneData, m_aBoneInfo,
+                 m_aGlobalTransforms, m_aBoneTransforms,
+                 m_aBoneDualQuaternions, m_skinningMode,
+                 m_animationLod, m_aPreviousKeyBoneTransforms,
+                 m_aNextKeyBoneTransforms,
+                 m_aPreviousKeyBoneDualQuaternions,
+                 m_aNextKeyBoneDualQuaternions, m_uKeyPoseFrame,
+                 m_uKeyPoseInterval, m_uMeshLod, m_aVisibleMeshes,
+                 m_timeSinceLoaded, m_uBoneTransformsVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     Model::Model(
-        _In_ const std::filesystem::path& filePath
+        _In_ const std::filesystem::path& filePath,
+        _In_opt_ eSkinningMode skinningMode
     )
         : Renderable(XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f))
         , m_filePath(filePath)
+        , m_asset(nullptr)
+        , m_pJobSystem(nullptr)
 
-        , m_animationBuffer(nullptr)
-        , m_skinningConstantBuffer(nullptr)
+        , m_boneTransformsBuffer(nullptr)
+        , m_boneTransformsView(nullptr)
 
-        , m_aVertices(std::vector<SimpleVertex>())
-        , m_aAnimationData(std::vector<AnimationData>())
-        , m_aIndices(std::vector<WORD>())
         , m_aBoneData(std::vector<VertexBoneData>())
         , m_aBoneInfo(std::vector<BoneInfo>())
-        , m_aTransforms(std::vector<XMMATRIX>())
-        , m_boneNameToIndexMap(std::unordered_map<std::string, UINT>())
+        , m_aGlobalTransforms(std::vector<XMMATRIX>())
+        , m_aBoneTransforms(std::vector<XMFLOAT3X4A>())
+        , m_aBoneDualQuaternions(std::vector<DualQuaternion>())
+        , m_skinningMode(skinningMode)
+
+        , m_animationLod(AnimationLodSelector::GetLod(eAnimationLod::FULL))
+        , m_aPreviousKeyBoneTransforms(std::vector<XMFLOAT3X4A>())
+        , m_aNextKeyBoneTransforms(std::vector<XMFLOAT3X4A>())
+        , m_aPreviousKeyBoneDualQuaternions(std::vector<DualQuaternion>())
+        , m_aNextKeyBoneDualQuaternions(std::vector<DualQuaternion>())
+        , m_uKeyPoseFrame(0u)
+        , m_uKeyPoseInterval(0u)
+        , m_uMeshLod(0u)
+        , m_aVisibleMeshes(std::vector<BasicMeshEntry>())
 
-        , m_pScene(nullptr)
         , m_timeSinceLoaded(0.0f)
-        , m_globalInverseTransform(XMMatrixIdentity())
+        , m_uBoneTransformsVersion(1u)
     {
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Initialize
 
-      Summary:  Load and initialize the 3d model and create buffers
+      Summary:  Shares the asset of the model file with the instances
+                already loaded, or loads it, and creates the buffers of
+                the instance
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
                 ID3D11DeviceContext* pImmediateContext
                   The Direct3D context to set buffers
 
-      Modifies: [m_pScene, m_globalInverseTransform, m_animationBuffer,
-                 m_skinningConstantBuffer].
+      Modifies: [sm_assetCache, m_asset, m_aGlobalTransforms,
+                 m_aVisibleMeshes, m_aBoneTransforms,
+                 m_aBoneDualQuaternions, m_boneTransformsBuffer,
+                 m_boneTransformsView].
 
       Returns:  HRESULT
                   Status code
@@ -133,79 +392,180 @@ namespace library
     {
         HRESULT hr = S_OK;
 
-        // Create the buffers for the vertices attributes
-        m_pScene = sm_pImporter->ReadFile(m_filePath.string().c_str(), ASSIMP_LOAD_FLAGS);
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
 
-        if (m_pScene)
+        if (isAssetShared())
         {
-            XMMATRIX transform = ConvertMatrix(m_pScene->mRootNode->mTransformation);
-            XMVECTOR det = XMMatrixDeterminant(transform);
-            m_globalInverseTransform = XMMatrixInverse(&det, transform);
-            hr = initFromScene(pDevice, pImmediateContext, m_pScene, m_filePath);
-            if (FAILED(hr))
+            // Every file has its own entry, a future the first instance to miss fulfills once it has
+            // loaded the asset. The cache is only locked to find or replace the entry, so files load
+            // side by side and the other instances of a file only wait for that file.
+            const std::wstring szPath = m_filePath.wstring();
+            while (!m_asset)
             {
-                return hr;
+                std::promise<std::weak_ptr<ModelAsset>> loadedAsset;
+                std::shared_future<std::weak_ptr<ModelAsset>> cachedAsset;
+                BOOL bLoad = FALSE;
+                {
+                    std::lock_guard<std::mutex> lock(sm_assetCacheMutex);
+
+                    auto it = sm_assetCache.find(szPath);
+                    if (it == sm_assetCache.end()
+                        || (it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready && it->second.get().expired()))
+                    {
+                        sm_assetCache[szPath] = loadedAsset.get_future().share();
+                        bLoad = TRUE;
+                    }
+                    else
+                    {
+                        cachedAsset = it->second;
+                    }
+                }
+
+                if (bLoad)
+                {
+                    hr = loadAsset(pDevice, pImmediateContext);
+
+                    // A failed load leaves an expired entry, the next instance tries again
+                    loadedAsset.set_value(SUCCEEDED(hr) ? m_asset : std::shared_ptr<ModelAsset>());
+                    if (FAILED(hr))
+                    {
+                        return hr;
+                    }
+                }
+                else
+                {
+                    // The asset expires when the load failed or its last instance released it in the
+                    // meantime, the entry is replaced by the next pass then
+                    m_asset = cachedAsset.get().lock();
+                    if (m_asset)
+                    {
+                        hr = initFromAsset(pDevice);
+                    }
+                }
             }
         }
         else
         {
-            OutputDebugString(L"Error parsing ");
-            OutputDebugString(m_filePath.c_str());
-            OutputDebugString(L": ");
-            OutputDebugStringA(sm_pImporter->GetErrorString());
-            OutputDebugString(L"\n");
+            hr = loadAsset(pDevice, pImmediateContext);
+        }
+        if (FAILED(hr))
+        {
+            return hr;
+        }
 
-            return E_FAIL;
+        m_aGlobalTransforms.resize(m_asset->aSkeleton.size());
+
+        // Every mesh is drawn whole until its meshlets are culled
+        m_aVisibleMeshes = m_aMeshes;
+
+        // Only the bones of the model are uploaded, either three rows of their transposed transform
+        // or the two parts of their dual quaternion each
+        const UINT uNumBones = static_cast<UINT>(m_asset->boneNameToIndexMap.empty() ? 1u : m_asset->boneNameToIndexMap.size());
+
+        const void* pBoneData = nullptr;
+        UINT uNumBoneBytes = 0u;
+        if (m_skinningMode == eSkinningMode::DUAL_QUATERNION)
+        {
+            DualQuaternion identity;
+            storeDualQuaternion(identity, XMMatrixIdentity());
+            m_aBoneDualQuaternions.assign(uNumBones, identity);
+
+            pBoneData = m_aBoneDualQuaternions.data();
+            uNumBoneBytes = static_cast<UINT>(sizeof(DualQuaternion) * m_aBoneDualQuaternions.size());
+        }
+        else
+        {
+            XMFLOAT3X4A identity;
+            XMStoreFloat3x4A(&identity, XMMatrixIdentity());
+            m_aBoneTransforms.assign(uNumBones, identity);
+
+            pBoneData = m_aBoneTransforms.data();
+            uNumBoneBytes = static_cast<UINT>(sizeof(XMFLOAT3X4A) * m_aBoneTransforms.size());
         }
 
-        // Create the animation vertex buffer
         D3D11_BUFFER_DESC bd =
         {
-            .ByteWidth = static_cast<UINT>(sizeof(AnimationData) * m_aAnimationData.size()),
-            .Usage = D3D11_USAGE_DEFAULT,
-            .BindFlags = D3D11_BIND_VERTEX_BUFFER,
-            .CPUAccessFlags = 0u,
+            .ByteWidth = uNumBoneBytes,
+            .Usage = D3D11_USAGE_DYNAMIC,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
             .MiscFlags = 0u
         };
 
         D3D11_SUBRESOURCE_DATA initData =
         {
-            .pSysMem = m_aAnimationData.data(),
+            .pSysMem = pBoneData,
             .SysMemPitch = 0u,
             .SysMemSlicePitch = 0u
         };
 
-        hr = pDevice->CreateBuffer(&bd, &initData, m_animationBuffer.GetAddressOf());
+        hr = pDevice->CreateBuffer(&bd, &initData, m_boneTransformsBuffer.GetAddressOf());
         if (FAILED(hr))
         {
             return hr;
         }
 
-        // Create the skinning constant buffer
-        bd.ByteWidth = sizeof(CBSkinning);
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        bd.CPUAccessFlags = 0u;
-        bd.MiscFlags = 0u;
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc =
+        {
+            .Format = DXGI_FORMAT_R32G32B32A32_FLOAT,
+            .ViewDimension = D3D11_SRV_DIMENSION_BUFFER,
+            .Buffer =
+            {
+                .FirstElement = 0u,
+                .NumElements = uNumBoneBytes / static_cast<UINT>(sizeof(XMFLOAT4))
+            }
+        };
 
-        hr = pDevice->CreateBuffer(&bd, nullptr, m_skinningConstantBuffer.GetAddressOf());
+        hr = pDevice->CreateShaderResourceView(m_boneTransformsBuffer.Get(), &srvDesc, m_boneTransformsView.GetAddressOf());
         if (FAILED(hr))
         {
             return hr;
         }
 
+        QueryPerformanceCounter(&endTime);
+        reportLoad(static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart));
+
+        // Dual quaternions drop the scaling of the bones, check that the animation has none to lose
+        if (m_skinningMode == eSkinningMode::DUAL_QUATERNION && m_asset->bHasAnimation)
+        {
+            WCHAR szMessage[256];
+            swprintf_s(
+                szMessage,
+                L": dual quaternions differ from the bone matrices by at most %f over %u poses\n",
+                measureDualQuaternionError(NUM_DUAL_QUATERNION_TEST_POSES),
+                NUM_DUAL_QUATERNION_TEST_POSES
+            );
+
+            OutputDebugString(L"Model ");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(szMessage);
+        }
+
         return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::Update
 
-      Summary:  Update bone transformations
+      Summary:  Update bone transformations. Depending on the
+                animation level of detail, the pose is evaluated every
+                frame, or evaluated for the end of the update interval
+                and blended from the pose on screen until then, or
+                kept as it is.
 
       Args:     FLOAT deltaTime
                   Time difference of a frame
 
-      Modifies: [m_aTransforms].
+      Modifies: [m_aGlobalTransforms, m_aBoneTransforms,
+                 m_aBoneDualQuaternions, m_aPreviousKeyBoneTransforms,
+                 m_aNextKeyBoneTransforms,
+                 m_aPreviousKeyBoneDualQuaternions,
+                 m_aNextKeyBoneDualQuaternions, m_uKeyPoseFrame,
+                 m_uKeyPoseInterval, m_uBoneTransformsVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Model::Update(
@@ -214,24 +574,97 @@ namespace library
     {
         m_timeSinceLoaded += deltaTime;
 
-        if (m_pScene->HasAnimations())
+        if (m_animationLod.uUpdateInterval == 0u)
         {
-            FLOAT ticksPerSecond = static_cast<FLOAT>(m_pScene->mAnimations[0]->mTicksPerSecond != 0.0 ? m_pScene->mAnimations[0]->mTicksPerSecond : 25.0f);
-            FLOAT timeInTicks = m_timeSinceLoaded * ticksPerSecond;
-            FLOAT animationTimeTicks = fmod(timeInTicks, static_cast<FLOAT>(m_pScene->mAnimations[0]->mDuration));
+            // A frozen model keeps its palette and version, so it isn't uploaded again either,
+            // and blends from that palette once it thaws
+            m_uKeyPoseFrame = 0u;
+            m_uKeyPoseInterval = 0u;
+            return;
+        }
 
-            if (m_pScene->mRootNode)
+        if (m_asset->bHasAnimation)
+        {
+            LARGE_INTEGER frequency;
+            LARGE_INTEGER startTime;
+            LARGE_INTEGER endTime;
+            QueryPerformanceFrequency(&frequency);
+            QueryPerformanceCounter(&startTime);
+
+            FLOAT ticksPerSecond = m_asset->TicksPerSecond;
+            FLOAT durationTicks = m_asset->DurationTicks;
+            FLOAT animationTimeTicks = fmod(m_timeSinceLoaded * ticksPerSecond, durationTicks);
+
+            // The first pose has nothing on screen to blend from
+            const BOOL bBlend = m_animationLod.uUpdateInterval > 1u && m_uBoneTransformsVersion > 1u;
+            if (!bBlend)
+            {
+                if (m_skinningMode == eSkinningMode::DUAL_QUATERNION)
+                {
+                    evaluatePose(animationTimeTicks, m_animationLod.bSkipLeafBones, m_aGlobalTransforms, m_aBoneDualQuaternions.data());
+                }
+                else
+                {
+                    evaluatePose(animationTimeTicks, m_animationLod.bSkipLeafBones, m_aGlobalTransforms, m_aBoneTransforms.data());
+                }
+                m_uKeyPoseFrame = 0u;
+                m_uKeyPoseInterval = 0u;
+            }
+            else
             {
-                readNodeHierarchy(animationTimeTicks, m_pScene->mRootNode, XMMatrixIdentity());
-                m_aTransforms.resize(m_aBoneInfo.size());
-                for (UINT i = 0u; i < m_aTransforms.size(); ++i)
+                if (m_uKeyPoseFrame >= m_uKeyPoseInterval)
                 {
-                    m_aTransforms[i] = m_aBoneInfo[i].FinalTransformation;
+                    // The next key pose is the one due at the last frame of the interval,
+                    // assuming the frame time stays the same
+                    const FLOAT keyTimeTicks = fmod((m_timeSinceLoaded + static_cast<FLOAT>(m_animationLod.uUpdateInterval - 1u) * deltaTime) * ticksPerSecond, durationTicks);
+
+                    if (m_skinningMode == eSkinningMode::DUAL_QUATERNION)
+                    {
+                        m_aPreviousKeyBoneDualQuaternions = m_aBoneDualQuaternions;
+                        m_aNextKeyBoneDualQuaternions.resize(m_aBoneDualQuaternions.size());
+                        evaluatePose(keyTimeTicks, m_animationLod.bSkipLeafBones, m_aGlobalTransforms, m_aNextKeyBoneDualQuaternions.data());
+                    }
+                    else
+                    {
+                        m_aPreviousKeyBoneTransforms = m_aBoneTransforms;
+                        m_aNextKeyBoneTransforms.resize(m_aBoneTransforms.size());
+                        evaluatePose(keyTimeTicks, m_animationLod.bSkipLeafBones, m_aGlobalTransforms, m_aNextKeyBoneTransforms.data());
+                    }
+                    m_uKeyPoseFrame = 0u;
+                    m_uKeyPoseInterval = m_animationLod.uUpdateInterval;
                 }
+
+                ++m_uKeyPoseFrame;
+                blendKeyPoses(static_cast<FLOAT>(m_uKeyPoseFrame) / static_cast<FLOAT>(m_uKeyPoseInterval));
             }
+            ++m_uBoneTransformsVersion;
+
+            QueryPerformanceCounter(&endTime);
+            reportUpdate(static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart));
         }
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::SetJobSystem
+
+      Summary:  Sets the job system the loading of the model file is
+                spread over. It is only used by Initialize and has to
+                live until Initialize returns.
+
+      Args:     JobSystem* pJobSystem
+                  Job system of the owner of the model, or nullptr to
+                  load on the calling thread
+
+      Modifies: [m_pJobSystem].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::SetJobSystem(
+        _In_opt_ JobSystem* pJobSystem
+    )
+    {
+        m_pJobSystem = pJobSystem;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Model::GetAnimationBuffer
 
@@ -242,20 +675,33 @@ namespace library
 
     ComPtr<ID3D11Buffer>& Model::GetAnimationBuffer()
     {
-        return m_animationBuffer;
+        return m_asset->AnimationBuffer;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::GetSkinningConstantBuffer
+      Method:   Model::GetBoneTransformsBuffer
 
-      Summary:  Returns the skinning constant buffer
+      Summary:  Returns the dynamic buffer of the bone transforms
 
       Returns:  ComPtr<ID3D11Buffer>&
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    ComPtr<ID3D11Buffer>& Model::GetSkinningConstantBuffer()
+    ComPtr<ID3D11Buffer>& Model::GetBoneTransformsBuffer()
+    {
+        return m_boneTransformsBuffer;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetBoneTransformsView
+
+      Summary:  Returns the shader resource view of the bone transforms
+
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ComPtr<ID3D11ShaderResourceView>& Model::GetBoneTransformsView()
     {
-        return m_skinningConstantBuffer;
+        return m_boneTransformsView;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -269,7 +715,7 @@ namespace library
 
     UINT Model::GetNumVertices() const
     {
-        return static_cast<UINT>(m_aVertices.size());
+        return static_cast<UINT>(m_asset->aVertices.size());
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -283,939 +729,2815 @@ namespace library
 
     UINT Model::GetNumIndices() const
     {
-        return static_cast<UINT>(m_aIndices.size());
+        UINT uNumIndices = 0u;
+        for (const BasicMeshEntry& mesh : m_aMeshes)
+        {
+            uNumIndices += mesh.uNumIndices;
+        }
+
+        return uNumIndices;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
        Method:   Model::GetBoneTransforms
 
-       Summary:  Returns the vector containing bone transforms
+       Summary:  Returns the transform of every bone of the model,
+                 already transposed to three rows in the layout of the
+                 bone transforms buffer
 
-       Returns:  std::vector<XMMATRIX>&
+       Returns:  const std::vector<XMFLOAT3X4A>&
      M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    std::vector<XMMATRIX>& Model::GetBoneTransforms()
+    const std::vector<XMFLOAT3X4A>& Model::GetBoneTransforms() const
     {
-        return m_aTransforms;
+        return m_aBoneTransforms;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::GetBoneNameToIndexMap
+       Method:   Model::GetBoneDualQuaternions
 
-        Summary:  Returns the bone name to index map
+       Summary:  Returns the dual quaternion of every bone of the model
+                 in the layout of the bone transforms buffer, empty
+                 unless the model is skinned with dual quaternions
 
-        Returns:  std::unordered_map<std::string, UINT>&
+       Returns:  const std::vector<DualQuaternion>&
      M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    const std::unordered_map<std::string, UINT>& Model::GetBoneNameToIndexMap() const
+    const std::vector<DualQuaternion>& Model::GetBoneDualQuaternions() const
     {
-        return m_boneNameToIndexMap;
+        return m_aBoneDualQuaternions;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::countVerticesAndIndices
+       Method:   Model::GetSkinningMode
 
-      Summary:  Fill the BasicMeshEntry information
+       Summary:  Returns how the bones of a vertex are blended
 
-      Args:     UINT& uOutNumVertices
-                  Total number of vertices
-                UINT& uOutNumIndices
-                  Total number of indices
-                const aiScene* pScene
-                  Pointer to an assimp scene object that contains the 
-                  mesh information
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+       Returns:  eSkinningMode
+                  Skinning mode
+     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Model::countVerticesAndIndices(
-        _Inout_ UINT& uOutNumVertices, 
-        _Inout_ UINT& uOutNumIndices, 
-        _In_ const aiScene* pScene
-    )
+    eSkinningMode Model::GetSkinningMode() const
     {
-        // Based on the number of meshes, resize the meshes vector and materials vector accordingly
-        m_aMeshes.resize(pScene->mNumMeshes);
+        return m_skinningMode;
+    }
 
-        for (UINT i = 0u; i < pScene->mNumMeshes; ++i) 
-        {
-            m_aMeshes[i].uMaterialIndex = pScene->mMeshes[i]->mMaterialIndex;
-            m_aMeshes[i].uNumIndices = pScene->mMeshes[i]->mNumFaces * 3u;
-            m_aMeshes[i].uBaseVertex = uOutNumVertices;    
-            m_aMeshes[i].uBaseIndex = uOutNumIndices;
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetAnimationLod
 
-            uOutNumVertices += pScene->mMeshes[i]->mNumVertices;
-            uOutNumIndices += m_aMeshes[i].uNumIndices;
-        }
+      Summary:  Returns how often and how much of the skeleton is
+                evaluated
+
+      Returns:  const AnimationLod&
+                  Animation level of detail
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const AnimationLod& Model::GetAnimationLod() const
+    {
+        return m_animationLod;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findNodeAnimOrNull
+      Method:   Model::SetAnimationLod
 
-        Summary:  Find the aiNodeAnim with the givne node name in the given animation
+      Summary:  Sets how often and how much of the skeleton is
+                evaluated by the next updates. A blend between key
+                poses in progress finishes with its own interval.
 
-        Args:     const aiAnimation* pAnimation
-                    Pointer to an assimp animation object
-                  PCSTR pszNodeName
-                    Node name to find
+      Args:     const AnimationLod& animationLod
+                  Animation level of detail
 
-        Returns:  aiNodeAnim* or nullptr
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+      Modifies: [m_animationLod].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    const aiNodeAnim* Model::findNodeAnimOrNull(
-        _In_ const aiAnimation* pAnimation,
-        _In_ PCSTR pszNodeName
+    void Model::SetAnimationLod(
+        _In_ const AnimationLod& animationLod
     )
     {
-        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
-        {
-            const aiNodeAnim* pNodeAnim = pAnimation->mChannels[i];
+        m_animationLod = animationLod;
+    }
 
-            if (strncmp(pNodeAnim->mNodeName.data, pszNodeName, pNodeAnim->mNodeName.length) == 0)
-            {
-                return pNodeAnim;
-            }
-        }
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetBoneTransformsVersion
+
+      Summary:  Returns the counter that is bumped whenever the bone
+                transforms are evaluated
+
+      Returns:  UINT64
+                  Version of the bone transforms
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-        return nullptr;
+    UINT64 Model::GetBoneTransformsVersion() const
+    {
+        return m_uBoneTransformsVersion;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findPosition
+      Method:   Model::GetPositionScale
 
-        Summary:  Find the index of the position key right before the given animation time
+      Summary:  Returns the scale that decodes the packed positions
 
-        Args:     FLOAT animationTimeTicks
-                    Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+      Returns:  const XMFLOAT4&
+                  Scale of the positions, 1 when they are not packed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-        Returns:  UINT
-                    Index of the key
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const XMFLOAT4& Model::GetPositionScale() const
+    {
+        return m_asset->PositionScale;
+    }
 
-    UINT Model::findPosition(
-        _In_ FLOAT animationTimeTicks,
-        _In_ const aiNodeAnim* pNodeAnim
-    )
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetPositionOffset
+
+      Summary:  Returns the offset that decodes the packed positions
+
+      Returns:  const XMFLOAT4&
+                  Offset of the positions, 0 when they are not packed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const XMFLOAT4& Model::GetPositionOffset() const
     {
-        assert(pNodeAnim->mNumPositionKeys > 0);
+        return m_asset->PositionOffset;
+    }
 
-        for (UINT i = 0; i < pNodeAnim->mNumPositionKeys - 1; ++i)
-        {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mPositionKeys[i + 1].mTime);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetMeshLod
 
-            if (animationTimeTicks < t)
-            {
-                return i;
-            }
-        }
+      Summary:  Returns the level of detail the meshes are drawn at
 
-        return 0u;
+      Returns:  UINT
+                  Level of detail, 0 for the imported meshes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT Model::GetMeshLod() const
+    {
+        return m_uMeshLod;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findRotation
+      Method:   Model::SetMeshLod
 
-        Summary:  Find the index of the rotation key right before the given animation time
+      Summary:  Sets the level of detail the meshes are drawn at
 
-        Args:     FLOAT animationTimeTicks
-                    Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+      Args:     UINT uMeshLod
+                  Level of detail, 0 for the imported meshes
 
-        Returns:  UINT
-                    Index of the key
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+      Modifies: [m_uMeshLod].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    UINT Model::findRotation(
-        _In_ FLOAT animationTimeTicks, 
-        _In_ const aiNodeAnim* pNodeAnim
+    void Model::SetMeshLod(
+        _In_ UINT uMeshLod
     )
     {
-        assert(pNodeAnim->mNumRotationKeys > 0);
+        assert(uMeshLod < MeshLodSelector::NUM_LODS);
+        m_uMeshLod = uMeshLod;
+    }
 
-        for (UINT i = 0u; i < pNodeAnim->mNumRotationKeys - 1; ++i)
-        {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mRotationKeys[i + 1].mTime);
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::GetLodMesh
 
-            if (animationTimeTicks < t)
-            {
-                return i;
-            }
+      Summary:  Returns a mesh at the level of detail of the model. A
+                level shares the vertices, the material and the index
+                format of the imported mesh and only has fewer indices.
+
+      Args:     UINT uMeshIndex
+                  Index of the mesh
+
+      Returns:  const BasicMeshEntry&
+                  Index range of the mesh at the current level
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const Renderable::BasicMeshEntry& Model::GetLodMesh(
+        _In_ UINT uMeshIndex
+    ) const
+    {
+        if (m_uMeshLod == 0u || m_asset->aLodMeshes.empty())
+        {
+            return m_aMeshes[uMeshIndex];
         }
 
-        return 0u;
+        return m_asset->aLodMeshes[(m_uMeshLod - 1u) * m_aMeshes.size() + uMeshIndex];
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::findScaling
+      Method:   Model::CullMeshlets
 
-        Summary:  Find the index of the scaling key right before the given animation time
+      Summary:  Builds the index ranges drawn this frame. The imported
+                meshes keep the ranges of the meshlets the camera can
+                see. Skinned vertices leave the bind pose the bounds of
+                the meshlets hold, and the simplified levels have no
+                meshlets, so those meshes are drawn whole.
 
-        Args:     FLOAT animationTimeTicks
-                    Animation time
-                  const aiNodeAnim* pNodeAnim
-                     Pointer to an assimp node anim object
+      Args:     const MeshletCuller& meshletCuller
+                  Culler set to the camera of the frame
 
-        Returns:  UINT
-                    Index of the key
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+      Modifies: [m_aVisibleMeshes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    UINT Model::findScaling(
-        _In_ FLOAT animationTimeTicks,
-        _In_ const aiNodeAnim* pNodeAnim
+    void Model::CullMeshlets(
+        _In_ const MeshletCuller& meshletCuller
     )
     {
-        assert(pNodeAnim->mNumScalingKeys > 0);
+        m_aVisibleMeshes.clear();
 
-        for (UINT i = 0u; i < pNodeAnim->mNumScalingKeys - 1; ++i)
-        {
-            FLOAT t = static_cast<FLOAT>(pNodeAnim->mScalingKeys[i + 1].mTime);
+        const BOOL bCulled = m_uMeshLod == 0u
+            && !m_asset->bHasAnimation
+            && m_asset->aMeshletOffsets.size() == m_aMeshes.size() + 1u;
 
-            if (animationTimeTicks < t)
+        for (UINT i = 0u; i < static_cast<UINT>(m_aMeshes.size()); ++i)
+        {
+            if (!bCulled)
             {
-                return i;
+                m_aVisibleMeshes.push_back(GetLodMesh(i));
+                continue;
             }
-        }
 
-        return 0u;
+            const UINT uFirstMeshlet = m_asset->aMeshletOffsets[i];
+            meshletCuller.Cull(
+                m_asset->aMeshlets.data() + uFirstMeshlet,
+                m_asset->aMeshletOffsets[i + 1u] - uFirstMeshlet,
+                m_aMeshes[i],
+                GetWorldMatrix(),
+                m_aVisibleMeshes
+            );
+        }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-        Method:   Model::getBoneId
+      Method:   Model::GetVisibleMeshes
 
-        Summary:  Find the the index of the bone
+      Summary:  Returns the index ranges drawn this frame, each with
+                the vertices, the material and the index format of its
+                mesh
 
-        Args:      const aiBone* pBone
-                     Pointer to an assimp bone object
+      Returns:  const std::vector<BasicMeshEntry>&
+                  Index ranges left by the last culling
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-        Modifies: [m_boneNameToIndexMap].
-
-        Returns:  UINT
-                    Index of the bone
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-
-    UINT Model::getBoneId(
-        _In_ const aiBone* pBone
-    )
-    {
-        UINT uBoneIndex = 0u;
-        PCSTR pszBoneName = pBone->mName.C_Str();
-        if (!m_boneNameToIndexMap.contains(pszBoneName))
-        {
-            uBoneIndex = static_cast<UINT>(m_boneNameToIndexMap.size());
-            m_boneNameToIndexMap[pszBoneName] = uBoneIndex;
-        }
-        else
-        {
-            uBoneIndex = m_boneNameToIndexMap[pszBoneName];
-        }
-
-        return uBoneIndex;
-    }
+    const std::vector<Renderable::BasicMeshEntry>& Model::GetVisibleMeshes() const
+    {
+        return m_aVisibleMeshes;
+    }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::getVertices
+        Method:   Model::GetBoneNameToIndexMap
 
-      Summary:  Returns the vertices data
+        Summary:  Returns the bone name to index map
 
-      Returns:  const SimpleVertex*
-                  Array of vertices
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+        Returns:  std::unordered_map<std::string, UINT>&
+     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    const SimpleVertex* Model::getVertices() const
+    const std::unordered_map<std::string, UINT>& Model::GetBoneNameToIndexMap() const
     {
-        return m_aVertices.data();
+        return m_asset->boneNameToIndexMap;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::getIndices
+      Method:   Model::CreateCpuSkinning
 
-      Summary:  Returns the indices data
+      Summary:  Creates the streams skinning the vertices of the model
+                on the CPU with the bone transforms of
+                GetBoneTransforms, for thumbnails, collision
+                proxies or checking the skinning shader
 
-      Returns:  const WORD*
-                  Array of indices
+      Returns:  std::unique_ptr<CpuSkinning>
+                  CPU skinning of the bind pose of the model
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    const WORD* Model::getIndices() const
+    std::unique_ptr<CpuSkinning> Model::CreateCpuSkinning() const
     {
-        return m_aIndices.data();
+        return std::make_unique<CpuSkinning>(m_asset->aVertices, m_asset->aAnimationData);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::initAllMeshes
+      Method:   Model::appendIndex
 
-      Summary:  Initialize all meshes in a given assimp scene
+      Summary:  Appends an index of a mesh to the index stream in the
+                format of the mesh. The first 32 bit index of a mesh
+                pads the stream to its 4 byte boundary.
 
-      Args:     const aiScene* pScene
-                  Assimp scene
+      Args:     UINT uMeshIndex
+                  Index of the mesh
+                UINT uValue
+                  Vertex index, relative to the base vertex of the mesh
+
+      Modifies: [m_asset].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Model::initAllMeshes(
-        _In_ const aiScene* pScene
+    void Model::appendIndex(
+        _In_ UINT uMeshIndex,
+        _In_ UINT uValue
     )
     {
-        for (UINT i = 0u; i < m_aMeshes.size(); ++i)
+        const BasicMeshEntry& mesh = m_aMeshes[uMeshIndex];
+        if (mesh.IndexFormat == DXGI_FORMAT_R32_UINT)
         {
-            const aiMesh* pMesh = pScene->mMeshes[i];
-            initSingleMesh(i, pMesh);
+            if (m_asset->aIndices.size() < static_cast<size_t>(mesh.uBaseIndex) * 2u)
+            {
+                m_asset->aIndices.resize(static_cast<size_t>(mesh.uBaseIndex) * 2u, 0u);
+            }
+            m_asset->aIndices.push_back(static_cast<WORD>(uValue & 0xFFFFu));
+            m_asset->aIndices.push_back(static_cast<WORD>(uValue >> 16u));
+        }
+        else
+        {
+            assert(uValue <= 0xFFFFu);
+            m_asset->aIndices.push_back(static_cast<WORD>(uValue));
         }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::initFromScene
+      Method:   Model::bakeAnimation
 
-      Summary:  Initialize all meshes in a given assimp scene
+      Summary:  Samples the bone palettes of the animation at a fixed
+                frame rate into the baked animation of the asset, once
+                for all the instances, and uploads them
 
       Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const aiScene* pScene
-                  Assimp scene
-                const std::filesystem::path& filePath
-                  Path to the model
+                  The Direct3D device to create the palette buffer
+                FLOAT frameRate
+                  Number of palettes baked per second of animation
+
+      Modifies: [m_asset].
 
       Returns:  HRESULT
                   Status code
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    HRESULT Model::initFromScene(
+    HRESULT Model::bakeAnimation(
         _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
-        _In_ const aiScene* pScene,
-        _In_ const std::filesystem::path& filePath
+        _In_ FLOAT frameRate
     )
     {
-        HRESULT hr = S_OK;
+        if (m_asset->pBakedAnimation)
+        {
+            return S_OK;
+        }
 
-        UINT uNumVertices = 0u;
-        UINT uNumIndices = 0u;
+        const UINT uNumBones = static_cast<UINT>(m_asset->boneNameToIndexMap.size());
+        if (!m_asset->bHasAnimation || uNumBones == 0u || uNumBones > MAX_NUM_BONES)
+        {
+            return E_FAIL;
+        }
 
-        countVerticesAndIndices(uNumVertices, uNumIndices, pScene);
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER bakeTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
 
-        reserveSpace(uNumVertices, uNumIndices);
+        const FLOAT ticksPerSecond = m_asset->TicksPerSecond;
+        const FLOAT durationTicks = m_asset->DurationTicks;
 
-        initAllMeshes(pScene);
+        // The last frame blends back into the first one, as the animation loops
+        const UINT uNumFrames = static_cast<UINT>(fmaxf(ceilf(durationTicks / ticksPerSecond * frameRate), 1.0f));
 
-        hr = initMaterials(pDevice, pImmediateContext, pScene, filePath);
+        std::unique_ptr<BakedAnimation> pBakedAnimation = std::make_unique<BakedAnimation>(uNumBones, frameRate);
+
+        UINT uClipIndex = 0u;
+        HRESULT hr = pBakedAnimation->AddClip(uNumFrames, uClipIndex);
         if (FAILED(hr))
         {
             return hr;
         }
 
-        for (size_t i = 0; i < m_aVertices.size(); ++i)
+        XMFLOAT3X4A identity;
+        XMStoreFloat3x4A(&identity, XMMatrixIdentity());
+
+        std::vector<XMMATRIX> aGlobalTransforms(m_asset->aSkeleton.size());
+        std::vector<XMFLOAT3X4A> aBoneTransforms(uNumBones, identity);
+        for (UINT uFrame = 0u; uFrame < uNumFrames; ++uFrame)
         {
-            m_aAnimationData.push_back(
-                AnimationData
-                {
-                    .aBoneIndices = XMUINT4(m_aBoneData.at(i).aBoneIds),
-                    .aBoneWeights = XMFLOAT4(m_aBoneData.at(i).aWeights)
-                }
-            );
+            const FLOAT animationTimeTicks = fminf(static_cast<FLOAT>(uFrame) / frameRate * ticksPerSecond, durationTicks);
+
+            evaluatePose(animationTimeTicks, FALSE, aGlobalTransforms, aBoneTransforms.data());
+            pBakedAnimation->SetPalette(uClipIndex, uFrame, aBoneTransforms.data());
         }
 
-        hr = initialize(pDevice, pImmediateContext);
+        QueryPerformanceCounter(&bakeTime);
+
+        hr = pBakedAnimation->Initialize(pDevice);
         if (FAILED(hr))
         {
             return hr;
         }
 
+        QueryPerformanceCounter(&endTime);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L": baked %u frames of %u bones, %zu bytes, in %.3f ms (%.3f ms upload)\n",
+            uNumFrames,
+            uNumBones,
+            pBakedAnimation->GetNumBytes(),
+            static_cast<FLOAT>(bakeTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart),
+            static_cast<FLOAT>(endTime.QuadPart - bakeTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart)
+        );
+
+        OutputDebugString(L"Model ");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugString(szMessage);
+
+        m_asset->uNumBytes += pBakedAnimation->GetNumBytes();
+        m_asset->pBakedAnimation = std::move(pBakedAnimation);
+
         return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::initMaterials
+      Method:   Model::blendKeyPoses
 
-      Summary:  Initialize all materials in a given assimp scene
+      Summary:  Blends the palette between the previous and the next
+                key pose. The transforms are blended linearly, which
+                is close enough over the few frames of an interval.
+                Dual quaternions are blended along the shortest arc.
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const aiScene* pScene
-                  Assimp scene
-                const std::filesystem::path& filePath
-                  Path to the model
+      Args:     FLOAT factor
+                  Weight of the next key pose in [0, 1]
 
-      Returns:  HRESULT
-                  Status code
+      Modifies: [m_aBoneTransforms, m_aBoneDualQuaternions].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    HRESULT Model::initMaterials(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
-        _In_ const aiScene* pScene,
-        _In_ const std::filesystem::path& filePath
+    void Model::blendKeyPoses(
+        _In_ FLOAT factor
     )
     {
-        HRESULT hr = S_OK;
-
-        // Extract the directory part from the file name
-        std::filesystem::path parentDirectory = filePath.parent_path();
-
-        // Initialize the materials
-        for (UINT i = 0u; i < pScene->mNumMaterials; ++i)
+        if (m_skinningMode == eSkinningMode::DUAL_QUATERNION)
         {
-            const aiMaterial* pMaterial = pScene->mMaterials[i];
+            for (size_t i = 0u; i < m_aBoneDualQuaternions.size(); ++i)
+            {
+                const XMVECTOR previousReal = XMLoadFloat4(&m_aPreviousKeyBoneDualQuaternions[i].Real);
+                const XMVECTOR previousDual = XMLoadFloat4(&m_aPreviousKeyBoneDualQuaternions[i].Dual);
+                XMVECTOR nextReal = XMLoadFloat4(&m_aNextKeyBoneDualQuaternions[i].Real);
+                XMVECTOR nextDual = XMLoadFloat4(&m_aNextKeyBoneDualQuaternions[i].Dual);
 
-            std::string szName = filePath.string() + std::to_string(i);
-            std::wstring pwszName(szName.length(), L' ');
-            std::copy(szName.begin(), szName.end(), pwszName.begin());
-            m_aMaterials.push_back(std::make_shared<Material>(pwszName));
+                if (XMVectorGetX(XMVector4Dot(previousReal, nextReal)) < 0.0f)
+                {
+                    nextReal = XMVectorNegate(nextReal);
+                    nextDual = XMVectorNegate(nextDual);
+                }
 
-            loadTextures(pDevice, pImmediateContext, parentDirectory, pMaterial, i);
+                // The shader normalizes the blended dual quaternion
+                XMStoreFloat4(&m_aBoneDualQuaternions[i].Real, XMVectorLerp(previousReal, nextReal, factor));
+                XMStoreFloat4(&m_aBoneDualQuaternions[i].Dual, XMVectorLerp(previousDual, nextDual, factor));
+            }
         }
+        else
+        {
+            for (size_t i = 0u; i < m_aBoneTransforms.size(); ++i)
+            {
+                const XMMATRIX previous = XMLoadFloat3x4A(&m_aPreviousKeyBoneTransforms[i]);
+                const XMMATRIX next = XMLoadFloat3x4A(&m_aNextKeyBoneTransforms[i]);
 
-        return hr;
+                XMMATRIX blended;
+                for (UINT uRow = 0u; uRow < 4u; ++uRow)
+                {
+                    blended.r[uRow] = XMVectorLerp(previous.r[uRow], next.r[uRow], factor);
+                }
+                XMStoreFloat3x4A(&m_aBoneTransforms[i], blended);
+            }
+        }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::initMeshBones
+      Method:   Model::countVerticesAndIndices
 
-      Summary:  Initialize all bones in a given aiMesh
+      Summary:  Fill the BasicMeshEntry information
 
-      Args:     const aiScene* pScene
-                  Assimp scene
+      Args:     UINT& uOutNumVertices
+                  Total number of vertices
+                UINT& uOutNumIndices
+                  Size of the index stream in 16 bit words
+                const aiScene* pScene
+                  Pointer to an assimp scene object that contains the 
+                  mesh information
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Model::initMeshBones(
-        _In_ UINT uMeshIndex, 
-        _In_ const aiMesh* pMesh
+    void Model::countVerticesAndIndices(
+        _Inout_ UINT& uOutNumVertices, 
+        _Inout_ UINT& uOutNumIndices, 
+        _In_ const aiScene* pScene
     )
     {
-        for (UINT i = 0u; i < pMesh->mNumBones; ++i)
+        // Based on the number of meshes, resize the meshes vector and materials vector accordingly
+        m_aMeshes.resize(pScene->mNumMeshes);
+
+        for (UINT i = 0u; i < pScene->mNumMeshes; ++i) 
         {
-            initMeshSingleBone(uMeshIndex, pMesh->mBones[i]);
+            m_aMeshes[i].uMaterialIndex = pScene->mMeshes[i]->mMaterialIndex;
+            m_aMeshes[i].uNumIndices = pScene->mMeshes[i]->mNumFaces * 3u;
+            m_aMeshes[i].uBaseVertex = uOutNumVertices;    
+
+            // 16 bit indices where the mesh fits, the 32 bit ones start on a 4 byte boundary
+            if (pScene->mMeshes[i]->mNumVertices <= MAX_NUM_16_BIT_INDEXED_VERTICES)
+            {
+                m_aMeshes[i].IndexFormat = DXGI_FORMAT_R16_UINT;
+                m_aMeshes[i].uBaseIndex = uOutNumIndices;
+                uOutNumIndices += m_aMeshes[i].uNumIndices;
+            }
+            else
+            {
+                uOutNumIndices += uOutNumIndices & 1u;
+                m_aMeshes[i].IndexFormat = DXGI_FORMAT_R32_UINT;
+                m_aMeshes[i].uBaseIndex = uOutNumIndices / 2u;
+                uOutNumIndices += m_aMeshes[i].uNumIndices * 2u;
+            }
+
+            uOutNumVertices += pScene->mMeshes[i]->mNumVertices;
         }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::initMeshSingleBone
+      Method:   Model::createAsset
 
-      Summary:  Initialize a single bone of the mesh
+      Summary:  Returns an empty asset, without animation
 
-      Args:     const aiScene* pScene
-                  Assimp scene
+      Returns:  std::shared_ptr<ModelAsset>
+                  New asset
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Model::initMeshSingleBone(
-        _In_ UINT uMeshIndex,
-        _In_ const aiBone* pBone
-    )
+    std::shared_ptr<ModelAsset> Model::createAsset()
     {
-        UINT uBoneId = getBoneId(pBone);
-
-        if (uBoneId == m_aBoneInfo.size())
-        {
-            BoneInfo boneInfo(ConvertMatrix(pBone->mOffsetMatrix));
-            m_aBoneInfo.push_back(boneInfo);
-        }
-
-        for (UINT i = 0u; i < pBone->mNumWeights; ++i)
-        {
-            const aiVertexWeight& vertexWeight = pBone->mWeights[i];
-            UINT uGlobalVertexId = m_aMeshes[uMeshIndex].uBaseVertex + vertexWeight.mVertexId;
-            m_aBoneData[uGlobalVertexId].AddBoneData(uBoneId, vertexWeight.mWeight);
-        }
+        std::shared_ptr<ModelAsset> asset = std::make_shared<ModelAsset>();
+        asset->TicksPerSecond = 25.0f;
+        asset->DurationTicks = 0.0f;
+        asset->bHasAnimation = FALSE;
+        asset->PositionScale = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+        asset->PositionOffset = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
+        asset->GlobalInverseTransform = XMMatrixIdentity();
+        asset->bHasNormalMap = FALSE;
+        asset->bLoadedFromCache = FALSE;
+        asset->uNumBytes = 0u;
+
+        return asset;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::initSingleMesh
+      Method:   Model::evaluateGlobalTransforms
 
-      Summary:  Initialize single mesh from a given assimp mesh
+      Summary:  Computes the global transform of every node of the
+                flattened skeleton in a single pass from the compressed
+                clip
 
-      Args:     UINT uMeshIndex
-                  Index of mesh
-                const aiMesh* pMesh
-                  Point to an assimp mesh object
+      Args:     FLOAT animationTimeTicks
+                  Animation time
+                BOOL bSkipLeafBones
+                  Whether the lowest levels of the skeleton keep their
+                  bind pose relative to their parent instead of being
+                  sampled
+                std::vector<XMMATRIX>& aGlobalTransforms
+                  Global transform of every node of the skeleton
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Model::initSingleMesh(
-        _In_ UINT uMeshIndex, 
-        _In_ const aiMesh* pMesh
-    )
+    void Model::evaluateGlobalTransforms(
+        _In_ FLOAT animationTimeTicks,
+        _In_ BOOL bSkipLeafBones,
+        _Inout_ std::vector<XMMATRIX>& aGlobalTransforms
+    ) const
     {
-        const aiVector3D zero3d(0.0f, 0.0f, 0.0f);
+        UINT uFrame = 0u;
+        FLOAT factor = 0.0f;
+        m_asset->Clip.FindFrame(animationTimeTicks, uFrame, factor);
 
-        // Populate the vertex attribute vector
-        for (UINT i = 0u; i < pMesh->mNumVertices; ++i)
+        for (size_t i = 0u; i < m_asset->aSkeleton.size(); ++i)
         {
-            const aiVector3D& position = pMesh->mVertices[i];
-            const aiVector3D& normal = pMesh->mNormals[i];
-            const aiVector3D& texCoord = pMesh->HasTextureCoords(0u) ? pMesh->mTextureCoords[0][i] : zero3d;
-            const aiVector3D& tangent = pMesh->HasTangentsAndBitangents() ? pMesh->mTangents[i] : zero3d;
-            const aiVector3D& bitangent = pMesh->HasTangentsAndBitangents() ? pMesh->mBitangents[i] : zero3d;
-
-            m_aVertices.push_back(
-                SimpleVertex
-                {
-                    .Position = XMFLOAT3(position.x, position.y, position.z),
-                    .TexCoord = XMFLOAT2(texCoord.x, texCoord.y),
-                    .Normal = XMFLOAT3(normal.x, normal.y, normal.z)
-                }
-            );
+            const SkeletonNode& node = m_asset->aSkeleton[i];
 
-            m_aNormalData.push_back(
-                NormalData
-                {
-                    .Tangent = XMFLOAT3(tangent.x, tangent.y, tangent.z),
-                    .Bitangent = XMFLOAT3(bitangent.x, bitangent.y, bitangent.z)
-                }
-            );
-        }
+            // Skipped leaves such as fingers and facial bones are collapsed onto their parent
+            XMMATRIX localTransform = node.LocalTransform;
+            if (node.uChannelIndex != INVALID_INDEX && (!bSkipLeafBones || node.uHeight >= NUM_SKIPPED_LEAF_LEVELS))
+            {
+                XMVECTOR scaling;
+                XMVECTOR rotation;
+                XMVECTOR translation;
+                m_asset->Clip.Sample(node.uChannelIndex, uFrame, factor, scaling, rotation, translation);
 
-        // Populate the index buffer 
-        for (UINT i = 0u; i < pMesh->mNumFaces; ++i)
-        {
-            const aiFace& face = pMesh->mFaces[i];
-            assert(face.mNumIndices == 3u);
+                // Scaling * rotation * translation
+                localTransform = XMMatrixAffineTransformation(scaling, g_XMZero, rotation, translation);
+            }
 
-            m_aIndices.push_back(static_cast<WORD>(face.mIndices[0]));
-            m_aIndices.push_back(static_cast<WORD>(face.mIndices[1]));
-            m_aIndices.push_back(static_cast<WORD>(face.mIndices[2]));
+            aGlobalTransforms[i] = node.uParentIndex != INVALID_INDEX ? localTransform * aGlobalTransforms[node.uParentIndex] : localTransform;
         }
-
-        initMeshBones(uMeshIndex, pMesh);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::interpolatePosition
+      Method:   Model::evaluatePose
 
-      Summary:  Interpolate two keyframes to find translate vector
+      Summary:  Computes the global transforms of the skeleton and
+                writes the final bone transforms transposed to three
+                rows, ready to be uploaded
 
-      Args:     XMFLOAT3& outTranslate
-                  Translate vector
-                FLOAT animationTimeTicks
+      Args:     FLOAT animationTimeTicks
                   Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
+                BOOL bSkipLeafBones
+                  Whether the leaf bones are collapsed onto their parent
+                std::vector<XMMATRIX>& aGlobalTransforms
+                  Global transform of every node of the skeleton
+                XMFLOAT3X4A* aBoneTransforms
+                  Transposed final transform of every bone
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Model::interpolatePosition(
-        _Inout_ XMFLOAT3& outTranslate, 
-        _In_ FLOAT animationTimeTicks, 
-        _In_ const aiNodeAnim* pNodeAnim
-    )
+    void Model::evaluatePose(
+        _In_ FLOAT animationTimeTicks,
+        _In_ BOOL bSkipLeafBones,
+        _Inout_ std::vector<XMMATRIX>& aGlobalTransforms,
+        _Out_ XMFLOAT3X4A* aBoneTransforms
+    ) const
     {
-        if (pNodeAnim->mNumPositionKeys == 1)
+        evaluateGlobalTransforms(animationTimeTicks, bSkipLeafBones, aGlobalTransforms);
+
+        for (size_t i = 0u; i < m_asset->aSkeleton.size(); ++i)
         {
-            outTranslate = ConvertVector3dToFloat3(pNodeAnim->mPositionKeys[0].mValue);
-            return;
+            const SkeletonNode& node = m_asset->aSkeleton[i];
+            if (node.uBoneIndex != INVALID_INDEX)
+            {
+                // The store transposes in registers and drops the constant last column
+                XMStoreFloat3x4A(&aBoneTransforms[node.uBoneIndex], node.OffsetMatrix * aGlobalTransforms[i] * m_asset->GlobalInverseTransform);
+            }
         }
-
-        UINT uPositionIndex = findPosition(animationTimeTicks, pNodeAnim);
-        UINT uNextPositionIndex = uPositionIndex + 1u;
-        assert(uNextPositionIndex < pNodeAnim->mNumPositionKeys);
-
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mPositionKeys[uPositionIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mPositionKeys[uNextPositionIndex].mTime);
-        FLOAT deltaTime = t2 - t1;
-        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
-        assert(factor >= 0.0f && factor <= 1.0f);
-
-        const aiVector3D& start = pNodeAnim->mPositionKeys[uPositionIndex].mValue;
-        const aiVector3D& end = pNodeAnim->mPositionKeys[uNextPositionIndex].mValue;
-        aiVector3D delta = end - start;
-        outTranslate = ConvertVector3dToFloat3(start + factor * delta);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::interpolateRotation
+      Method:   Model::evaluatePose
 
-      Summary:  Interpolate two keyframes to find rotation vector
+      Summary:  Computes the global transforms of the skeleton and
+                writes the final bone transforms as dual quaternions,
+                ready to be uploaded
 
-      Args:     XMVECTOR& outQuaternion
-                  Quaternion vector
-                FLOAT animationTimeTicks
+      Args:     FLOAT animationTimeTicks
                   Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
+                BOOL bSkipLeafBones
+                  Whether the leaf bones are collapsed onto their parent
+                std::vector<XMMATRIX>& aGlobalTransforms
+                  Global transform of every node of the skeleton
+                DualQuaternion* aBoneDualQuaternions
+                  Final transform of every bone
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Model::interpolateRotation(
-        _Inout_ XMVECTOR& outQuaternion,
-        _In_ FLOAT animationTimeTicks, 
-        _In_ const aiNodeAnim* pNodeAnim
-    )
+    void Model::evaluatePose(
+        _In_ FLOAT animationTimeTicks,
+        _In_ BOOL bSkipLeafBones,
+        _Inout_ std::vector<XMMATRIX>& aGlobalTransforms,
+        _Out_ DualQuaternion* aBoneDualQuaternions
+    ) const
     {
-        if (pNodeAnim->mNumRotationKeys == 1)
+        evaluateGlobalTransforms(animationTimeTicks, bSkipLeafBones, aGlobalTransforms);
+
+        for (size_t i = 0u; i < m_asset->aSkeleton.size(); ++i)
         {
-            outQuaternion = ConvertQuaternionToVector(pNodeAnim->mRotationKeys[0].mValue);
-            return;
+            const SkeletonNode& node = m_asset->aSkeleton[i];
+            if (node.uBoneIndex != INVALID_INDEX)
+            {
+                storeDualQuaternion(aBoneDualQuaternions[node.uBoneIndex], node.OffsetMatrix * aGlobalTransforms[i] * m_asset->GlobalInverseTransform);
+            }
         }
-
-        UINT uRotationIndex = findRotation(animationTimeTicks, pNodeAnim);
-        UINT uNextRotationIndex = uRotationIndex + 1;
-        assert(uNextRotationIndex < pNodeAnim->mNumRotationKeys);
-
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mRotationKeys[uRotationIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mRotationKeys[uNextRotationIndex].mTime);
-        FLOAT deltaTime = t2 - t1;
-        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
-        assert(factor >= 0.0f && factor <= 1.0f);
-
-        aiQuaternion outQ;
-        const aiQuaternion& startRotationQ = pNodeAnim->mRotationKeys[uRotationIndex].mValue;
-        const aiQuaternion& endRotationQ = pNodeAnim->mRotationKeys[uNextRotationIndex].mValue;
-        aiQuaternion::Interpolate(outQ, startRotationQ, endRotationQ, factor);
-        outQ = startRotationQ;
-        outQ.Normalize();
-        outQuaternion = ConvertQuaternionToVector(outQ);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::interpolateScaling
+        Method:   Model::getBoneId
 
-      Summary:  Interpolate two keyframes to find scaling vector
+        Summary:  Find the the index of the bone
 
-      Args:     XMFLOAT3& outScale
-                  Scaling vector
-                FLOAT animationTimeTicks
-                  Animation time
-                const aiNodeAnim* pNodeAnim
-                  Pointer to an assimp node anim object
-    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+        Args:      const aiBone* pBone
+                     Pointer to an assimp bone object
 
-    void Model::interpolateScaling(
-        _Inout_ XMFLOAT3& outScale, 
-        _In_ FLOAT animationTimeTicks, 
-        _In_ const aiNodeAnim* pNodeAnim
-    )
+        Modifies: [m_asset->boneNameToIndexMap].
+
+        Returns:  UINT
+                    Index of the bone
+     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT Model::getBoneId(
+        _In_ const aiBone* pBone
+    )
+    {
+        UINT uBoneIndex = 0u;
+        PCSTR pszBoneName = pBone->mName.C_Str();
+        if (!m_asset->boneNameToIndexMap.contains(pszBoneName))
+        {
+            uBoneIndex = static_cast<UINT>(m_asset->boneNameToIndexMap.size());
+            m_asset->boneNameToIndexMap[pszBoneName] = uBoneIndex;
+        }
+        else
+        {
+            uBoneIndex = m_asset->boneNameToIndexMap[pszBoneName];
+        }
+
+        return uBoneIndex;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::getCachePath
+
+      Summary:  Returns the path to the model cache, next to the model
+                file
+
+      Returns:  std::filesystem::path
+                  Path to the cache file
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    std::filesystem::path Model::getCachePath() const
+    {
+        std::filesystem::path cachePath = m_filePath;
+        cachePath += CACHE_EXTENSION;
+
+        return cachePath;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::getIndexBufferByteWidth
+
+      Summary:  Returns the size of the index stream
+
+      Returns:  UINT
+                  Size of the indices of every mesh in bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT Model::getIndexBufferByteWidth() const
+    {
+        return static_cast<UINT>(m_asset->aIndices.size() * sizeof(WORD));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::getVertices
+
+      Summary:  Returns the vertices data
+
+      Returns:  const SimpleVertex*
+                  Array of vertices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const SimpleVertex* Model::getVertices() const
+    {
+        return m_asset->aVertices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::getIndices
+
+      Summary:  Returns the index stream, where the 16 and 32 bit
+                indices of the meshes follow each other
+
+      Returns:  const WORD*
+                  Index stream
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const WORD* Model::getIndices() const
+    {
+        return m_asset->aIndices.data();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initializeVertexBuffers
+
+      Summary:  Packs the vertices and their tangent frames into a
+                single vertex buffer, decoded with the bounds of the
+                model. The tangents and bitangents have no buffer of
+                their own.
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+
+      Modifies: [m_asset, m_vertexBuffer, m_boundingSphere].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::initializeVertexBuffers(
+        _In_ ID3D11Device* pDevice
+    )
+    {
+        if (!isVertexFormatPacked())
+        {
+            return Renderable::initializeVertexBuffers(pDevice);
+        }
+
+        // Local space bounds used for culling
+        BoundingSphere::CreateFromPoints(m_boundingSphere, GetNumVertices(), &getVertices()->Position, sizeof(SimpleVertex));
+
+        // Every vertex comes with its tangent and bitangent, from the importer or the model cache
+        assert(m_aNormalData.size() == GetNumVertices());
+
+        BoundingBox bounds;
+        BoundingBox::CreateFromPoints(bounds, GetNumVertices(), &getVertices()->Position, sizeof(SimpleVertex));
+
+        const VertexPacker packer(bounds);
+        std::vector<PackedVertex> aPackedVertices;
+        const VertexPackingError error = packer.PackVertices(getVertices(), m_aNormalData.data(), GetNumVertices(), aPackedVertices);
+
+        m_asset->PositionScale = packer.GetPositionScale();
+        m_asset->PositionOffset = packer.GetPositionOffset();
+
+        // A position moves by at most half a step of the 16 bit grid on every axis, a whole step leaves room for rounding
+        const FLOAT maxPositionError = XMVectorGetX(XMVector3Length(XMLoadFloat4(&m_asset->PositionScale))) / 32767.0f;
+        assert(error.MaxPositionError <= maxPositionError);
+        assert(error.MaxNormalAngle <= MAX_PACKED_NORMAL_ANGLE);
+        assert(error.MaxTangentAngle <= MAX_PACKED_TANGENT_ANGLE);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L": packed %u vertices from %zu to %zu bytes, largest errors: position %f, texture coordinate %f, normal %.4f, tangent %.4f degrees\n",
+            GetNumVertices(),
+            sizeof(SimpleVertex) + sizeof(NormalData),
+            sizeof(PackedVertex),
+            error.MaxPositionError,
+            error.MaxTexCoordError,
+            error.MaxNormalAngle,
+            error.MaxTangentAngle
+        );
+        OutputDebugString(L"Model ");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugString(szMessage);
+
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = static_cast<UINT>(sizeof(PackedVertex) * aPackedVertices.size()),
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u,
+        };
+
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = aPackedVertices.data(),
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+
+        return pDevice->CreateBuffer(&bd, &initData, m_vertexBuffer.GetAddressOf());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initAllMeshes
+
+      Summary:  Initialize all meshes in a given assimp scene
+
+      Args:     const aiScene* pScene
+                  Assimp scene
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::initAllMeshes(
+        _In_ const aiScene* pScene
+    )
+    {
+        for (UINT i = 0u; i < m_aMeshes.size(); ++i)
+        {
+            const aiMesh* pMesh = pScene->mMeshes[i];
+            initSingleMesh(i, pMesh);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initAnimationClip
+
+      Summary:  Resamples every channel of the animation at the
+                shortest interval between its keys and compresses the
+                result
+
+      Args:     const aiAnimation* pAnimation
+                  Pointer to an assimp animation object
+
+      Modifies: [m_asset->Clip].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::initAnimationClip(
+        _In_ const aiAnimation* pAnimation
+    )
+    {
+        const FLOAT duration = static_cast<FLOAT>(pAnimation->mDuration);
+
+        // Keys a frame apart land on the samples
+        FLOAT frameTicks = duration;
+        size_t uNumSourceBytes = 0u;
+        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
+        {
+            const aiNodeAnim* pNodeAnim = pAnimation->mChannels[i];
+
+            frameTicks = FindSmallestKeyInterval(pNodeAnim->mPositionKeys, pNodeAnim->mNumPositionKeys, frameTicks);
+            frameTicks = FindSmallestKeyInterval(pNodeAnim->mRotationKeys, pNodeAnim->mNumRotationKeys, frameTicks);
+            frameTicks = FindSmallestKeyInterval(pNodeAnim->mScalingKeys, pNodeAnim->mNumScalingKeys, frameTicks);
+
+            uNumSourceBytes += sizeof(aiNodeAnim)
+                + pNodeAnim->mNumPositionKeys * sizeof(aiVectorKey)
+                + pNodeAnim->mNumRotationKeys * sizeof(aiQuatKey)
+                + pNodeAnim->mNumScalingKeys * sizeof(aiVectorKey);
+        }
+        frameTicks = fmaxf(frameTicks, duration / static_cast<FLOAT>(MAX_CLIP_FRAMES - 1u));
+
+        const UINT uNumFrames = frameTicks > 0.0f ? static_cast<UINT>(ceilf(duration / frameTicks - 1e-3f)) + 1u : 1u;
+        const size_t uNumSamples = static_cast<size_t>(pAnimation->mNumChannels) * uNumFrames;
+
+        std::vector<XMFLOAT3> aTranslations(uNumSamples);
+        std::vector<XMFLOAT4> aRotations(uNumSamples);
+        std::vector<XMFLOAT3> aScales(uNumSamples);
+
+        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
+        {
+            const aiNodeAnim* pNodeAnim = pAnimation->mChannels[i];
+            UINT uPositionKey = 0u;
+            UINT uRotationKey = 0u;
+            UINT uScalingKey = 0u;
+
+            for (UINT uFrame = 0u; uFrame < uNumFrames; ++uFrame)
+            {
+                const size_t uIndex = static_cast<size_t>(i) * uNumFrames + uFrame;
+                const FLOAT animationTimeTicks = fminf(static_cast<FLOAT>(uFrame) * frameTicks, duration);
+
+                aTranslations[uIndex] = SampleVectorKeys(pNodeAnim->mPositionKeys, pNodeAnim->mNumPositionKeys, animationTimeTicks, uPositionKey);
+                aScales[uIndex] = SampleVectorKeys(pNodeAnim->mScalingKeys, pNodeAnim->mNumScalingKeys, animationTimeTicks, uScalingKey);
+                XMStoreFloat4(&aRotations[uIndex], SampleQuaternionKeys(pNodeAnim->mRotationKeys, pNodeAnim->mNumRotationKeys, animationTimeTicks, uRotationKey));
+            }
+        }
+
+        HRESULT hr = m_asset->Clip.Initialize(pAnimation->mNumChannels, uNumFrames, frameTicks, aTranslations, aRotations, aScales);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        const AnimationClipStats& stats = m_asset->Clip.GetStats();
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Model: %u channels resampled to %u frames, %zu bytes of keys compressed to %zu bytes (%.1fx), %u of %u tracks constant\n",
+            pAnimation->mNumChannels,
+            uNumFrames,
+            uNumSourceBytes,
+            stats.uNumBytes,
+            static_cast<FLOAT>(uNumSourceBytes) / static_cast<FLOAT>(stats.uNumBytes > 0u ? stats.uNumBytes : 1u),
+            stats.uNumConstantTracks,
+            stats.uNumConstantTracks + stats.uNumAnimatedTracks
+        );
+        OutputDebugString(szMessage);
+
+        swprintf_s(
+            szMessage,
+            L"Model: largest clip error %.6f in translation, %.4f degrees in rotation, %.6f in scaling\n",
+            stats.maxTranslationError,
+            stats.maxRotationError,
+            stats.maxScalingError
+        );
+        OutputDebugString(szMessage);
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initCachedMaterials
+
+      Summary:  Creates the materials and their textures from the
+                paths read from the model cache, the way the importer
+                does
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the textures
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set the textures
+
+      Modifies: [m_aMaterials].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::initCachedMaterials(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext
+    )
+    {
+        std::filesystem::path parentDirectory = m_filePath.parent_path();
+
+        // Models of different files load side by side, the textures are created through the immediate context
+        std::lock_guard<std::mutex> lock(sm_immediateContextMutex);
+
+        for (size_t i = 0u; i < m_asset->aMaterialTexturePaths.size(); ++i)
+        {
+            const MaterialTexturePaths& paths = m_asset->aMaterialTexturePaths[i];
+
+            std::string szName = m_filePath.string() + std::to_string(i);
+            std::wstring pwszName(szName.length(), L' ');
+            std::copy(szName.begin(), szName.end(), pwszName.begin());
+            std::shared_ptr<Material> material = std::make_shared<Material>(pwszName);
+
+            if (!paths.szDiffuse.empty())
+            {
+                material->pDiffuse = std::make_shared<Texture>(parentDirectory / paths.szDiffuse);
+                if (FAILED(material->pDiffuse->Initialize(pDevice, pImmediateContext)))
+                {
+                    OutputDebugString(L"Error loading diffuse texture \"");
+                    OutputDebugString((parentDirectory / paths.szDiffuse).c_str());
+                    OutputDebugString(L"\"\n");
+                }
+            }
+
+            if (!paths.szSpecularExponent.empty())
+            {
+                material->pSpecularExponent = std::make_shared<Texture>(parentDirectory / paths.szSpecularExponent);
+                if (FAILED(material->pSpecularExponent->Initialize(pDevice, pImmediateContext)))
+                {
+                    OutputDebugString(L"Error loading specular texture \"");
+                    OutputDebugString((parentDirectory / paths.szSpecularExponent).c_str());
+                    OutputDebugString(L"\"\n");
+                }
+            }
+
+            // As in loadNormalTexture, the normal map is created but not initialized here
+            if (!paths.szNormal.empty())
+            {
+                material->pNormal = std::make_shared<Texture>(parentDirectory / paths.szNormal);
+            }
+
+            m_aMaterials.push_back(material);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initSkeleton
+
+      Summary:  Appends the node and its descendants to the flattened
+                skeleton in depth-first order, with the animation
+                channel index and the bone index resolved, so the pose
+                evaluation doesn't compare names, and the height of
+                every node
+
+      Args:     const aiScene* pScene
+                  Assimp scene
+                const aiNode* pNode
+                  Pointer to an assimp node object
+                UINT uParentIndex
+                  Index of the parent node in the skeleton, or
+                  INVALID_INDEX for the root
+
+      Modifies: [m_asset->aSkeleton].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::initSkeleton(
+        _In_ const aiScene* pScene,
+        _In_ const aiNode* pNode,
+        _In_ UINT uParentIndex
+    )
+    {
+        UINT uChannelIndex = INVALID_INDEX;
+        if (pScene->HasAnimations())
+        {
+            const aiAnimation* pAnimation = pScene->mAnimations[0];
+            for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
+            {
+                if (pAnimation->mChannels[i]->mNodeName == pNode->mName)
+                {
+                    uChannelIndex = i;
+                    break;
+                }
+            }
+        }
+
+        auto bone = m_asset->boneNameToIndexMap.find(pNode->mName.C_Str());
+        const UINT uBoneIndex = bone != m_asset->boneNameToIndexMap.end() ? bone->second : INVALID_INDEX;
+        assert(uBoneIndex == INVALID_INDEX || uBoneIndex < MAX_NUM_BONES);
+
+        const UINT uNodeIndex = static_cast<UINT>(m_asset->aSkeleton.size());
+        m_asset->aSkeleton.push_back(
+            SkeletonNode
+            {
+                .LocalTransform = ConvertMatrix(pNode->mTransformation),
+                .OffsetMatrix = uBoneIndex != INVALID_INDEX ? m_aBoneInfo[uBoneIndex].OffsetMatrix : XMMatrixIdentity(),
+                .uParentIndex = uParentIndex,
+                .uChannelIndex = uChannelIndex,
+                .uBoneIndex = uBoneIndex,
+                .uHeight = 0u
+            }
+        );
+
+        for (UINT i = 0u; i < pNode->mNumChildren; ++i)
+        {
+            initSkeleton(pScene, pNode->mChildren[i], uNodeIndex);
+        }
+
+        // The descendants are complete, the parent is at least one level above the node
+        const UINT uParentHeight = m_asset->aSkeleton[uNodeIndex].uHeight + 1u;
+        if (uParentIndex != INVALID_INDEX && m_asset->aSkeleton[uParentIndex].uHeight < uParentHeight)
+        {
+            m_asset->aSkeleton[uParentIndex].uHeight = uParentHeight;
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initFromAsset
+
+      Summary:  Points the instance at the buffers, meshes and
+                materials of an asset already loaded and creates its
+                own constant buffer
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+
+      Modifies: [m_vertexBuffer, m_normalBuffer, m_indexBuffer,
+                 m_constantBuffer, m_aMeshes, m_aMaterials,
+                 m_boundingSphere, m_bHasNormalMap].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::initFromAsset(
+        _In_ ID3D11Device* pDevice
+    )
+    {
+        m_vertexBuffer = m_asset->VertexBuffer;
+        m_normalBuffer = m_asset->NormalBuffer;
+        m_indexBuffer = m_asset->IndexBuffer;
+        m_aMeshes = m_asset->aMeshes;
+        m_aMaterials = m_asset->aMaterials;
+        m_boundingSphere = m_asset->BoundingSphere;
+        m_bHasNormalMap = m_asset->bHasNormalMap;
+
+        return initializeConstantBuffer(pDevice);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initFromScene
+
+      Summary:  Initialize all meshes in a given assimp scene
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+                const aiScene* pScene
+                  Assimp scene
+                const std::filesystem::path& filePath
+                  Path to the model
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::initFromScene(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ const aiScene* pScene,
+        _In_ const std::filesystem::path& filePath
+    )
+    {
+        HRESULT hr = S_OK;
+
+        UINT uNumVertices = 0u;
+        UINT uNumIndices = 0u;
+
+        countVerticesAndIndices(uNumVertices, uNumIndices, pScene);
+
+        reserveSpace(uNumVertices, uNumIndices);
+
+        initAllMeshes(pScene);
+        optimizeMeshes();
+
+        // Generated on the final vertex order, which keeps the gathers of the vertices close together
+        generateTangents();
+
+        // Every index addresses a vertex of its own mesh, in the format of the mesh
+        assert(validateIndices());
+
+        // Flatten the hierarchy once, with the animation channel and the bone of every node resolved
+        if (pScene->mRootNode)
+        {
+            initSkeleton(pScene, pScene->mRootNode, INVALID_INDEX);
+        }
+
+        if (pScene->HasAnimations())
+        {
+            const aiAnimation* pAnimation = pScene->mAnimations[0];
+            m_asset->TicksPerSecond = static_cast<FLOAT>(pAnimation->mTicksPerSecond != 0.0 ? pAnimation->mTicksPerSecond : 25.0f);
+            m_asset->DurationTicks = static_cast<FLOAT>(pAnimation->mDuration);
+            m_asset->bHasAnimation = TRUE;
+
+            hr = initAnimationClip(pAnimation);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        hr = initMaterials(pDevice, pImmediateContext, pScene, filePath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // The bone indices of the vertex stream are 8 bits wide
+        if (m_asset->boneNameToIndexMap.size() > MAX_NUM_BONES)
+        {
+            OutputDebugString(L"Model: the skeleton has more bones than the vertex stream can address\n");
+            return E_FAIL;
+        }
+
+        UINT uNumTruncatedVertices = 0u;
+        FLOAT maxDroppedWeight = 0.0f;
+        FLOAT maxQuantizationError = 0.0f;
+
+        m_asset->aAnimationData.reserve(m_asset->aVertices.size());
+        for (size_t i = 0; i < m_asset->aVertices.size(); ++i)
+        {
+            FLOAT droppedWeight = 0.0f;
+            FLOAT quantizationError = 0.0f;
+            m_asset->aAnimationData.push_back(BoneWeightPacker::PackBoneData(m_aBoneData.at(i), droppedWeight, quantizationError));
+
+            if (m_aBoneData.at(i).uNumBones > BoneWeightPacker::NUM_PACKED_INFLUENCES)
+            {
+                ++uNumTruncatedVertices;
+            }
+            maxDroppedWeight = fmaxf(maxDroppedWeight, droppedWeight);
+            maxQuantizationError = fmaxf(maxQuantizationError, quantizationError);
+        }
+
+        // Largest remainder rounding never moves a weight by a whole step
+        assert(maxQuantizationError <= 1.0f / 255.0f);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Model: packed %zu bone influences, %u vertices dropped up to %.4f of their weight, largest quantization error %.5f\n",
+            m_asset->aAnimationData.size(),
+            uNumTruncatedVertices,
+            maxDroppedWeight,
+            maxQuantizationError
+        );
+        OutputDebugString(szMessage);
+
+        // Simplified after the bone weights are packed, which keeps vertices of different bones apart
+        generateLods();
+        assert(validateIndices());
+
+        buildMeshlets();
+
+        hr = initialize(pDevice, pImmediateContext);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initMaterials
+
+      Summary:  Initialize all materials in a given assimp scene
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+                const aiScene* pScene
+                  Assimp scene
+                const std::filesystem::path& filePath
+                  Path to the model
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::initMaterials(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ const aiScene* pScene,
+        _In_ const std::filesystem::path& filePath
+    )
+    {
+        HRESULT hr = S_OK;
+
+        // Extract the directory part from the file name
+        std::filesystem::path parentDirectory = filePath.parent_path();
+
+        // The texture loaders keep the paths for the model cache
+        m_asset->aMaterialTexturePaths.resize(pScene->mNumMaterials);
+
+        // Initialize the materials
+        for (UINT i = 0u; i < pScene->mNumMaterials; ++i)
+        {
+            const aiMaterial* pMaterial = pScene->mMaterials[i];
+
+            std::string szName = filePath.string() + std::to_string(i);
+            std::wstring pwszName(szName.length(), L' ');
+            std::copy(szName.begin(), szName.end(), pwszName.begin());
+            m_aMaterials.push_back(std::make_shared<Material>(pwszName));
+
+            loadTextures(pDevice, pImmediateContext, parentDirectory, pMaterial, i);
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initMeshBones
+
+      Summary:  Initialize all bones in a given aiMesh
+
+      Args:     const aiScene* pScene
+                  Assimp scene
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::initMeshBones(
+        _In_ UINT uMeshIndex, 
+        _In_ const aiMesh* pMesh
+    )
+    {
+        for (UINT i = 0u; i < pMesh->mNumBones; ++i)
+        {
+            initMeshSingleBone(uMeshIndex, pMesh->mBones[i]);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initMeshSingleBone
+
+      Summary:  Initialize a single bone of the mesh
+
+      Args:     const aiScene* pScene
+                  Assimp scene
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::initMeshSingleBone(
+        _In_ UINT uMeshIndex,
+        _In_ const aiBone* pBone
+    )
+    {
+        UINT uBoneId = getBoneId(pBone);
+
+        if (uBoneId == m_aBoneInfo.size())
+        {
+            BoneInfo boneInfo(ConvertMatrix(pBone->mOffsetMatrix));
+            m_aBoneInfo.push_back(boneInfo);
+        }
+
+        for (UINT i = 0u; i < pBone->mNumWeights; ++i)
+        {
+            const aiVertexWeight& vertexWeight = pBone->mWeights[i];
+            UINT uGlobalVertexId = m_aMeshes[uMeshIndex].uBaseVertex + vertexWeight.mVertexId;
+            m_aBoneData[uGlobalVertexId].AddBoneData(uBoneId, vertexWeight.mWeight);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::initSingleMesh
+
+      Summary:  Initialize single mesh from a given assimp mesh
+
+      Args:     UINT uMeshIndex
+                  Index of mesh
+                const aiMesh* pMesh
+                  Point to an assimp mesh object
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::initSingleMesh(
+        _In_ UINT uMeshIndex, 
+        _In_ const aiMesh* pMesh
+    )
+    {
+        const aiVector3D zero3d(0.0f, 0.0f, 0.0f);
+
+        // Populate the vertex attribute vector
+        for (UINT i = 0u; i < pMesh->mNumVertices; ++i)
+        {
+            const aiVector3D& position = pMesh->mVertices[i];
+            const aiVector3D& normal = pMesh->mNormals[i];
+            const aiVector3D& texCoord = pMesh->HasTextureCoords(0u) ? pMesh->mTextureCoords[0][i] : zero3d;
+
+            m_asset->aVertices.push_back(
+                SimpleVertex
+                {
+                    .Position = XMFLOAT3(position.x, position.y, position.z),
+                    .TexCoord = XMFLOAT2(texCoord.x, texCoord.y),
+                    .Normal = XMFLOAT3(normal.x, normal.y, normal.z)
+                }
+            );
+        }
+
+        // Populate the index buffer 
+        for (UINT i = 0u; i < pMesh->mNumFaces; ++i)
+        {
+            const aiFace& face = pMesh->mFaces[i];
+            assert(face.mNumIndices == 3u);
+
+            appendIndex(uMeshIndex, face.mIndices[0]);
+            appendIndex(uMeshIndex, face.mIndices[1]);
+            appendIndex(uMeshIndex, face.mIndices[2]);
+        }
+
+        initMeshBones(uMeshIndex, pMesh);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::isAssetShared
+
+      Summary:  Returns whether the asset is cached and shared with
+                the other instances of the same model file
+
+      Returns:  BOOL
+                  TRUE if the asset is shared
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL Model::isAssetShared() const
+    {
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::isVertexFormatPacked
+
+      Summary:  Returns whether the vertex buffer holds packed
+                vertices, which the vertex shaders of the model decode
+
+      Returns:  BOOL
+                  TRUE if the vertices are packed
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL Model::isVertexFormatPacked() const
+    {
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::loadAsset
+
+      Summary:  Loads the model file into a new asset from the model
+                cache, or imports it and writes the cache when the cache
+                is missing or stale, and creates its buffers and
+                textures
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Modifies: [m_asset, m_aBoneData, m_aBoneInfo, m_aNormalData,
+                 m_aMeshes, m_aMaterials, m_bHasNormalMap].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::loadAsset(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext
+    )
+    {
+        HRESULT hr = S_OK;
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER loadTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        m_asset = createAsset();
+
+        hr = loadCache(pDevice, pImmediateContext);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        if (hr == S_OK)
+        {
+            m_asset->bLoadedFromCache = TRUE;
+        }
+        else
+        {
+            // Whatever a stale or damaged cache left behind is discarded
+            m_asset = createAsset();
+            m_aMeshes.clear();
+            m_aMaterials.clear();
+            m_aNormalData.clear();
+            m_bHasNormalMap = FALSE;
+            hr = S_OK;
+
+            // Every load owns its importer, the scene only lives until the asset has been extracted from it
+            Assimp::Importer importer;
+            const size_t uWorkingSetBeforeImport = GetWorkingSetSize();
+
+            // Create the buffers for the vertices attributes
+            const aiScene* pScene = importer.ReadFile(m_filePath.string().c_str(), ASSIMP_LOAD_FLAGS);
+
+            if (pScene)
+            {
+                XMMATRIX transform = ConvertMatrix(pScene->mRootNode->mTransformation);
+                XMVECTOR det = XMMatrixDeterminant(transform);
+                m_asset->GlobalInverseTransform = XMMatrixInverse(&det, transform);
+                hr = initFromScene(pDevice, pImmediateContext, pScene, m_filePath);
+                if (FAILED(hr))
+                {
+                    return hr;
+                }
+            }
+            else
+            {
+                OutputDebugString(L"Error parsing ");
+                OutputDebugString(m_filePath.c_str());
+                OutputDebugString(L": ");
+                OutputDebugStringA(importer.GetErrorString());
+                OutputDebugString(L"\n");
+
+                return E_FAIL;
+            }
+
+            const size_t uWorkingSetWithScene = GetWorkingSetSize();
+            importer.FreeScene();
+            const size_t uWorkingSetAfterImport = GetWorkingSetSize();
+
+            WCHAR szMessage[256];
+            swprintf_s(
+                szMessage,
+                L": working set %zu KB before the import, %zu KB with the Assimp scene, %zu KB once it was freed\n",
+                uWorkingSetBeforeImport / 1024u,
+                uWorkingSetWithScene / 1024u,
+                uWorkingSetAfterImport / 1024u
+            );
+            OutputDebugString(L"Model ");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(szMessage);
+        }
+
+        QueryPerformanceCounter(&loadTime);
+
+        // Create the animation vertex buffer
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = static_cast<UINT>(sizeof(AnimationData) * m_asset->aAnimationData.size()),
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_VERTEX_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = m_asset->aAnimationData.data(),
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+
+        hr = pDevice->CreateBuffer(&bd, &initData, m_asset->AnimationBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_asset->VertexBuffer = m_vertexBuffer;
+        m_asset->NormalBuffer = m_normalBuffer;
+        m_asset->IndexBuffer = m_indexBuffer;
+        m_asset->aMeshes = m_aMeshes;
+        m_asset->aMaterials = m_aMaterials;
+        m_asset->BoundingSphere = m_boundingSphere;
+        m_asset->bHasNormalMap = m_bHasNormalMap;
+
+        // The vertex buffers hold the tangents and the bone weights, the bone offsets are in the skeleton
+        const size_t uVertexBufferStride = isVertexFormatPacked() ? sizeof(PackedVertex) : sizeof(SimpleVertex) + sizeof(NormalData);
+        m_asset->uNumBytes = m_asset->aVertices.size() * (sizeof(SimpleVertex) + uVertexBufferStride)
+            + m_asset->aAnimationData.size() * sizeof(AnimationData) * 2u
+            + m_asset->aIndices.size() * sizeof(WORD) * 2u
+            + m_asset->aSkeleton.size() * sizeof(SkeletonNode)
+            + m_asset->Clip.GetStats().uNumBytes;
+
+        if (!m_asset->bLoadedFromCache && FAILED(saveCache()))
+        {
+            OutputDebugString(L"Model ");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(L": the model cache could not be written\n");
+        }
+
+        QueryPerformanceCounter(&endTime);
+
+        const FLOAT loadMilliseconds = static_cast<FLOAT>(loadTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+        const FLOAT saveMilliseconds = static_cast<FLOAT>(endTime.QuadPart - loadTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+
+        WCHAR szMessage[256];
+        if (m_asset->bLoadedFromCache)
+        {
+            swprintf_s(szMessage, L": loaded from the model cache in %.3f ms\n", loadMilliseconds);
+        }
+        else
+        {
+            swprintf_s(szMessage, L": imported in %.3f ms, model cache written in %.3f ms\n", loadMilliseconds, saveMilliseconds);
+        }
+        OutputDebugString(L"Model ");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugString(szMessage);
+
+        m_aNormalData.clear();
+        m_aNormalData.shrink_to_fit();
+        m_aBoneData.clear();
+        m_aBoneData.shrink_to_fit();
+        m_aBoneInfo.clear();
+        m_aBoneInfo.shrink_to_fit();
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::loadCache
+
+      Summary:  Maps the model cache and reads the asset back with a
+                copy per array, then creates the buffers and the
+                materials. Nothing is created on the GPU until the
+                whole file has been read and checked.
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Modifies: [m_asset, m_aNormalData, m_aMeshes, m_aMaterials,
+                 m_bHasNormalMap, m_vertexBuffer, m_normalBuffer,
+                 m_indexBuffer, m_constantBuffer, m_boundingSphere].
+
+      Returns:  HRESULT
+                  S_OK if the asset was loaded, S_FALSE if the cache is
+                  missing, stale or damaged, or an error code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::loadCache(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext
+    )
+    {
+        ModelCacheReader reader;
+        HRESULT hr = reader.Open(getCachePath(), m_filePath, MODEL_CACHE_LAYOUT);
+        if (hr != S_OK)
+        {
+            return hr;
+        }
+
+        reader.Read(m_asset->GlobalInverseTransform);
+        reader.Read(m_bHasNormalMap);
+        reader.ReadArray(m_asset->aVertices);
+        reader.ReadArray(m_aNormalData);
+        reader.ReadArray(m_asset->aIndices);
+        reader.ReadArray(m_asset->aAnimationData);
+        reader.ReadArray(m_aMeshes);
+        reader.ReadArray(m_asset->aLodMeshes);
+        reader.ReadArray(m_asset->aMeshlets);
+        reader.ReadArray(m_asset->aMeshletOffsets);
+
+        UINT uNumMaterials = 0u;
+        reader.Read(uNumMaterials);
+        for (UINT i = 0u; i < uNumMaterials && !reader.HasFailed(); ++i)
+        {
+            MaterialTexturePaths paths;
+            reader.ReadString(paths.szDiffuse);
+            reader.ReadString(paths.szSpecularExponent);
+            reader.ReadString(paths.szNormal);
+            m_asset->aMaterialTexturePaths.push_back(std::move(paths));
+        }
+
+        UINT uNumBones = 0u;
+        reader.Read(uNumBones);
+        for (UINT i = 0u; i < uNumBones && !reader.HasFailed(); ++i)
+        {
+            std::string szBoneName;
+            UINT uBoneIndex = 0u;
+            reader.ReadString(szBoneName);
+            reader.Read(uBoneIndex);
+            m_asset->boneNameToIndexMap[szBoneName] = uBoneIndex;
+        }
+
+        reader.ReadArray(m_asset->aSkeleton);
+        reader.Read(m_asset->bHasAnimation);
+        reader.Read(m_asset->TicksPerSecond);
+        reader.Read(m_asset->DurationTicks);
+        if (m_asset->bHasAnimation && FAILED(m_asset->Clip.Load(reader)))
+        {
+            return S_FALSE;
+        }
+
+        if (reader.HasFailed())
+        {
+            return S_FALSE;
+        }
+
+        // The pose evaluation and the draws index these arrays without checks
+        const size_t uNumVertices = m_asset->aVertices.size();
+        BOOL bConsistent = m_aNormalData.size() == uNumVertices
+            && m_asset->aAnimationData.size() == uNumVertices
+            && m_asset->aLodMeshes.size() == (MeshLodSelector::NUM_LODS - 1u) * m_aMeshes.size()
+            && m_asset->aMeshletOffsets.size() == m_aMeshes.size() + 1u
+            && m_asset->aMeshletOffsets.front() == 0u
+            && m_asset->aMeshletOffsets.back() == m_asset->aMeshlets.size()
+            && m_asset->boneNameToIndexMap.size() <= MAX_NUM_BONES;
+        for (size_t i = 0u; i < m_asset->aSkeleton.size() && bConsistent; ++i)
+        {
+            const SkeletonNode& node = m_asset->aSkeleton[i];
+            bConsistent = (node.uParentIndex == INVALID_INDEX || node.uParentIndex < i)
+                && (node.uBoneIndex == INVALID_INDEX || node.uBoneIndex < m_asset->boneNameToIndexMap.size())
+                && (node.uChannelIndex == INVALID_INDEX || node.uChannelIndex < m_asset->Clip.GetNumChannels());
+        }
+        for (size_t i = 0u; i < m_aMeshes.size() && bConsistent; ++i)
+        {
+            const BasicMeshEntry& mesh = m_aMeshes[i];
+            bConsistent = mesh.uBaseVertex <= uNumVertices
+                && (mesh.uMaterialIndex == INVALID_MATERIAL || mesh.uMaterialIndex < m_asset->aMaterialTexturePaths.size());
+        }
+        for (size_t i = 0u; i < m_asset->aLodMeshes.size() && bConsistent; ++i)
+        {
+            // A level is drawn with the vertices, the material and the index format of its imported mesh
+            const BasicMeshEntry& mesh = m_aMeshes[i % m_aMeshes.size()];
+            const BasicMeshEntry& lodMesh = m_asset->aLodMeshes[i];
+            bConsistent = lodMesh.uBaseVertex == mesh.uBaseVertex
+                && lodMesh.uMaterialIndex == mesh.uMaterialIndex
+                && lodMesh.IndexFormat == mesh.IndexFormat;
+        }
+        for (size_t i = 0u; i < m_aMeshes.size() && bConsistent; ++i)
+        {
+            // The culled ranges are drawn without checks, every meshlet stays within the indices of its mesh
+            const UINT uFirstMeshlet = m_asset->aMeshletOffsets[i];
+            const UINT uEndMeshlet = m_asset->aMeshletOffsets[i + 1u];
+            bConsistent = uFirstMeshlet <= uEndMeshlet;
+            for (UINT j = uFirstMeshlet; j < uEndMeshlet && bConsistent; ++j)
+            {
+                const Meshlet& meshlet = m_asset->aMeshlets[j];
+                bConsistent = meshlet.uFirstIndex <= m_aMeshes[i].uNumIndices
+                    && meshlet.uNumIndices <= m_aMeshes[i].uNumIndices - meshlet.uFirstIndex;
+            }
+        }
+        if (!bConsistent || !validateIndices())
+        {
+            return S_FALSE;
+        }
+
+        hr = initialize(pDevice, pImmediateContext);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        initCachedMaterials(pDevice, pImmediateContext);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::loadDualQuaternion
+
+      Summary:  Rebuilds the rigid transform of a bone from its dual
+                quaternion, the way the vertex shader applies it
+
+      Args:     const DualQuaternion& dualQuaternion
+                  Unit dual quaternion of the bone
+
+      Returns:  XMMATRIX
+                  Rotation followed by the translation
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    XMMATRIX Model::loadDualQuaternion(
+        _In_ const DualQuaternion& dualQuaternion
+    )
+    {
+        const XMVECTOR real = XMLoadFloat4(&dualQuaternion.Real);
+        const XMVECTOR dual = XMLoadFloat4(&dualQuaternion.Dual);
+
+        // Translation = 2 * dual * conjugate(real), XMQuaternionMultiply(q1, q2) returns q2 * q1
+        const XMVECTOR translation = XMVectorScale(XMQuaternionMultiply(XMQuaternionConjugate(real), dual), 2.0f);
+
+        XMMATRIX transform = XMMatrixRotationQuaternion(real);
+        transform.r[3] = XMVectorSetW(translation, 1.0f);
+
+        return transform;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::loadDiffuseTexture
+
+      Summary:  Load a diffuse texture from given path
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+                const std::filesystem::path& parentDirectory
+                  Parent path to the model
+                const aiMaterial* pMaterial
+                  Pointer to an assimp material object
+                UINT uIndex
+                  Index to a material
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::loadDiffuseTexture(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ const std::filesystem::path& parentDirectory,
+        _In_ const aiMaterial* pMaterial,
+        _In_ UINT uIndex
+    )
+    {
+        HRESULT hr = S_OK;
+        m_aMaterials[uIndex]->pDiffuse = nullptr;
+
+        if (pMaterial->GetTextureCount(aiTextureType_DIFFUSE) > 0)
+        {
+            aiString aiPath;
+
+            if (pMaterial->GetTexture(aiTextureType_DIFFUSE, 0u, &aiPath, nullptr, nullptr, nullptr, nullptr, nullptr) == AI_SUCCESS)
+            {
+                std::string szPath(aiPath.data);
+
+                if (szPath.substr(0ull, 2ull) == ".\\")
+                {
+                    szPath = szPath.substr(2ull, szPath.size() - 2ull);
+                }
+
+                std::filesystem::path fullPath = parentDirectory / szPath;
+                m_asset->aMaterialTexturePaths[uIndex].szDiffuse = szPath;
+
+                m_aMaterials[uIndex]->pDiffuse = std::make_shared<Texture>(fullPath);
+
+                hr = m_aMaterials[uIndex]->pDiffuse->Initialize(pDevice, pImmediateContext);
+                if (FAILED(hr))
+                {
+                    OutputDebugString(L"Error loading diffuse texture \"");
+                    OutputDebugString(fullPath.c_str());
+                    OutputDebugString(L"\"\n");
+
+                    return hr;
+                }
+
+                OutputDebugString(L"Loaded diffuse texture \"");
+                OutputDebugString(fullPath.c_str());
+                OutputDebugString(L"\"\n");
+            }
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+       Method:   Model::loadSpecularTexture
+
+       Summary:  Load a specular texture from given path
+
+       Args:     ID3D11Device* pDevice
+                   The Direct3D device to create the buffers
+                 ID3D11DeviceContext* pImmediateContext
+                   The Direct3D context to set buffers
+                 const std::filesystem::path& parentDirectory
+                   Parent path to the model
+                 const aiMaterial* pMaterial
+                   Pointer to an assimp material object
+                 UINT uIndex
+                   Index to a material
+     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::loadSpecularTexture(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ const std::filesystem::path& parentDirectory,
+        _In_ const aiMaterial* pMaterial,
+        _In_ UINT uIndex
+    )
+    {
+        HRESULT hr = S_OK;
+        m_aMaterials[uIndex]->pSpecularExponent = nullptr;
+
+        if (pMaterial->GetTextureCount(aiTextureType_SHININESS) > 0)
+        {
+            aiString aiPath;
+
+            if (pMaterial->GetTexture(aiTextureType_SHININESS, 0u, &aiPath, nullptr, nullptr, nullptr, nullptr, nullptr) == AI_SUCCESS)
+            {
+                std::string szPath(aiPath.data);
+
+                if (szPath.substr(0ull, 2ull) == ".\\")
+                {
+                    szPath = szPath.substr(2ull, szPath.size() - 2ull);
+                }
+
+                std::filesystem::path fullPath = parentDirectory / szPath;
+                m_asset->aMaterialTexturePaths[uIndex].szSpecularExponent = szPath;
+
+                m_aMaterials[uIndex]->pSpecularExponent = std::make_shared<Texture>(fullPath);
+
+                hr = m_aMaterials[uIndex]->pSpecularExponent->Initialize(pDevice, pImmediateContext);
+                if (FAILED(hr))
+                {
+                    OutputDebugString(L"Error loading specular texture \"");
+                    OutputDebugString(fullPath.c_str());
+                    OutputDebugString(L"\"\n");
+
+                    return hr;
+                }
+
+                OutputDebugString(L"Loaded specular texture \"");
+                OutputDebugString(fullPath.c_str());
+                OutputDebugString(L"\"\n");
+            }
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::loadNormalTexture
+
+      Summary:  Load a normal texture from given path
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+                const std::filesystem::path& parentDirectory
+                  Parent path to the model
+                const aiMaterial* pMaterial
+                  Pointer to an assimp material object
+                UINT uIndex
+                  Index to a material
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::loadNormalTexture(
+        _In_ ID3D11Device* pDevice, 
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ const std::filesystem::path& parentDirectory,
+        _In_ const aiMaterial* pMaterial, 
+        _In_ UINT uIndex
+    )
+    {
+        HRESULT hr = S_OK;
+        m_aMaterials[uIndex]->pNormal = nullptr;
+
+        if (pMaterial->GetTextureCount(aiTextureType_HEIGHT) > 0)
+        {
+            aiString aiPath;
+
+            if (pMaterial->GetTexture(aiTextureType_HEIGHT, 0u, &aiPath, nullptr, nullptr, nullptr, nullptr, nullptr) == AI_SUCCESS)
+            {
+                std::string szPath(aiPath.data);
+
+                if (szPath.substr(0ull, 2ull) == ".\\")
+                {
+                    szPath = szPath.substr(2ull, szPath.size() - 2ull);
+                }
+
+                std::filesystem::path fullPath = parentDirectory / szPath;
+                m_asset->aMaterialTexturePaths[uIndex].szNormal = szPath;
+
+                m_aMaterials[uIndex]->pNormal = std::make_shared<Texture>(fullPath);
+                m_bHasNormalMap = true;
+
+                if (FAILED(hr))
+                {
+                    OutputDebugString(L"Error loading normal texture \"");
+                    OutputDebugString(fullPath.c_str());
+                    OutputDebugString(L"\"\n");
+
+                    return hr;
+                }
+
+                OutputDebugString(L"Loaded normal texture \"");
+                OutputDebugString(fullPath.c_str());
+                OutputDebugString(L"\"\n");
+            }
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::loadTextures
+
+      Summary:  Load a specular texture from given path
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+                const std::filesystem::path& parentDirectory
+                  Parent path to the model
+                const aiMaterial* pMaterial
+                  Pointer to an assimp material object
+                UINT uIndex
+                  Index to a material
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::loadTextures(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ const std::filesystem::path& parentDirectory, 
+        _In_ const aiMaterial* pMaterial,
+        _In_ UINT uIndex
+    )
+    {
+        // Textures of models loading on other threads go through the same immediate context
+        std::lock_guard<std::mutex> lock(sm_immediateContextMutex);
+
+        HRESULT hr = loadDiffuseTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = loadSpecularTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = loadNormalTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return hr;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::measureDualQuaternionError
+
+      Summary:  Evaluates poses spread over the animation both as bone
+                matrices and as dual quaternions and compares the
+                transforms rebuilt from the dual quaternions with the
+                matrices
+
+      Args:     UINT uNumPoses
+                  Number of poses compared
+
+      Returns:  FLOAT
+                  Largest difference between an element of a bone
+                  matrix and its dual quaternion counterpart
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT Model::measureDualQuaternionError(
+        _In_ UINT uNumPoses
+    ) const
+    {
+        const size_t uNumBones = m_asset->boneNameToIndexMap.size();
+        const FLOAT durationTicks = m_asset->DurationTicks;
+
+        XMFLOAT3X4A identity;
+        XMStoreFloat3x4A(&identity, XMMatrixIdentity());
+        DualQuaternion identityDualQuaternion;
+        storeDualQuaternion(identityDualQuaternion, XMMatrixIdentity());
+
+        std::vector<XMMATRIX> aGlobalTransforms(m_asset->aSkeleton.size());
+        std::vector<XMFLOAT3X4A> aBoneTransforms(uNumBones, identity);
+        std::vector<DualQuaternion> aBoneDualQuaternions(uNumBones, identityDualQuaternion);
+
+        FLOAT maxError = 0.0f;
+        for (UINT uPose = 0u; uPose < uNumPoses; ++uPose)
+        {
+            const FLOAT animationTimeTicks = durationTicks * static_cast<FLOAT>(uPose) / static_cast<FLOAT>(uNumPoses);
+
+            evaluatePose(animationTimeTicks, FALSE, aGlobalTransforms, aBoneTransforms.data());
+            evaluatePose(animationTimeTicks, FALSE, aGlobalTransforms, aBoneDualQuaternions.data());
+
+            for (size_t i = 0u; i < uNumBones; ++i)
+            {
+                const XMMATRIX boneTransform = XMLoadFloat3x4A(&aBoneTransforms[i]);
+                const XMMATRIX dualQuaternionTransform = loadDualQuaternion(aBoneDualQuaternions[i]);
+
+                for (UINT uRow = 0u; uRow < 4u; ++uRow)
+                {
+                    XMFLOAT4 difference;
+                    XMStoreFloat4(&difference, XMVectorAbs(XMVectorSubtract(boneTransform.r[uRow], dualQuaternionTransform.r[uRow])));
+                    maxError = fmaxf(maxError, fmaxf(fmaxf(difference.x, difference.y), fmaxf(difference.z, difference.w)));
+                }
+            }
+        }
+
+        return maxError;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::reportLoad
+
+      Summary:  Prints the time taken to initialize the instance, the
+                memory its asset shares between the instances and the
+                memory of the instance itself
+
+      Args:     FLOAT milliseconds
+                  Duration of the initialization
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::reportLoad(
+        _In_ FLOAT milliseconds
+    )
+    {
+        const size_t uNumInstanceBytes = sizeof(*this)
+            + m_aGlobalTransforms.size() * sizeof(XMMATRIX)
+            + sizeof(CBChangesEveryFrame)
+            + m_aBoneTransforms.size() * sizeof(XMFLOAT3X4A) * 2u
+            + m_aBoneDualQuaternions.size() * sizeof(DualQuaternion) * 2u;
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L": initialized in %.3f ms, instance %ld sharing %zu bytes, %zu bytes per instance\n",
+            milliseconds,
+            m_asset.use_count(),
+            m_asset->uNumBytes,
+            uNumInstanceBytes
+        );
+
+        OutputDebugString(L"Model ");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugString(szMessage);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::reportUpdate
+
+      Summary:  Accumulates the pose evaluation time of every animated
+                model and prints the average to the debug output every
+                REPORT_INTERVAL updates
+
+      Args:     FLOAT milliseconds
+                  Duration of the last pose evaluation
+
+      Modifies: [sm_accumulatedUpdateTime, sm_uNumUpdates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::reportUpdate(
+        _In_ FLOAT milliseconds
+    )
     {
-        if (pNodeAnim->mNumScalingKeys == 1)
+        // Models are updated from the job threads
+        std::lock_guard<std::mutex> lock(sm_reportMutex);
+
+        sm_accumulatedUpdateTime += milliseconds;
+        ++sm_uNumUpdates;
+
+        if (sm_uNumUpdates < REPORT_INTERVAL)
         {
-            outScale = ConvertVector3dToFloat3(pNodeAnim->mScalingKeys[0].mValue);
             return;
         }
 
-        UINT uScalingIndex = findScaling(animationTimeTicks, pNodeAnim);
-        UINT uNextScalingIndex = uScalingIndex + 1;
-        assert(uNextScalingIndex < pNodeAnim->mNumScalingKeys);
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Model: %u pose evaluations took %.4f ms on average\n",
+            sm_uNumUpdates,
+            sm_accumulatedUpdateTime / static_cast<FLOAT>(sm_uNumUpdates)
+        );
+        OutputDebugString(szMessage);
+
+        sm_accumulatedUpdateTime = 0.0f;
+        sm_uNumUpdates = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::reserveSpace
+      Summary:  Reserve space for vertices and indices vectors
+      Args:     UINT uNumVertices
+                  Number of vertices
+                UINT uNumIndices
+                  Number of indices
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::reserveSpace(
+        _In_ UINT uNumVertices, 
+        _In_ UINT uNumIndices
+    )
+    {
+        m_asset->aVertices.reserve(uNumVertices);
+        m_asset->aIndices.reserve(uNumIndices);
+        m_aBoneData.resize(uNumVertices);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::saveCache
+
+      Summary:  Writes everything the asset needs at runtime to the
+                model cache, in the order loadCache reads it
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Model::saveCache() const
+    {
+        ModelCacheWriter writer;
+
+        writer.Write(m_asset->GlobalInverseTransform);
+        writer.Write(m_bHasNormalMap);
+        writer.WriteArray(m_asset->aVertices);
+        writer.WriteArray(m_aNormalData);
+        writer.WriteArray(m_asset->aIndices);
+        writer.WriteArray(m_asset->aAnimationData);
+        writer.WriteArray(m_aMeshes);
+        writer.WriteArray(m_asset->aLodMeshes);
+        writer.WriteArray(m_asset->aMeshlets);
+        writer.WriteArray(m_asset->aMeshletOffsets);
+
+        writer.Write(static_cast<UINT>(m_asset->aMaterialTexturePaths.size()));
+        for (const MaterialTexturePaths& paths : m_asset->aMaterialTexturePaths)
+        {
+            writer.WriteString(paths.szDiffuse);
+            writer.WriteString(paths.szSpecularExponent);
+            writer.WriteString(paths.szNormal);
+        }
+
+        writer.Write(static_cast<UINT>(m_asset->boneNameToIndexMap.size()));
+        for (auto it = m_asset->boneNameToIndexMap.begin(); it != m_asset->boneNameToIndexMap.end(); ++it)
+        {
+            writer.WriteString(it->first);
+            writer.Write(it->second);
+        }
+
+        writer.WriteArray(m_asset->aSkeleton);
+        writer.Write(m_asset->bHasAnimation);
+        writer.Write(m_asset->TicksPerSecond);
+        writer.Write(m_asset->DurationTicks);
+        if (m_asset->bHasAnimation)
+        {
+            m_asset->Clip.Save(writer);
+        }
+
+        return writer.Save(getCachePath(), m_filePath, MODEL_CACHE_LAYOUT);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::optimizeMeshes
+
+      Summary:  Reorders the triangles of every mesh for the vertex
+                cache and for less overdraw, then the vertices in the
+                order the triangles use them, and prints the vertex
+                cache statistics before and after
+
+      Modifies: [m_asset, m_aBoneData].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::optimizeMeshes()
+    {
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        MeshOptimizer optimizer;
+        VertexCacheStats before = {};
+        VertexCacheStats after = {};
+        std::vector<UINT> aIndices;
+        std::vector<UINT> aRemap;
+
+        for (UINT i = 0u; i < static_cast<UINT>(m_aMeshes.size()); ++i)
+        {
+            const BasicMeshEntry& mesh = m_aMeshes[i];
+            const UINT uEndVertex = i + 1u < m_aMeshes.size() ? m_aMeshes[i + 1u].uBaseVertex : static_cast<UINT>(m_asset->aVertices.size());
+            const UINT uNumVertices = uEndVertex - mesh.uBaseVertex;
+            if (uNumVertices == 0u)
+            {
+                continue;
+            }
+
+            aIndices.resize(mesh.uNumIndices);
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
+            {
+                aIndices[j] = readIndex(m_asset->aIndices, mesh, j);
+            }
+
+            VertexCacheStats stats = MeshOptimizer::AnalyzeVertexCache(aIndices, uNumVertices);
+            before.uNumMisses += stats.uNumMisses;
+            before.uNumTriangles += stats.uNumTriangles;
+            before.uNumVertices += stats.uNumVertices;
+
+            optimizer.OptimizeVertexCache(aIndices, uNumVertices);
+            optimizer.OptimizeOverdraw(aIndices, &m_asset->aVertices[mesh.uBaseVertex], uNumVertices);
+            optimizer.OptimizeVertexFetch(aIndices, uNumVertices, aRemap);
+
+            stats = MeshOptimizer::AnalyzeVertexCache(aIndices, uNumVertices);
+            after.uNumMisses += stats.uNumMisses;
+            after.uNumTriangles += stats.uNumTriangles;
+            after.uNumVertices += stats.uNumVertices;
+
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
+            {
+                writeIndex(m_asset->aIndices, mesh, j, aIndices[j]);
+            }
+
+            RemapVertices(m_asset->aVertices, mesh.uBaseVertex, aRemap);
+            RemapVertices(m_aBoneData, mesh.uBaseVertex, aRemap);
+        }
+
+        QueryPerformanceCounter(&endTime);
+
+        const FLOAT numTriangles = static_cast<FLOAT>(before.uNumTriangles > 0u ? before.uNumTriangles : 1u);
+        const FLOAT numVertices = static_cast<FLOAT>(before.uNumVertices > 0u ? before.uNumVertices : 1u);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L": vertex cache ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, meshes reordered in %.3f ms\n",
+            static_cast<FLOAT>(before.uNumMisses) / numTriangles,
+            static_cast<FLOAT>(after.uNumMisses) / numTriangles,
+            static_cast<FLOAT>(before.uNumMisses) / numVertices,
+            static_cast<FLOAT>(after.uNumMisses) / numVertices,
+            static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart)
+        );
+        OutputDebugString(L"Model ");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugString(szMessage);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Model::generateTangents
+
+      Summary:  Generates the tangent frame of every vertex from the
+                triangles of its mesh. Meshes large enough to gain from
+                threads are spread over the job system set on the
+                model. Prints the time it took.
+
+      Modifies: [m_aNormalData].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Model::generateTangents()
+    {
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        const size_t uNumMeshes = m_aMeshes.size();
+        UINT uNumTriangles = 0u;
+        UINT uMaxNumMeshTriangles = 0u;
+        for (const BasicMeshEntry& mesh : m_aMeshes)
+        {
+            uNumTriangles += mesh.uNumIndices / 3u;
+            uMaxNumMeshTriangles = mesh.uNumIndices / 3u > uMaxNumMeshTriangles ? mesh.uNumIndices / 3u : uMaxNumMeshTriangles;
+        }
+
+        JobSystem* pJobSystem = uMaxNumMeshTriangles >= TangentGenerator::MIN_PARALLEL_TRIANGLES ? m_pJobSystem : nullptr;
+        TangentGenerator::ParallelFor parallelFor;
+        if (pJobSystem)
+        {
+            parallelFor = [pJobSystem](UINT uNumJobs, const std::function<void(UINT)>& job)
+            {
+                pJobSystem->ParallelFor(uNumJobs, job);
+            };
+        }
+
+        TangentGenerator generator;
+        std::vector<UINT> aIndices;
+        m_aNormalData.assign(m_asset->aVertices.size(), NormalData());
+
+        for (UINT i = 0u; i < static_cast<UINT>(uNumMeshes); ++i)
+        {
+            const BasicMeshEntry& mesh = m_aMeshes[i];
+            const UINT uEndVertex = i + 1u < uNumMeshes ? m_aMeshes[i + 1u].uBaseVertex : static_cast<UINT>(m_asset->aVertices.size());
+            const UINT uNumVertices = uEndVertex - mesh.uBaseVertex;
+            if (uNumVertices == 0u)
+            {
+                continue;
+            }
+
+            aIndices.resize(mesh.uNumIndices);
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
+            {
+                aIndices[j] = readIndex(m_asset->aIndices, mesh, j);
+            }
+
+            generator.Generate(
+                aIndices.data(),
+                mesh.uNumIndices,
+                &m_asset->aVertices[mesh.uBaseVertex],
+                uNumVertices,
+                &m_aNormalData[mesh.uBaseVertex],
+                parallelFor
+            );
+        }
+
+        QueryPerformanceCounter(&endTime);
 
-        FLOAT t1 = static_cast<FLOAT>(pNodeAnim->mScalingKeys[uScalingIndex].mTime);
-        FLOAT t2 = static_cast<FLOAT>(pNodeAnim->mScalingKeys[uNextScalingIndex].mTime);
-        FLOAT deltaTime = t2 - t1;
-        FLOAT factor = (animationTimeTicks - t1) / deltaTime;
-        assert(factor >= 0.0f && factor <= 1.0f);
-
-        const aiVector3D& start = pNodeAnim->mScalingKeys[uScalingIndex].mValue;
-        const aiVector3D& end = pNodeAnim->mScalingKeys[uNextScalingIndex].mValue;
-        aiVector3D delta = end - start;
-        outScale = ConvertVector3dToFloat3(start + factor * delta);
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L": tangent frames of %zu vertices and %u triangles generated in %.3f ms on %u threads\n",
+            m_aNormalData.size(),
+            uNumTriangles,
+            static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart),
+            pJobSystem ? pJobSystem->GetNumThreads() : 1u
+        );
+        OutputDebugString(L"Model ");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugString(szMessage);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::loadDiffuseTexture
+      Method:   Model::generateLods
 
-      Summary:  Load a diffuse texture from given path
+      Summary:  Simplifies every mesh into the levels of detail, each
+                from the one before with half of its triangles as the
+                target, reorders them for the vertex cache and appends
+                them to the index stream. A level that could not remove
+                a triangle within its error reuses the indices of the
+                level before. Prints the triangles and the error of
+                every level and the simplification throughput.
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const std::filesystem::path& parentDirectory
-                  Parent path to the model
-                const aiMaterial* pMaterial
-                  Pointer to an assimp material object
-                UINT uIndex
-                  Index to a material
+      Modifies: [m_asset].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    HRESULT Model::loadDiffuseTexture(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
-        _In_ const std::filesystem::path& parentDirectory,
-        _In_ const aiMaterial* pMaterial,
-        _In_ UINT uIndex
-    )
+    void Model::generateLods()
     {
-        HRESULT hr = S_OK;
-        m_aMaterials[uIndex]->pDiffuse = nullptr;
-
-        if (pMaterial->GetTextureCount(aiTextureType_DIFFUSE) > 0)
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        MeshSimplifier simplifier;
+        MeshOptimizer optimizer;
+        std::vector<UINT> aIndices;
+        UINT auNumTriangles[MeshLodSelector::NUM_LODS] = { 0u, };
+        FLOAT aMaxErrors[MeshLodSelector::NUM_LODS] = { 0.0f, };
+
+        const size_t uNumMeshes = m_aMeshes.size();
+        m_asset->aLodMeshes.resize((MeshLodSelector::NUM_LODS - 1u) * uNumMeshes);
+
+        for (UINT i = 0u; i < static_cast<UINT>(uNumMeshes); ++i)
         {
-            aiString aiPath;
+            const BasicMeshEntry& mesh = m_aMeshes[i];
+            const UINT uEndVertex = i + 1u < uNumMeshes ? m_aMeshes[i + 1u].uBaseVertex : static_cast<UINT>(m_asset->aVertices.size());
+            const UINT uNumVertices = uEndVertex - mesh.uBaseVertex;
 
-            if (pMaterial->GetTexture(aiTextureType_DIFFUSE, 0u, &aiPath, nullptr, nullptr, nullptr, nullptr, nullptr) == AI_SUCCESS)
+            aIndices.resize(mesh.uNumIndices);
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
             {
-                std::string szPath(aiPath.data);
+                aIndices[j] = readIndex(m_asset->aIndices, mesh, j);
+            }
+            auNumTriangles[0] += mesh.uNumIndices / 3u;
 
-                if (szPath.substr(0ull, 2ull) == ".\\")
+            BasicMeshEntry previousMesh = mesh;
+            for (UINT uLod = 1u; uLod < MeshLodSelector::NUM_LODS; ++uLod)
+            {
+                BasicMeshEntry& lodMesh = m_asset->aLodMeshes[(uLod - 1u) * uNumMeshes + i];
+                lodMesh = previousMesh;
+
+                if (uNumVertices > 0u)
                 {
-                    szPath = szPath.substr(2ull, szPath.size() - 2ull);
+                    const UINT uTargetNumIndices = (mesh.uNumIndices >> uLod) / 3u * 3u;
+                    const FLOAT error = simplifier.Simplify(
+                        aIndices,
+                        &m_asset->aVertices[mesh.uBaseVertex],
+                        &m_asset->aAnimationData[mesh.uBaseVertex],
+                        uNumVertices,
+                        uTargetNumIndices,
+                        MAX_LOD_ERRORS[uLod - 1u]
+                    );
+                    aMaxErrors[uLod] = fmaxf(aMaxErrors[uLod], error);
                 }
 
-                std::filesystem::path fullPath = parentDirectory / szPath;
-
-                m_aMaterials[uIndex]->pDiffuse = std::make_shared<Texture>(fullPath);
-
-                hr = m_aMaterials[uIndex]->pDiffuse->Initialize(pDevice, pImmediateContext);
-                if (FAILED(hr))
+                if (aIndices.size() < previousMesh.uNumIndices)
                 {
-                    OutputDebugString(L"Error loading diffuse texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
-
-                    return hr;
+                    optimizer.OptimizeVertexCache(aIndices, uNumVertices);
+
+                    // Appended in the format of the mesh, the 32 bit indices start on a 4 byte boundary
+                    lodMesh.uNumIndices = static_cast<UINT>(aIndices.size());
+                    if (lodMesh.IndexFormat == DXGI_FORMAT_R32_UINT)
+                    {
+                        m_asset->aIndices.resize(m_asset->aIndices.size() + (m_asset->aIndices.size() & 1u), 0u);
+                        lodMesh.uBaseIndex = static_cast<UINT>(m_asset->aIndices.size() / 2u);
+                        m_asset->aIndices.resize(m_asset->aIndices.size() + aIndices.size() * 2u);
+                    }
+                    else
+                    {
+                        lodMesh.uBaseIndex = static_cast<UINT>(m_asset->aIndices.size());
+                        m_asset->aIndices.resize(m_asset->aIndices.size() + aIndices.size());
+                    }
+
+                    for (UINT j = 0u; j < lodMesh.uNumIndices; ++j)
+                    {
+                        writeIndex(m_asset->aIndices, lodMesh, j, aIndices[j]);
+                    }
                 }
 
-                OutputDebugString(L"Loaded diffuse texture \"");
-                OutputDebugString(fullPath.c_str());
-                OutputDebugString(L"\"\n");
+                auNumTriangles[uLod] += lodMesh.uNumIndices / 3u;
+                previousMesh = lodMesh;
             }
         }
 
-        return hr;
+        QueryPerformanceCounter(&endTime);
+
+        const FLOAT milliseconds = static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+        const FLOAT numTriangles = static_cast<FLOAT>(auNumTriangles[0] > 0u ? auNumTriangles[0] : 1u);
+
+        // Every level is simplified from the level before
+        FLOAT numSimplifiedTriangles = 0.0f;
+        for (UINT uLod = 0u; uLod + 1u < MeshLodSelector::NUM_LODS; ++uLod)
+        {
+            numSimplifiedTriangles += static_cast<FLOAT>(auNumTriangles[uLod]);
+        }
+
+        WCHAR szMessage[256];
+        for (UINT uLod = 1u; uLod < MeshLodSelector::NUM_LODS; ++uLod)
+        {
+            swprintf_s(
+                szMessage,
+                L": LOD %u has %u triangles, %.1f%% of the imported meshes, largest error %.4f of the mesh extent\n",
+                uLod,
+                auNumTriangles[uLod],
+                static_cast<FLOAT>(auNumTriangles[uLod]) * 100.0f / numTriangles,
+                aMaxErrors[uLod]
+            );
+            OutputDebugString(L"Model ");
+            OutputDebugString(m_filePath.c_str());
+            OutputDebugString(szMessage);
+        }
+
+        swprintf_s(
+            szMessage,
+            L": %u triangles simplified into %u levels in %.3f ms, %.3g triangles/s\n",
+            auNumTriangles[0],
+            MeshLodSelector::NUM_LODS - 1u,
+            milliseconds,
+            numSimplifiedTriangles * 1000.0f / fmaxf(milliseconds, FLT_MIN)
+        );
+        OutputDebugString(L"Model ");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugString(szMessage);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-       Method:   Model::loadSpecularTexture
+      Method:   Model::buildMeshlets
 
-       Summary:  Load a specular texture from given path
+      Summary:  Splits every imported mesh into meshlets, checks them
+                and prints their size and the share of the triangles
+                the cone test culls from the six axis views. A mesh
+                whose meshlets fail the checks keeps none and is drawn
+                whole.
 
-       Args:     ID3D11Device* pDevice
-                   The Direct3D device to create the buffers
-                 ID3D11DeviceContext* pImmediateContext
-                   The Direct3D context to set buffers
-                 const std::filesystem::path& parentDirectory
-                   Parent path to the model
-                 const aiMaterial* pMaterial
-                   Pointer to an assimp material object
-                 UINT uIndex
-                   Index to a material
-     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+      Modifies: [m_asset].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    HRESULT Model::loadSpecularTexture(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
-        _In_ const std::filesystem::path& parentDirectory,
-        _In_ const aiMaterial* pMaterial,
-        _In_ UINT uIndex
-    )
+    void Model::buildMeshlets()
     {
-        HRESULT hr = S_OK;
-        m_aMaterials[uIndex]->pSpecularExponent = nullptr;
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
 
-        if (pMaterial->GetTextureCount(aiTextureType_SHININESS) > 0)
+        MeshletBuilder builder;
+        std::vector<UINT> aIndices;
+
+        const size_t uNumMeshes = m_aMeshes.size();
+        m_asset->aMeshlets.clear();
+        m_asset->aMeshletOffsets.assign(1u, 0u);
+
+        for (UINT i = 0u; i < static_cast<UINT>(uNumMeshes); ++i)
         {
-            aiString aiPath;
+            const BasicMeshEntry& mesh = m_aMeshes[i];
+            const UINT uEndVertex = i + 1u < uNumMeshes ? m_aMeshes[i + 1u].uBaseVertex : static_cast<UINT>(m_asset->aVertices.size());
+            const UINT uNumVertices = uEndVertex - mesh.uBaseVertex;
 
-            if (pMaterial->GetTexture(aiTextureType_SHININESS, 0u, &aiPath, nullptr, nullptr, nullptr, nullptr, nullptr) == AI_SUCCESS)
+            aIndices.resize(mesh.uNumIndices);
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
             {
-                std::string szPath(aiPath.data);
+                aIndices[j] = readIndex(m_asset->aIndices, mesh, j);
+            }
 
-                if (szPath.substr(0ull, 2ull) == ".\\")
-                {
-                    szPath = szPath.substr(2ull, szPath.size() - 2ull);
-                }
+            if (uNumVertices > 0u)
+            {
+                builder.Build(aIndices, &m_asset->aVertices[mesh.uBaseVertex], uNumVertices, m_asset->aMeshlets);
+            }
+            m_asset->aMeshletOffsets.push_back(static_cast<UINT>(m_asset->aMeshlets.size()));
+        }
 
-                std::filesystem::path fullPath = parentDirectory / szPath;
+        QueryPerformanceCounter(&endTime);
 
-                m_aMaterials[uIndex]->pSpecularExponent = std::make_shared<Texture>(fullPath);
+        MeshletStats stats = {};
+        for (UINT i = 0u; i < static_cast<UINT>(uNumMeshes); ++i)
+        {
+            const BasicMeshEntry& mesh = m_aMeshes[i];
+            const UINT uEndVertex = i + 1u < uNumMeshes ? m_aMeshes[i + 1u].uBaseVertex : static_cast<UINT>(m_asset->aVertices.size());
+            const UINT uFirstMeshlet = m_asset->aMeshletOffsets[i];
+            const UINT uNumMeshlets = m_asset->aMeshletOffsets[i + 1u] - uFirstMeshlet;
+            if (uNumMeshlets == 0u)
+            {
+                continue;
+            }
 
-                hr = m_aMaterials[uIndex]->pSpecularExponent->Initialize(pDevice, pImmediateContext);
-                if (FAILED(hr))
-                {
-                    OutputDebugString(L"Error loading specular texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
+            aIndices.resize(mesh.uNumIndices);
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
+            {
+                aIndices[j] = readIndex(m_asset->aIndices, mesh, j);
+            }
 
-                    return hr;
+            const BOOL bValid = builder.Analyze(
+                &m_asset->aMeshlets[uFirstMeshlet],
+                uNumMeshlets,
+                aIndices,
+                &m_asset->aVertices[mesh.uBaseVertex],
+                uEndVertex - mesh.uBaseVertex,
+                stats
+            );
+            assert(bValid);
+            if (!bValid)
+            {
+                m_asset->aMeshlets.erase(m_asset->aMeshlets.begin() + uFirstMeshlet, m_asset->aMeshlets.begin() + uFirstMeshlet + uNumMeshlets);
+                for (size_t j = i + 1u; j < m_asset->aMeshletOffsets.size(); ++j)
+                {
+                    m_asset->aMeshletOffsets[j] -= uNumMeshlets;
                 }
-
-                OutputDebugString(L"Loaded specular texture \"");
-                OutputDebugString(fullPath.c_str());
-                OutputDebugString(L"\"\n");
             }
         }
 
-        return hr;
+        // The cone test is conservative, it never culls a triangle that faces the camera
+        assert(stats.uNumWronglyCulledTriangles == 0u);
+
+        const FLOAT numMeshlets = static_cast<FLOAT>(stats.uNumMeshlets > 0u ? stats.uNumMeshlets : 1u);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L": %u meshlets of %.1f vertices and %.1f triangles on average, %u with a normal cone, built in %.3f ms\n",
+            stats.uNumMeshlets,
+            static_cast<FLOAT>(stats.uNumVertices) / numMeshlets,
+            static_cast<FLOAT>(stats.uNumTriangles) / numMeshlets,
+            stats.uNumCones,
+            static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart)
+        );
+        OutputDebugString(L"Model ");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugString(szMessage);
+
+        swprintf_s(
+            szMessage,
+            L": the cone test culls %.1f%% of the triangles seen along the axes, %u of them facing the view\n",
+            static_cast<FLOAT>(stats.uNumCulledTriangles) * 100.0f / static_cast<FLOAT>(stats.uNumViewedTriangles > 0u ? stats.uNumViewedTriangles : 1u),
+            stats.uNumWronglyCulledTriangles
+        );
+        OutputDebugString(L"Model ");
+        OutputDebugString(m_filePath.c_str());
+        OutputDebugString(szMessage);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::loadNormalTexture
+      Method:   Model::readIndex
 
-      Summary:  Load a normal texture from given path
+      Summary:  Reads an index of a mesh from the index stream
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const std::filesystem::path& parentDirectory
-                  Parent path to the model
-                const aiMaterial* pMaterial
-                  Pointer to an assimp material object
+      Args:     const std::vector<WORD>& aIndices
+                  Index stream
+                const BasicMeshEntry& mesh
+                  Mesh the index belongs to
                 UINT uIndex
-                  Index to a material
+                  Position of the index within the mesh
+
+      Returns:  UINT
+                  Vertex index, relative to the base vertex of the mesh
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    HRESULT Model::loadNormalTexture(
-        _In_ ID3D11Device* pDevice, 
-        _In_ ID3D11DeviceContext* pImmediateContext,
-        _In_ const std::filesystem::path& parentDirectory,
-        _In_ const aiMaterial* pMaterial, 
+    UINT Model::readIndex(
+        _In_ const std::vector<WORD>& aIndices,
+        _In_ const BasicMeshEntry& mesh,
         _In_ UINT uIndex
     )
     {
-        HRESULT hr = S_OK;
-        m_aMaterials[uIndex]->pNormal = nullptr;
-
-        if (pMaterial->GetTextureCount(aiTextureType_HEIGHT) > 0)
+        if (mesh.IndexFormat == DXGI_FORMAT_R32_UINT)
         {
-            aiString aiPath;
-
-            if (pMaterial->GetTexture(aiTextureType_HEIGHT, 0u, &aiPath, nullptr, nullptr, nullptr, nullptr, nullptr) == AI_SUCCESS)
-            {
-                std::string szPath(aiPath.data);
-
-                if (szPath.substr(0ull, 2ull) == ".\\")
-                {
-                    szPath = szPath.substr(2ull, szPath.size() - 2ull);
-                }
-
-                std::filesystem::path fullPath = parentDirectory / szPath;
-
-                m_aMaterials[uIndex]->pNormal = std::make_shared<Texture>(fullPath);
-                m_bHasNormalMap = true;
-
-                if (FAILED(hr))
-                {
-                    OutputDebugString(L"Error loading normal texture \"");
-                    OutputDebugString(fullPath.c_str());
-                    OutputDebugString(L"\"\n");
-
-                    return hr;
-                }
-
-                OutputDebugString(L"Loaded normal texture \"");
-                OutputDebugString(fullPath.c_str());
-                OutputDebugString(L"\"\n");
-            }
+            const size_t uWord = (static_cast<size_t>(mesh.uBaseIndex) + uIndex) * 2u;
+            return static_cast<UINT>(aIndices[uWord]) | (static_cast<UINT>(aIndices[uWord + 1u]) << 16u);
         }
 
-        return hr;
+        return aIndices[static_cast<size_t>(mesh.uBaseIndex) + uIndex];
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::loadTextures
+      Method:   Model::writeIndex
 
-      Summary:  Load a specular texture from given path
+      Summary:  Overwrites an index of a mesh in the index stream
 
-      Args:     ID3D11Device* pDevice
-                  The Direct3D device to create the buffers
-                ID3D11DeviceContext* pImmediateContext
-                  The Direct3D context to set buffers
-                const std::filesystem::path& parentDirectory
-                  Parent path to the model
-                const aiMaterial* pMaterial
-                  Pointer to an assimp material object
+      Args:     std::vector<WORD>& aIndices
+                  Index stream
+                const BasicMeshEntry& mesh
+                  Mesh the index belongs to
                 UINT uIndex
-                  Index to a material
+                  Position of the index within the mesh
+                UINT uValue
+                  Vertex index, relative to the base vertex of the mesh
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    HRESULT Model::loadTextures(
-        _In_ ID3D11Device* pDevice,
-        _In_ ID3D11DeviceContext* pImmediateContext,
-        _In_ const std::filesystem::path& parentDirectory, 
-        _In_ const aiMaterial* pMaterial,
-        _In_ UINT uIndex
+    void Model::writeIndex(
+        _Inout_ std::vector<WORD>& aIndices,
+        _In_ const BasicMeshEntry& mesh,
+        _In_ UINT uIndex,
+        _In_ UINT uValue
     )
     {
-        HRESULT hr = loadDiffuseTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
-
-        hr = loadSpecularTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
-        if (FAILED(hr))
+        if (mesh.IndexFormat == DXGI_FORMAT_R32_UINT)
         {
-            return hr;
+            const size_t uWord = (static_cast<size_t>(mesh.uBaseIndex) + uIndex) * 2u;
+            aIndices[uWord] = static_cast<WORD>(uValue & 0xFFFFu);
+            aIndices[uWord + 1u] = static_cast<WORD>(uValue >> 16u);
         }
-
-        hr = loadNormalTexture(pDevice, pImmediateContext, parentDirectory, pMaterial, uIndex);
-        if (FAILED(hr))
+        else
         {
-            return hr;
+            assert(uValue <= 0xFFFFu);
+            aIndices[static_cast<size_t>(mesh.uBaseIndex) + uIndex] = static_cast<WORD>(uValue);
         }
-
-        return hr;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::readNodeHierarchy
+      Method:   Model::storeDualQuaternion
 
-      Summary:  Calculate bone transformation of the given assimp node
+      Summary:  Converts the transform of a bone to a unit dual
+                quaternion. Dual quaternions are rigid, the scaling of
+                the transform is dropped.
 
-      Args:     FLOAT animationTimeTicks
-                  Animation time
-               const aiNode* pNode
-                  Pointer to an assimp node object
-                const XMMATRIX& parentTransform
-                  Parent transform in hierarchy
+      Args:     DualQuaternion& outDualQuaternion
+                  Dual quaternion of the bone
+                const XMMATRIX& boneTransform
+                  Final transform of the bone
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
-    
-    void Model::readNodeHierarchy(
-        _In_ FLOAT animationTimeTicks,
-        _In_ const aiNode* pNode,
-        _In_ const XMMATRIX& parentTransform
+
+    void Model::storeDualQuaternion(
+        _Out_ DualQuaternion& outDualQuaternion,
+        _In_ const XMMATRIX& boneTransform
     )
     {
-        XMMATRIX nodeTransform = ConvertMatrix(pNode->mTransformation);
-        const aiAnimation* pAnim = m_pScene->mAnimations[0];
-        const aiNodeAnim* pNodeAnim = findNodeAnimOrNull(pAnim, pNode->mName.C_Str());
-
-        if (pNodeAnim)
+        XMVECTOR scaling;
+        XMVECTOR rotation;
+        XMVECTOR translation;
+        if (!XMMatrixDecompose(&scaling, &rotation, &translation, boneTransform))
         {
-            // Scaling matrix
-            XMFLOAT3 scaling = XMFLOAT3();
-            interpolateScaling(scaling, animationTimeTicks, pNodeAnim);
-            XMMATRIX sMatrix = XMMatrixScaling(scaling.x, scaling.y, scaling.z);
-
-            // Rotation matrix
-            XMVECTOR rotation = XMVECTOR();
-            interpolateRotation(rotation, animationTimeTicks, pNodeAnim);
-            XMMATRIX rMatrix = XMMatrixRotationQuaternion(rotation);
-
-            // Translation matrix
-            XMFLOAT3 translation = XMFLOAT3();
-            interpolatePosition(translation, animationTimeTicks, pNodeAnim);
-            XMMATRIX tMatrix = XMMatrixTranslation(translation.x, translation.y, translation.z);
-
-            // Transform matrix
-            nodeTransform = sMatrix * rMatrix * tMatrix;
+            rotation = XMQuaternionIdentity();
+            translation = boneTransform.r[3];
         }
 
-        XMMATRIX globalTransform = nodeTransform * parentTransform;
-
-        if (m_boneNameToIndexMap.contains(pNode->mName.C_Str()))
-        {
-            UINT boneIndex = m_boneNameToIndexMap[pNode->mName.C_Str()];
-            m_aBoneInfo[boneIndex].FinalTransformation = m_aBoneInfo[boneIndex].OffsetMatrix * globalTransform * m_globalInverseTransform;
-        }
+        // Dual = translation * real / 2, XMQuaternionMultiply(q1, q2) returns q2 * q1
+        const XMVECTOR dual = XMVectorScale(XMQuaternionMultiply(rotation, XMVectorSetW(translation, 0.0f)), 0.5f);
 
-        for (UINT i = 0u; i < pNode->mNumChildren; ++i)
-        {
-            readNodeHierarchy(animationTimeTicks, pNode->mChildren[i], globalTransform);
-        }
+        XMStoreFloat4(&outDualQuaternion.Real, rotation);
+        XMStoreFloat4(&outDualQuaternion.Dual, dual);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Model::reserveSpace
-      Summary:  Reserve space for vertices and indices vectors
-      Args:     UINT uNumVertices
-                  Number of vertices
-                UINT uNumIndices
-                  Number of indices
+      Method:   Model::validateIndices
+
+      Summary:  Checks that the indices of every mesh and of its
+                simplified levels lie within the index stream in the
+                format of the mesh and address a vertex of the mesh
+
+      Returns:  BOOL
+                  TRUE if every index can be drawn
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Model::reserveSpace(
-        _In_ UINT uNumVertices, 
-        _In_ UINT uNumIndices
-    )
+    BOOL Model::validateIndices() const
     {
-        m_aVertices.reserve(uNumVertices);
-        m_aIndices.reserve(uNumIndices);
-        m_aBoneData.resize(uNumVertices);
+        for (size_t i = 0u; i < m_aMeshes.size(); ++i)
+        {
+            const BasicMeshEntry& mesh = m_aMeshes[i];
+            const size_t uEndVertex = i + 1u < m_aMeshes.size() ? m_aMeshes[i + 1u].uBaseVertex : m_asset->aVertices.size();
+            if (uEndVertex < mesh.uBaseVertex || uEndVertex > m_asset->aVertices.size())
+            {
+                return FALSE;
+            }
+
+            const size_t uNumVertices = uEndVertex - mesh.uBaseVertex;
+            for (size_t uLod = 0u; uLod < MeshLodSelector::NUM_LODS; ++uLod)
+            {
+                const BasicMeshEntry* pLodMesh = &mesh;
+                if (uLod > 0u)
+                {
+                    // The levels are only there once they are generated or read from the cache
+                    const size_t uLodMeshIndex = (uLod - 1u) * m_aMeshes.size() + i;
+                    if (uLodMeshIndex >= m_asset->aLodMeshes.size())
+                    {
+                        break;
+                    }
+                    pLodMesh = &m_asset->aLodMeshes[uLodMeshIndex];
+                }
+
+                const BasicMeshEntry& lodMesh = *pLodMesh;
+                size_t uEndWord = static_cast<size_t>(lodMesh.uBaseIndex) + lodMesh.uNumIndices;
+                if (lodMesh.IndexFormat == DXGI_FORMAT_R32_UINT)
+                {
+                    uEndWord *= 2u;
+                }
+                else if (lodMesh.IndexFormat != DXGI_FORMAT_R16_UINT)
+                {
+                    return FALSE;
+                }
+                if (uEndWord > m_asset->aIndices.size())
+                {
+                    return FALSE;
+                }
+
+                for (UINT j = 0u; j < lodMesh.uNumIndices; ++j)
+                {
+                    if (readIndex(m_asset->aIndices, lodMesh, j) >= uNumVertices)
+                    {
+                        return FALSE;
+                    }
+                }
+            }
+        }
+
+        return TRUE;
     }
 }
\ No newline at end of file
@@ -12,8 +12,25 @@
 #pragma once
 
 #include "Common.h"
+
+#include <future>
+#include <mutex>
+
+#include "Model/AnimationClip.h"
+#include "Model/AnimationLod.h"
+#include "Model/BoneWeightPacker.h"
+#include "Model/CpuSkinning.h"
+#include "Model/ModelAsset.h"
+#include "Model/MeshLod.h"
+#include "Model/Meshlet.h"
+#include "Model/MeshOptimizer.h"
+#include "Model/MeshSimplifier.h"
+#include "Model/ModelCache.h"
+#include "Model/VertexPacker.h"
 #include "Renderer/DataTypes.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/TangentGenerator.h"
+#include "Scene/JobSystem.h"
 #include "Shader/PixelShader.h"
 #include "Shader/VertexShader.h"
 #include "Texture/Material.h"
@@ -24,39 +41,76 @@ struct aiMaterial;
 struct aiAnimation;
 struct aiBone;
 struct aiNode;
-struct aiNodeAnim;
-
-namespace Assimp
-{
-    class Importer;
-}
 
 namespace library
 {
+    /*E+E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E+++E
+        Enum:     eSkinningMode
+
+        Summary:  Enumeration of the ways the bones of a vertex are
+                  blended
+    E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E---E-E*/
+    enum class eSkinningMode : UINT
+    {
+        LINEAR_BLEND = 0,
+        DUAL_QUATERNION,
+        COUNT,
+    };
+
     /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
       Class:    Model
 
       Summary:  Model class is a renderable from model files
 
       Methods:  Initialize
-                  Pure virtual function that initializes the object
+                  Shares or loads the asset of the model file and
+                  creates the buffers of the instance
                 Update
-                  Pure virtual function that updates the object each
-                  frame
-                GetVertexBuffer
-                  Returns the vertex buffer
-                GetIndexBuffer
-                  Returns the index buffer
-                GetConstantBuffer
-                  Returns the constant buffer
-                GetWorldMatrix
-                  Returns the world matrix
+                  Samples the animation clip at the rate of the
+                  animation LOD and uploads the bone transforms
+                SetJobSystem
+                  Sets the job system the loading of the model file
+                  is spread over
+                GetAnimationBuffer
+                  Returns the buffer of the bone indices and weights
+                GetBoneTransformsBuffer
+                  Returns the buffer of the bone transforms
+                GetBoneTransformsView
+                  Returns the view of the bone transforms
                 GetNumVertices
-                  Pure virtual function that returns the number of
-                  vertices
+                  Returns the number of vertices
                 GetNumIndices
-                  Pure virtual function that returns the number of
-                  indices
+                  Returns the number of indices
+                GetBoneTransforms
+                  Returns the 3x4 bone transforms of the current pose
+                GetBoneDualQuaternions
+                  Returns the dual quaternions of the current pose
+                GetSkinningMode
+                  Returns how the bones of a vertex are blended
+                GetAnimationLod
+                  Returns the animation LOD
+                SetAnimationLod
+                  Sets the animation LOD
+                GetBoneTransformsVersion
+                  Returns the number of poses uploaded so far
+                GetPositionScale
+                  Returns the scale that decodes packed positions
+                GetPositionOffset
+                  Returns the offset that decodes packed positions
+                GetMeshLod
+                  Returns the mesh LOD drawn
+                SetMeshLod
+                  Sets the mesh LOD drawn
+                GetLodMesh
+                  Returns a mesh at the current mesh LOD
+                CullMeshlets
+                  Gathers the meshlets that pass the culler
+                GetVisibleMeshes
+                  Returns the meshes gathered by CullMeshlets
+                GetBoneNameToIndexMap
+                  Returns the bone index of every bone name
+                CreateCpuSkinning
+                  Creates the CPU skinning of the model
                 Model
                   Constructor.
                 ~Model
@@ -64,9 +118,13 @@ namespace library
     C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
     class Model : public Renderable
     {
+    public:
+        static constexpr const UINT INVALID_INDEX = (0xFFFFFFFF);
+        static constexpr const PCWSTR CACHE_EXTENSION = L".modelcache";
+
     public:
         Model() = delete;
-        Model(_In_ const std::filesystem::path& filePath);
+        Model(_In_ const std::filesystem::path& filePath, _In_opt_ eSkinningMode skinningMode = eSkinningMode::LINEAR_BLEND);
         Model(const Model& other) = delete;
         Model(Model&& other) = delete;
         Model& operator=(const Model& other) = delete;
@@ -75,69 +133,82 @@ namespace library
 
         virtual HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
         virtual void Update(_In_ FLOAT deltaTime) override;
+        void SetJobSystem(_In_opt_ JobSystem* pJobSystem);
 
         ComPtr<ID3D11Buffer>& GetAnimationBuffer();
-        ComPtr<ID3D11Buffer>& GetSkinningConstantBuffer();
+        ComPtr<ID3D11Buffer>& GetBoneTransformsBuffer();
+        ComPtr<ID3D11ShaderResourceView>& GetBoneTransformsView();
 
         virtual UINT GetNumVertices() const override;
         virtual UINT GetNumIndices() const override;
 
-        std::vector<XMMATRIX>& GetBoneTransforms();
+        const std::vector<XMFLOAT3X4A>& GetBoneTransforms() const;
+        const std::vector<DualQuaternion>& GetBoneDualQuaternions() const;
+        eSkinningMode GetSkinningMode() const;
+        const AnimationLod& GetAnimationLod() const;
+        void SetAnimationLod(_In_ const AnimationLod& animationLod);
+        UINT64 GetBoneTransformsVersion() const;
+        const XMFLOAT4& GetPositionScale() const;
+        const XMFLOAT4& GetPositionOffset() const;
+        UINT GetMeshLod() const;
+        void SetMeshLod(_In_ UINT uMeshLod);
+        const BasicMeshEntry& GetLodMesh(_In_ UINT uMeshIndex) const;
+        void CullMeshlets(_In_ const MeshletCuller& meshletCuller);
+        const std::vector<BasicMeshEntry>& GetVisibleMeshes() const;
         const std::unordered_map<std::string, UINT>& GetBoneNameToIndexMap() const;
 
-    protected:
-        struct VertexBoneData
-        {
-            VertexBoneData()
-                : aBoneIds{ 0u, }
-                , aWeights{ 0.0f, }
-                , uNumBones(0u)
-            {
-                ZeroMemory(aBoneIds, ARRAYSIZE(aBoneIds) * sizeof(aBoneIds[0]));
-                ZeroMemory(aWeights, ARRAYSIZE(aWeights) * sizeof(aWeights[0]));
-            }
-
-            void AddBoneData(_In_ UINT uBoneId, _In_ FLOAT weight)
-            {
-                assert(uNumBones < ARRAYSIZE(aBoneIds));
-
-                aBoneIds[uNumBones] = uBoneId;
-                aWeights[uNumBones] = weight;
-
-                static CHAR szDebugMessage[256];
-                sprintf_s(szDebugMessage, "\t\t\tBone %d, weight: %f, index %u\n", uBoneId, weight, uNumBones);
-                OutputDebugStringA(szDebugMessage);
-
-                ++uNumBones;
-            }
+        std::unique_ptr<CpuSkinning> CreateCpuSkinning() const;
 
-            UINT aBoneIds[MAX_NUM_BONES_PER_VERTEX];
-            FLOAT aWeights[MAX_NUM_BONES_PER_VERTEX];
-            UINT uNumBones;
-        };
+    protected:
+        static XMMATRIX loadDualQuaternion(_In_ const DualQuaternion& dualQuaternion);
+        static void storeDualQuaternion(_Out_ DualQuaternion& outDualQuaternion, _In_ const XMMATRIX& boneTransform);
+        static UINT readIndex(_In_ const std::vector<WORD>& aIndices, _In_ const BasicMeshEntry& mesh, _In_ UINT uIndex);
+        static void writeIndex(_Inout_ std::vector<WORD>& aIndices, _In_ const BasicMeshEntry& mesh, _In_ UINT uIndex, _In_ UINT uValue);
+        static std::shared_ptr<ModelAsset> createAsset();
 
+    protected:
         struct BoneInfo
         {
             BoneInfo() = default;
             BoneInfo(const XMMATRIX& Offset)
                 : OffsetMatrix(Offset)
-                , FinalTransformation()
             {
             }
 
             XMMATRIX OffsetMatrix;
-            XMMATRIX FinalTransformation;
         };
 
+        void appendIndex(_In_ UINT uMeshIndex, _In_ UINT uValue);
+        HRESULT bakeAnimation(_In_ ID3D11Device* pDevice, _In_ FLOAT frameRate);
+        void blendKeyPoses(_In_ FLOAT factor);
+        void buildMeshlets();
         void countVerticesAndIndices(_Inout_ UINT& uOutNumVertices, _Inout_ UINT& uOutNumIndices, _In_ const aiScene* pScene);
-        const aiNodeAnim* findNodeAnimOrNull(_In_ const aiAnimation* pAnimation, _In_ PCSTR pszNodeName);
-        UINT findPosition(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        UINT findRotation(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        UINT findScaling(_In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
+        void evaluateGlobalTransforms(_In_ FLOAT animationTimeTicks, _In_ BOOL bSkipLeafBones, _Inout_ std::vector<XMMATRIX>& aGlobalTransforms) const;
+        void evaluatePose(
+            _In_ FLOAT animationTimeTicks,
+            _In_ BOOL bSkipLeafBones,
+            _Inout_ std::vector<XMMATRIX>& aGlobalTransforms,
+            _Out_ XMFLOAT3X4A* aBoneTransforms
+        ) const;
+        void evaluatePose(
+            _In_ FLOAT animationTimeTicks,
+            _In_ BOOL bSkipLeafBones,
+            _Inout_ std::vector<XMMATRIX>& aGlobalTransforms,
+            _Out_ DualQuaternion* aBoneDualQuaternions
+        ) const;
+        void generateLods();
+        void generateTangents();
         UINT getBoneId(_In_ const aiBone* pBone);
+        std::filesystem::path getCachePath() const;
         const virtual SimpleVertex* getVertices() const override;
         virtual const WORD* getIndices() const override;
+        virtual UINT getIndexBufferByteWidth() const override;
+        virtual HRESULT initializeVertexBuffers(_In_ ID3D11Device* pDevice) override;
         void initAllMeshes(_In_ const aiScene* pScene);
+        void initCachedMaterials(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        HRESULT initAnimationClip(_In_ const aiAnimation* pAnimation);
+        void initSkeleton(_In_ const aiScene* pScene, _In_ const aiNode* pNode, _In_ UINT uParentIndex);
+        HRESULT initFromAsset(_In_ ID3D11Device* pDevice);
         HRESULT initFromScene(
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext,
@@ -153,9 +224,12 @@ namespace library
         void initMeshBones(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh);
         void initMeshSingleBone(_In_ UINT uBoneIndex, _In_ const aiBone* pBone);
         virtual void initSingleMesh(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh);
-        void interpolatePosition(_Inout_ XMFLOAT3& outTranslate, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        void interpolateRotation(_Inout_ XMVECTOR& outQuaternion, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
-        void interpolateScaling(_Inout_ XMFLOAT3& outScale, _In_ FLOAT animationTimeTicks, _In_ const aiNodeAnim* pNodeAnim);
+        virtual BOOL isAssetShared() const;
+        virtual BOOL isVertexFormatPacked() const;
+        HRESULT loadAsset(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        HRESULT loadCache(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        FLOAT measureDualQuaternionError(_In_ UINT uNumPoses) const;
+        void optimizeMeshes();
         HRESULT loadDiffuseTexture(
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext,
@@ -184,32 +258,56 @@ namespace library
             _In_ const aiMaterial* pMaterial,
             _In_ UINT uIndex
         );
-        void readNodeHierarchy(_In_ FLOAT animationTimeTicks, _In_ const aiNode* pNode, _In_ const XMMATRIX& parentTransform);
+        void reportLoad(_In_ FLOAT milliseconds);
+        void reportUpdate(_In_ FLOAT milliseconds);
         void reserveSpace(_In_ UINT uNumVertices, _In_ UINT uNumIndices);
+        HRESULT saveCache() const;
+        BOOL validateIndices() const;
 
     protected:
-        static std::unique_ptr<Assimp::Importer> sm_pImporter;
+        static constexpr const UINT REPORT_INTERVAL = 1000u;
+        static constexpr const UINT MAX_CLIP_FRAMES = 4096u;
+        static constexpr const UINT NUM_DUAL_QUATERNION_TEST_POSES = 64u;
+        static constexpr const UINT NUM_SKIPPED_LEAF_LEVELS = 2u;
+        static constexpr const UINT MAX_NUM_16_BIT_INDEXED_VERTICES = 0x10000u;
+        static constexpr const FLOAT MAX_PACKED_NORMAL_ANGLE = 0.05f;
+        static constexpr const FLOAT MAX_PACKED_TANGENT_ANGLE = 0.5f;
+        // Largest distance the surface of each simplified level may move, as a fraction of the extent of the mesh
+        static constexpr const FLOAT MAX_LOD_ERRORS[MeshLodSelector::NUM_LODS - 1u] = { 0.01f, 0.02f, 0.04f };
+
+        static std::unordered_map<std::wstring, std::shared_future<std::weak_ptr<ModelAsset>>> sm_assetCache;
+        static std::mutex sm_assetCacheMutex;
+        static std::mutex sm_immediateContextMutex;
+        static std::mutex sm_reportMutex;
+        static FLOAT sm_accumulatedUpdateTime;
+        static UINT sm_uNumUpdates;
 
     protected:
         std::filesystem::path m_filePath;
+        std::shared_ptr<ModelAsset> m_asset;
+        JobSystem* m_pJobSystem;
 
-        ComPtr<ID3D11Buffer> m_animationBuffer;
-        ComPtr<ID3D11Buffer> m_skinningConstantBuffer;
+        ComPtr<ID3D11Buffer> m_boneTransformsBuffer;
+        ComPtr<ID3D11ShaderResourceView> m_boneTransformsView;
 
-        std::vector<SimpleVertex> m_aVertices;
-        std::vector<AnimationData> m_aAnimationData;
-        std::vector<WORD> m_aIndices;
         std::vector<VertexBoneData> m_aBoneData;
         std::vector<BoneInfo> m_aBoneInfo;
-        std::vector<XMMATRIX> m_aTransforms;
-        std::unordered_map<std::string, UINT> m_boneNameToIndexMap;
+        std::vector<XMMATRIX> m_aGlobalTransforms;
+        std::vector<XMFLOAT3X4A> m_aBoneTransforms;
+        std::vector<DualQuaternion> m_aBoneDualQuaternions;
+        eSkinningMode m_skinningMode;
 
-        const aiScene* m_pScene;
+        AnimationLod m_animationLod;
+        std::vector<XMFLOAT3X4A> m_aPreviousKeyBoneTransforms;
+        std::vector<XMFLOAT3X4A> m_aNextKeyBoneTransforms;
+        std::vector<DualQuaternion> m_aPreviousKeyBoneDualQuaternions;
+        std::vector<DualQuaternion> m_aNextKeyBoneDualQuaternions;
+        UINT m_uKeyPoseFrame;
+        UINT m_uKeyPoseInterval;
+        UINT m_uMeshLod;
+        std::vector<BasicMeshEntry> m_aVisibleMeshes;
 
         float m_timeSinceLoaded;
-
-        XMMATRIX m_globalInverseTransform;
-
-        //BYTE m_padding[8];
+        UINT64 m_uBoneTransformsVersion;
     };
 }
\ No newline at end of file
@@ -0,0 +1,108 @@
+/*+===================================================================
+  File:      MODELASSET.H
+
+  Summary:   ModelAsset header file contains declarations of the data
+             imported from a model file once and shared by every Model
+             instance of that file.
+
+  Structs: SkeletonNode, MaterialTexturePaths, ModelAsset
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Model/AnimationClip.h"
+#include "Model/BakedAnimation.h"
+#include "Model/Meshlet.h"
+#include "Renderer/DataTypes.h"
+#include "Renderer/Renderable.h"
+#include "Texture/Material.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SkeletonNode
+
+      Summary:  Node of the flattened hierarchy. Parents are stored
+                before their children, so the global transforms are
+                computed in a single pass. The height is the number of
+                levels below the node, 0 for a leaf.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SkeletonNode
+    {
+        XMMATRIX LocalTransform;
+        XMMATRIX OffsetMatrix;
+        UINT uParentIndex;
+        UINT uChannelIndex;
+        UINT uBoneIndex;
+        UINT uHeight;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   MaterialTexturePaths
+
+      Summary:  Paths of the textures of a material relative to the
+                directory of the model file, empty when the material
+                has no such texture
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct MaterialTexturePaths
+    {
+        std::string szDiffuse;
+        std::string szSpecularExponent;
+        std::string szNormal;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ModelAsset
+
+      Summary:  Immutable data of a model file: the GPU buffers, the
+                CPU copies of the geometry, of its simplified levels and
+                of its meshlets, the materials, the skeleton and the
+                compressed animation, with its bone palettes once baked
+                for crowds. Nothing refers to the assimp scene, which is
+                freed once the asset is extracted from it. Everything
+                but the baked palettes is stored in the model cache.
+                Instances hold it through a shared pointer and keep
+                only their pose and world transform of their own.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct ModelAsset
+    {
+        ComPtr<ID3D11Buffer> VertexBuffer;
+        ComPtr<ID3D11Buffer> NormalBuffer;
+        ComPtr<ID3D11Buffer> IndexBuffer;
+        ComPtr<ID3D11Buffer> AnimationBuffer;
+
+        std::vector<SimpleVertex> aVertices;
+        std::vector<WORD> aIndices;
+        std::vector<AnimationData> aAnimationData;
+        std::vector<Renderable::BasicMeshEntry> aMeshes;
+
+        // Simplified levels of every mesh, level l of mesh i at (l - 1) * aMeshes.size() + i, indexed in aIndices
+        std::vector<Renderable::BasicMeshEntry> aLodMeshes;
+
+        // Meshlets of the imported meshes, those of mesh i from aMeshletOffsets[i] to aMeshletOffsets[i + 1]
+        std::vector<Meshlet> aMeshlets;
+        std::vector<UINT> aMeshletOffsets;
+        std::vector<std::shared_ptr<Material>> aMaterials;
+        std::vector<MaterialTexturePaths> aMaterialTexturePaths;
+
+        std::unordered_map<std::string, UINT> boneNameToIndexMap;
+        std::vector<SkeletonNode> aSkeleton;
+        AnimationClip Clip;
+        std::unique_ptr<BakedAnimation> pBakedAnimation;
+        FLOAT TicksPerSecond;
+        FLOAT DurationTicks;
+        BOOL bHasAnimation;
+
+        BoundingSphere BoundingSphere;
+        XMFLOAT4 PositionScale;
+        XMFLOAT4 PositionOffset;
+        XMMATRIX GlobalInverseTransform;
+        BOOL bHasNormalMap;
+        BOOL bLoadedFromCache;
+
+        size_t uNumBytes;
+    };
+}
@@ -0,0 +1,423 @@
+#include "Model/ModelCache.h"
+
+#include "assimp/postprocess.h"	// post processing flags
+
+#include <fstream>
+
+namespace library
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: DescribeSource
+
+      Summary:  Fills the part of a cache header that identifies the
+                source file
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the model file
+                UINT uLayout
+                  Layout of the structs stored in the cache
+                ModelCacheHeader& outHeader
+                  Header, every field but the number of bytes
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+
+    static HRESULT DescribeSource(
+        _In_ const std::filesystem::path& sourcePath,
+        _In_ UINT uLayout,
+        _Out_ ModelCacheHeader& outHeader
+    )
+    {
+        outHeader = ModelCacheHeader{};
+
+        std::error_code error;
+        const UINT64 uSourceSize = static_cast<UINT64>(std::filesystem::file_size(sourcePath, error));
+        if (error)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(sourcePath, error);
+        if (error)
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        outHeader.uMagic = ModelCacheWriter::MAGIC;
+        outHeader.uVersion = ModelCacheWriter::FORMAT_VERSION;
+        outHeader.uLayout = uLayout;
+        outHeader.uLoadFlags = static_cast<UINT>(ASSIMP_LOAD_FLAGS);
+        outHeader.uSourceSize = uSourceSize;
+        outHeader.sourceWriteTime = static_cast<INT64>(writeTime.time_since_epoch().count());
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheWriter::ModelCacheWriter
+
+      Summary:  Constructor
+
+      Modifies: [m_aBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ModelCacheWriter::ModelCacheWriter()
+        : m_aBytes()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheWriter::WriteString
+
+      Summary:  Appends the length and the characters of a string
+
+      Args:     const std::string& szValue
+                  String to append
+
+      Modifies: [m_aBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void ModelCacheWriter::WriteString(
+        _In_ const std::string& szValue
+    )
+    {
+        Write(static_cast<UINT>(szValue.size()));
+        append(szValue.data(), szValue.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheWriter::Save
+
+      Summary:  Writes the header describing the source file followed
+                by the appended bytes. The file is written under a
+                temporary name and renamed, so a reader never maps a
+                partial cache.
+
+      Args:     const std::filesystem::path& cachePath
+                  Path to the cache file
+                const std::filesystem::path& sourcePath
+                  Path to the model file the cache was built from
+                UINT uLayout
+                  Layout of the stored structs
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT ModelCacheWriter::Save(
+        _In_ const std::filesystem::path& cachePath,
+        _In_ const std::filesystem::path& sourcePath,
+        _In_ UINT uLayout
+    ) const
+    {
+        ModelCacheHeader header;
+        HRESULT hr = DescribeSource(sourcePath, uLayout, header);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+        header.uNumBytes = static_cast<UINT64>(m_aBytes.size());
+
+        std::filesystem::path temporaryPath = cachePath;
+        temporaryPath += L".tmp";
+
+        {
+            std::ofstream outputFile(temporaryPath, std::ios::binary | std::ios::trunc);
+            outputFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            outputFile.write(reinterpret_cast<const char*>(m_aBytes.data()), static_cast<std::streamsize>(m_aBytes.size()));
+            if (!outputFile)
+            {
+                return E_FAIL;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, cachePath, error);
+        if (error)
+        {
+            std::filesystem::remove(temporaryPath, error);
+            return E_FAIL;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheWriter::align
+
+      Summary:  Pads the bytes to the next multiple of ALIGNMENT
+
+      Modifies: [m_aBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void ModelCacheWriter::align()
+    {
+        m_aBytes.resize((m_aBytes.size() + ALIGNMENT - 1u) & ~(ALIGNMENT - 1u), 0u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheWriter::append
+
+      Summary:  Appends raw bytes
+
+      Args:     const void* pData
+                  Bytes to append
+                size_t uNumBytes
+                  Number of bytes
+
+      Modifies: [m_aBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void ModelCacheWriter::append(
+        _In_reads_bytes_(uNumBytes) const void* pData,
+        _In_ size_t uNumBytes
+    )
+    {
+        const BYTE* pBytes = static_cast<const BYTE*>(pData);
+        m_aBytes.insert(m_aBytes.end(), pBytes, pBytes + uNumBytes);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheReader::ModelCacheReader
+
+      Summary:  Constructor
+
+      Modifies: [m_hFile, m_hMapping, m_pBytes, m_uNumBytes, m_uOffset,
+                 m_bFailed].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ModelCacheReader::ModelCacheReader()
+        : m_hFile(INVALID_HANDLE_VALUE)
+        , m_hMapping(nullptr)
+        , m_pBytes(nullptr)
+        , m_uNumBytes(0u)
+        , m_uOffset(0u)
+        , m_bFailed(TRUE)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheReader::~ModelCacheReader
+
+      Summary:  Destructor, unmaps the file
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ModelCacheReader::~ModelCacheReader()
+    {
+        close();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheReader::Open
+
+      Summary:  Maps the cache file and checks its header against the
+                source file
+
+      Args:     const std::filesystem::path& cachePath
+                  Path to the cache file
+                const std::filesystem::path& sourcePath
+                  Path to the model file
+                UINT uLayout
+                  Layout of the structs the caller reads
+
+      Modifies: [m_hFile, m_hMapping, m_pBytes, m_uNumBytes, m_uOffset,
+                 m_bFailed].
+
+      Returns:  HRESULT
+                  S_OK if the cache is up to date, S_FALSE if it is
+                  stale or missing, or an error code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT ModelCacheReader::Open(
+        _In_ const std::filesystem::path& cachePath,
+        _In_ const std::filesystem::path& sourcePath,
+        _In_ UINT uLayout
+    )
+    {
+        close();
+
+        ModelCacheHeader expected;
+        HRESULT hr = DescribeSource(sourcePath, uLayout, expected);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_hFile = CreateFileW(cachePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (m_hFile == INVALID_HANDLE_VALUE)
+        {
+            return S_FALSE;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(m_hFile, &fileSize) || static_cast<UINT64>(fileSize.QuadPart) < sizeof(ModelCacheHeader))
+        {
+            close();
+            return S_FALSE;
+        }
+
+        m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+        if (!m_hMapping)
+        {
+            close();
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        const BYTE* pView = static_cast<const BYTE*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0u, 0u, 0u));
+        if (!pView)
+        {
+            close();
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        ModelCacheHeader header;
+        memcpy(&header, pView, sizeof(header));
+
+        m_pBytes = pView + sizeof(ModelCacheHeader);
+        m_uNumBytes = static_cast<size_t>(fileSize.QuadPart) - sizeof(ModelCacheHeader);
+        m_uOffset = 0u;
+
+        if (header.uMagic != expected.uMagic
+            || header.uVersion != expected.uVersion
+            || header.uLayout != expected.uLayout
+            || header.uLoadFlags != expected.uLoadFlags
+            || header.uSourceSize != expected.uSourceSize
+            || header.sourceWriteTime != expected.sourceWriteTime
+            || header.uNumBytes != static_cast<UINT64>(m_uNumBytes))
+        {
+            close();
+            return S_FALSE;
+        }
+
+        m_bFailed = FALSE;
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheReader::ReadString
+
+      Summary:  Reads the length and the characters of a string
+
+      Args:     std::string& szOutValue
+                  String read
+
+      Modifies: [m_uOffset, m_bFailed].
+
+      Returns:  BOOL
+                  TRUE if the string was read
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL ModelCacheReader::ReadString(
+        _Out_ std::string& szOutValue
+    )
+    {
+        szOutValue.clear();
+
+        UINT uLength = 0u;
+        if (!Read(uLength))
+        {
+            return FALSE;
+        }
+
+        const BYTE* pData = consume(uLength);
+        if (!pData)
+        {
+            return FALSE;
+        }
+
+        szOutValue.assign(reinterpret_cast<const char*>(pData), uLength);
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheReader::HasFailed
+
+      Summary:  Returns whether the file wasn't opened or a read went
+                past its end
+
+      Returns:  BOOL
+                  TRUE if the data read can't be trusted
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL ModelCacheReader::HasFailed() const
+    {
+        return m_bFailed;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheReader::alignOffset
+
+      Summary:  Skips the padding the writer put before an array
+
+      Modifies: [m_uOffset].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void ModelCacheReader::alignOffset()
+    {
+        m_uOffset = (m_uOffset + ModelCacheWriter::ALIGNMENT - 1u) & ~(ModelCacheWriter::ALIGNMENT - 1u);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheReader::consume
+
+      Summary:  Returns the next bytes of the file and moves past them
+
+      Args:     size_t uNumBytes
+                  Number of bytes
+
+      Modifies: [m_uOffset, m_bFailed].
+
+      Returns:  const BYTE*
+                  Bytes in the mapped file, or nullptr past the end
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const BYTE* ModelCacheReader::consume(
+        _In_ size_t uNumBytes
+    )
+    {
+        if (m_bFailed || m_uOffset > m_uNumBytes || uNumBytes > m_uNumBytes - m_uOffset)
+        {
+            m_bFailed = TRUE;
+            return nullptr;
+        }
+
+        const BYTE* pData = m_pBytes + m_uOffset;
+        m_uOffset += uNumBytes;
+
+        return pData;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   ModelCacheReader::close
+
+      Summary:  Unmaps and closes the file
+
+      Modifies: [m_hFile, m_hMapping, m_pBytes, m_uNumBytes, m_uOffset,
+                 m_bFailed].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void ModelCacheReader::close()
+    {
+        if (m_pBytes)
+        {
+            UnmapViewOfFile(m_pBytes - sizeof(ModelCacheHeader));
+        }
+        if (m_hMapping)
+        {
+            CloseHandle(m_hMapping);
+        }
+        if (m_hFile != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_hFile);
+        }
+
+        m_hFile = INVALID_HANDLE_VALUE;
+        m_hMapping = nullptr;
+        m_pBytes = nullptr;
+        m_uNumBytes = 0u;
+        m_uOffset = 0u;
+        m_bFailed = TRUE;
+    }
+}
@@ -0,0 +1,213 @@
+/*+===================================================================
+  File:      MODELCACHE.H
+
+  Summary:   ModelCache header file contains declarations of
+             ModelCacheWriter and ModelCacheReader classes that store
+             an imported model in a versioned binary file and map it
+             back without running the importer.
+
+  Classes: ModelCacheWriter, ModelCacheReader
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <type_traits>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   ModelCacheHeader
+
+      Summary:  First bytes of a cache file. The cache is stale when
+                the format, the layout of the stored structs, the
+                import flags, or the size or write time of the source
+                file differ. The header keeps the bytes after it
+                aligned.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct alignas(16) ModelCacheHeader
+    {
+        UINT uMagic;
+        UINT uVersion;
+        UINT uLayout;
+        UINT uLoadFlags;
+        UINT64 uSourceSize;
+        INT64 sourceWriteTime;
+        UINT64 uNumBytes;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ModelCacheWriter
+
+      Summary:  Appends values, arrays and strings to a byte stream and
+                saves it behind a header describing the source file.
+                Arrays start on a 16 byte boundary, so they can be used
+                in place once the file is mapped.
+
+      Methods:  Write
+                  Appends a value
+                WriteArray
+                  Appends the number of elements and the elements
+                WriteString
+                  Appends the length and the characters
+                Save
+                  Writes the header and the bytes to a file
+                ModelCacheWriter
+                  Constructor.
+                ~ModelCacheWriter
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ModelCacheWriter
+    {
+    public:
+        static constexpr const UINT MAGIC = 0x4C444F4D; // "MODL"
+        static constexpr const UINT FORMAT_VERSION = 6u;
+        static constexpr const size_t ALIGNMENT = 16u;
+
+    public:
+        ModelCacheWriter();
+        ModelCacheWriter(const ModelCacheWriter& other) = delete;
+        ModelCacheWriter(ModelCacheWriter&& other) = delete;
+        ModelCacheWriter& operator=(const ModelCacheWriter& other) = delete;
+        ModelCacheWriter& operator=(ModelCacheWriter&& other) = delete;
+        virtual ~ModelCacheWriter() = default;
+
+        template <typename T>
+        void Write(_In_ const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            append(&value, sizeof(T));
+        }
+
+        template <typename T>
+        void WriteArray(_In_ const std::vector<T>& aValues)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            Write(static_cast<UINT64>(aValues.size()));
+            align();
+            append(aValues.data(), aValues.size() * sizeof(T));
+        }
+
+        void WriteString(_In_ const std::string& szValue);
+
+        HRESULT Save(_In_ const std::filesystem::path& cachePath, _In_ const std::filesystem::path& sourcePath, _In_ UINT uLayout) const;
+
+    protected:
+        void align();
+        void append(_In_reads_bytes_(uNumBytes) const void* pData, _In_ size_t uNumBytes);
+
+    protected:
+        std::vector<BYTE> m_aBytes;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    ModelCacheReader
+
+      Summary:  Maps a cache file written by ModelCacheWriter and reads
+                it back in the same order. Arrays are either copied with
+                a single memcpy or viewed in place, the view is valid
+                while the reader is alive. A read past the end fails and
+                every later read fails too.
+
+      Methods:  Open
+                  Maps the file if it is up to date with the source
+                Read
+                  Reads a value
+                ReadArray
+                  Copies an array
+                ViewArray
+                  Returns a pointer to an array in the mapped file
+                ReadString
+                  Reads a string
+                HasFailed
+                  Returns whether a read went past the end
+                ModelCacheReader
+                  Constructor.
+                ~ModelCacheReader
+                  Destructor, unmaps the file.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class ModelCacheReader
+    {
+    public:
+        ModelCacheReader();
+        ModelCacheReader(const ModelCacheReader& other) = delete;
+        ModelCacheReader(ModelCacheReader&& other) = delete;
+        ModelCacheReader& operator=(const ModelCacheReader& other) = delete;
+        ModelCacheReader& operator=(ModelCacheReader&& other) = delete;
+        virtual ~ModelCacheReader();
+
+        HRESULT Open(_In_ const std::filesystem::path& cachePath, _In_ const std::filesystem::path& sourcePath, _In_ UINT uLayout);
+
+        template <typename T>
+        BOOL Read(_Out_ T& outValue)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const BYTE* pData = consume(sizeof(T));
+            if (!pData)
+            {
+                return FALSE;
+            }
+
+            memcpy(&outValue, pData, sizeof(T));
+            return TRUE;
+        }
+
+        template <typename T>
+        BOOL ReadArray(_Out_ std::vector<T>& outValues)
+        {
+            size_t uNumValues = 0u;
+            const T* pValues = ViewArray<T>(uNumValues);
+            if (!pValues)
+            {
+                outValues.clear();
+                return !m_bFailed;
+            }
+
+            outValues.resize(uNumValues);
+            memcpy(outValues.data(), pValues, uNumValues * sizeof(T));
+            return TRUE;
+        }
+
+        template <typename T>
+        const T* ViewArray(_Out_ size_t& uOutNumValues)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            uOutNumValues = 0u;
+
+            UINT64 uNumValues = 0u;
+            if (!Read(uNumValues) || uNumValues > (m_uNumBytes - m_uOffset) / sizeof(T))
+            {
+                m_bFailed = TRUE;
+                return nullptr;
+            }
+
+            alignOffset();
+            const BYTE* pData = consume(static_cast<size_t>(uNumValues) * sizeof(T));
+            if (!pData || uNumValues == 0u)
+            {
+                return nullptr;
+            }
+
+            uOutNumValues = static_cast<size_t>(uNumValues);
+            return reinterpret_cast<const T*>(pData);
+        }
+
+        BOOL ReadString(_Out_ std::string& szOutValue);
+        BOOL HasFailed() const;
+
+    protected:
+        void alignOffset();
+        const BYTE* consume(_In_ size_t uNumBytes);
+        void close();
+
+    protected:
+        HANDLE m_hFile;
+        HANDLE m_hMapping;
+        const BYTE* m_pBytes;
+        size_t m_uNumBytes;
+        size_t m_uOffset;
+        BOOL m_bFailed;
+    };
+}
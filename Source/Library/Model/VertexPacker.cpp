@@ -0,0 +1,440 @@
+#include "Model/VertexPacker.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::EncodeOctahedron
+
+      Summary:  Projects a unit vector on the octahedron |x|+|y|+|z|=1
+                and unfolds the lower half over the corners of the
+                upper one, which maps the sphere to the [-1, 1] square
+
+      Args:     FXMVECTOR normal
+                  Unit vector
+
+      Returns:  XMFLOAT2
+                  Point of the square
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    XMFLOAT2 VertexPacker::EncodeOctahedron(
+        _In_ FXMVECTOR normal
+    )
+    {
+        XMFLOAT3 n;
+        XMStoreFloat3(&n, normal);
+
+        const FLOAT l1Norm = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+        if (l1Norm <= 0.0f)
+        {
+            return XMFLOAT2(0.0f, 0.0f);
+        }
+
+        XMFLOAT2 octahedron(n.x / l1Norm, n.y / l1Norm);
+        if (n.z < 0.0f)
+        {
+            octahedron = XMFLOAT2(
+                (1.0f - fabsf(octahedron.y)) * (octahedron.x >= 0.0f ? 1.0f : -1.0f),
+                (1.0f - fabsf(octahedron.x)) * (octahedron.y >= 0.0f ? 1.0f : -1.0f)
+            );
+        }
+
+        return octahedron;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::DecodeOctahedron
+
+      Summary:  Folds a point of the [-1, 1] square back on the
+                octahedron and normalizes it
+
+      Args:     const XMFLOAT2& octahedron
+                  Point of the square
+
+      Returns:  XMVECTOR
+                  Unit vector
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    XMVECTOR VertexPacker::DecodeOctahedron(
+        _In_ const XMFLOAT2& octahedron
+    )
+    {
+        XMFLOAT3 n(octahedron.x, octahedron.y, 1.0f - fabsf(octahedron.x) - fabsf(octahedron.y));
+
+        const FLOAT fold = fmaxf(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -fold : fold;
+        n.y += n.y >= 0.0f ? -fold : fold;
+
+        return XMVector3Normalize(XMLoadFloat3(&n));
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::EncodeTangentFrame
+
+      Summary:  Packs the rotation from the tangent space to the model
+                space in 32 bits. The quaternion and its negation are
+                the same rotation, so it is flipped to make its largest
+                component positive, which is then rebuilt from the
+                unit length.
+
+      Args:     FXMVECTOR normal
+                  Unit normal
+                FXMVECTOR tangent
+                  Tangent, made orthogonal to the normal
+                FXMVECTOR bitangent
+                  Bitangent, only its side of the normal and the
+                  tangent is kept
+
+      Returns:  UINT
+                  Packed tangent frame
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT VertexPacker::EncodeTangentFrame(
+        _In_ FXMVECTOR normal,
+        _In_ FXMVECTOR tangent,
+        _In_ FXMVECTOR bitangent
+    )
+    {
+        const XMVECTOR t = orthogonalizeTangent(normal, tangent);
+        const XMVECTOR b = XMVector3Cross(normal, t);
+        const BOOL bFlipped = XMVectorGetX(XMVector3Dot(b, bitangent)) < 0.0f;
+
+        // Rows are the images of the axes, so the frame is a rotation
+        const XMMATRIX frame(t, b, XMVectorSetW(normal, 0.0f), g_XMIdentityR3);
+
+        XMFLOAT4 quaternion;
+        XMStoreFloat4(&quaternion, XMQuaternionNormalize(XMQuaternionRotationMatrix(frame)));
+        FLOAT aComponents[4] = { quaternion.x, quaternion.y, quaternion.z, quaternion.w };
+
+        UINT uLargest = 0u;
+        for (UINT i = 1u; i < 4u; ++i)
+        {
+            if (fabsf(aComponents[i]) > fabsf(aComponents[uLargest]))
+            {
+                uLargest = i;
+            }
+        }
+        const FLOAT sign = aComponents[uLargest] < 0.0f ? -1.0f : 1.0f;
+
+        // The three other components are within [-1/sqrt(2), 1/sqrt(2)]
+        UINT uTangentFrame = 0u;
+        UINT uShift = 0u;
+        for (UINT i = 0u, j = 0u; i < 4u; ++i)
+        {
+            if (i == uLargest)
+            {
+                continue;
+            }
+
+            const UINT uMax = (1u << TANGENT_FRAME_BITS[j]) - 1u;
+            const FLOAT value = fminf(fmaxf(sign * aComponents[i] * XM_SQRT2, -1.0f), 1.0f);
+            uTangentFrame |= static_cast<UINT>(lroundf((value * 0.5f + 0.5f) * static_cast<FLOAT>(uMax))) << uShift;
+
+            uShift += TANGENT_FRAME_BITS[j];
+            ++j;
+        }
+
+        uTangentFrame |= uLargest << TANGENT_FRAME_INDEX_SHIFT;
+        uTangentFrame |= (bFlipped ? 1u : 0u) << TANGENT_FRAME_HANDEDNESS_SHIFT;
+
+        return uTangentFrame;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::DecodeTangentFrame
+
+      Summary:  Rebuilds the quaternion of a packed tangent frame and
+                rotates the tangent axis with it. The normal is decoded
+                more precisely on its own, so the tangent is made
+                orthogonal to it and the bitangent follows from both.
+
+      Args:     UINT uTangentFrame
+                  Packed tangent frame
+                FXMVECTOR normal
+                  Decoded unit normal
+                XMVECTOR& outTangent
+                  Unit tangent
+                XMVECTOR& outBitangent
+                  Unit bitangent
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void VertexPacker::DecodeTangentFrame(
+        _In_ UINT uTangentFrame,
+        _In_ FXMVECTOR normal,
+        _Out_ XMVECTOR& outTangent,
+        _Out_ XMVECTOR& outBitangent
+    )
+    {
+        const UINT uLargest = (uTangentFrame >> TANGENT_FRAME_INDEX_SHIFT) & 3u;
+
+        FLOAT aComponents[4] = { 0.0f, };
+        FLOAT sumOfSquares = 0.0f;
+        UINT uShift = 0u;
+        for (UINT i = 0u, j = 0u; i < 4u; ++i)
+        {
+            if (i == uLargest)
+            {
+                continue;
+            }
+
+            const UINT uMax = (1u << TANGENT_FRAME_BITS[j]) - 1u;
+            const FLOAT value = static_cast<FLOAT>((uTangentFrame >> uShift) & uMax) / static_cast<FLOAT>(uMax);
+            aComponents[i] = (value * 2.0f - 1.0f) / XM_SQRT2;
+            sumOfSquares += aComponents[i] * aComponents[i];
+
+            uShift += TANGENT_FRAME_BITS[j];
+            ++j;
+        }
+        aComponents[uLargest] = sqrtf(fmaxf(1.0f - sumOfSquares, 0.0f));
+
+        const XMVECTOR quaternion = XMQuaternionNormalize(XMVectorSet(aComponents[0], aComponents[1], aComponents[2], aComponents[3]));
+        outTangent = orthogonalizeTangent(normal, XMVector3Rotate(g_XMIdentityR0, quaternion));
+        outBitangent = XMVector3Cross(normal, outTangent);
+        if ((uTangentFrame >> TANGENT_FRAME_HANDEDNESS_SHIFT) != 0u)
+        {
+            outBitangent = XMVectorNegate(outBitangent);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::VertexPacker
+
+      Summary:  Constructor
+
+      Args:     const BoundingBox& bounds
+                  Bounds of the positions to pack
+
+      Modifies: [m_positionScale, m_positionOffset].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    VertexPacker::VertexPacker(
+        _In_ const BoundingBox& bounds
+    )
+        : m_positionScale(
+            fmaxf(bounds.Extents.x, MIN_EXTENT),
+            fmaxf(bounds.Extents.y, MIN_EXTENT),
+            fmaxf(bounds.Extents.z, MIN_EXTENT),
+            1.0f
+        )
+        , m_positionOffset(bounds.Center.x, bounds.Center.y, bounds.Center.z, 0.0f)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::PackVertex
+
+      Summary:  Quantizes a vertex and its tangent frame
+
+      Args:     const SimpleVertex& vertex
+                  Vertex, its position within the bounds
+                const NormalData& normalData
+                  Tangent and bitangent of the vertex
+
+      Returns:  PackedVertex
+                  Packed vertex
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    PackedVertex VertexPacker::PackVertex(
+        _In_ const SimpleVertex& vertex,
+        _In_ const NormalData& normalData
+    ) const
+    {
+        PackedVertex packedVertex;
+
+        XMVECTOR position = XMLoadFloat3(&vertex.Position);
+        position = XMVectorDivide(XMVectorSubtract(position, XMLoadFloat4(&m_positionOffset)), XMLoadFloat4(&m_positionScale));
+        PackedVector::XMStoreShortN4(&packedVertex.Position, XMVectorSetW(position, 1.0f));
+
+        PackedVector::XMStoreHalf2(&packedVertex.TexCoord, XMLoadFloat2(&vertex.TexCoord));
+
+        const XMVECTOR normal = loadNormal(vertex);
+        const XMFLOAT2 octahedron = EncodeOctahedron(normal);
+        PackedVector::XMStoreShortN2(&packedVertex.Normal, XMLoadFloat2(&octahedron));
+
+        packedVertex.uTangentFrame = EncodeTangentFrame(normal, XMLoadFloat3(&normalData.Tangent), XMLoadFloat3(&normalData.Bitangent));
+
+        return packedVertex;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::UnpackVertex
+
+      Summary:  Decodes a packed vertex the way the vertex shaders do
+
+      Args:     const PackedVertex& packedVertex
+                  Packed vertex
+                SimpleVertex& outVertex
+                  Decoded vertex
+                NormalData& outNormalData
+                  Decoded tangent and bitangent
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void VertexPacker::UnpackVertex(
+        _In_ const PackedVertex& packedVertex,
+        _Out_ SimpleVertex& outVertex,
+        _Out_ NormalData& outNormalData
+    ) const
+    {
+        const XMVECTOR position = PackedVector::XMLoadShortN4(&packedVertex.Position);
+        XMStoreFloat3(&outVertex.Position, XMVectorMultiplyAdd(position, XMLoadFloat4(&m_positionScale), XMLoadFloat4(&m_positionOffset)));
+
+        XMStoreFloat2(&outVertex.TexCoord, PackedVector::XMLoadHalf2(&packedVertex.TexCoord));
+
+        XMFLOAT2 octahedron;
+        XMStoreFloat2(&octahedron, PackedVector::XMLoadShortN2(&packedVertex.Normal));
+        const XMVECTOR normal = DecodeOctahedron(octahedron);
+        XMStoreFloat3(&outVertex.Normal, normal);
+
+        XMVECTOR tangent;
+        XMVECTOR bitangent;
+        DecodeTangentFrame(packedVertex.uTangentFrame, normal, tangent, bitangent);
+        XMStoreFloat3(&outNormalData.Tangent, tangent);
+        XMStoreFloat3(&outNormalData.Bitangent, bitangent);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::PackVertices
+
+      Summary:  Quantizes vertices and decodes them back to measure how
+                far they moved
+
+      Args:     const SimpleVertex* aVertices
+                  Vertices, their positions within the bounds
+                const NormalData* aNormalData
+                  Tangent and bitangent of every vertex
+                UINT uNumVertices
+                  Number of vertices
+                std::vector<PackedVertex>& aOutPackedVertices
+                  Packed vertices
+
+      Returns:  VertexPackingError
+                  Largest error of every attribute
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    VertexPackingError VertexPacker::PackVertices(
+        _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+        _In_reads_(uNumVertices) const NormalData* aNormalData,
+        _In_ UINT uNumVertices,
+        _Out_ std::vector<PackedVertex>& aOutPackedVertices
+    ) const
+    {
+        VertexPackingError error =
+        {
+            .MaxPositionError = 0.0f,
+            .MaxTexCoordError = 0.0f,
+            .MaxNormalAngle = 0.0f,
+            .MaxTangentAngle = 0.0f
+        };
+
+        aOutPackedVertices.resize(uNumVertices);
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            aOutPackedVertices[i] = PackVertex(aVertices[i], aNormalData[i]);
+
+            SimpleVertex vertex;
+            NormalData normalData;
+            UnpackVertex(aOutPackedVertices[i], vertex, normalData);
+
+            const XMVECTOR normal = loadNormal(aVertices[i]);
+            const XMVECTOR tangent = orthogonalizeTangent(normal, XMLoadFloat3(&aNormalData[i].Tangent));
+
+            const FLOAT positionError = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&vertex.Position), XMLoadFloat3(&aVertices[i].Position))));
+            const FLOAT texCoordError = XMVectorGetX(XMVector2Length(XMVectorSubtract(XMLoadFloat2(&vertex.TexCoord), XMLoadFloat2(&aVertices[i].TexCoord))));
+            const FLOAT normalAngle = XMVectorGetX(XMVector3AngleBetweenNormals(XMLoadFloat3(&vertex.Normal), normal));
+            const FLOAT tangentAngle = XMVectorGetX(XMVector3AngleBetweenNormals(XMLoadFloat3(&normalData.Tangent), tangent));
+
+            error.MaxPositionError = fmaxf(error.MaxPositionError, positionError);
+            error.MaxTexCoordError = fmaxf(error.MaxTexCoordError, texCoordError);
+            error.MaxNormalAngle = fmaxf(error.MaxNormalAngle, XMConvertToDegrees(normalAngle));
+            error.MaxTangentAngle = fmaxf(error.MaxTangentAngle, XMConvertToDegrees(tangentAngle));
+        }
+
+        return error;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::GetPositionScale
+
+      Summary:  Returns the scale the normalized positions are
+                multiplied by, the extents of the bounds
+
+      Returns:  const XMFLOAT4&
+                  Scale of the positions
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const XMFLOAT4& VertexPacker::GetPositionScale() const
+    {
+        return m_positionScale;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::GetPositionOffset
+
+      Summary:  Returns the offset added to the scaled positions, the
+                center of the bounds
+
+      Returns:  const XMFLOAT4&
+                  Offset of the positions
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const XMFLOAT4& VertexPacker::GetPositionOffset() const
+    {
+        return m_positionOffset;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::loadNormal
+
+      Summary:  Loads the normal of a vertex with a unit length,
+                vertices without a normal face up
+
+      Args:     const SimpleVertex& vertex
+                  Vertex
+
+      Returns:  XMVECTOR
+                  Unit normal
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    XMVECTOR VertexPacker::loadNormal(
+        _In_ const SimpleVertex& vertex
+    )
+    {
+        const XMVECTOR normal = XMLoadFloat3(&vertex.Normal);
+        if (XMVectorGetX(XMVector3LengthSq(normal)) <= 0.0f)
+        {
+            return g_XMIdentityR2;
+        }
+
+        return XMVector3Normalize(normal);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   VertexPacker::orthogonalizeTangent
+
+      Summary:  Removes the part of the tangent along the normal. A
+                tangent parallel to the normal, or missing, is replaced
+                by any direction orthogonal to it.
+
+      Args:     FXMVECTOR normal
+                  Unit normal
+                FXMVECTOR tangent
+                  Tangent
+
+      Returns:  XMVECTOR
+                  Unit tangent orthogonal to the normal
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    XMVECTOR VertexPacker::orthogonalizeTangent(
+        _In_ FXMVECTOR normal,
+        _In_ FXMVECTOR tangent
+    )
+    {
+        XMVECTOR orthogonal = XMVectorSubtract(tangent, XMVectorMultiply(normal, XMVector3Dot(normal, tangent)));
+        if (XMVectorGetX(XMVector3LengthSq(orthogonal)) <= MIN_TANGENT_LENGTH_SQ)
+        {
+            const XMVECTOR axis = fabsf(XMVectorGetX(normal)) < 0.9f ? g_XMIdentityR0 : g_XMIdentityR1;
+            orthogonal = XMVector3Cross(axis, normal);
+        }
+
+        return XMVectorSetW(XMVector3Normalize(orthogonal), 0.0f);
+    }
+}
@@ -0,0 +1,119 @@
+/*+===================================================================
+  File:      VERTEXPACKER.H
+
+  Summary:   VertexPacker header file contains declarations of
+             VertexPacker class that quantizes a SimpleVertex and its
+             NormalData into a PackedVertex and decodes it back.
+
+  Classes: VertexPacker
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   VertexPackingError
+
+      Summary:  Largest difference between the vertices and their
+                decoded packed vertices. The position error is in model
+                units, the texture coordinate error in texture space
+                and the angles in degrees. The tangent is compared
+                after it is made orthogonal to the normal.
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct VertexPackingError
+    {
+        FLOAT MaxPositionError;
+        FLOAT MaxTexCoordError;
+        FLOAT MaxNormalAngle;
+        FLOAT MaxTangentAngle;
+    };
+
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    VertexPacker
+
+      Summary:  Packs the 56 bytes of a vertex and its tangent frame
+                into 20. The position is stored relative to the bounds
+                of the vertices in 16 bit normalized integers, the
+                texture coordinates in half floats and the normal with
+                the octahedral mapping in two 16 bit normalized
+                integers. The tangent frame is a quaternion in 32 bits:
+                the largest component is dropped and rebuilt from the
+                three others, stored in 10, 10 and 9 bits, next to its
+                index and to the sign of the bitangent. The vertex
+                shaders decode the same way.
+
+      Methods:  PackVertex
+                  Quantizes a vertex
+                UnpackVertex
+                  Decodes a packed vertex
+                PackVertices
+                  Quantizes vertices and measures the error
+                GetPositionScale
+                  Returns the scale that decodes the positions
+                GetPositionOffset
+                  Returns the offset that decodes the positions
+                EncodeOctahedron
+                  Maps a unit vector to the octahedron
+                DecodeOctahedron
+                  Maps a point of the octahedron to a unit vector
+                EncodeTangentFrame
+                  Packs a tangent frame into a quaternion
+                DecodeTangentFrame
+                  Unpacks a tangent frame from a quaternion
+                VertexPacker
+                  Constructor.
+                ~VertexPacker
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class VertexPacker
+    {
+    public:
+        static XMFLOAT2 EncodeOctahedron(_In_ FXMVECTOR normal);
+        static XMVECTOR DecodeOctahedron(_In_ const XMFLOAT2& octahedron);
+        static UINT EncodeTangentFrame(_In_ FXMVECTOR normal, _In_ FXMVECTOR tangent, _In_ FXMVECTOR bitangent);
+        static void DecodeTangentFrame(_In_ UINT uTangentFrame, _In_ FXMVECTOR normal, _Out_ XMVECTOR& outTangent, _Out_ XMVECTOR& outBitangent);
+
+    public:
+        VertexPacker() = delete;
+        VertexPacker(_In_ const BoundingBox& bounds);
+        VertexPacker(const VertexPacker& other) = delete;
+        VertexPacker(VertexPacker&& other) = delete;
+        VertexPacker& operator=(const VertexPacker& other) = delete;
+        VertexPacker& operator=(VertexPacker&& other) = delete;
+        virtual ~VertexPacker() = default;
+
+        PackedVertex PackVertex(_In_ const SimpleVertex& vertex, _In_ const NormalData& normalData) const;
+        void UnpackVertex(_In_ const PackedVertex& packedVertex, _Out_ SimpleVertex& outVertex, _Out_ NormalData& outNormalData) const;
+        VertexPackingError PackVertices(
+            _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+            _In_reads_(uNumVertices) const NormalData* aNormalData,
+            _In_ UINT uNumVertices,
+            _Out_ std::vector<PackedVertex>& aOutPackedVertices
+        ) const;
+
+        const XMFLOAT4& GetPositionScale() const;
+        const XMFLOAT4& GetPositionOffset() const;
+
+    protected:
+        static XMVECTOR loadNormal(_In_ const SimpleVertex& vertex);
+        static XMVECTOR orthogonalizeTangent(_In_ FXMVECTOR normal, _In_ FXMVECTOR tangent);
+
+    protected:
+        // Extent below which an axis of the bounds is treated as flat
+        static constexpr const FLOAT MIN_EXTENT = 1e-6f;
+        static constexpr const FLOAT MIN_TANGENT_LENGTH_SQ = 1e-12f;
+        static constexpr const UINT TANGENT_FRAME_BITS[3] = { 10u, 10u, 9u };
+        static constexpr const UINT TANGENT_FRAME_INDEX_SHIFT = 29u;
+        static constexpr const UINT TANGENT_FRAME_HANDEDNESS_SHIFT = 31u;
+
+    protected:
+        XMFLOAT4 m_positionScale;
+        XMFLOAT4 m_positionOffset;
+    };
+}
@@ -7,6 +7,9 @@ namespace library
 #define NUM_LIGHTS (1)
 #define MAX_NUM_BONES (256)
 #define MAX_NUM_BONES_PER_VERTEX (16)
+#define MAX_NUM_BAKED_CLIPS (16)
+#define NUM_CASCADES (3)
+#define NUM_SH_COEFFICIENTS (9)
 
     struct SimpleVertex
     {
@@ -15,15 +18,36 @@ namespace library
         XMFLOAT3 Normal;
     };
 
+    struct PackedVertex
+    {
+        PackedVector::XMSHORTN4 Position;
+        PackedVector::XMHALF2 TexCoord;
+        PackedVector::XMSHORTN2 Normal;
+        UINT uTangentFrame;
+    };
+
     struct InstanceData
     {
         XMMATRIX Transformation;
     };
 
+    struct CrowdInstanceData
+    {
+        XMMATRIX Transformation;
+        FLOAT TimeOffset;
+        UINT uClipIndex;
+    };
+
     struct AnimationData
     {
-        XMUINT4 aBoneIndices;
-        XMFLOAT4 aBoneWeights;
+        PackedVector::XMUBYTE4 aBoneIndices;
+        PackedVector::XMUBYTEN4 aBoneWeights;
+    };
+
+    struct DualQuaternion
+    {
+        XMFLOAT4 Real;
+        XMFLOAT4 Dual;
     };
 
     struct NormalData
@@ -57,11 +81,18 @@ namespace library
         XMMATRIX World;
         XMFLOAT4 OutputColor;
         BOOL HasNormalMap;
+        UINT Padding[3];
+        XMFLOAT4 PositionScale;
+        XMFLOAT4 PositionOffset;
     };
 
-    struct CBSkinning
+    struct CBBakedAnimation
     {
-        XMMATRIX BoneTransforms[MAX_NUM_BONES];
+        FLOAT AnimationTime;
+        FLOAT FrameRate;
+        UINT NumBones;
+        UINT Padding;
+        XMUINT4 Clips[MAX_NUM_BAKED_CLIPS];
     };
 
     struct CBLights
@@ -81,5 +112,24 @@ namespace library
         XMMATRIX View;
         XMMATRIX Projection;
         BOOL IsVoxel;
+        UINT Padding[3];
+        XMFLOAT4 PositionScale;
+        XMFLOAT4 PositionOffset;
+    };
+
+    struct CBCascades
+    {
+        XMMATRIX ViewProjections[NUM_CASCADES];
+        XMFLOAT4 SplitDistances;
+    };
+
+    struct CBHorizonMap
+    {
+        XMFLOAT4 Extent;
+    };
+
+    struct CBIrradiance
+    {
+        XMFLOAT4 Coefficients[NUM_SH_COEFFICIENTS];
     };
 }
\ No newline at end of file
@@ -95,12 +95,13 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   InstancedRenderable::initializeInstance
 
-      Summary:  Creates an instance buffer
+      Summary:  Creates an instance buffer and grows the bounding
+                sphere to enclose every instance
 
       Args:     ID3D11Device* pDevice
                   Pointer to a Direct3D 11 device
 
-      Modifies: [m_instanceBuffer].
+      Modifies: [m_instanceBuffer, m_boundingSphere].
 
       Returns:  HRESULT
                   Status code
@@ -130,6 +131,23 @@ namespace library
         if (FAILED(hr))
             return hr;
 
+        if (!m_aInstanceData.empty())
+        {
+            XMVECTOR boundsMin = g_XMFltMax;
+            XMVECTOR boundsMax = XMVectorNegate(g_XMFltMax);
+            XMVECTOR radius = XMVectorReplicate(m_boundingSphere.Radius);
+            for (const InstanceData& instanceData : m_aInstanceData)
+            {
+                XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&m_boundingSphere.Center), instanceData.Transformation);
+                boundsMin = XMVectorMin(boundsMin, XMVectorSubtract(center, radius));
+                boundsMax = XMVectorMax(boundsMax, XMVectorAdd(center, radius));
+            }
+
+            BoundingBox boundingBox;
+            BoundingBox::CreateFromPoints(boundingBox, boundsMin, boundsMax);
+            BoundingSphere::CreateFromBoundingBox(m_boundingSphere, boundingBox);
+        }
+
         return hr;
     }
 }
\ No newline at end of file
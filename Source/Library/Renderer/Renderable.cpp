@@ -4,6 +4,7 @@
 #include "assimp/scene.h"		// output data structure
 #include "assimp/postprocess.h"	// post processing flags
 
+#include "Renderer/TangentGenerator.h"
 #include "Texture/DDSTextureLoader.h"
 
 namespace library
@@ -18,8 +19,8 @@ namespace library
 
       Modifies: [m_vertexBuffer, m_indexBuffer, m_constantBuffer,
                  m_normalBuffer, m_aMeshes, m_aMaterials, m_vertexShader,
-                 m_pixelShader, m_outputColor, m_world, m_bHasNormalMap
-                 m_aNormalData].
+                 m_pixelShader, m_outputColor, m_world, m_boundingSphere,
+                 m_bHasNormalMap, m_aNormalData, m_uTransformVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     Renderable::Renderable(
@@ -40,7 +41,9 @@ namespace library
         , m_outputColor(outputColor)
         , m_padding()
         , m_world(XMMatrixIdentity())
+        , m_boundingSphere()
         , m_bHasNormalMap(FALSE)
+        , m_uTransformVersion(1u)
     {
     }
 
@@ -56,8 +59,7 @@ namespace library
                 PCWSTR pszTextureFileName
                   File name of the texture to usen
 
-      Modifies: [m_vertexBuffer, m_normalBuffer, m_indexBuffer
-                 m_constantBuffer].
+      Modifies: [m_indexBuffer, m_constantBuffer].
 
       Returns:  HRESULT
                   Status code
@@ -67,6 +69,58 @@ namespace library
         _In_ ID3D11Device* pDevice,
         _In_ ID3D11DeviceContext* pImmediateContext
     )
+    {
+        HRESULT hr = initializeVertexBuffers(pDevice);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Create the index buffer
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = getIndexBufferByteWidth(),
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_INDEX_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u,
+        };
+
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = getIndices(),
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+
+        hr = pDevice->CreateBuffer(&bd, &initData, m_indexBuffer.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return initializeConstantBuffer(pDevice);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::initializeVertexBuffers
+
+      Summary:  Creates the vertex buffer and the normal buffer holding
+                the tangents and bitangents of the vertices
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+
+      Modifies: [m_vertexBuffer, m_normalBuffer, m_aNormalData,
+                 m_boundingSphere].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Renderable::initializeVertexBuffers(
+        _In_ ID3D11Device* pDevice
+    )
     {
         HRESULT hr = S_OK;
 
@@ -93,6 +147,9 @@ namespace library
             return hr;
         }
 
+        // Local space bounds used for culling
+        BoundingSphere::CreateFromPoints(m_boundingSphere, GetNumVertices(), &getVertices()->Position, sizeof(SimpleVertex));
+
         if (m_aNormalData.empty())
         {
             calculateNormalMapVectors();
@@ -109,35 +166,35 @@ namespace library
         initData.SysMemPitch = 0u;
         initData.SysMemSlicePitch = 0u;
 
-        hr = pDevice->CreateBuffer(&bd, &initData, m_normalBuffer.GetAddressOf());
-        if (FAILED(hr))
-        {
-            return hr;
-        }
+        return pDevice->CreateBuffer(&bd, &initData, m_normalBuffer.GetAddressOf());
+    }
 
-        // Create the index buffer
-        bd.ByteWidth = static_cast<UINT>(sizeof(WORD)) * GetNumIndices();
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        bd.CPUAccessFlags = 0u;
-        bd.MiscFlags = 0u;
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::initializeConstantBuffer
 
-        initData.pSysMem = getIndices();
-        initData.SysMemPitch = 0u;
-        initData.SysMemSlicePitch = 0u;
+      Summary:  Creates the constant buffer holding the world matrix
 
-        hr = pDevice->CreateBuffer(&bd, &initData, m_indexBuffer.GetAddressOf());
-        if (FAILED(hr))
-        {
-            return hr;
-        }
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffer
 
-        // Create constant buffer
-        bd.ByteWidth = sizeof(CBChangesEveryFrame);
-        bd.Usage = D3D11_USAGE_DEFAULT;
-        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        bd.CPUAccessFlags = 0u;
-        bd.MiscFlags = 0u;
+      Modifies: [m_constantBuffer].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Renderable::initializeConstantBuffer(
+        _In_ ID3D11Device* pDevice
+    )
+    {
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = sizeof(CBChangesEveryFrame),
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
 
         CBChangesEveryFrame cbChangesEveryFrame =
         {
@@ -146,129 +203,68 @@ namespace library
             .HasNormalMap = m_bHasNormalMap
         };
 
-        initData.pSysMem = &cbChangesEveryFrame;
-        initData.SysMemPitch = 0u;
-        initData.SysMemSlicePitch = 0u;
-
-        hr = pDevice->CreateBuffer(&bd, &initData, m_constantBuffer.GetAddressOf());
-        if (FAILED(hr))
+        D3D11_SUBRESOURCE_DATA initData =
         {
-            return hr;
-        }
+            .pSysMem = &cbChangesEveryFrame,
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
 
-        return hr;
+        return pDevice->CreateBuffer(&bd, &initData, m_constantBuffer.GetAddressOf());
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderable::calculateNormalMapVectors
+      Method:   Renderable::getIndexBufferByteWidth
 
-      Summary:  Calculate tangent and bitangent vectors of every vertex
+      Summary:  Returns the size of the index buffer, 16 bits per index
 
-      Modifies: [m_aNormalData].
+      Returns:  UINT
+                  Size of the indices in bytes
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Renderable::calculateNormalMapVectors()
+    UINT Renderable::getIndexBufferByteWidth() const
     {
-        UINT uNumFaces = GetNumIndices() / 3u;
-        const SimpleVertex* aVertices = getVertices();
-        const WORD* aIndices = getIndices();
-
-        m_aNormalData.resize(GetNumVertices(), NormalData());
-
-        XMFLOAT3 tangent, bitangent;
-
-        for (UINT i = 0u; i < uNumFaces; ++i)
-        {
-            calculateTangentBitangent(
-                aVertices[aIndices[i * 3]],
-                aVertices[aIndices[i * 3 + 1]],
-                aVertices[aIndices[i * 3 + 2]],
-                tangent,
-                bitangent
-            );
-
-            m_aNormalData[aIndices[i * 3]].Tangent = tangent;
-            m_aNormalData[aIndices[i * 3]].Bitangent = bitangent;
-
-            m_aNormalData[aIndices[i * 3 + 1]].Tangent = tangent;
-            m_aNormalData[aIndices[i * 3 + 1]].Bitangent = bitangent;
-
-            m_aNormalData[aIndices[i * 3 + 2]].Tangent = tangent;
-            m_aNormalData[aIndices[i * 3 + 2]].Bitangent = bitangent;
-        }
+        return static_cast<UINT>(sizeof(WORD)) * GetNumIndices();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
-      Method:   Renderable::calculateTangentBitangent
+      Method:   Renderable::setWorldMatrix
+
+      Summary:  Replaces the world matrix, used by the renderables
+                that rebuild their transform every frame
 
-      Summary:  Calculate tangent/bitangent vectors of the given face
+      Args:     const XMMATRIX& world
+                  New world matrix
 
-      Args:     SimpleVertex& v1
-                  The first vertex of the face
-                SimpleVertex& v2
-                  The second vertex of the face
-                SimpleVertex& v3
-                  The third vertex of the face
-                XMFLOAT3& tangent
-                  Calculated tangent vector
-                XMFLOAT3& bitangent
-                  Calculated bitangent vector
+      Modifies: [m_world, m_uTransformVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-    void Renderable::calculateTangentBitangent(
-        _In_ const SimpleVertex& v1,
-        _In_ const SimpleVertex& v2,
-        _In_ const SimpleVertex& v3,
-        _Out_ XMFLOAT3& tangent,
-        _Out_ XMFLOAT3& bitangent
+    void Renderable::setWorldMatrix(
+        _In_ const XMMATRIX& world
     )
     {
-        XMFLOAT3 vector1, vector2;
-        XMFLOAT2 tuVector, tvVector;
-
-        // Calculate the two vectors for this face.
-        vector1.x = v2.Position.x - v1.Position.x;
-        vector1.y = v2.Position.y - v1.Position.y;
-        vector1.z = v2.Position.z - v1.Position.z;
-
-        vector2.x = v3.Position.x - v1.Position.x;
-        vector2.y = v3.Position.y - v1.Position.y;
-        vector2.z = v3.Position.z - v1.Position.z;
-
-        // Calculate the tu and tv texture space vectors.
-        tuVector.x = v2.TexCoord.x - v1.TexCoord.x;
-        tvVector.x = v2.TexCoord.y - v1.TexCoord.y;
-
-        tuVector.y = v3.TexCoord.x - v1.TexCoord.x;
-        tvVector.y = v3.TexCoord.y - v1.TexCoord.y;
-
-        // Calculate the denominator of the tangent/binormal equation.
-        float den = 1.0f / (tuVector.x * tvVector.y - tuVector.y * tvVector.x);
+        m_world = world;
+        ++m_uTransformVersion;
+    }
 
-        // Calculate the cross products and multiply by the coefficient to get the tangent and binormal.
-        tangent.x = (tvVector.y * vector1.x - tvVector.x * vector2.x) * den;
-        tangent.y = (tvVector.y * vector1.y - tvVector.x * vector2.y) * den;
-        tangent.z = (tvVector.y * vector1.z - tvVector.x * vector2.z) * den;
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::calculateNormalMapVectors
 
-        bitangent.x = (tuVector.x * vector2.x - tuVector.y * vector1.x) * den;
-        bitangent.y = (tuVector.x * vector2.y - tuVector.y * vector1.y) * den;
-        bitangent.z = (tuVector.x * vector2.z - tuVector.y * vector1.z) * den;
+      Summary:  Calculate tangent and bitangent vectors of every vertex
+                from the triangles around it
 
-        // Calculate the length of this normal.
-        float length = sqrt((tangent.x * tangent.x) + (tangent.y * tangent.y) + (tangent.z * tangent.z));
+      Modifies: [m_aNormalData].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
-        // Normalize the normal and then store it
-        tangent.x = tangent.x / length;
-        tangent.y = tangent.y / length;
-        tangent.z = tangent.z / length;
+    void Renderable::calculateNormalMapVectors()
+    {
+        const WORD* aIndices = getIndices();
+        const std::vector<UINT> aWideIndices(aIndices, aIndices + GetNumIndices());
 
-        // Calculate the length of this normal.
-        length = sqrt((bitangent.x * bitangent.x) + (bitangent.y * bitangent.y) + (bitangent.z * bitangent.z));
+        m_aNormalData.resize(GetNumVertices(), NormalData());
 
-        // Normalize the normal and then store it
-        bitangent.x = bitangent.x / length;
-        bitangent.y = bitangent.y / length;
-        bitangent.z = bitangent.z / length;
+        TangentGenerator generator;
+        generator.Generate(aWideIndices.data(), GetNumIndices(), getVertices(), GetNumVertices(), m_aNormalData.data(), nullptr);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -473,6 +469,40 @@ namespace library
         return m_world;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetTransformVersion
+
+      Summary:  Returns the counter that is bumped whenever the world
+                matrix changes, so the renderer only uploads the
+                constant buffer of a moved renderable
+
+      Returns:  UINT64
+                  Version of the world matrix
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT64 Renderable::GetTransformVersion() const
+    {
+        return m_uTransformVersion;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderable::GetBoundingSphere
+
+      Summary:  Returns the bounding sphere transformed by the world
+                matrix
+
+      Returns:  BoundingSphere
+                  World space bounding sphere
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BoundingSphere Renderable::GetBoundingSphere() const
+    {
+        BoundingSphere boundingSphere;
+        m_boundingSphere.Transform(boundingSphere, m_world);
+
+        return boundingSphere;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderable::GetOutputColor
 
@@ -552,7 +582,7 @@ namespace library
       Args:     FLOAT angle
                   Angle of rotation around the x-axis, in radians
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uTransformVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Renderable::RotateX(
@@ -561,6 +591,7 @@ namespace library
     {
         // m_world *= x-axis rotation by angle matrix
         m_world *= XMMatrixRotationX(angle);
+        ++m_uTransformVersion;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -571,7 +602,7 @@ namespace library
       Args:     FLOAT angle
                   Angle of rotation around the y-axis, in radians
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uTransformVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Renderable::RotateY(
@@ -580,6 +611,7 @@ namespace library
     {
         // m_world *= y-axis rotation by angle matrix
         m_world *= XMMatrixRotationY(angle);
+        ++m_uTransformVersion;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -590,7 +622,7 @@ namespace library
       Args:     FLOAT angle
                   Angle of rotation around the z-axis, in radians
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uTransformVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Renderable::RotateZ(
@@ -599,6 +631,7 @@ namespace library
     {
         // m_world *= z-axis rotation by angle matrix
         m_world *= XMMatrixRotationZ(angle);
+        ++m_uTransformVersion;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -613,7 +646,7 @@ namespace library
                 FLOAT roll
                   Angle of rotation around the z-axis, in radians
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uTransformVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Renderable::RotateRollPitchYaw(
@@ -624,6 +657,7 @@ namespace library
     {
         // m_world *= x, y, z-axis rotation by pitch, yaw, roll matrix
         m_world *= XMMatrixRotationRollPitchYaw(pitch, yaw, roll);
+        ++m_uTransformVersion;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -638,7 +672,7 @@ namespace library
                 FLOAT scaleZ
                   Scaling factor along the z-axis.
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uTransformVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Renderable::Scale(
@@ -649,6 +683,7 @@ namespace library
     {
         // m_world *= x, y, z-axis scaling by scale factor matrix
         m_world *= XMMatrixScaling(scaleX, scaleY, scaleZ);
+        ++m_uTransformVersion;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -659,7 +694,7 @@ namespace library
       Args:     const XMVECTOR& offset
                   3D vector describing the translations along the x-axis, y-axis, and z-axis
 
-      Modifies: [m_world].
+      Modifies: [m_world, m_uTransformVersion].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
     void Renderable::Translate(
         _In_ const XMVECTOR& offset
@@ -667,6 +702,7 @@ namespace library
     {
         // m_world *= translate by offset vector matrix
         m_world *= XMMatrixTranslationFromVector(offset);
+        ++m_uTransformVersion;
     }
 
 
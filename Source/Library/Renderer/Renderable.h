@@ -39,6 +39,11 @@ namespace library
                   Returns the constant buffer
                 GetWorldMatrix
                   Returns the world matrix
+                GetTransformVersion
+                  Returns the counter bumped whenever the world matrix
+                  changes
+                GetBoundingSphere
+                  Returns the world space bounding sphere
                 GetNumVertices
                   Pure virtual function that returns the number of
                   vertices
@@ -55,7 +60,7 @@ namespace library
     public:
         static constexpr const UINT INVALID_MATERIAL = (0xFFFFFFFF);
 
-    protected:
+    public:
         struct BasicMeshEntry
         {
             BasicMeshEntry()
@@ -63,6 +68,7 @@ namespace library
                 , uBaseVertex(0u)
                 , uBaseIndex(0u)
                 , uMaterialIndex(INVALID_MATERIAL)
+                , IndexFormat(DXGI_FORMAT_R16_UINT)
             {
             }
 
@@ -70,6 +76,9 @@ namespace library
             UINT uBaseVertex;
             UINT uBaseIndex;
             UINT uMaterialIndex;
+
+            // uBaseIndex counts indices of this format from the start of the index buffer
+            DXGI_FORMAT IndexFormat;
         };
 
     public:
@@ -98,6 +107,8 @@ namespace library
         ComPtr<ID3D11Buffer>& GetNormalBuffer();
 
         const XMMATRIX& GetWorldMatrix() const;
+        UINT64 GetTransformVersion() const;
+        BoundingSphere GetBoundingSphere() const;
         const XMFLOAT4& GetOutputColor() const;
         BOOL HasTexture() const;
         const std::shared_ptr<Material>& GetMaterial(UINT uIndex) const;
@@ -124,9 +135,13 @@ namespace library
             _In_ ID3D11Device* pDevice,
             _In_ ID3D11DeviceContext* pImmediateContext
         );
+        HRESULT initializeConstantBuffer(_In_ ID3D11Device* pDevice);
+        virtual HRESULT initializeVertexBuffers(_In_ ID3D11Device* pDevice);
+        virtual UINT getIndexBufferByteWidth() const;
+
+        void setWorldMatrix(_In_ const XMMATRIX& world);
 
         void calculateNormalMapVectors();
-        void calculateTangentBitangent(_In_ const SimpleVertex& v1, _In_ const SimpleVertex& v2, _In_ const SimpleVertex& v3, _Out_ XMFLOAT3& tangent, _Out_ XMFLOAT3& bitangent);
 
     protected:
         ComPtr<ID3D11Buffer> m_vertexBuffer;
@@ -144,6 +159,8 @@ namespace library
         XMFLOAT4 m_outputColor;
         BYTE m_padding[8];
         XMMATRIX m_world;
+        BoundingSphere m_boundingSphere;
         BOOL m_bHasNormalMap;
+        UINT64 m_uTransformVersion;
     };
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 namespace library
 {
+    // Private data of a constant buffer that holds the version of the state it was last uploaded from
+    static constexpr const GUID UPLOADED_VERSION_GUID = { 0x4f0d8a27, 0x93c1, 0x4b5e, { 0xa6, 0x2d, 0x71, 0xe8, 0x0b, 0x3c, 0x95, 0xd4 } };
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Renderer
 
@@ -11,9 +14,14 @@ namespace library
                   m_immediateContext, m_immediateContext1, m_swapChain,
                   m_swapChain1, m_renderTargetView, m_depthStencil,
                   m_depthStencilView, m_cbChangeOnResize, m_cbShadowMatrix,
-                  m_pszMainSceneName, m_camera, m_projection, m_scenes
-                  m_invalidTexture, m_shadowMapTexture, m_shadowVertexShader,
-                  m_shadowPixelShader].
+                  m_cbCascades, m_cascadeDepthStencil,
+                  m_cascadeDepthStencilView, m_pszMainSceneName, m_camera,
+                  m_projection, m_scenes, m_invalidTexture,
+                  m_aShadowCascades, m_aCascadeTextures, m_shadowVertexShader,
+                  m_shadowPixelShader, m_uFrameUploadedBytes, m_uFrameSkippedBytes,
+                  m_uFrameUploadedBoneBytes, m_uReportedUploadedBytes,
+                  m_uReportedSkippedBytes, m_uReportedUploadedBoneBytes,
+                  m_uNumReportedFrames].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     Renderer::Renderer()
@@ -32,6 +40,9 @@ namespace library
         , m_cbChangeOnResize(nullptr)
         , m_cbLights(nullptr)
         , m_cbShadowMatrix(nullptr)
+        , m_cbCascades(nullptr)
+        , m_cascadeDepthStencil(nullptr)
+        , m_cascadeDepthStencilView(nullptr)
 
         , m_pszMainSceneName(nullptr)
         , m_padding{ '\0' }
@@ -40,9 +51,18 @@ namespace library
         , m_scenes(std::unordered_map<std::wstring, std::shared_ptr<Scene>>())
         , m_invalidTexture(std::make_shared<Texture>(L"Content/Common/InvalidTexture.png"))
 
-        , m_shadowMapTexture(nullptr)
+        , m_aShadowCascades()
+        , m_aCascadeTextures{ nullptr, }
         , m_shadowVertexShader(nullptr)
         , m_shadowPixelShader(nullptr)
+
+        , m_uFrameUploadedBytes(0u)
+        , m_uFrameSkippedBytes(0u)
+        , m_uFrameUploadedBoneBytes(0u)
+        , m_uReportedUploadedBytes(0u)
+        , m_uReportedSkippedBytes(0u)
+        , m_uReportedUploadedBoneBytes(0u)
+        , m_uNumReportedFrames(0u)
     {
     }
 
@@ -58,7 +78,8 @@ namespace library
                   m_d3dDevice1, m_immediateContext1, m_swapChain1,
                   m_swapChain, m_renderTargetView, m_vertexShader,
                   m_vertexLayout, m_pixelShader, m_vertexBuffer
-                  m_cbShadowMatrix].
+                  m_cbShadowMatrix, m_cbCascades, m_cascadeDepthStencil,
+                  m_cascadeDepthStencilView, m_aCascadeTextures].
 
       Returns:  HRESULT
                   Status code
@@ -306,9 +327,38 @@ namespace library
             return hr;
         }
 
-        // Initialize shadow map texture
-        m_shadowMapTexture = std::make_shared<RenderTexture>(uWidth, uHeight);
-        hr = m_shadowMapTexture->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+        // Create cascades constant buffer
+        bd.ByteWidth = sizeof(CBCascades);
+        bd.Usage = D3D11_USAGE_DEFAULT;
+        bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        bd.CPUAccessFlags = 0u;
+
+        hr = m_d3dDevice->CreateBuffer(&bd, nullptr, m_cbCascades.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Initialize cascade shadow map textures, they share a single depth buffer
+        for (UINT i = 0u; i < NUM_CASCADES; ++i)
+        {
+            m_aCascadeTextures[i] = std::make_shared<RenderTexture>(CASCADE_RESOLUTION, CASCADE_RESOLUTION);
+            hr = m_aCascadeTextures[i]->Initialize(m_d3dDevice.Get(), m_immediateContext.Get());
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        descDepth.Width = CASCADE_RESOLUTION;
+        descDepth.Height = CASCADE_RESOLUTION;
+        hr = m_d3dDevice->CreateTexture2D(&descDepth, nullptr, m_cascadeDepthStencil.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        hr = m_d3dDevice->CreateDepthStencilView(m_cascadeDepthStencil.Get(), &descDSV, m_cascadeDepthStencilView.GetAddressOf());
         if (FAILED(hr))
         {
             return hr;
@@ -409,7 +459,7 @@ namespace library
       Args:     PCWSTR pszSceneName
                   The name of the scene
 
-      Modifies: [m_pszMainSceneName].
+      Modifies: [m_pszMainSceneName, m_cbLights, m_cbCascades].
 
       Returns:  HRESULT
                   Status code
@@ -426,6 +476,15 @@ namespace library
 
         m_pszMainSceneName = pszSceneName;
 
+        // Versions of the lights and cascades of different scenes can't be compared
+        for (ID3D11Buffer* pBuffer : { m_cbLights.Get(), m_cbCascades.Get() })
+        {
+            if (pBuffer)
+            {
+                pBuffer->SetPrivateData(UPLOADED_VERSION_GUID, 0u, nullptr);
+            }
+        }
+
         return S_OK;
     }
 
@@ -483,19 +542,33 @@ namespace library
         _In_ FLOAT deltaTime
     )
     {
+        // The levels of detail are selected from the viewpoint of the last frame
+        m_scenes[m_pszMainSceneName]->SetAnimationLodViewpoint(m_camera.GetEye(), m_camera.GetView(), m_projection);
+        m_scenes[m_pszMainSceneName]->SetMeshLodViewpoint(m_camera.GetEye(), m_camera.GetView(), m_projection);
         m_scenes[m_pszMainSceneName]->Update(deltaTime);
 
         m_camera.Update(deltaTime);
+
+        // Culled from the camera the frame is rendered with, a stale frustum would cut meshlets at the edges of the screen
+        m_scenes[m_pszMainSceneName]->CullMeshlets(m_camera.GetEye(), m_camera.GetView(), m_projection);
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::Render
 
-      Summary:  Render the frame
+      Summary:  Render the frame. Constant buffers are only uploaded
+                when the version of their source state changed.
+
+      Modifies: [m_uFrameUploadedBytes, m_uFrameSkippedBytes,
+                 m_uFrameUploadedBoneBytes].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Renderer::Render()
     {
+        m_uFrameUploadedBytes = 0u;
+        m_uFrameSkippedBytes = 0u;
+        m_uFrameUploadedBoneBytes = 0u;
+
         RenderSceneToTexture();
 
         // Clear the backbuffer
@@ -505,42 +578,64 @@ namespace library
         m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0F, 0);
 
         // Update camera constant buffer
-        CBChangeOnCameraMovement cbChangeOnCameraMovement =
+        if (isConstantBufferOutdated(m_camera.GetConstantBuffer().Get(), m_camera.GetVersion(), sizeof(CBChangeOnCameraMovement)))
         {
-            .View = XMMatrixTranspose(m_camera.GetView()),
-        };
-        XMStoreFloat4(&cbChangeOnCameraMovement.CameraPosition, m_camera.GetEye());
-        m_immediateContext->UpdateSubresource(m_camera.GetConstantBuffer().Get(), 0u, nullptr, &cbChangeOnCameraMovement, 0u, 0u);
+            CBChangeOnCameraMovement cbChangeOnCameraMovement =
+            {
+                .View = XMMatrixTranspose(m_camera.GetView()),
+            };
+            XMStoreFloat4(&cbChangeOnCameraMovement.CameraPosition, m_camera.GetEye());
+            uploadConstantBuffer(m_camera.GetConstantBuffer().Get(), &cbChangeOnCameraMovement, sizeof(cbChangeOnCameraMovement));
+        }
         m_immediateContext->VSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
         m_immediateContext->PSSetConstantBuffers(0u, 1u, m_camera.GetConstantBuffer().GetAddressOf());
 
-        // Update the Light Constant Buffer
-        CBLights cbLights = {};
-
+        // Update the Light Constant Buffer, it stays bound to b3 since Initialize
+        UINT64 uLightsVersion = 0u;
         for (UINT i = 0u; i < NUM_LIGHTS; ++i)
         {
-            FLOAT attenuationDistance = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetAttenuationDistance();
-            FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
-
-            cbLights.PointLights[i].Position = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetPosition();
-            cbLights.PointLights[i].Color = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetColor();
-            cbLights.PointLights[i].View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetViewMatrix());
-            cbLights.PointLights[i].Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetProjectionMatrix());
-            cbLights.PointLights[i].AttenuationDistance = XMFLOAT4(
-                attenuationDistance,
-                attenuationDistance,
-                attenuationDistanceSquared,
-                attenuationDistanceSquared
-            );
-        }
-        m_immediateContext->UpdateSubresource(m_cbLights.Get(), 0u, nullptr, &cbLights, 0u, 0u);
-        m_immediateContext->PSSetConstantBuffers(3u, 1u, m_cbLights.GetAddressOf());
+            uLightsVersion += m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetVersion();
+        }
 
-        // Shadow texture and sampler state
-        m_immediateContext->PSSetShaderResources(2u, 1u, m_shadowMapTexture->GetShaderResourceView().GetAddressOf());
-        m_immediateContext->PSSetSamplers(2u, 1u, m_shadowMapTexture->GetSamplerState().GetAddressOf());
+        if (isConstantBufferOutdated(m_cbLights.Get(), uLightsVersion, sizeof(CBLights)))
+        {
+            CBLights cbLights = {};
 
-        // Env texture and sampler state
+            for (UINT i = 0u; i < NUM_LIGHTS; ++i)
+            {
+                FLOAT attenuationDistance = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetAttenuationDistance();
+                FLOAT attenuationDistanceSquared = attenuationDistance * attenuationDistance;
+
+                cbLights.PointLights[i].Position = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetPosition();
+                cbLights.PointLights[i].Color = m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetColor();
+                cbLights.PointLights[i].View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetViewMatrix());
+                cbLights.PointLights[i].Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(i)->GetProjectionMatrix());
+                cbLights.PointLights[i].AttenuationDistance = XMFLOAT4(
+                    attenuationDistance,
+                    attenuationDistance,
+                    attenuationDistanceSquared,
+                    attenuationDistanceSquared
+                );
+            }
+            uploadConstantBuffer(m_cbLights.Get(), &cbLights, sizeof(cbLights));
+        }
+
+        // Cascade shadow textures and sampler state
+        for (UINT i = 0u; i < NUM_CASCADES; ++i)
+        {
+            m_immediateContext->PSSetShaderResources(4u + i, 1u, m_aCascadeTextures[i]->GetShaderResourceView().GetAddressOf());
+        }
+        m_immediateContext->PSSetSamplers(2u, 1u, m_aCascadeTextures[0]->GetSamplerState().GetAddressOf());
+        m_immediateContext->PSSetConstantBuffers(5u, 1u, m_cbCascades.GetAddressOf());
+
+        // Horizon map of the voxel heightfield
+        if (m_scenes[m_pszMainSceneName]->GetHorizonMap())
+        {
+            m_immediateContext->PSSetShaderResources(7u, 1u, m_scenes[m_pszMainSceneName]->GetHorizonMap()->GetShaderResourceView().GetAddressOf());
+            m_immediateContext->PSSetConstantBuffers(6u, 1u, m_scenes[m_pszMainSceneName]->GetHorizonMap()->GetConstantBuffer().GetAddressOf());
+        }
+
+        // Env texture, sampler state, irradiance and prefiltered specular
         if (m_scenes[m_pszMainSceneName]->GetSkyBox())
         {
             m_immediateContext->PSSetShaderResources(
@@ -551,6 +646,8 @@ namespace library
                 3u,
                 1u,
                 Texture::s_samplers[static_cast<size_t>(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMaterial(0)->pDiffuse->GetSamplerType())].GetAddressOf());
+            m_immediateContext->PSSetConstantBuffers(7u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetIrradianceConstantBuffer().GetAddressOf());
+            m_immediateContext->PSSetShaderResources(8u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetPrefilteredSpecularView().GetAddressOf());
         }
 
         // Bind Buffer(vertex buffer, index buffer, input layout), Update Constant Buffer, 
@@ -569,19 +666,19 @@ namespace library
             uStride = sizeof(NormalData);
             m_immediateContext->IASetVertexBuffers(1u, 1u, renderable.second->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
 
-            // Set the index buffer 
-            m_immediateContext->IASetIndexBuffer(renderable.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
-
             // Set the input layout
             m_immediateContext->IASetInputLayout(renderable.second->GetVertexLayout().Get());
 
-            CBChangesEveryFrame cbChangesEveryFrame =
+            if (isConstantBufferOutdated(renderable.second->GetConstantBuffer().Get(), renderable.second->GetTransformVersion(), sizeof(CBChangesEveryFrame)))
             {
-                .World = XMMatrixTranspose(renderable.second->GetWorldMatrix()),
-                .OutputColor = renderable.second->GetOutputColor(),
-                .HasNormalMap = renderable.second->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(renderable.second->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+                CBChangesEveryFrame cbChangesEveryFrame =
+                {
+                    .World = XMMatrixTranspose(renderable.second->GetWorldMatrix()),
+                    .OutputColor = renderable.second->GetOutputColor(),
+                    .HasNormalMap = renderable.second->HasNormalMap()
+                };
+                uploadConstantBuffer(renderable.second->GetConstantBuffer().Get(), &cbChangesEveryFrame, sizeof(cbChangesEveryFrame));
+            }
 
             // Set shaders and constant buffers, shader resources, and samplers
             m_immediateContext->VSSetShader(renderable.second->GetVertexShader().Get(), nullptr, 0u);
@@ -628,6 +725,9 @@ namespace library
                         );
                     }
                 }
+                // Set the index buffer in the format of the mesh
+                m_immediateContext->IASetIndexBuffer(renderable.second->GetIndexBuffer().Get(), renderable.second->GetMesh(i).IndexFormat, 0u);
+
                 // Render the triangles
                 m_immediateContext->DrawIndexed(
                     renderable.second->GetMesh(i).uNumIndices,
@@ -652,19 +752,19 @@ namespace library
             uStride = sizeof(InstanceData);
             m_immediateContext->IASetVertexBuffers(2u, 1u, voxel->GetInstanceBuffer().GetAddressOf(), &uStride, &uOffset);
 
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(voxel->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
-
             // Set the input layout
             m_immediateContext->IASetInputLayout(voxel->GetVertexLayout().Get());
 
-            CBChangesEveryFrame cbChangesEveryFrame =
+            if (isConstantBufferOutdated(voxel->GetConstantBuffer().Get(), voxel->GetTransformVersion(), sizeof(CBChangesEveryFrame)))
             {
-                .World = XMMatrixTranspose(voxel->GetWorldMatrix()),
-                .OutputColor = voxel->GetOutputColor(),
-                .HasNormalMap = voxel->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(voxel->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+                CBChangesEveryFrame cbChangesEveryFrame =
+                {
+                    .World = XMMatrixTranspose(voxel->GetWorldMatrix()),
+                    .OutputColor = voxel->GetOutputColor(),
+                    .HasNormalMap = voxel->HasNormalMap()
+                };
+                uploadConstantBuffer(voxel->GetConstantBuffer().Get(), &cbChangesEveryFrame, sizeof(cbChangesEveryFrame));
+            }
 
             // Set shaders and constant buffers
             m_immediateContext->VSSetShader(voxel->GetVertexShader().Get(), nullptr, 0u);
@@ -711,6 +811,9 @@ namespace library
                         );
                     }
                 }
+                // Set the index buffer in the format of the mesh
+                m_immediateContext->IASetIndexBuffer(voxel->GetIndexBuffer().Get(), voxel->GetMesh(i).IndexFormat, 0u);
+
                 // Render the triangles
                 m_immediateContext->DrawIndexedInstanced(
                     voxel->GetMesh(i).uNumIndices,
@@ -724,54 +827,60 @@ namespace library
 
         for (auto model : m_scenes[m_pszMainSceneName]->GetModels())
         {
-            // Set the vertex buffer
-            UINT uStride = sizeof(SimpleVertex);
+            // Set the vertex buffer, the packed vertices hold their tangent frame
+            UINT uStride = sizeof(PackedVertex);
             UINT uOffset = 0u;
             m_immediateContext->IASetVertexBuffers(0u, 1u, model.second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
 
-            // Set the normal buffer
-            uStride = sizeof(NormalData);
-            m_immediateContext->IASetVertexBuffers(1u, 1u, model.second->GetNormalBuffer().GetAddressOf(), &uStride, &uOffset);
-
             // Set the animation buffer
             uStride = sizeof(AnimationData);
-            m_immediateContext->IASetVertexBuffers(2u, 1u, model.second->GetAnimationBuffer().GetAddressOf(), &uStride, &uOffset);
-
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
+            m_immediateContext->IASetVertexBuffers(1u, 1u, model.second->GetAnimationBuffer().GetAddressOf(), &uStride, &uOffset);
 
             // Set the input layout
             m_immediateContext->IASetInputLayout(model.second->GetVertexLayout().Get());
 
-            CBChangesEveryFrame cbChangesEveryFrame =
+            if (isConstantBufferOutdated(model.second->GetConstantBuffer().Get(), model.second->GetTransformVersion(), sizeof(CBChangesEveryFrame)))
             {
-                .World = XMMatrixTranspose(model.second->GetWorldMatrix()),
-                .OutputColor = model.second->GetOutputColor(),
-                .HasNormalMap = model.second->HasNormalMap()
-            };
-            m_immediateContext->UpdateSubresource(model.second->GetConstantBuffer().Get(), 0u, nullptr, &cbChangesEveryFrame, 0u, 0u);
+                CBChangesEveryFrame cbChangesEveryFrame =
+                {
+                    .World = XMMatrixTranspose(model.second->GetWorldMatrix()),
+                    .OutputColor = model.second->GetOutputColor(),
+                    .HasNormalMap = model.second->HasNormalMap(),
+                    .PositionScale = model.second->GetPositionScale(),
+                    .PositionOffset = model.second->GetPositionOffset()
+                };
+                uploadConstantBuffer(model.second->GetConstantBuffer().Get(), &cbChangesEveryFrame, sizeof(cbChangesEveryFrame));
+            }
 
-            // Update skinning constant buffer
-            CBSkinning cbSkinning = { };
-            for (UINT i = 0u; i < model.second->GetBoneTransforms().size(); ++i)
+            // Update the bone transforms, only as many as the model has bones
+            const void* pBoneTransforms = model.second->GetBoneTransforms().data();
+            UINT uBoneTransformBytes = static_cast<UINT>(model.second->GetBoneTransforms().size() * sizeof(XMFLOAT3X4A));
+            if (model.second->GetSkinningMode() == eSkinningMode::DUAL_QUATERNION)
             {
-                cbSkinning.BoneTransforms[i] = XMMatrixTranspose(model.second->GetBoneTransforms()[i]);
+                pBoneTransforms = model.second->GetBoneDualQuaternions().data();
+                uBoneTransformBytes = static_cast<UINT>(model.second->GetBoneDualQuaternions().size() * sizeof(DualQuaternion));
+            }
+
+            if (isConstantBufferOutdated(model.second->GetBoneTransformsBuffer().Get(), model.second->GetBoneTransformsVersion(), uBoneTransformBytes))
+            {
+                uploadBoneTransforms(model.second->GetBoneTransformsBuffer().Get(), pBoneTransforms, uBoneTransformBytes);
             }
-            m_immediateContext->UpdateSubresource(model.second->GetSkinningConstantBuffer().Get(), 0u, nullptr, &cbSkinning, 0u, 0u);
 
             // Set shaders and constant buffers
             m_immediateContext->VSSetShader(model.second->GetVertexShader().Get(), nullptr, 0u);
             m_immediateContext->VSSetConstantBuffers(2u, 1u, model.second->GetConstantBuffer().GetAddressOf());
-            m_immediateContext->VSSetConstantBuffers(4u, 1u, model.second->GetSkinningConstantBuffer().GetAddressOf());
+            m_immediateContext->VSSetShaderResources(3u, 1u, model.second->GetBoneTransformsView().GetAddressOf());
 
             m_immediateContext->PSSetShader(model.second->GetPixelShader().Get(), nullptr, 0u);
             m_immediateContext->PSSetConstantBuffers(2u, 1u, model.second->GetConstantBuffer().GetAddressOf());
 
-            for (UINT i = 0u; i < model.second->GetNumMeshes(); ++i)
+            // The ranges left by the meshlet culling, those of a mesh follow each other and share its material
+            const Renderable::BasicMeshEntry* pPreviousMesh = nullptr;
+            for (const Renderable::BasicMeshEntry& visibleMesh : model.second->GetVisibleMeshes())
             {
-                if (model.second->HasTexture())
+                if (model.second->HasTexture() && (!pPreviousMesh || pPreviousMesh->uMaterialIndex != visibleMesh.uMaterialIndex))
                 {
-                    const UINT materialIndex = model.second->GetMesh(i).uMaterialIndex;
+                    const UINT materialIndex = visibleMesh.uMaterialIndex;
                     eTextureSamplerType textureSamplerType = model.second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
 
                     // Set texture resource view of the renderable into the pixel shader
@@ -806,11 +915,96 @@ namespace library
                     }
                 }
 
-                // Render the triangles
+                // Set the index buffer in the format of the mesh
+                m_immediateContext->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), visibleMesh.IndexFormat, 0u);
+
+                // Render the visible triangles of the level of detail of the model
                 m_immediateContext->DrawIndexed(
-                    model.second->GetMesh(i).uNumIndices,
-                    model.second->GetMesh(i).uBaseIndex,
-                    static_cast<INT>(model.second->GetMesh(i).uBaseVertex)
+                    visibleMesh.uNumIndices,
+                    visibleMesh.uBaseIndex,
+                    static_cast<INT>(visibleMesh.uBaseVertex)
+                );
+                pPreviousMesh = &visibleMesh;
+            }
+        }
+
+        // Crowds read their poses from the baked palettes, only the animation time is uploaded
+        for (auto& crowd : m_scenes[m_pszMainSceneName]->GetCrowds())
+        {
+            // Set the vertex buffer
+            UINT uStride = sizeof(PackedVertex);
+            UINT uOffset = 0u;
+            m_immediateContext->IASetVertexBuffers(0u, 1u, crowd.second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
+
+            // Set the animation buffer
+            uStride = sizeof(AnimationData);
+            m_immediateContext->IASetVertexBuffers(1u, 1u, crowd.second->GetAnimationBuffer().GetAddressOf(), &uStride, &uOffset);
+
+            // Set the instance buffer
+            uStride = sizeof(CrowdInstanceData);
+            m_immediateContext->IASetVertexBuffers(2u, 1u, crowd.second->GetInstanceBuffer().GetAddressOf(), &uStride, &uOffset);
+
+            // Set the input layout
+            m_immediateContext->IASetInputLayout(crowd.second->GetVertexLayout().Get());
+
+            if (isConstantBufferOutdated(crowd.second->GetConstantBuffer().Get(), crowd.second->GetTransformVersion(), sizeof(CBChangesEveryFrame)))
+            {
+                CBChangesEveryFrame cbChangesEveryFrame =
+                {
+                    .World = XMMatrixTranspose(crowd.second->GetWorldMatrix()),
+                    .OutputColor = crowd.second->GetOutputColor(),
+                    .HasNormalMap = crowd.second->HasNormalMap(),
+                    .PositionScale = crowd.second->GetPositionScale(),
+                    .PositionOffset = crowd.second->GetPositionOffset()
+                };
+                uploadConstantBuffer(crowd.second->GetConstantBuffer().Get(), &cbChangesEveryFrame, sizeof(cbChangesEveryFrame));
+            }
+
+            if (isConstantBufferOutdated(crowd.second->GetBakedAnimationConstantBuffer().Get(), crowd.second->GetBoneTransformsVersion(), sizeof(CBBakedAnimation)))
+            {
+                uploadConstantBuffer(crowd.second->GetBakedAnimationConstantBuffer().Get(), &crowd.second->GetBakedAnimation(), sizeof(CBBakedAnimation));
+            }
+
+            // Set shaders, constant buffers and the baked palettes
+            m_immediateContext->VSSetShader(crowd.second->GetVertexShader().Get(), nullptr, 0u);
+            m_immediateContext->VSSetConstantBuffers(2u, 1u, crowd.second->GetConstantBuffer().GetAddressOf());
+            m_immediateContext->VSSetConstantBuffers(5u, 1u, crowd.second->GetBakedAnimationConstantBuffer().GetAddressOf());
+            m_immediateContext->VSSetShaderResources(2u, 1u, crowd.second->GetPaletteView().GetAddressOf());
+
+            m_immediateContext->PSSetShader(crowd.second->GetPixelShader().Get(), nullptr, 0u);
+            m_immediateContext->PSSetConstantBuffers(2u, 1u, crowd.second->GetConstantBuffer().GetAddressOf());
+
+            for (UINT i = 0u; i < crowd.second->GetNumMeshes(); ++i)
+            {
+                if (crowd.second->HasTexture())
+                {
+                    const UINT materialIndex = crowd.second->GetMesh(i).uMaterialIndex;
+                    eTextureSamplerType textureSamplerType = crowd.second->GetMaterial(materialIndex)->pDiffuse->GetSamplerType();
+
+                    // Set texture resource view of the renderable into the pixel shader
+                    m_immediateContext->PSSetShaderResources(
+                        0u,
+                        1u,
+                        crowd.second->GetMaterial(materialIndex)->pDiffuse->GetTextureResourceView().GetAddressOf()
+                    );
+                    // Set sampler state of the renderable into the pixel shader
+                    m_immediateContext->PSSetSamplers(
+                        0u,
+                        1u,
+                        Texture::s_samplers[static_cast<size_t>(textureSamplerType)].GetAddressOf()
+                    );
+                }
+
+                // Set the index buffer in the format of the mesh
+                m_immediateContext->IASetIndexBuffer(crowd.second->GetIndexBuffer().Get(), crowd.second->GetMesh(i).IndexFormat, 0u);
+
+                // Render every instance of the mesh
+                m_immediateContext->DrawIndexedInstanced(
+                    crowd.second->GetMesh(i).uNumIndices,
+                    crowd.second->GetNumInstances(),
+                    crowd.second->GetMesh(i).uBaseIndex,
+                    static_cast<INT>(crowd.second->GetMesh(i).uBaseVertex),
+                    0u
                 );
             }
         }
@@ -823,31 +1017,31 @@ namespace library
 
             m_immediateContext->IASetVertexBuffers(0u, 1u, m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
 
-            // Set the index buffer
-            m_immediateContext->IASetIndexBuffer(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0);
-
             // Set the input layout
             m_immediateContext->IASetInputLayout(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexLayout().Get());
 
-            // Create and update renderable constant buffer
-            CBChangesEveryFrame cbChangesEveryFrame = 
-            {
-                .World = XMMatrixTranspose(
-                    m_scenes[m_pszMainSceneName]->GetSkyBox()->GetWorldMatrix()
-                    * XMMatrixTranslationFromVector(m_camera.GetEye())
-                ),
-                .OutputColor = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetOutputColor(),
-                .HasNormalMap = m_scenes[m_pszMainSceneName]->GetSkyBox()->HasNormalMap()
-            };
-
-            m_immediateContext->UpdateSubresource(
+            // Create and update renderable constant buffer, the skybox follows the camera
+            if (isConstantBufferOutdated(
                 m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().Get(),
-                0u,
-                nullptr,
-                &cbChangesEveryFrame,
-                0u,
-                0u
-            );
+                m_scenes[m_pszMainSceneName]->GetSkyBox()->GetTransformVersion() + m_camera.GetVersion(),
+                sizeof(CBChangesEveryFrame)))
+            {
+                CBChangesEveryFrame cbChangesEveryFrame = 
+                {
+                    .World = XMMatrixTranspose(
+                        m_scenes[m_pszMainSceneName]->GetSkyBox()->GetWorldMatrix()
+                        * XMMatrixTranslationFromVector(m_camera.GetEye())
+                    ),
+                    .OutputColor = m_scenes[m_pszMainSceneName]->GetSkyBox()->GetOutputColor(),
+                    .HasNormalMap = m_scenes[m_pszMainSceneName]->GetSkyBox()->HasNormalMap()
+                };
+
+                uploadConstantBuffer(
+                    m_scenes[m_pszMainSceneName]->GetSkyBox()->GetConstantBuffer().Get(),
+                    &cbChangesEveryFrame,
+                    sizeof(cbChangesEveryFrame)
+                );
+            }
 
             // Set shaders and constant buffers
             m_immediateContext->VSSetShader(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetVertexShader().Get(), nullptr, 0u);
@@ -878,6 +1072,9 @@ namespace library
                     );
                 }
 
+                // Set the index buffer in the format of the mesh
+                m_immediateContext->IASetIndexBuffer(m_scenes[m_pszMainSceneName]->GetSkyBox()->GetIndexBuffer().Get(), m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).IndexFormat, 0u);
+
                 // Render the triangles
                 m_immediateContext->DrawIndexed(
                     m_scenes[m_pszMainSceneName]->GetSkyBox()->GetMesh(i).uNumIndices, 
@@ -892,96 +1089,392 @@ namespace library
 
         // Set Render Target View again (Present call for DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL unbinds backbuffer 0)
         m_immediateContext->OMSetRenderTargets(1u, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+
+        reportConstantBufferUploads();
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Renderer::RenderSceneToTexture
 
-      Summary:  Render scene to the texture
+      Summary:  Fits the cascades of the main light around the camera
+                frustum and renders the shadow casters into them
+
+      Modifies: [m_aShadowCascades, m_cbCascades].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Renderer::RenderSceneToTexture()
     {
         //Unbind current pixel shader resources
-        ID3D11ShaderResourceView* const pSRV[2] = { NULL, NULL };
+        ID3D11ShaderResourceView* const pSRV[NUM_CASCADES] = { nullptr, };
         m_immediateContext->PSSetShaderResources(0u, 2u, pSRV);
-        m_immediateContext->PSSetShaderResources(2u, 1u, pSRV);
+        m_immediateContext->PSSetShaderResources(4u, NUM_CASCADES, pSRV);
 
-        // Change render target to the shadow map texture
-        m_immediateContext->OMSetRenderTargets(1u, m_shadowMapTexture->GetRenderTargetView().GetAddressOf(), m_depthStencilView.Get());
-        // Clear render target view with white color
-        m_immediateContext->ClearRenderTargetView(m_shadowMapTexture->GetRenderTargetView().Get(), Colors::White);
-        // Clear depth stencil view
-        m_immediateContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0F, 0u);
+        // The main light is treated as a directional light aimed at the origin of the scene
+        XMVECTOR lightDirection = XMVector3Normalize(XMVectorNegate(XMLoadFloat4(&m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetPosition())));
 
-        // Set shaders
+        // The cascades only move with the camera, the main light and the shadow casters
+        UINT64 uCascadesVersion = m_camera.GetVersion() + m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetVersion();
+        for (auto& renderable : m_scenes[m_pszMainSceneName]->GetRenderables())
+        {
+            uCascadesVersion += renderable.second->GetTransformVersion();
+        }
+        for (auto& model : m_scenes[m_pszMainSceneName]->GetModels())
+        {
+            uCascadesVersion += model.second->GetTransformVersion();
+        }
+
+        if (isConstantBufferOutdated(m_cbCascades.Get(), uCascadesVersion, sizeof(CBCascades)))
+        {
+            FLOAT aSplits[NUM_CASCADES + 1];
+            ComputeCascadeSplits(m_projection, CASCADE_SPLIT_LAMBDA, SHADOW_DISTANCE, NUM_CASCADES, aSplits);
+
+            CBCascades cbCascades = {};
+            for (UINT i = 0u; i < NUM_CASCADES; ++i)
+            {
+                ShadowCascade& cascade = m_aShadowCascades[i];
+                FitShadowCascade(m_camera.GetView(), m_projection, aSplits[i], aSplits[i + 1], lightDirection, CASCADE_RESOLUTION, cascade);
+
+                for (auto& renderable : m_scenes[m_pszMainSceneName]->GetRenderables())
+                {
+                    AddShadowCaster(cascade, renderable.second->GetBoundingSphere());
+                }
+                for (auto& model : m_scenes[m_pszMainSceneName]->GetModels())
+                {
+                    AddShadowCaster(cascade, model.second->GetBoundingSphere());
+                }
+                FinalizeShadowCascade(cascade);
+
+                cbCascades.ViewProjections[i] = XMMatrixTranspose(cascade.View * cascade.Projection);
+            }
+            static_assert(NUM_CASCADES == 3, "SplitDistances holds the far distance of each cascade");
+            cbCascades.SplitDistances = XMFLOAT4(aSplits[1], aSplits[2], aSplits[3], 0.0f);
+            uploadConstantBuffer(m_cbCascades.Get(), &cbCascades, sizeof(cbCascades));
+        }
+
+        // Voxels are shadowed by the horizon map instead of being rendered into the cascades
+        if (m_scenes[m_pszMainSceneName]->GetHorizonMap())
+        {
+            m_scenes[m_pszMainSceneName]->GetHorizonMap()->Update(m_immediateContext.Get(), lightDirection);
+        }
+
+        // Cascades have their own resolution
+        UINT uNumViewports = 1u;
+        D3D11_VIEWPORT mainViewport;
+        m_immediateContext->RSGetViewports(&uNumViewports, &mainViewport);
+
+        D3D11_VIEWPORT cascadeViewport =
+        {
+            .TopLeftX = 0.0f,
+            .TopLeftY = 0.0f,
+            .Width = static_cast<FLOAT>(CASCADE_RESOLUTION),
+            .Height = static_cast<FLOAT>(CASCADE_RESOLUTION),
+            .MinDepth = 0.0f,
+            .MaxDepth = 1.0f,
+        };
+        m_immediateContext->RSSetViewports(1u, &cascadeViewport);
+
+        // Set shaders, the input layout depends on the vertex format of the casters
         m_immediateContext->VSSetShader(m_shadowVertexShader->GetVertexShader().Get(), nullptr, 0u);
         m_immediateContext->PSSetShader(m_shadowPixelShader->GetPixelShader().Get(), nullptr, 0u);
 
-        // Render renderables / voxels / models with shadow map shaders
-        for (auto renderable : m_scenes[m_pszMainSceneName]->GetRenderables())
+        for (UINT i = 0u; i < NUM_CASCADES; ++i)
+        {
+            renderShadowCascade(i);
+        }
+
+        // After rendering the scene, reset the render target back to the original back buffer
+        m_immediateContext->RSSetViewports(1u, &mainViewport);
+        m_immediateContext->OMSetRenderTargets(1u, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::renderShadowCascade
+
+      Summary:  Renders the casters that overlap the cascade into its
+                shadow map texture
+
+      Args:     UINT uCascadeIndex
+                  Index of the cascade
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Renderer::renderShadowCascade(
+        _In_ UINT uCascadeIndex
+    )
+    {
+        const ShadowCascade& cascade = m_aShadowCascades[uCascadeIndex];
+        const std::shared_ptr<RenderTexture>& cascadeTexture = m_aCascadeTextures[uCascadeIndex];
+
+        // Change render target to the cascade texture
+        m_immediateContext->OMSetRenderTargets(1u, cascadeTexture->GetRenderTargetView().GetAddressOf(), m_cascadeDepthStencilView.Get());
+        // Clear render target view with white color
+        m_immediateContext->ClearRenderTargetView(cascadeTexture->GetRenderTargetView().Get(), Colors::White);
+        // Clear depth stencil view
+        m_immediateContext->ClearDepthStencilView(m_cascadeDepthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0F, 0u);
+
+        CBShadowMatrix cbShadowMatrix =
+        {
+            .World = XMMatrixIdentity(),
+            .View = XMMatrixTranspose(cascade.View),
+            .Projection = XMMatrixTranspose(cascade.Projection),
+            .IsVoxel = FALSE,
+            .PositionScale = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f),
+            .PositionOffset = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f)
+        };
+
+        // Render renderables / models with shadow map shaders
+        m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
+        for (auto& renderable : m_scenes[m_pszMainSceneName]->GetRenderables())
         {
-            // Bind vertex buffer, index buffer, input layout
+            if (!IsCasterInShadowCascade(cascade, renderable.second->GetBoundingSphere()))
+            {
+                continue;
+            }
+
+            // Bind vertex buffer, index buffer
             UINT uStride = sizeof(SimpleVertex);
             UINT uOffset = 0u;
             m_immediateContext->IASetVertexBuffers(0u, 1u, renderable.second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
-            m_immediateContext->IASetIndexBuffer(renderable.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
 
             // Update and bind CBShadowMatrix constant buffer
-            CBShadowMatrix cbShadowMatrix = 
-            {
-                .World = XMMatrixTranspose(renderable.second->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetProjectionMatrix()),
-                .IsVoxel = false 
-            };
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
-            m_immediateContext->VSSetConstantBuffers(0, 1, m_cbShadowMatrix.GetAddressOf());
+            cbShadowMatrix.World = XMMatrixTranspose(renderable.second->GetWorldMatrix());
+            cbShadowMatrix.IsVoxel = FALSE;
+            uploadConstantBuffer(m_cbShadowMatrix.Get(), &cbShadowMatrix, sizeof(cbShadowMatrix));
+            m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
             // Draw
             for (UINT i = 0u; i < renderable.second->GetNumMeshes(); ++i)
             {
+                // Set the index buffer in the format of the mesh
+                m_immediateContext->IASetIndexBuffer(renderable.second->GetIndexBuffer().Get(), renderable.second->GetMesh(i).IndexFormat, 0u);
                 m_immediateContext->DrawIndexed(
                     renderable.second->GetMesh(i).uNumIndices,
-                    renderable.second->GetMesh(i).uBaseIndex, 
+                    renderable.second->GetMesh(i).uBaseIndex,
                     static_cast<INT>(renderable.second->GetMesh(i).uBaseVertex)
                 );
             }
         }
-        for (auto model : m_scenes[m_pszMainSceneName]->GetModels())
+
+        m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetPackedVertexLayout().Get());
+        for (auto& model : m_scenes[m_pszMainSceneName]->GetModels())
         {
-            // Bind vertex buffer, index buffer, input layout
-            UINT uStride = sizeof(SimpleVertex);
+            if (!IsCasterInShadowCascade(cascade, model.second->GetBoundingSphere()))
+            {
+                continue;
+            }
+
+            // Bind vertex buffer, index buffer
+            UINT uStride = sizeof(PackedVertex);
             UINT uOffset = 0u;
             m_immediateContext->IASetVertexBuffers(0u, 1u, model.second->GetVertexBuffer().GetAddressOf(), &uStride, &uOffset);
-            m_immediateContext->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), DXGI_FORMAT_R16_UINT, 0u);
-            m_immediateContext->IASetInputLayout(m_shadowVertexShader->GetVertexLayout().Get());
 
             // Update and bind CBShadowMatrix constant buffer
-            CBShadowMatrix cbShadowMatrix =
-            {
-                .World = XMMatrixTranspose(model.second->GetWorldMatrix()),
-                .View = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetViewMatrix()),
-                .Projection = XMMatrixTranspose(m_scenes[m_pszMainSceneName]->GetPointLight(0)->GetProjectionMatrix()),
-                .IsVoxel = false
-            };
-            m_immediateContext->UpdateSubresource(m_cbShadowMatrix.Get(), 0u, nullptr, &cbShadowMatrix, 0u, 0u);
+            cbShadowMatrix.World = XMMatrixTranspose(model.second->GetWorldMatrix());
+            cbShadowMatrix.IsVoxel = FALSE;
+            cbShadowMatrix.PositionScale = model.second->GetPositionScale();
+            cbShadowMatrix.PositionOffset = model.second->GetPositionOffset();
+            uploadConstantBuffer(m_cbShadowMatrix.Get(), &cbShadowMatrix, sizeof(cbShadowMatrix));
             m_immediateContext->VSSetConstantBuffers(0u, 1u, m_cbShadowMatrix.GetAddressOf());
 
             // Draw
             for (UINT i = 0u; i < model.second->GetNumMeshes(); ++i)
             {
+                // Casters are drawn at the level of detail of the main view
+                const Renderable::BasicMeshEntry& lodMesh = model.second->GetLodMesh(i);
+                m_immediateContext->IASetIndexBuffer(model.second->GetIndexBuffer().Get(), lodMesh.IndexFormat, 0u);
                 m_immediateContext->DrawIndexed(
-                    model.second->GetMesh(i).uNumIndices,
-                    model.second->GetMesh(i).uBaseIndex,
-                    static_cast<INT>(model.second->GetMesh(i).uBaseVertex)
+                    lodMesh.uNumIndices,
+                    lodMesh.uBaseIndex,
+                    static_cast<INT>(lodMesh.uBaseVertex)
                 );
             }
         }
+    }
 
-        // After rendering the scene, reset the render target back to the original back buffer
-        m_immediateContext->OMSetRenderTargets(1u, m_renderTargetView.GetAddressOf(), m_depthStencilView.Get());
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::isConstantBufferOutdated
+
+      Summary:  Checks whether the constant buffer holds an older
+                version of its source state than the given one. An
+                outdated buffer is expected to be uploaded right after,
+                so the new version is remembered; otherwise the size of
+                the upload is counted as skipped. The version is kept
+                in the private data of the buffer, so a buffer created
+                at the address of a released one starts without a
+                version instead of inheriting it.
+
+      Args:     ID3D11Buffer* pBuffer
+                  Constant buffer
+                UINT64 uVersion
+                  Version of the state the buffer is built from
+                UINT uSize
+                  Size of the constant buffer in bytes
+
+      Modifies: [m_uFrameSkippedBytes].
+
+      Returns:  BOOL
+                  TRUE if the buffer has to be uploaded
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL Renderer::isConstantBufferOutdated(
+        _In_ ID3D11Buffer* pBuffer,
+        _In_ UINT64 uVersion,
+        _In_ UINT uSize
+    )
+    {
+        UINT64 uUploadedVersion = 0u;
+        UINT uDataSize = sizeof(uUploadedVersion);
+        if (SUCCEEDED(pBuffer->GetPrivateData(UPLOADED_VERSION_GUID, &uDataSize, &uUploadedVersion)) && uUploadedVersion == uVersion)
+        {
+            m_uFrameSkippedBytes += uSize;
+            return FALSE;
+        }
+
+        pBuffer->SetPrivateData(UPLOADED_VERSION_GUID, sizeof(uVersion), &uVersion);
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::uploadConstantBuffer
+
+      Summary:  Uploads the constant buffer and counts its size
+
+      Args:     ID3D11Buffer* pBuffer
+                  Constant buffer
+                const void* pData
+                  Content of the constant buffer
+                UINT uSize
+                  Size of the constant buffer in bytes
+
+      Modifies: [m_uFrameUploadedBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Renderer::uploadConstantBuffer(
+        _In_ ID3D11Buffer* pBuffer,
+        _In_reads_bytes_(uSize) const void* pData,
+        _In_ UINT uSize
+    )
+    {
+        m_immediateContext->UpdateSubresource(pBuffer, 0u, nullptr, pData, 0u, 0u);
+        m_uFrameUploadedBytes += uSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::uploadBoneTransforms
+
+      Summary:  Overwrites the dynamic bone transforms buffer and
+                counts its size
+
+      Args:     ID3D11Buffer* pBuffer
+                  Dynamic buffer of the bone transforms
+                const void* pData
+                  Bone transforms
+                UINT uSize
+                  Size of the bone transforms in bytes
+
+      Modifies: [m_uFrameUploadedBoneBytes].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Renderer::uploadBoneTransforms(
+        _In_ ID3D11Buffer* pBuffer,
+        _In_reads_bytes_(uSize) const void* pData,
+        _In_ UINT uSize
+    )
+    {
+        D3D11_MAPPED_SUBRESOURCE mappedResource = {};
+        if (FAILED(m_immediateContext->Map(pBuffer, 0u, D3D11_MAP_WRITE_DISCARD, 0u, &mappedResource)))
+        {
+            return;
+        }
+
+        memcpy(mappedResource.pData, pData, uSize);
+        m_immediateContext->Unmap(pBuffer, 0u);
+
+        m_uFrameUploadedBoneBytes += uSize;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::reportConstantBufferUploads
+
+      Summary:  Accumulates the constant buffer bytes of the frame and
+                prints their average to the debug output every
+                REPORT_INTERVAL frames
+
+      Modifies: [m_uReportedUploadedBytes, m_uReportedSkippedBytes,
+                 m_uReportedUploadedBoneBytes, m_uNumReportedFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Renderer::reportConstantBufferUploads()
+    {
+        m_uReportedUploadedBytes += m_uFrameUploadedBytes;
+        m_uReportedSkippedBytes += m_uFrameSkippedBytes;
+        m_uReportedUploadedBoneBytes += m_uFrameUploadedBoneBytes;
+        ++m_uNumReportedFrames;
+
+        if (m_uNumReportedFrames < REPORT_INTERVAL)
+        {
+            return;
+        }
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Renderer: %llu constant buffer bytes uploaded and %llu bytes skipped, %llu bone transform bytes uploaded per frame on average\n",
+            m_uReportedUploadedBytes / m_uNumReportedFrames,
+            m_uReportedSkippedBytes / m_uNumReportedFrames,
+            m_uReportedUploadedBoneBytes / m_uNumReportedFrames
+        );
+        OutputDebugString(szMessage);
+
+        m_uReportedUploadedBytes = 0u;
+        m_uReportedSkippedBytes = 0u;
+        m_uReportedUploadedBoneBytes = 0u;
+        m_uNumReportedFrames = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetUploadedConstantBufferBytes
+
+      Summary:  Returns the number of constant buffer bytes uploaded
+                during the last frame
+
+      Returns:  UINT
+                  Uploaded bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT Renderer::GetUploadedConstantBufferBytes() const
+    {
+        return m_uFrameUploadedBytes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetSkippedConstantBufferBytes
+
+      Summary:  Returns the number of constant buffer bytes that were
+                not uploaded during the last frame because their source
+                state was unchanged
+
+      Returns:  UINT
+                  Skipped bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT Renderer::GetSkippedConstantBufferBytes() const
+    {
+        return m_uFrameSkippedBytes;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Renderer::GetUploadedBoneTransformBytes
+
+      Summary:  Returns the number of bone transform bytes uploaded
+                during the last frame
+
+      Returns:  UINT
+                  Uploaded bytes
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT Renderer::GetUploadedBoneTransformBytes() const
+    {
+        return m_uFrameUploadedBoneBytes;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -15,6 +15,7 @@
 
 #include "Camera/Camera.h"
 #include "Light/PointLight.h"
+#include "Light/ShadowCascade.h"
 #include "Model/Model.h"
 #include "Renderer/DataTypes.h"
 #include "Renderer/Renderable.h"
@@ -41,6 +42,17 @@ namespace library
                   Update the renderables each frame
                 Render
                   Renders the frame
+                RenderSceneToTexture
+                  Renders the shadow casters into the cascades
+                GetUploadedConstantBufferBytes
+                  Returns the constant buffer bytes uploaded in the
+                  last frame
+                GetSkippedConstantBufferBytes
+                  Returns the constant buffer bytes skipped in the
+                  last frame
+                GetUploadedBoneTransformBytes
+                  Returns the bone transform bytes uploaded in the
+                  last frame
                 GetDriverType
                   Returns the Direct3D driver type
                 Renderer
@@ -70,9 +82,25 @@ namespace library
         void Render();
         void RenderSceneToTexture();
 
+        UINT GetUploadedConstantBufferBytes() const;
+        UINT GetSkippedConstantBufferBytes() const;
+        UINT GetUploadedBoneTransformBytes() const;
+
         D3D_DRIVER_TYPE GetDriverType() const;
 
     private:
+        void renderShadowCascade(_In_ UINT uCascadeIndex);
+        BOOL isConstantBufferOutdated(_In_ ID3D11Buffer* pBuffer, _In_ UINT64 uVersion, _In_ UINT uSize);
+        void uploadConstantBuffer(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize);
+        void uploadBoneTransforms(_In_ ID3D11Buffer* pBuffer, _In_reads_bytes_(uSize) const void* pData, _In_ UINT uSize);
+        void reportConstantBufferUploads();
+
+    private:
+        static constexpr const UINT CASCADE_RESOLUTION = 2048u;
+        static constexpr const FLOAT CASCADE_SPLIT_LAMBDA = 0.75f;
+        static constexpr const FLOAT SHADOW_DISTANCE = 200.0f;
+        static constexpr const UINT REPORT_INTERVAL = 1000u;
+
         D3D_DRIVER_TYPE m_driverType;
         D3D_FEATURE_LEVEL m_featureLevel;
         ComPtr<ID3D11Device> m_d3dDevice;
@@ -87,6 +115,9 @@ namespace library
         ComPtr<ID3D11Buffer> m_cbChangeOnResize;
         ComPtr<ID3D11Buffer> m_cbLights;
         ComPtr<ID3D11Buffer> m_cbShadowMatrix;
+        ComPtr<ID3D11Buffer> m_cbCascades;
+        ComPtr<ID3D11Texture2D> m_cascadeDepthStencil;
+        ComPtr<ID3D11DepthStencilView> m_cascadeDepthStencilView;
         PCWSTR m_pszMainSceneName;
         BYTE m_padding[8];
         Camera m_camera;
@@ -94,8 +125,17 @@ namespace library
 
         std::unordered_map<std::wstring, std::shared_ptr<Scene>> m_scenes;
         std::shared_ptr<Texture> m_invalidTexture;
-        std::shared_ptr<RenderTexture> m_shadowMapTexture;
+        ShadowCascade m_aShadowCascades[NUM_CASCADES];
+        std::shared_ptr<RenderTexture> m_aCascadeTextures[NUM_CASCADES];
         std::shared_ptr<ShadowVertexShader> m_shadowVertexShader;
         std::shared_ptr<PixelShader> m_shadowPixelShader;
+
+        UINT m_uFrameUploadedBytes;
+        UINT m_uFrameSkippedBytes;
+        UINT m_uFrameUploadedBoneBytes;
+        UINT64 m_uReportedUploadedBytes;
+        UINT64 m_uReportedSkippedBytes;
+        UINT64 m_uReportedUploadedBoneBytes;
+        UINT m_uNumReportedFrames;
     };
 }
\ No newline at end of file
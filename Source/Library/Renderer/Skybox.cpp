@@ -4,6 +4,8 @@
 #include "assimp/scene.h"		// output data structure
 #include "assimp/postprocess.h"	// post processing flags
 
+#include <thread>
+
 namespace library
 {
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -16,7 +18,8 @@ namespace library
                 FLOAT scale
                   Scaling factor
 
-      Modifies: [m_cubeMapFileName, m_scale].
+      Modifies: [m_cubeMapFileName, m_scale, m_cbIrradiance,
+                 m_prefilteredSpecular].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     Skybox::Skybox(
@@ -26,20 +29,25 @@ namespace library
         : Model("Content/Common/Sphere.obj")
         , m_cubeMapFileName(cubeMapFilePath)
         , m_scale(scale)
+        , m_cbIrradiance(nullptr)
+        , m_prefilteredSpecular()
     {
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Skybox::Initialize
 
-      Summary:  Initializes the skybox and cube map texture
+      Summary:  Initializes the skybox, cube map texture, the
+                irradiance constant buffer and the prefiltered
+                specular cube map
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
                 ID3D11DeviceContext* pImmediateContext
                   The Direct3D context to set buffers
 
-      Modifies: [m_aMeshes, m_aMaterials].
+      Modifies: [m_aMeshes, m_aMaterials, m_cbIrradiance,
+                 m_prefilteredSpecular].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     HRESULT Skybox::Initialize(
@@ -55,7 +63,7 @@ namespace library
             return hr;
         }
 
-        m_world = XMMatrixScaling(m_scale, m_scale, m_scale);
+        setWorldMatrix(XMMatrixScaling(m_scale, m_scale, m_scale));
 
         m_aMeshes[0].uMaterialIndex = 0;
 
@@ -67,7 +75,57 @@ namespace library
             return hr;
         }
 
-        return hr;
+        // Baked data is cached next to the cube map and keyed by the hash of its file
+        UINT64 uHash = 0u;
+        HRESULT hrHash = ComputeFileHash(m_cubeMapFileName, uHash);
+        CubeMapData cubeMap = {};
+
+        // Diffuse ambient from the sky, the flat ambient is kept when the cube map can't be read back
+        CBIrradiance cbIrradiance = {};
+        hr = SUCCEEDED(hrHash) ? computeIrradiance(pDevice, pImmediateContext, uHash, cubeMap, cbIrradiance) : hrHash;
+        if (FAILED(hr))
+        {
+            OutputDebugString(L"Can't compute the irradiance of \"");
+            OutputDebugString(m_cubeMapFileName.c_str());
+            OutputDebugString(L"\"\n");
+
+            cbIrradiance = {};
+            cbIrradiance.Coefficients[0] = XMFLOAT4(DEFAULT_AMBIENT, DEFAULT_AMBIENT, DEFAULT_AMBIENT, 0.0f);
+        }
+
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = sizeof(CBIrradiance),
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u,
+            .StructureByteStride = 0u
+        };
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = &cbIrradiance,
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+        hr = pDevice->CreateBuffer(&bd, &initData, m_cbIrradiance.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Glossy reflections, the unfiltered cube map is used when the bake fails
+        hr = SUCCEEDED(hrHash) ? prefilterSpecular(pDevice, pImmediateContext, uHash, cubeMap) : hrHash;
+        if (FAILED(hr))
+        {
+            OutputDebugString(L"Can't prefilter the specular environment of \"");
+            OutputDebugString(m_cubeMapFileName.c_str());
+            OutputDebugString(L"\"\n");
+
+            m_prefilteredSpecular.reset();
+        }
+
+        return S_OK;
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
@@ -84,6 +142,268 @@ namespace library
         return m_aMaterials[0]->pDiffuse;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skybox::GetIrradianceConstantBuffer
+
+      Summary:  Returns the constant buffer of the irradiance spherical
+                harmonics coefficients
+
+      Returns:  ComPtr<ID3D11Buffer>&
+                  The constant buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ComPtr<ID3D11Buffer>& Skybox::GetIrradianceConstantBuffer()
+    {
+        return m_cbIrradiance;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skybox::GetPrefilteredSpecularView
+
+      Summary:  Returns the GGX prefiltered mip chain of the cube map,
+                or the cube map itself when it could not be baked
+
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  Shader resource view of the prefiltered cube map
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ComPtr<ID3D11ShaderResourceView>& Skybox::GetPrefilteredSpecularView()
+    {
+        if (m_prefilteredSpecular)
+        {
+            return m_prefilteredSpecular->GetTextureResourceView();
+        }
+
+        return m_aMaterials[0]->pDiffuse->GetTextureResourceView();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skybox::computeIrradiance
+
+      Summary:  Projects the cube map into irradiance spherical
+                harmonics. The coefficients are cached next to the cube
+                map, keyed by the hash of the cube map file, so the
+                projection only runs when the file changes.
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to read back the cube map
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to read back the cube map
+                UINT64 uHash
+                  Hash of the cube map file
+                CubeMapData& cubeMap
+                  Cube map read back to the CPU, read on first use
+                CBIrradiance& cbIrradiance
+                  Irradiance coefficients
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Skybox::computeIrradiance(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ UINT64 uHash,
+        _Inout_ CubeMapData& cubeMap,
+        _Out_ CBIrradiance& cbIrradiance
+    )
+    {
+        std::filesystem::path cacheFilePath = m_cubeMapFileName;
+        cacheFilePath += L".sh9";
+        if (SUCCEEDED(LoadIrradianceCache(cacheFilePath, uHash, cbIrradiance.Coefficients)))
+        {
+            OutputDebugString(L"Skybox irradiance: loaded from \"");
+            OutputDebugString(cacheFilePath.c_str());
+            OutputDebugString(L"\"\n");
+            return S_OK;
+        }
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        HRESULT hr = readCubeMap(pDevice, pImmediateContext, cubeMap);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        ProjectIrradianceSH9(cubeMap, cbIrradiance.Coefficients);
+
+        QueryPerformanceCounter(&endTime);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Skybox irradiance: projected 6 x %u x %u texels in %.3f ms\n",
+            cubeMap.uSize,
+            cubeMap.uSize,
+            static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart)
+        );
+        OutputDebugString(szMessage);
+
+        if (FAILED(SaveIrradianceCache(cacheFilePath, uHash, cbIrradiance.Coefficients)))
+        {
+            OutputDebugString(L"Can't write the irradiance cache \"");
+            OutputDebugString(cacheFilePath.c_str());
+            OutputDebugString(L"\"\n");
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skybox::prefilterSpecular
+
+      Summary:  Bakes the GGX prefiltered mip chain of the cube map
+                with one worker thread per hardware thread and loads it
+                through the DDS loader. The chain is written next to
+                the cube map with the hash of the cube map file in its
+                name, so the bake only runs when the file changes.
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the texture
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to read back the cube map
+                UINT64 uHash
+                  Hash of the cube map file
+                CubeMapData& cubeMap
+                  Cube map read back to the CPU, read on first use and
+                  consumed by the bake
+
+      Modifies: [m_prefilteredSpecular].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Skybox::prefilterSpecular(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ UINT64 uHash,
+        _Inout_ CubeMapData& cubeMap
+    )
+    {
+        WCHAR szMessage[256];
+        swprintf_s(szMessage, L".%016llX.ggx.dds", uHash);
+
+        std::filesystem::path cacheFilePath = m_cubeMapFileName;
+        cacheFilePath += szMessage;
+
+        if (std::filesystem::exists(cacheFilePath))
+        {
+            m_prefilteredSpecular = std::make_shared<Texture>(cacheFilePath, eTextureSamplerType::TRILINEAR_CLAMP);
+            if (SUCCEEDED(m_prefilteredSpecular->Initialize(pDevice, pImmediateContext)))
+            {
+                OutputDebugString(L"Skybox specular: cache hit \"");
+                OutputDebugString(cacheFilePath.c_str());
+                OutputDebugString(L"\"\n");
+                return S_OK;
+            }
+        }
+
+        OutputDebugString(L"Skybox specular: cache miss \"");
+        OutputDebugString(cacheFilePath.c_str());
+        OutputDebugString(L"\"\n");
+
+        HRESULT hr = readCubeMap(pDevice, pImmediateContext, cubeMap);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Box filtered source chain, fetched according to the solid angle of every sample
+        std::vector<CubeMapData> aSourceMips;
+        aSourceMips.push_back(std::move(cubeMap));
+        while (aSourceMips.back().uSize > 1u)
+        {
+            CubeMapData nextMip;
+            DownsampleCubeMap(aSourceMips.back(), nextMip);
+            aSourceMips.push_back(std::move(nextMip));
+        }
+
+        UINT uSize = aSourceMips[0].uSize < SPECULAR_SIZE ? aSourceMips[0].uSize : SPECULAR_SIZE;
+        UINT uNumMips = 1u;
+        while (uNumMips < NUM_SPECULAR_MIPS && (uSize >> uNumMips) > 0u)
+        {
+            ++uNumMips;
+        }
+
+        const UINT uNumThreads = std::thread::hardware_concurrency() > 0u ? std::thread::hardware_concurrency() : 1u;
+
+        std::vector<CubeMapData> aPrefilteredMips;
+        PrefilterStats stats = {};
+        PrefilterSpecularGGX(aSourceMips, uSize, uNumMips, NUM_SPECULAR_SAMPLES, uNumThreads, aPrefilteredMips, stats);
+
+        FLOAT busyTime = 0.0f;
+        for (UINT i = 0u; i < stats.aThreads.size(); ++i)
+        {
+            swprintf_s(
+                szMessage,
+                L"Skybox specular: thread %u prefiltered %u rows, %u texels in %.3f ms\n",
+                i,
+                stats.aThreads[i].uNumRows,
+                stats.aThreads[i].uNumTexels,
+                stats.aThreads[i].busyTime
+            );
+            OutputDebugString(szMessage);
+            busyTime += stats.aThreads[i].busyTime;
+        }
+        swprintf_s(
+            szMessage,
+            L"Skybox specular: baked %u mips of %u x %u in %.3f ms, %.2fx speedup on %u threads\n",
+            uNumMips,
+            uSize,
+            uSize,
+            stats.bakeTime,
+            stats.bakeTime > 0.0f ? busyTime / stats.bakeTime : 0.0f,
+            uNumThreads
+        );
+        OutputDebugString(szMessage);
+
+        hr = SaveCubeMapToDDS(cacheFilePath, aPrefilteredMips);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_prefilteredSpecular = std::make_shared<Texture>(cacheFilePath, eTextureSamplerType::TRILINEAR_CLAMP);
+        return m_prefilteredSpecular->Initialize(pDevice, pImmediateContext);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skybox::readCubeMap
+
+      Summary:  Reads the cube map back to the CPU unless it was
+                already read
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the staging texture
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to copy the faces
+                CubeMapData& cubeMap
+                  Cube map read back to the CPU
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Skybox::readCubeMap(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _Inout_ CubeMapData& cubeMap
+    )
+    {
+        if (cubeMap.uSize > 0u)
+        {
+            return S_OK;
+        }
+
+        return ReadCubeMap(pDevice, pImmediateContext, m_aMaterials[0]->pDiffuse->GetTextureResourceView().Get(), cubeMap);
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Skybox::initSingleMesh
 
@@ -108,10 +428,8 @@ namespace library
             const aiVector3D& position = pMesh->mVertices[i];
             const aiVector3D& normal = pMesh->mNormals[i];
             const aiVector3D& texCoord = pMesh->HasTextureCoords(0u) ? pMesh->mTextureCoords[0][i] : zero3d;
-            const aiVector3D& tangent = pMesh->HasTangentsAndBitangents() ? pMesh->mTangents[i] : zero3d;
-            const aiVector3D& bitangent = pMesh->HasTangentsAndBitangents() ? pMesh->mBitangents[i] : zero3d;
 
-            m_aVertices.push_back(
+            m_asset->aVertices.push_back(
                 SimpleVertex
                 {
                     .Position = XMFLOAT3(position.x, position.y, position.z),
@@ -119,14 +437,6 @@ namespace library
                     .Normal = XMFLOAT3(normal.x, normal.y, normal.z)
                 }
             );
-
-            m_aNormalData.push_back(
-                NormalData
-                {
-                    .Tangent = XMFLOAT3(tangent.x, tangent.y, tangent.z),
-                    .Bitangent = XMFLOAT3(bitangent.x, bitangent.y, bitangent.z)
-                }
-            );
         }
 
         // Populate the index buffer 
@@ -135,11 +445,42 @@ namespace library
             const aiFace& face = pMesh->mFaces[i];
             assert(face.mNumIndices == 3u);
 
-            m_aIndices.push_back(static_cast<WORD>(face.mIndices[2]));
-            m_aIndices.push_back(static_cast<WORD>(face.mIndices[1]));
-            m_aIndices.push_back(static_cast<WORD>(face.mIndices[0]));
+            appendIndex(uMeshIndex, face.mIndices[2]);
+            appendIndex(uMeshIndex, face.mIndices[1]);
+            appendIndex(uMeshIndex, face.mIndices[0]);
         }
 
         initMeshBones(uMeshIndex, pMesh);
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skybox::isAssetShared
+
+      Summary:  The sphere of the skybox is wound inside out and gets
+                the cube map as its own material, so it is never shared
+                with the models loading the same file
+
+      Returns:  BOOL
+                  FALSE
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL Skybox::isAssetShared() const
+    {
+        return FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Skybox::isVertexFormatPacked
+
+      Summary:  The cube map shader reads the full precision positions
+                of the sphere
+
+      Returns:  BOOL
+                  FALSE
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL Skybox::isVertexFormatPacked() const
+    {
+        return FALSE;
+    }
 }
\ No newline at end of file
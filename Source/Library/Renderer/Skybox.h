@@ -13,7 +13,9 @@
 
 #include "Common.h"
 
+#include "Light/SphericalHarmonics.h"
 #include "Model/Model.h"
+#include "Texture/SpecularPrefilter.h"
 
 namespace library
 {
@@ -31,12 +33,27 @@ namespace library
         //virtual void Update(_In_ FLOAT deltaTime, _In_ const XMVECTOR& lightPosition);
 
         const std::shared_ptr<Texture>& GetSkyboxTexture() const;
+        ComPtr<ID3D11Buffer>& GetIrradianceConstantBuffer();
+        ComPtr<ID3D11ShaderResourceView>& GetPrefilteredSpecularView();
 
     protected:
         virtual void initSingleMesh(_In_ UINT uMeshIndex, _In_ const aiMesh* pMesh) override;
+        virtual BOOL isAssetShared() const override;
+        virtual BOOL isVertexFormatPacked() const override;
+
+        HRESULT computeIrradiance(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ UINT64 uHash, _Inout_ CubeMapData& cubeMap, _Out_ CBIrradiance& cbIrradiance);
+        HRESULT prefilterSpecular(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ UINT64 uHash, _Inout_ CubeMapData& cubeMap);
+        HRESULT readCubeMap(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _Inout_ CubeMapData& cubeMap);
 
     protected:
+        static constexpr const FLOAT DEFAULT_AMBIENT = 0.2f;
+        static constexpr const UINT SPECULAR_SIZE = 256u;
+        static constexpr const UINT NUM_SPECULAR_MIPS = 6u;
+        static constexpr const UINT NUM_SPECULAR_SAMPLES = 128u;
+
         std::filesystem::path m_cubeMapFileName;
         FLOAT m_scale;
+        ComPtr<ID3D11Buffer> m_cbIrradiance;
+        std::shared_ptr<Texture> m_prefilteredSpecular;
     };
 }
\ No newline at end of file
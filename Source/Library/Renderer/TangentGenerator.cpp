@@ -0,0 +1,449 @@
+#include "Renderer/TangentGenerator.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TangentGenerator::TangentGenerator
+
+      Summary:  Constructor
+
+      Modifies: [m_aFaceFrames, m_aCornerOffsets, m_aVertexCorners].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    TangentGenerator::TangentGenerator()
+        : m_aFaceFrames()
+        , m_aCornerOffsets()
+        , m_aVertexCorners()
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TangentGenerator::Generate
+
+      Summary:  Computes the frame of every triangle, lists the corners
+                of every vertex and gathers the frames of the corners
+                into the frame of the vertex
+
+      Args:     const UINT* aIndices
+                  Indices of a triangle list, relative to the first
+                  vertex of the mesh
+                UINT uNumIndices
+                  Number of indices
+                const SimpleVertex* aVertices
+                  Vertices the indices refer to
+                UINT uNumVertices
+                  Number of vertices
+                NormalData* aOutNormalData
+                  Tangent and bitangent of every vertex
+                const ParallelFor& parallelFor
+                  Parallel for the ranges are spread over, or an empty
+                  function to run on the calling thread
+
+      Modifies: [m_aFaceFrames, m_aCornerOffsets, m_aVertexCorners].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void TangentGenerator::Generate(
+        _In_reads_(uNumIndices) const UINT* aIndices,
+        _In_ UINT uNumIndices,
+        _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+        _In_ UINT uNumVertices,
+        _Out_writes_(uNumVertices) NormalData* aOutNormalData,
+        _In_ const ParallelFor& parallelFor
+    )
+    {
+        const UINT uNumTriangles = uNumIndices / 3u;
+        const BOOL bParallel = parallelFor && uNumTriangles >= MIN_PARALLEL_TRIANGLES;
+
+        m_aFaceFrames.resize(uNumTriangles);
+
+        const UINT uNumFaceRanges = (uNumTriangles + RANGE_SIZE - 1u) / RANGE_SIZE;
+        const std::function<void(UINT)> computeFaces = [this, aIndices, aVertices, uNumTriangles](UINT uRange)
+        {
+            const UINT uBegin = uRange * RANGE_SIZE;
+            computeFaceRange(aIndices, aVertices, uBegin, uBegin + RANGE_SIZE < uNumTriangles ? uBegin + RANGE_SIZE : uNumTriangles);
+        };
+
+        const UINT uNumVertexRanges = (uNumVertices + RANGE_SIZE - 1u) / RANGE_SIZE;
+        const std::function<void(UINT)> computeVertices = [this, aVertices, aOutNormalData, uNumVertices](UINT uRange)
+        {
+            const UINT uBegin = uRange * RANGE_SIZE;
+            computeVertexRange(aVertices, aOutNormalData, uBegin, uBegin + RANGE_SIZE < uNumVertices ? uBegin + RANGE_SIZE : uNumVertices);
+        };
+
+        if (bParallel)
+        {
+            parallelFor(uNumFaceRanges, computeFaces);
+        }
+        else
+        {
+            for (UINT uRange = 0u; uRange < uNumFaceRanges; ++uRange)
+            {
+                computeFaces(uRange);
+            }
+        }
+
+        // A counting sort over the vertices, its writes depend on each other
+        buildVertexCorners(aIndices, uNumTriangles * 3u, uNumVertices);
+
+        if (bParallel)
+        {
+            parallelFor(uNumVertexRanges, computeVertices);
+        }
+        else
+        {
+            for (UINT uRange = 0u; uRange < uNumVertexRanges; ++uRange)
+            {
+                computeVertices(uRange);
+            }
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TangentGenerator::Benchmark
+
+      Summary:  Generates the tangent frames of a wavy grid whose
+                texture coordinates follow its x and y axes, on the
+                calling thread and on the parallel for, and prints the
+                triangles per second of both. The tangent of the grid
+                is known at every vertex, the largest angle to it and
+                whether both variants agree are printed too.
+
+      Args:     UINT uNumTriangles
+                  Least number of triangles of the grid
+                UINT uNumIterations
+                  Number of times every variant generates the frames
+                const ParallelFor& parallelFor
+                  Parallel for of the parallel variant, or an empty
+                  function to skip it
+
+      Modifies: [m_aFaceFrames, m_aCornerOffsets, m_aVertexCorners].
+
+      Returns:  FLOAT
+                  Largest angle between a generated tangent and the
+                  tangent of the grid, in radians
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT TangentGenerator::Benchmark(
+        _In_ UINT uNumTriangles,
+        _In_ UINT uNumIterations,
+        _In_ const ParallelFor& parallelFor
+    )
+    {
+        const UINT uGridSize = static_cast<UINT>(ceilf(sqrtf(static_cast<FLOAT>(uNumTriangles) * 0.5f)));
+        const UINT uNumRowVertices = uGridSize + 1u;
+        const FLOAT frequency = XM_2PI * 4.0f;
+        const FLOAT amplitude = 0.02f;
+
+        std::vector<SimpleVertex> aVertices(static_cast<size_t>(uNumRowVertices) * uNumRowVertices);
+        std::vector<XMFLOAT3> aExpectedTangents(aVertices.size());
+        for (UINT y = 0u; y < uNumRowVertices; ++y)
+        {
+            for (UINT x = 0u; x < uNumRowVertices; ++x)
+            {
+                const FLOAT u = static_cast<FLOAT>(x) / static_cast<FLOAT>(uGridSize);
+                const FLOAT v = static_cast<FLOAT>(y) / static_cast<FLOAT>(uGridSize);
+                const FLOAT height = amplitude * sinf(frequency * u) * cosf(frequency * v);
+                const FLOAT slopeU = amplitude * frequency * cosf(frequency * u) * cosf(frequency * v);
+                const FLOAT slopeV = -amplitude * frequency * sinf(frequency * u) * sinf(frequency * v);
+
+                SimpleVertex& vertex = aVertices[static_cast<size_t>(y) * uNumRowVertices + x];
+                vertex.Position = XMFLOAT3(u, v, height);
+                vertex.TexCoord = XMFLOAT2(u, v);
+                XMStoreFloat3(&vertex.Normal, XMVector3Normalize(XMVectorSet(-slopeU, -slopeV, 1.0f, 0.0f)));
+
+                // The position moves along (1, 0, slopeU) with u, the tangent is its part in the plane of the normal
+                const XMVECTOR normal = XMLoadFloat3(&vertex.Normal);
+                const XMVECTOR direction = XMVectorSet(1.0f, 0.0f, slopeU, 0.0f);
+                XMStoreFloat3(
+                    &aExpectedTangents[static_cast<size_t>(y) * uNumRowVertices + x],
+                    XMVector3Normalize(XMVectorSubtract(direction, XMVectorScale(normal, XMVectorGetX(XMVector3Dot(normal, direction)))))
+                );
+            }
+        }
+
+        std::vector<UINT> aIndices;
+        aIndices.reserve(static_cast<size_t>(uGridSize) * uGridSize * 6u);
+        for (UINT y = 0u; y < uGridSize; ++y)
+        {
+            for (UINT x = 0u; x < uGridSize; ++x)
+            {
+                const UINT uCorner = y * uNumRowVertices + x;
+                aIndices.insert(aIndices.end(), { uCorner, uCorner + uNumRowVertices, uCorner + 1u });
+                aIndices.insert(aIndices.end(), { uCorner + 1u, uCorner + uNumRowVertices, uCorner + uNumRowVertices + 1u });
+            }
+        }
+
+        const UINT uNumVertices = static_cast<UINT>(aVertices.size());
+        const UINT uNumIndices = static_cast<UINT>(aIndices.size());
+        std::vector<NormalData> aSerialNormalData(uNumVertices);
+        std::vector<NormalData> aParallelNormalData(uNumVertices);
+
+        LARGE_INTEGER timerFrequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&timerFrequency);
+
+        const UINT uNumVariants = parallelFor ? 2u : 1u;
+        FLOAT aSeconds[2] = { 0.0f, };
+        for (UINT uVariant = 0u; uVariant < uNumVariants; ++uVariant)
+        {
+            QueryPerformanceCounter(&startTime);
+            for (UINT i = 0u; i < uNumIterations; ++i)
+            {
+                if (uVariant == 0u)
+                {
+                    Generate(aIndices.data(), uNumIndices, aVertices.data(), uNumVertices, aSerialNormalData.data(), nullptr);
+                }
+                else
+                {
+                    Generate(aIndices.data(), uNumIndices, aVertices.data(), uNumVertices, aParallelNormalData.data(), parallelFor);
+                }
+            }
+            QueryPerformanceCounter(&endTime);
+
+            aSeconds[uVariant] = static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) / static_cast<FLOAT>(timerFrequency.QuadPart);
+        }
+
+        FLOAT maxAngle = 0.0f;
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            const FLOAT cosine = XMVectorGetX(XMVector3Dot(XMLoadFloat3(&aSerialNormalData[i].Tangent), XMLoadFloat3(&aExpectedTangents[i])));
+            maxAngle = fmaxf(maxAngle, acosf(fminf(fmaxf(cosine, -1.0f), 1.0f)));
+        }
+
+        const BOOL bIdentical = !parallelFor || memcmp(aSerialNormalData.data(), aParallelNormalData.data(), sizeof(NormalData) * uNumVertices) == 0;
+        const FLOAT numTriangles = static_cast<FLOAT>(uNumIndices / 3u) * static_cast<FLOAT>(uNumIterations);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Tangent generation of %u triangles: %.3g triangles/s, in parallel %.3g triangles/s, %s, max tangent error %.4f rad\n",
+            uNumIndices / 3u,
+            numTriangles / fmaxf(aSeconds[0], FLT_MIN),
+            parallelFor ? numTriangles / fmaxf(aSeconds[1], FLT_MIN) : 0.0f,
+            bIdentical ? L"identical results" : L"results differ",
+            maxAngle
+        );
+        OutputDebugString(szMessage);
+
+        return maxAngle;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TangentGenerator::buildVertexCorners
+
+      Summary:  Lists the corners of every vertex, in the order of the
+                triangles, as offsets into one array
+
+      Args:     const UINT* aIndices
+                  Indices of a triangle list
+                UINT uNumIndices
+                  Number of indices, a multiple of 3
+                UINT uNumVertices
+                  Number of vertices
+
+      Modifies: [m_aCornerOffsets, m_aVertexCorners].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void TangentGenerator::buildVertexCorners(
+        _In_reads_(uNumIndices) const UINT* aIndices,
+        _In_ UINT uNumIndices,
+        _In_ UINT uNumVertices
+    )
+    {
+        m_aCornerOffsets.assign(static_cast<size_t>(uNumVertices) + 1u, 0u);
+        for (UINT i = 0u; i < uNumIndices; ++i)
+        {
+            ++m_aCornerOffsets[aIndices[i] + 1u];
+        }
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            m_aCornerOffsets[i + 1u] += m_aCornerOffsets[i];
+        }
+
+        // Filled through the offsets shifted down by one, which end up where they started
+        m_aVertexCorners.resize(uNumIndices);
+        for (UINT i = 0u; i < uNumIndices; ++i)
+        {
+            m_aVertexCorners[m_aCornerOffsets[aIndices[i]]++] = i;
+        }
+        for (UINT i = uNumVertices; i > 0u; --i)
+        {
+            m_aCornerOffsets[i] = m_aCornerOffsets[i - 1u];
+        }
+        m_aCornerOffsets[0] = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TangentGenerator::computeFaceRange
+
+      Summary:  Computes the unit tangent and bitangent of a range of
+                triangles from the edges in space and in texture
+                space, and their angles at each corner. A triangle
+                whose texture coordinates are mirrored keeps tangents
+                that point along the texture axes.
+
+      Args:     const UINT* aIndices
+                  Indices of a triangle list
+                const SimpleVertex* aVertices
+                  Vertices the indices refer to
+                UINT uBegin
+                  First triangle of the range
+                UINT uEnd
+                  Triangle past the range
+
+      Modifies: [m_aFaceFrames].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void TangentGenerator::computeFaceRange(
+        _In_ const UINT* aIndices,
+        _In_ const SimpleVertex* aVertices,
+        _In_ UINT uBegin,
+        _In_ UINT uEnd
+    )
+    {
+        for (UINT i = uBegin; i < uEnd; ++i)
+        {
+            const SimpleVertex& v0 = aVertices[aIndices[i * 3u]];
+            const SimpleVertex& v1 = aVertices[aIndices[i * 3u + 1u]];
+            const SimpleVertex& v2 = aVertices[aIndices[i * 3u + 2u]];
+
+            const XMVECTOR p0 = XMLoadFloat3(&v0.Position);
+            const XMVECTOR p1 = XMLoadFloat3(&v1.Position);
+            const XMVECTOR p2 = XMLoadFloat3(&v2.Position);
+            const XMVECTOR edge1 = XMVectorSubtract(p1, p0);
+            const XMVECTOR edge2 = XMVectorSubtract(p2, p0);
+
+            const FLOAT du1 = v1.TexCoord.x - v0.TexCoord.x;
+            const FLOAT dv1 = v1.TexCoord.y - v0.TexCoord.y;
+            const FLOAT du2 = v2.TexCoord.x - v0.TexCoord.x;
+            const FLOAT dv2 = v2.TexCoord.y - v0.TexCoord.y;
+            const FLOAT signedArea = du1 * dv2 - du2 * dv1;
+
+            FaceFrame& frame = m_aFaceFrames[i];
+            XMVECTOR tangent = XMVectorZero();
+            XMVECTOR bitangent = XMVectorZero();
+            if (signedArea != 0.0f)
+            {
+                // Only the directions are kept, the sign of the area turns them along the texture axes
+                const XMVECTOR sign = XMVectorReplicate(signedArea > 0.0f ? 1.0f : -1.0f);
+                tangent = XMVectorMultiply(XMVectorSubtract(XMVectorScale(edge1, dv2), XMVectorScale(edge2, dv1)), sign);
+                bitangent = XMVectorMultiply(XMVectorSubtract(XMVectorScale(edge2, du1), XMVectorScale(edge1, du2)), sign);
+                tangent = XMVector3Normalize(tangent);
+                bitangent = XMVector3Normalize(bitangent);
+            }
+            XMStoreFloat3(&frame.Tangent, tangent);
+            XMStoreFloat3(&frame.Bitangent, bitangent);
+
+            // A triangle without area has no direction to give, as in MikkTSpace it does not count
+            if (XMVectorGetX(XMVector3LengthSq(XMVector3Cross(edge1, edge2))) <= 0.0f)
+            {
+                frame.aCornerAngles[0] = 0.0f;
+                frame.aCornerAngles[1] = 0.0f;
+                frame.aCornerAngles[2] = 0.0f;
+                continue;
+            }
+
+            const XMVECTOR direction01 = XMVector3Normalize(edge1);
+            const XMVECTOR direction02 = XMVector3Normalize(edge2);
+            const XMVECTOR direction12 = XMVector3Normalize(XMVectorSubtract(p2, p1));
+            const FLOAT cosine0 = XMVectorGetX(XMVector3Dot(direction01, direction02));
+            const FLOAT cosine1 = -XMVectorGetX(XMVector3Dot(direction01, direction12));
+            const FLOAT cosine2 = XMVectorGetX(XMVector3Dot(direction02, direction12));
+            frame.aCornerAngles[0] = XMScalarACos(fminf(fmaxf(cosine0, -1.0f), 1.0f));
+            frame.aCornerAngles[1] = XMScalarACos(fminf(fmaxf(cosine1, -1.0f), 1.0f));
+            frame.aCornerAngles[2] = XMScalarACos(fminf(fmaxf(cosine2, -1.0f), 1.0f));
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TangentGenerator::computeVertexRange
+
+      Summary:  Gathers the frames of the triangles around a range of
+                vertices. The tangents of the triangles are projected
+                on the plane of the normal of the vertex, normalized
+                and weighted by the angle of the triangle at the
+                vertex. Right and left handed triangles are summed
+                apart, as their tangents cancel out on a mirrored seam,
+                and the vertex takes the side with the larger angle. A
+                vertex whose triangles have no tangent takes any
+                direction perpendicular to its normal.
+
+      Args:     const SimpleVertex* aVertices
+                  Vertices of the mesh
+                NormalData* aOutNormalData
+                  Tangent and bitangent of every vertex
+                UINT uBegin
+                  First vertex of the range
+                UINT uEnd
+                  Vertex past the range
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void TangentGenerator::computeVertexRange(
+        _In_ const SimpleVertex* aVertices,
+        _Out_ NormalData* aOutNormalData,
+        _In_ UINT uBegin,
+        _In_ UINT uEnd
+    ) const
+    {
+        for (UINT i = uBegin; i < uEnd; ++i)
+        {
+            const XMVECTOR normal = XMVector3Normalize(XMLoadFloat3(&aVertices[i].Normal));
+
+            // Index 0 sums the right handed triangles, index 1 the mirrored ones
+            XMVECTOR aTangentSums[2] = { XMVectorZero(), XMVectorZero() };
+            XMVECTOR aBitangentSums[2] = { XMVectorZero(), XMVectorZero() };
+            FLOAT aAngleSums[2] = { 0.0f, 0.0f };
+            for (UINT j = m_aCornerOffsets[i]; j < m_aCornerOffsets[i + 1u]; ++j)
+            {
+                const UINT uCorner = m_aVertexCorners[j];
+                const FaceFrame& frame = m_aFaceFrames[uCorner / 3u];
+                const FLOAT angle = frame.aCornerAngles[uCorner % 3u];
+
+                const XMVECTOR faceTangent = XMLoadFloat3(&frame.Tangent);
+                if (XMVector3Equal(faceTangent, XMVectorZero()))
+                {
+                    continue;
+                }
+
+                const XMVECTOR faceBitangent = XMLoadFloat3(&frame.Bitangent);
+                const UINT uSide = XMVectorGetX(XMVector3Dot(XMVector3Cross(normal, faceTangent), faceBitangent)) < 0.0f ? 1u : 0u;
+
+                const XMVECTOR projectedTangent = XMVectorSubtract(faceTangent, XMVectorMultiply(normal, XMVector3Dot(normal, faceTangent)));
+                aTangentSums[uSide] = XMVectorMultiplyAdd(XMVector3Normalize(projectedTangent), XMVectorReplicate(angle), aTangentSums[uSide]);
+                aBitangentSums[uSide] = XMVectorMultiplyAdd(faceBitangent, XMVectorReplicate(angle), aBitangentSums[uSide]);
+                aAngleSums[uSide] += angle;
+            }
+
+            const UINT uSide = aAngleSums[1] > aAngleSums[0] ? 1u : 0u;
+            const XMVECTOR tangentSum = aTangentSums[uSide];
+            const XMVECTOR bitangentSum = aBitangentSums[uSide];
+
+            XMVECTOR tangent = XMVectorSubtract(tangentSum, XMVectorMultiply(normal, XMVector3Dot(normal, tangentSum)));
+            if (XMVectorGetX(XMVector3LengthSq(tangent)) <= FLT_MIN)
+            {
+                // Any axis at least 54 degrees away from the normal
+                const XMVECTOR absNormal = XMVectorAbs(normal);
+                const XMVECTOR axis = XMVectorGetX(absNormal) <= XMVectorGetY(absNormal) && XMVectorGetX(absNormal) <= XMVectorGetZ(absNormal)
+                    ? g_XMIdentityR0
+                    : XMVectorGetY(absNormal) <= XMVectorGetZ(absNormal) ? g_XMIdentityR1 : g_XMIdentityR2;
+                tangent = XMVectorSubtract(axis, XMVectorMultiply(normal, XMVector3Dot(normal, axis)));
+            }
+            tangent = XMVector3Normalize(tangent);
+
+            XMVECTOR bitangent = XMVector3Cross(normal, tangent);
+            if (XMVectorGetX(XMVector3LengthSq(bitangent)) <= FLT_MIN)
+            {
+                // A vertex without a normal keeps the directions of its triangles
+                bitangent = XMVector3Normalize(bitangentSum);
+            }
+            else if (XMVectorGetX(XMVector3Dot(bitangent, bitangentSum)) < 0.0f)
+            {
+                bitangent = XMVectorNegate(bitangent);
+            }
+
+            XMStoreFloat3(&aOutNormalData[i].Tangent, tangent);
+            XMStoreFloat3(&aOutNormalData[i].Bitangent, bitangent);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/*+===================================================================
+  File:      TANGENTGENERATOR.H
+
+  Summary:   TangentGenerator header file contains declarations of
+             TangentGenerator class that computes the tangent frame of
+             every vertex of a mesh from the triangles around it.
+
+  Classes: TangentGenerator
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <functional>
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TangentGenerator
+
+      Summary:  Accumulates the tangents of the triangles around every
+                vertex the way MikkTSpace does. The tangent of every
+                triangle is taken from its texture coordinates, then
+                every vertex projects the tangents of its triangles on
+                the plane of its normal, weights them by the angle of
+                the triangle at the vertex and normalizes the sum. The
+                bitangent is the cross product of the normal and the
+                tangent, flipped where the texture is mirrored, so the
+                frame is orthonormal. Unlike MikkTSpace, a vertex on a
+                mirrored seam is not split in two: it keeps the frame
+                of the triangles that hold most of its angle, and the
+                triangles on the other side of the seam get their
+                bitangent flipped. Such seams should be split in the
+                modeling tool. The triangles are processed first and
+                the vertices then gather their triangles, both in
+                ranges spread over a parallel for, so no two jobs
+                write the same vertex and the result does not depend
+                on the number of threads.
+
+      Methods:  Generate
+                  Computes the tangent frames of a mesh
+                Benchmark
+                  Prints the throughput on a synthetic mesh
+                TangentGenerator
+                  Constructor.
+                ~TangentGenerator
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TangentGenerator
+    {
+    public:
+        // Runs a job for every index below a count, on any thread, and returns once all of them are done
+        using ParallelFor = std::function<void(UINT uNumJobs, const std::function<void(UINT)>& job)>;
+
+        // Meshes with fewer triangles are faster on a single thread than spread over the parallel for
+        static constexpr const UINT MIN_PARALLEL_TRIANGLES = 65536u;
+
+    public:
+        TangentGenerator();
+        TangentGenerator(const TangentGenerator& other) = delete;
+        TangentGenerator(TangentGenerator&& other) = delete;
+        TangentGenerator& operator=(const TangentGenerator& other) = delete;
+        TangentGenerator& operator=(TangentGenerator&& other) = delete;
+        virtual ~TangentGenerator() = default;
+
+        void Generate(
+            _In_reads_(uNumIndices) const UINT* aIndices,
+            _In_ UINT uNumIndices,
+            _In_reads_(uNumVertices) const SimpleVertex* aVertices,
+            _In_ UINT uNumVertices,
+            _Out_writes_(uNumVertices) NormalData* aOutNormalData,
+            _In_ const ParallelFor& parallelFor
+        );
+        FLOAT Benchmark(_In_ UINT uNumTriangles, _In_ UINT uNumIterations, _In_ const ParallelFor& parallelFor);
+
+    protected:
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   FaceFrame
+
+          Summary:  Unit tangent and bitangent of a triangle, zero when
+                    its texture coordinates have no area, and its angle
+                    at each corner
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct FaceFrame
+        {
+            XMFLOAT3 Tangent;
+            XMFLOAT3 Bitangent;
+            FLOAT aCornerAngles[3];
+        };
+
+        void buildVertexCorners(_In_reads_(uNumIndices) const UINT* aIndices, _In_ UINT uNumIndices, _In_ UINT uNumVertices);
+        void computeFaceRange(
+            _In_ const UINT* aIndices,
+            _In_ const SimpleVertex* aVertices,
+            _In_ UINT uBegin,
+            _In_ UINT uEnd
+        );
+        void computeVertexRange(
+            _In_ const SimpleVertex* aVertices,
+            _Out_ NormalData* aOutNormalData,
+            _In_ UINT uBegin,
+            _In_ UINT uEnd
+        ) const;
+
+    protected:
+        static constexpr const UINT RANGE_SIZE = 4096u;
+
+    protected:
+        std::vector<FaceFrame> m_aFaceFrames;
+        std::vector<UINT> m_aCornerOffsets;
+        std::vector<UINT> m_aVertexCorners;
+    };
+}
@@ -0,0 +1,701 @@
+#include "Scene/HorizonMap.h"
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::HorizonMap
+
+      Summary:  Constructor
+
+      Args:     UINT uWidth
+                  Number of columns along the x axis
+                UINT uDepth
+                  Number of columns along the z axis
+                FLOAT cellSize
+                  World space width of a column
+                const XMFLOAT2& origin
+                  World space xz corner of the first column
+                std::vector<FLOAT>&& aColumnHeights
+                  World space top height of every column, row by row
+                  along the z axis
+
+      Modifies: [m_uWidth, m_uDepth, m_cellSize, m_origin,
+                 m_aColumnHeights, m_aHorizonAngles,
+                 m_aColumnsByPenumbraLow, m_aColumnsByPenumbraHigh,
+                 m_aVisibility, m_lightAzimuth, m_lightElevation,
+                 m_uLightSector, m_bHasResolved, m_fullRebuildTime,
+                 m_incrementalUpdateTime, m_uNumResolvedColumns,
+                 m_uNumUploadedTexels, m_visibilityTexture,
+                 m_visibilityView, m_cbHorizonMap].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HorizonMap::HorizonMap(
+        _In_ UINT uWidth,
+        _In_ UINT uDepth,
+        _In_ FLOAT cellSize,
+        _In_ const XMFLOAT2& origin,
+        _In_ std::vector<FLOAT>&& aColumnHeights
+    )
+        : m_uWidth(uWidth)
+        , m_uDepth(uDepth)
+        , m_cellSize(cellSize)
+        , m_origin(origin)
+
+        , m_aColumnHeights(std::move(aColumnHeights))
+        , m_aHorizonAngles()
+        , m_aColumnsByPenumbraLow()
+        , m_aColumnsByPenumbraHigh()
+        , m_aVisibility(static_cast<size_t>(uWidth) * static_cast<size_t>(uDepth), UCHAR_MAX)
+
+        , m_lightAzimuth(0.0f)
+        , m_lightElevation(0.0f)
+        , m_uLightSector(0u)
+        , m_bHasResolved(FALSE)
+
+        , m_fullRebuildTime(0.0f)
+        , m_incrementalUpdateTime(0.0f)
+        , m_uNumResolvedColumns(0u)
+        , m_uNumUploadedTexels(0u)
+
+        , m_visibilityTexture(nullptr)
+        , m_visibilityView(nullptr)
+        , m_cbHorizonMap(nullptr)
+    {
+        assert(m_aColumnHeights.size() == m_aVisibility.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::Initialize
+
+      Summary:  Builds the horizon angles of every column and their
+                order in every sector, and creates the light visibility
+                texture and the constant buffer
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to set buffers
+
+      Modifies: [m_aHorizonAngles, m_aColumnsByPenumbraLow,
+                 m_aColumnsByPenumbraHigh, m_fullRebuildTime,
+                 m_visibilityTexture, m_visibilityView, m_cbHorizonMap].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT HorizonMap::Initialize(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext
+    )
+    {
+        UNREFERENCED_PARAMETER(pImmediateContext);
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        buildHorizonAngles();
+        buildSectorOrders();
+
+        QueryPerformanceCounter(&endTime);
+        m_fullRebuildTime = static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Horizon map: full rebuild of %u x %u columns, %u directions took %.3f ms\n",
+            m_uWidth,
+            m_uDepth,
+            NUM_DIRECTIONS,
+            m_fullRebuildTime
+        );
+        OutputDebugString(szMessage);
+
+        // Create the light visibility texture, every column starts lit
+        D3D11_TEXTURE2D_DESC textureDesc =
+        {
+            .Width = m_uWidth,
+            .Height = m_uDepth,
+            .MipLevels = 1u,
+            .ArraySize = 1u,
+            .Format = DXGI_FORMAT_R8_UNORM,
+            .SampleDesc = {.Count = 1u },
+            .Usage = D3D11_USAGE_DEFAULT,
+            .BindFlags = D3D11_BIND_SHADER_RESOURCE,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u
+        };
+        D3D11_SUBRESOURCE_DATA textureData =
+        {
+            .pSysMem = m_aVisibility.data(),
+            .SysMemPitch = m_uWidth,
+            .SysMemSlicePitch = 0u
+        };
+        HRESULT hr = pDevice->CreateTexture2D(&textureDesc, &textureData, m_visibilityTexture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc =
+        {
+            .Format = textureDesc.Format,
+            .ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D,
+            .Texture2D =
+            {
+                .MostDetailedMip = 0u,
+                .MipLevels = 1u
+            }
+        };
+        hr = pDevice->CreateShaderResourceView(m_visibilityTexture.Get(), &srvDesc, m_visibilityView.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // The mapping from world xz to texture coordinates never changes
+        CBHorizonMap cbHorizonMap =
+        {
+            .Extent = XMFLOAT4(
+                m_origin.x,
+                m_origin.y,
+                1.0f / (static_cast<FLOAT>(m_uWidth) * m_cellSize),
+                1.0f / (static_cast<FLOAT>(m_uDepth) * m_cellSize)
+            )
+        };
+        D3D11_BUFFER_DESC bd =
+        {
+            .ByteWidth = sizeof(CBHorizonMap),
+            .Usage = D3D11_USAGE_IMMUTABLE,
+            .BindFlags = D3D11_BIND_CONSTANT_BUFFER,
+            .CPUAccessFlags = 0u,
+            .MiscFlags = 0u,
+            .StructureByteStride = 0u
+        };
+        D3D11_SUBRESOURCE_DATA initData =
+        {
+            .pSysMem = &cbHorizonMap,
+            .SysMemPitch = 0u,
+            .SysMemSlicePitch = 0u
+        };
+        hr = pDevice->CreateBuffer(&bd, &initData, m_cbHorizonMap.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::Update
+
+      Summary:  Resolves the light visibility of the columns from the
+                horizon angles of the two directions surrounding the
+                light azimuth. Nothing is done while the light does not
+                move. When the light enters another sector every column
+                is resolved, otherwise only the columns whose penumbra
+                overlaps the elevations between the previous and the
+                current light, taken from whichever sorted order gives
+                fewer columns. Only the rectangle of texels whose
+                visibility changed is uploaded.
+
+      Args:     ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload the texels
+                FXMVECTOR lightDirection
+                  Normalized direction the light travels in
+
+      Modifies: [m_aVisibility, m_lightAzimuth, m_lightElevation,
+                 m_uLightSector, m_bHasResolved,
+                 m_incrementalUpdateTime, m_uNumResolvedColumns,
+                 m_uNumUploadedTexels].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void HorizonMap::Update(
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ FXMVECTOR lightDirection
+    )
+    {
+        XMFLOAT3 toLight;
+        XMStoreFloat3(&toLight, XMVectorNegate(lightDirection));
+
+        FLOAT azimuth = atan2f(toLight.z, toLight.x);
+        if (azimuth < 0.0f)
+        {
+            azimuth += XM_2PI;
+        }
+        const FLOAT elevation = atan2f(toLight.y, sqrtf(toLight.x * toLight.x + toLight.z * toLight.z));
+
+        if (m_bHasResolved
+            && fabsf(azimuth - m_lightAzimuth) < LIGHT_ANGLE_EPSILON
+            && fabsf(elevation - m_lightElevation) < LIGHT_ANGLE_EPSILON)
+        {
+            return;
+        }
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        const FLOAT sectorPosition = azimuth * static_cast<FLOAT>(NUM_DIRECTIONS) / XM_2PI;
+        const UINT uSector = static_cast<UINT>(sectorPosition) % NUM_DIRECTIONS;
+        const FLOAT blend = sectorPosition - floorf(sectorPosition);
+
+        const UINT uNumColumns = static_cast<UINT>(m_aVisibility.size());
+
+        D3D11_BOX dirtyBox =
+        {
+            .left = m_uWidth,
+            .top = m_uDepth,
+            .front = 0u,
+            .right = 0u,
+            .bottom = 0u,
+            .back = 1u
+        };
+
+        m_uNumResolvedColumns = 0u;
+        if (m_bHasResolved && uSector == m_uLightSector)
+        {
+            // Columns whose penumbra is below both elevations stay lit, above both stay shadowed
+            const FLOAT minElevation = elevation < m_lightElevation ? elevation : m_lightElevation;
+            const FLOAT maxElevation = elevation > m_lightElevation ? elevation : m_lightElevation;
+
+            const UINT* pByLowBegin = &m_aColumnsByPenumbraLow[static_cast<size_t>(uSector) * uNumColumns];
+            const UINT* pByLowEnd = std::partition_point(
+                pByLowBegin,
+                pByLowBegin + uNumColumns,
+                [this, uSector, maxElevation](UINT uColumn)
+                {
+                    return getPenumbraLow(uSector, uColumn) < maxElevation;
+                }
+            );
+
+            const UINT* pByHighEnd = &m_aColumnsByPenumbraHigh[static_cast<size_t>(uSector) * uNumColumns] + uNumColumns;
+            const UINT* pByHighBegin = std::partition_point(
+                pByHighEnd - uNumColumns,
+                pByHighEnd,
+                [this, uSector, minElevation](UINT uColumn)
+                {
+                    return getPenumbraHigh(uSector, uColumn) <= minElevation;
+                }
+            );
+
+            if (pByLowEnd - pByLowBegin < pByHighEnd - pByHighBegin)
+            {
+                for (const UINT* pColumn = pByLowBegin; pColumn != pByLowEnd; ++pColumn)
+                {
+                    if (getPenumbraHigh(uSector, *pColumn) > minElevation)
+                    {
+                        resolveColumn(*pColumn, uSector, blend, elevation, dirtyBox);
+                    }
+                }
+            }
+            else
+            {
+                for (const UINT* pColumn = pByHighBegin; pColumn != pByHighEnd; ++pColumn)
+                {
+                    if (getPenumbraLow(uSector, *pColumn) < maxElevation)
+                    {
+                        resolveColumn(*pColumn, uSector, blend, elevation, dirtyBox);
+                    }
+                }
+            }
+        }
+        else
+        {
+            for (UINT uColumn = 0u; uColumn < uNumColumns; ++uColumn)
+            {
+                resolveColumn(uColumn, uSector, blend, elevation, dirtyBox);
+            }
+        }
+
+        m_lightAzimuth = azimuth;
+        m_lightElevation = elevation;
+        m_uLightSector = uSector;
+        m_bHasResolved = TRUE;
+
+        m_uNumUploadedTexels = 0u;
+        if (dirtyBox.left < dirtyBox.right)
+        {
+            pImmediateContext->UpdateSubresource(
+                m_visibilityTexture.Get(),
+                0u,
+                &dirtyBox,
+                &m_aVisibility[static_cast<size_t>(dirtyBox.top) * m_uWidth + dirtyBox.left],
+                m_uWidth,
+                0u
+            );
+            m_uNumUploadedTexels = (dirtyBox.right - dirtyBox.left) * (dirtyBox.bottom - dirtyBox.top);
+        }
+
+        QueryPerformanceCounter(&endTime);
+        m_incrementalUpdateTime = static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::Invalidate
+
+      Summary:  Makes the next update resolve every column
+
+      Modifies: [m_bHasResolved].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void HorizonMap::Invalidate()
+    {
+        m_bHasResolved = FALSE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::GetShaderResourceView
+
+      Summary:  Returns the light visibility texture
+
+      Returns:  ComPtr<ID3D11ShaderResourceView>&
+                  Shader resource view of the light visibility
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ComPtr<ID3D11ShaderResourceView>& HorizonMap::GetShaderResourceView()
+    {
+        return m_visibilityView;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::GetConstantBuffer
+
+      Summary:  Returns the constant buffer mapping world xz to the
+                light visibility texture
+
+      Returns:  ComPtr<ID3D11Buffer>&
+                  The constant buffer
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    ComPtr<ID3D11Buffer>& HorizonMap::GetConstantBuffer()
+    {
+        return m_cbHorizonMap;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::GetVisibility
+
+      Summary:  Returns the light visibility of every column
+
+      Returns:  const std::vector<BYTE>&
+                  Visibility of every column, row by row along the z
+                  axis, 0 is shadowed and UCHAR_MAX is lit
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    const std::vector<BYTE>& HorizonMap::GetVisibility() const
+    {
+        return m_aVisibility;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::GetFullRebuildTime
+
+      Summary:  Returns the duration of the last full rebuild
+
+      Returns:  FLOAT
+                  Duration in milliseconds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT HorizonMap::GetFullRebuildTime() const
+    {
+        return m_fullRebuildTime;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::GetIncrementalUpdateTime
+
+      Summary:  Returns the duration of the last update
+
+      Returns:  FLOAT
+                  Duration in milliseconds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT HorizonMap::GetIncrementalUpdateTime() const
+    {
+        return m_incrementalUpdateTime;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::GetNumResolvedColumns
+
+      Summary:  Returns the number of columns the last update resolved
+
+      Returns:  UINT
+                  Number of columns
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT HorizonMap::GetNumResolvedColumns() const
+    {
+        return m_uNumResolvedColumns;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::GetNumUploadedTexels
+
+      Summary:  Returns the number of texels the last update uploaded
+
+      Returns:  UINT
+                  Number of texels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT HorizonMap::GetNumUploadedTexels() const
+    {
+        return m_uNumUploadedTexels;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::buildHorizonAngles
+
+      Summary:  Sweeps every column towards every azimuth direction.
+                The rows of all directions are independent of each
+                other, so they are swept in parallel.
+
+      Modifies: [m_aHorizonAngles].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void HorizonMap::buildHorizonAngles()
+    {
+        m_aHorizonAngles.resize(static_cast<size_t>(NUM_DIRECTIONS) * m_aVisibility.size());
+
+        std::vector<UINT> aRows(NUM_DIRECTIONS * m_uDepth);
+        std::iota(aRows.begin(), aRows.end(), 0u);
+
+        std::for_each(
+            std::execution::par,
+            aRows.begin(),
+            aRows.end(),
+            [this](UINT uRow)
+            {
+                const UINT uDirection = uRow / m_uDepth;
+                const UINT uColumnZ = uRow % m_uDepth;
+                const FLOAT azimuth = XM_2PI * static_cast<FLOAT>(uDirection) / static_cast<FLOAT>(NUM_DIRECTIONS);
+                const FLOAT dirX = cosf(azimuth);
+                const FLOAT dirZ = sinf(azimuth);
+
+                FLOAT* aAngles = &m_aHorizonAngles[static_cast<size_t>(uRow) * m_uWidth];
+                for (UINT x = 0u; x < m_uWidth; ++x)
+                {
+                    aAngles[x] = sweepHorizonAngle(x, uColumnZ, dirX, dirZ);
+                }
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::buildSectorOrders
+
+      Summary:  Sorts the columns of every sector by the lowest and by
+                the highest elevation of their penumbra. The sectors
+                are independent of each other, so they are sorted in
+                parallel.
+
+      Modifies: [m_aColumnsByPenumbraLow, m_aColumnsByPenumbraHigh].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void HorizonMap::buildSectorOrders()
+    {
+        const UINT uNumColumns = static_cast<UINT>(m_aVisibility.size());
+
+        m_aColumnsByPenumbraLow.resize(static_cast<size_t>(NUM_DIRECTIONS) * uNumColumns);
+        m_aColumnsByPenumbraHigh.resize(static_cast<size_t>(NUM_DIRECTIONS) * uNumColumns);
+
+        std::vector<UINT> aSectors(NUM_DIRECTIONS);
+        std::iota(aSectors.begin(), aSectors.end(), 0u);
+
+        std::for_each(
+            std::execution::par,
+            aSectors.begin(),
+            aSectors.end(),
+            [this, uNumColumns](UINT uSector)
+            {
+                UINT* pByLow = &m_aColumnsByPenumbraLow[static_cast<size_t>(uSector) * uNumColumns];
+                std::iota(pByLow, pByLow + uNumColumns, 0u);
+                std::sort(
+                    pByLow,
+                    pByLow + uNumColumns,
+                    [this, uSector](UINT uLeft, UINT uRight)
+                    {
+                        return getPenumbraLow(uSector, uLeft) < getPenumbraLow(uSector, uRight);
+                    }
+                );
+
+                UINT* pByHigh = &m_aColumnsByPenumbraHigh[static_cast<size_t>(uSector) * uNumColumns];
+                std::iota(pByHigh, pByHigh + uNumColumns, 0u);
+                std::sort(
+                    pByHigh,
+                    pByHigh + uNumColumns,
+                    [this, uSector](UINT uLeft, UINT uRight)
+                    {
+                        return getPenumbraHigh(uSector, uLeft) < getPenumbraHigh(uSector, uRight);
+                    }
+                );
+            }
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::sweepHorizonAngle
+
+      Summary:  Marches from the top of a column towards a direction
+                and returns the highest elevation angle of the columns
+                on the way
+
+      Args:     UINT uColumnX
+                  Column index along the x axis
+                UINT uColumnZ
+                  Column index along the z axis
+                FLOAT dirX
+                  x component of the normalized marching direction
+                FLOAT dirZ
+                  z component of the normalized marching direction
+
+      Returns:  FLOAT
+                  Horizon angle in radians, never below the horizontal
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT HorizonMap::sweepHorizonAngle(
+        _In_ UINT uColumnX,
+        _In_ UINT uColumnZ,
+        _In_ FLOAT dirX,
+        _In_ FLOAT dirZ
+    ) const
+    {
+        const FLOAT height = m_aColumnHeights[static_cast<size_t>(uColumnZ) * m_uWidth + uColumnX];
+
+        FLOAT maxTangent = 0.0f;
+        for (UINT uStep = 1u; uStep <= MAX_SWEEP_STEPS; ++uStep)
+        {
+            const INT x = static_cast<INT>(floorf(static_cast<FLOAT>(uColumnX) + dirX * static_cast<FLOAT>(uStep) + 0.5f));
+            const INT z = static_cast<INT>(floorf(static_cast<FLOAT>(uColumnZ) + dirZ * static_cast<FLOAT>(uStep) + 0.5f));
+            if (x < 0 || z < 0 || x >= static_cast<INT>(m_uWidth) || z >= static_cast<INT>(m_uDepth))
+            {
+                break;
+            }
+
+            const FLOAT rise = m_aColumnHeights[static_cast<size_t>(z) * m_uWidth + static_cast<size_t>(x)] - height;
+            const FLOAT tangent = rise / (static_cast<FLOAT>(uStep) * m_cellSize);
+            maxTangent = tangent > maxTangent ? tangent : maxTangent;
+        }
+
+        return atanf(maxTangent);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::getPenumbraLow
+
+      Summary:  Returns the elevation below which a column is fully
+                shadowed anywhere in a sector
+
+      Args:     UINT uSector
+                  Sector between the direction of the same index and
+                  the next one
+                UINT uColumn
+                  Column index, row by row along the z axis
+
+      Returns:  FLOAT
+                  Elevation angle in radians
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT HorizonMap::getPenumbraLow(
+        _In_ UINT uSector,
+        _In_ UINT uColumn
+    ) const
+    {
+        const size_t uNumColumns = m_aVisibility.size();
+        const FLOAT first = m_aHorizonAngles[uSector * uNumColumns + uColumn];
+        const FLOAT second = m_aHorizonAngles[((uSector + 1u) % NUM_DIRECTIONS) * uNumColumns + uColumn];
+
+        return (first < second ? first : second) - 0.5f * PENUMBRA_ANGLE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::getPenumbraHigh
+
+      Summary:  Returns the elevation above which a column is fully lit
+                anywhere in a sector
+
+      Args:     UINT uSector
+                  Sector between the direction of the same index and
+                  the next one
+                UINT uColumn
+                  Column index, row by row along the z axis
+
+      Returns:  FLOAT
+                  Elevation angle in radians
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    FLOAT HorizonMap::getPenumbraHigh(
+        _In_ UINT uSector,
+        _In_ UINT uColumn
+    ) const
+    {
+        const size_t uNumColumns = m_aVisibility.size();
+        const FLOAT first = m_aHorizonAngles[uSector * uNumColumns + uColumn];
+        const FLOAT second = m_aHorizonAngles[((uSector + 1u) % NUM_DIRECTIONS) * uNumColumns + uColumn];
+
+        return (first > second ? first : second) + 0.5f * PENUMBRA_ANGLE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   HorizonMap::resolveColumn
+
+      Summary:  Blends the horizon angles of the directions surrounding
+                the light azimuth and stores the light visibility of a
+                column, growing the dirty rectangle when it changed
+
+      Args:     UINT uColumn
+                  Column index, row by row along the z axis
+                UINT uSector
+                  Sector the light azimuth is in
+                FLOAT blend
+                  Position of the light azimuth in the sector
+                FLOAT elevation
+                  Light elevation angle in radians
+                D3D11_BOX& dirtyBox
+                  Rectangle of the texels that changed
+
+      Modifies: [m_aVisibility, m_uNumResolvedColumns].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void HorizonMap::resolveColumn(
+        _In_ UINT uColumn,
+        _In_ UINT uSector,
+        _In_ FLOAT blend,
+        _In_ FLOAT elevation,
+        _Inout_ D3D11_BOX& dirtyBox
+    )
+    {
+        const size_t uNumColumns = m_aVisibility.size();
+        const FLOAT first = m_aHorizonAngles[uSector * uNumColumns + uColumn];
+        const FLOAT second = m_aHorizonAngles[((uSector + 1u) % NUM_DIRECTIONS) * uNumColumns + uColumn];
+
+        const FLOAT horizon = first + (second - first) * blend;
+        const FLOAT visibility = std::clamp((elevation - horizon) / PENUMBRA_ANGLE + 0.5f, 0.0f, 1.0f);
+        const BYTE value = static_cast<BYTE>(visibility * static_cast<FLOAT>(UCHAR_MAX) + 0.5f);
+
+        ++m_uNumResolvedColumns;
+
+        if (value != m_aVisibility[uColumn])
+        {
+            m_aVisibility[uColumn] = value;
+
+            const UINT x = uColumn % m_uWidth;
+            const UINT z = uColumn / m_uWidth;
+            dirtyBox.left = x < dirtyBox.left ? x : dirtyBox.left;
+            dirtyBox.right = x + 1u > dirtyBox.right ? x + 1u : dirtyBox.right;
+            dirtyBox.top = z < dirtyBox.top ? z : dirtyBox.top;
+            dirtyBox.bottom = z + 1u > dirtyBox.bottom ? z + 1u : dirtyBox.bottom;
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/*+===================================================================
+  File:      HORIZONMAP.H
+
+  Summary:   HorizonMap header file contains declaration of class
+             HorizonMap used to shadow the voxel heightfield without
+             rendering the voxels into the shadow pass.
+
+  Classes:  HorizonMap
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Renderer/DataTypes.h"
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    HorizonMap
+
+      Summary:  Stores, for every column of the heightfield and a fixed
+                set of azimuth directions, the highest elevation angle
+                at which the terrain occludes the sky. The angles only
+                depend on the heightfield, so they are built once along
+                with, for every sector between two directions, the
+                columns sorted by the lowest and the highest elevation
+                of their penumbra. While the light stays in a sector,
+                only the columns whose penumbra the light elevation was
+                or is in are resolved again, the others stay fully lit
+                or fully shadowed. Only the texels that changed are
+                uploaded.
+
+      Methods:  Initialize
+                  Builds the horizon angles and creates the texture
+                Update
+                  Resolves the light visibility for a light direction
+                Invalidate
+                  Makes the next update resolve every column
+                GetShaderResourceView
+                  Returns the light visibility texture
+                GetConstantBuffer
+                  Returns the constant buffer mapping world xz to the
+                  texture
+                GetVisibility
+                  Returns the light visibility of every column
+                GetFullRebuildTime
+                  Returns the duration of the last full rebuild
+                GetIncrementalUpdateTime
+                  Returns the duration of the last update
+                GetNumResolvedColumns
+                  Returns the number of columns the last update
+                  resolved
+                GetNumUploadedTexels
+                  Returns the number of texels the last update
+                  uploaded
+                HorizonMap
+                  Constructor.
+                ~HorizonMap
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class HorizonMap
+    {
+    public:
+        HorizonMap() = delete;
+        HorizonMap(
+            _In_ UINT uWidth,
+            _In_ UINT uDepth,
+            _In_ FLOAT cellSize,
+            _In_ const XMFLOAT2& origin,
+            _In_ std::vector<FLOAT>&& aColumnHeights
+        );
+        HorizonMap(const HorizonMap& other) = delete;
+        HorizonMap(HorizonMap&& other) = delete;
+        HorizonMap& operator=(const HorizonMap& other) = delete;
+        HorizonMap& operator=(HorizonMap&& other) = delete;
+        ~HorizonMap() = default;
+
+        HRESULT Initialize(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext);
+        void Update(_In_ ID3D11DeviceContext* pImmediateContext, _In_ FXMVECTOR lightDirection);
+        void Invalidate();
+
+        ComPtr<ID3D11ShaderResourceView>& GetShaderResourceView();
+        ComPtr<ID3D11Buffer>& GetConstantBuffer();
+        const std::vector<BYTE>& GetVisibility() const;
+
+        FLOAT GetFullRebuildTime() const;
+        FLOAT GetIncrementalUpdateTime() const;
+        UINT GetNumResolvedColumns() const;
+        UINT GetNumUploadedTexels() const;
+
+    private:
+        void buildHorizonAngles();
+        void buildSectorOrders();
+        FLOAT sweepHorizonAngle(_In_ UINT uColumnX, _In_ UINT uColumnZ, _In_ FLOAT dirX, _In_ FLOAT dirZ) const;
+        FLOAT getPenumbraLow(_In_ UINT uSector, _In_ UINT uColumn) const;
+        FLOAT getPenumbraHigh(_In_ UINT uSector, _In_ UINT uColumn) const;
+        void resolveColumn(_In_ UINT uColumn, _In_ UINT uSector, _In_ FLOAT blend, _In_ FLOAT elevation, _Inout_ D3D11_BOX& dirtyBox);
+
+    private:
+        static constexpr const UINT NUM_DIRECTIONS = 32u;
+        static constexpr const UINT MAX_SWEEP_STEPS = 64u;
+        static constexpr const FLOAT PENUMBRA_ANGLE = 0.05f;
+        static constexpr const FLOAT LIGHT_ANGLE_EPSILON = 0.0005f;
+
+        UINT m_uWidth;
+        UINT m_uDepth;
+        FLOAT m_cellSize;
+        XMFLOAT2 m_origin;
+
+        std::vector<FLOAT> m_aColumnHeights;
+        std::vector<FLOAT> m_aHorizonAngles;
+        std::vector<UINT> m_aColumnsByPenumbraLow;
+        std::vector<UINT> m_aColumnsByPenumbraHigh;
+        std::vector<BYTE> m_aVisibility;
+
+        FLOAT m_lightAzimuth;
+        FLOAT m_lightElevation;
+        UINT m_uLightSector;
+        BOOL m_bHasResolved;
+
+        FLOAT m_fullRebuildTime;
+        FLOAT m_incrementalUpdateTime;
+        UINT m_uNumResolvedColumns;
+        UINT m_uNumUploadedTexels;
+
+        ComPtr<ID3D11Texture2D> m_visibilityTexture;
+        ComPtr<ID3D11ShaderResourceView> m_visibilityView;
+        ComPtr<ID3D11Buffer> m_cbHorizonMap;
+    };
+}
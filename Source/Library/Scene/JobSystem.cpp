@@ -0,0 +1,243 @@
+#include "Scene/JobSystem.h"
+
+namespace library
+{
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   JobSystem::JobSystem
+
+      Summary:  Constructor, starts the worker threads
+
+      Args:     UINT uNumThreads
+                  Number of threads running the jobs, including the
+                  thread that dispatches them
+
+      Modifies: [m_aQueues, m_aWorkers, m_mutex, m_wakeUp,
+                 m_batchDone, m_uBatch, m_bExit].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    JobSystem::JobSystem(
+        _In_ UINT uNumThreads
+    )
+        : m_aQueues()
+        , m_aWorkers()
+        , m_mutex()
+        , m_wakeUp()
+        , m_batchDone()
+        , m_uBatch(0u)
+        , m_bExit(FALSE)
+    {
+        uNumThreads = uNumThreads > 0u ? uNumThreads : 1u;
+
+        m_aQueues.reserve(uNumThreads);
+        for (UINT i = 0u; i < uNumThreads; ++i)
+        {
+            m_aQueues.push_back(std::make_unique<WorkQueue>());
+        }
+
+        // The first queue belongs to the dispatching thread
+        m_aWorkers.reserve(uNumThreads - 1u);
+        for (UINT i = 1u; i < uNumThreads; ++i)
+        {
+            m_aWorkers.emplace_back(&JobSystem::workerMain, this, i);
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   JobSystem::~JobSystem
+
+      Summary:  Destructor, stops and joins the worker threads
+
+      Modifies: [m_bExit, m_aWorkers].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bExit = TRUE;
+        }
+        m_wakeUp.notify_all();
+
+        for (std::thread& worker : m_aWorkers)
+        {
+            worker.join();
+        }
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   JobSystem::ParallelFor
+
+      Summary:  Spreads the indices over the queues, wakes the workers,
+                works on the batch and waits until every job is done.
+                The batch counts its jobs on the stack of the call, so
+                calls from other threads or from inside a job wait
+                only for their own jobs.
+
+      Args:     UINT uNumJobs
+                  Number of jobs
+                const std::function<void(UINT)>& job
+                  Function called once with every index in
+                  [0, uNumJobs)
+
+      Modifies: [m_aQueues, m_uBatch].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void JobSystem::ParallelFor(
+        _In_ UINT uNumJobs,
+        _In_ const std::function<void(UINT)>& job
+    )
+    {
+        if (uNumJobs == 0u)
+        {
+            return;
+        }
+
+        if (m_aWorkers.empty())
+        {
+            for (UINT i = 0u; i < uNumJobs; ++i)
+            {
+                job(i);
+            }
+            return;
+        }
+
+        Batch batch;
+        batch.pFunction = &job;
+        batch.uNumPendingJobs.store(uNumJobs);
+
+        const UINT uNumQueues = static_cast<UINT>(m_aQueues.size());
+        for (UINT uQueue = 0u; uQueue < uNumQueues; ++uQueue)
+        {
+            std::lock_guard<std::mutex> lock(m_aQueues[uQueue]->Mutex);
+            for (UINT i = uQueue; i < uNumJobs; i += uNumQueues)
+            {
+                m_aQueues[uQueue]->aJobs.push_back(Job{ .pBatch = &batch, .uIndex = i });
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_uBatch;
+        }
+        m_wakeUp.notify_all();
+
+        while (runJob(0u))
+        {
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_batchDone.wait(lock, [&batch] { return batch.uNumPendingJobs.load() == 0u; });
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   JobSystem::GetNumThreads
+
+      Summary:  Returns the number of threads running the jobs
+
+      Returns:  UINT
+                  Number of worker threads plus the dispatching thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT JobSystem::GetNumThreads() const
+    {
+        return static_cast<UINT>(m_aQueues.size());
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   JobSystem::runJob
+
+      Summary:  Runs the newest job of the given queue, or the oldest
+                job of another queue when it is empty
+
+      Args:     UINT uQueueIndex
+                  Queue of the calling thread
+
+      Modifies: [m_aQueues].
+
+      Returns:  BOOL
+                  TRUE if a job was run
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    BOOL JobSystem::runJob(
+        _In_ UINT uQueueIndex
+    )
+    {
+        Job job = {};
+        BOOL bFound = FALSE;
+
+        const UINT uNumQueues = static_cast<UINT>(m_aQueues.size());
+        for (UINT uOffset = 0u; uOffset < uNumQueues && !bFound; ++uOffset)
+        {
+            WorkQueue& queue = *m_aQueues[(uQueueIndex + uOffset) % uNumQueues];
+
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            if (queue.aJobs.empty())
+            {
+                continue;
+            }
+
+            if (uOffset == 0u)
+            {
+                job = queue.aJobs.back();
+                queue.aJobs.pop_back();
+            }
+            else
+            {
+                job = queue.aJobs.front();
+                queue.aJobs.pop_front();
+            }
+            bFound = TRUE;
+        }
+
+        if (!bFound)
+        {
+            return FALSE;
+        }
+
+        (*job.pBatch->pFunction)(job.uIndex);
+
+        // The dispatching thread may return as soon as the count reaches zero, the batch isn't touched after it
+        if (job.pBatch->uNumPendingJobs.fetch_sub(1u) == 1u)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_batchDone.notify_all();
+        }
+
+        return TRUE;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   JobSystem::workerMain
+
+      Summary:  Sleeps until a batch is dispatched and runs jobs until
+                none is left in any queue
+
+      Args:     UINT uQueueIndex
+                  Queue of the worker
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void JobSystem::workerMain(
+        _In_ UINT uQueueIndex
+    )
+    {
+        UINT64 uBatch = 0u;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeUp.wait(lock, [this, uBatch] { return m_bExit || m_uBatch != uBatch; });
+
+                if (m_bExit)
+                {
+                    return;
+                }
+                uBatch = m_uBatch;
+            }
+
+            while (runJob(uQueueIndex))
+            {
+            }
+        }
+    }
+}
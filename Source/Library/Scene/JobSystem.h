@@ -0,0 +1,108 @@
+/*+===================================================================
+  File:      JOBSYSTEM.H
+
+  Summary:   JobSystem header file contains declarations of JobSystem
+             class that runs batches of independent jobs on a pool of
+             work stealing threads.
+
+  Classes: JobSystem
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace library
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    JobSystem
+
+      Summary:  Pool of worker threads, each with its own queue. A
+                thread takes the newest job of its own queue and, when
+                it runs dry, steals the oldest job of another queue.
+                The thread that dispatches a batch works on it too and
+                returns once every job of the batch is done. Every
+                batch counts its own jobs, so batches may be dispatched
+                from several threads or from inside a job.
+
+      Methods:  ParallelFor
+                  Runs a job for every index and waits for all of them
+                GetNumThreads
+                  Returns the number of threads including the caller
+                JobSystem
+                  Constructor.
+                ~JobSystem
+                  Destructor.
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class JobSystem
+    {
+    public:
+        JobSystem() = delete;
+        JobSystem(_In_ UINT uNumThreads);
+        JobSystem(const JobSystem& other) = delete;
+        JobSystem(JobSystem&& other) = delete;
+        JobSystem& operator=(const JobSystem& other) = delete;
+        JobSystem& operator=(JobSystem&& other) = delete;
+        virtual ~JobSystem();
+
+        void ParallelFor(_In_ UINT uNumJobs, _In_ const std::function<void(UINT)>& job);
+
+        UINT GetNumThreads() const;
+
+    protected:
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   Batch
+
+          Summary:  Function of a ParallelFor call and the number of its
+                    jobs not done yet, lives on the stack of the call
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct Batch
+        {
+            const std::function<void(UINT)>* pFunction;
+            std::atomic<UINT> uNumPendingJobs;
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   Job
+
+          Summary:  Batch of the job and the index it runs for
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct Job
+        {
+            Batch* pBatch;
+            UINT uIndex;
+        };
+
+        /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+          Struct:   WorkQueue
+
+          Summary:  Jobs handed to a single thread
+        S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+        struct WorkQueue
+        {
+            std::mutex Mutex;
+            std::deque<Job> aJobs;
+        };
+
+        BOOL runJob(_In_ UINT uQueueIndex);
+        void workerMain(_In_ UINT uQueueIndex);
+
+    protected:
+        std::vector<std::unique_ptr<WorkQueue>> m_aQueues;
+        std::vector<std::thread> m_aWorkers;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wakeUp;
+        std::condition_variable m_batchDone;
+        UINT64 m_uBatch;
+        BOOL m_bExit;
+    };
+}
@@ -29,11 +29,20 @@ namespace library
         , m_voxels()
         , m_renderables()
         , m_models()
+        , m_crowds()
         , m_aPointLights{ nullptr }
         , m_vertexShaders()
         , m_pixelShaders()
         , m_materials()
         , m_skyBox()
+        , m_horizonMap()
+        , m_jobSystem(std::make_unique<JobSystem>(std::thread::hardware_concurrency()))
+        , m_apUpdatedModels()
+        , m_animationLodSelector()
+        , m_meshLodSelector()
+        , m_meshletCuller()
+        , m_accumulatedModelUpdateTime(0.0f)
+        , m_uNumModelUpdates(0u)
     {
         std::ifstream inputFile;
         inputFile.open(m_filePath.string());
@@ -93,6 +102,10 @@ namespace library
             );
         }
 
+        // Top of the highest voxel of every column, used to build the horizon map
+        const FLOAT baseHeight = static_cast<FLOAT>(aDimension[1]) * 0.75f - 2.0f * static_cast<FLOAT>(aDimension[1]) - 1.0f;
+        std::vector<FLOAT> aColumnHeights(static_cast<size_t>(aDimension[0]) * static_cast<size_t>(aDimension[2]), baseHeight);
+
         UINT uDepthIdx = 0u;
         UINT uWidthIdx = 0u;
         CHAR voxelType;
@@ -112,7 +125,10 @@ namespace library
             }
             else if (static_cast<CHAR>(eBlockType::GRASSLAND) <= voxelType && voxelType < static_cast<CHAR>(eBlockType::COUNT))
             {
-                for (UINT heightIdx = 0; heightIdx < static_cast<UINT>(static_cast<float>(aDimension[1]) * height); ++heightIdx)
+                const UINT uColumnHeight = static_cast<UINT>(static_cast<float>(aDimension[1]) * height);
+                aColumnHeights[static_cast<size_t>(uDepthIdx) * static_cast<size_t>(aDimension[0]) + uWidthIdx] = baseHeight + 2.0f * static_cast<FLOAT>(uColumnHeight);
+
+                for (UINT heightIdx = 0; heightIdx < uColumnHeight; ++heightIdx)
                 {
                     aInstanceData[static_cast<size_t>(voxelType) - static_cast<size_t>(eBlockType::GRASSLAND)].push_back(
                         InstanceData
@@ -156,13 +172,24 @@ namespace library
             }
             ++uVoxelIdx;
         }
+
+        if (!m_voxels.empty())
+        {
+            m_horizonMap = std::make_shared<HorizonMap>(
+                aDimension[0],
+                aDimension[2],
+                2.0f,
+                XMFLOAT2(-static_cast<FLOAT>(aDimension[0]) - 1.0f, -static_cast<FLOAT>(aDimension[2]) - 1.0f),
+                std::move(aColumnHeights)
+            );
+        }
     }
 
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::Initialize
 
       Summary:  Initializes the voxels, shaders, renderables, models,
-                and skybox
+                crowds, skybox and horizon map
 
       Args:     ID3D11Device* pDevice
                   The Direct3D device to create the buffers
@@ -213,6 +240,9 @@ namespace library
 
         for (auto it = m_models.begin(); it != m_models.end(); ++it)
         {
+            // Large meshes generate their tangent frames on the threads that update the poses
+            it->second->SetJobSystem(m_jobSystem.get());
+
             HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
             if (FAILED(hr))
             {
@@ -225,6 +255,20 @@ namespace library
             }
         }
 
+        for (auto it = m_crowds.begin(); it != m_crowds.end(); ++it)
+        {
+            HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            for (UINT i = 0u; i < it->second->GetNumMaterials(); ++i)
+            {
+                AddMaterial(it->second->GetMaterial(i));
+            }
+        }
+
         for (auto it = m_materials.begin(); it != m_materials.end(); ++it)
         {
             HRESULT hr = it->second->Initialize(pDevice, pImmediateContext);
@@ -243,6 +287,15 @@ namespace library
             }
         }
 
+        if (m_horizonMap)
+        {
+            HRESULT hr = m_horizonMap->Initialize(pDevice, pImmediateContext);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
         return S_OK;
     }
 
@@ -323,6 +376,34 @@ namespace library
         return S_OK;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::AddCrowd
+
+      Summary:  Add a crowd of animated model instances
+
+      Args:     PCWSTR pszCrowdName
+                  Key of the crowd
+                const std::shared_ptr<Crowd>& pCrowd
+                  Shared pointer to the crowd
+
+      Modifies: [m_crowds].
+
+      Returns:  HRESULT
+                  Status code.
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Scene::AddCrowd(_In_ PCWSTR pszCrowdName, _In_ const std::shared_ptr<Crowd>& pCrowd)
+    {
+        if (m_crowds.contains(pszCrowdName))
+        {
+            return E_FAIL;
+        }
+
+        m_crowds[pszCrowdName] = pCrowd;
+
+        return S_OK;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::AddPointLight
 
@@ -453,11 +534,18 @@ namespace library
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::Update
 
-      Summary:  Update the renderables, models, point lights, skybox
-                each frame
+      Summary:  Update the renderables, models, crowds, point lights,
+                skybox each frame. The poses of the models are independent of
+                each other and evaluated as jobs, every model writes
+                its own bone palette. The jobs are joined before
+                returning, so the palettes are complete when the frame
+                is rendered. Every job first selects the animation
+                level of detail of its model from the viewpoint.
 
       Args:     FLOAT deltaTime
                   Time difference of a frame
+
+      Modifies: [m_apUpdatedModels].
     M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
 
     void Scene::Update(
@@ -469,7 +557,35 @@ namespace library
             it->second->Update(deltaTime);
         }
 
+        m_apUpdatedModels.clear();
         for (auto it = m_models.begin(); it != m_models.end(); ++it)
+        {
+            m_apUpdatedModels.push_back(it->second.get());
+        }
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        m_jobSystem->ParallelFor(
+            static_cast<UINT>(m_apUpdatedModels.size()),
+            [this, deltaTime](UINT uModelIndex)
+            {
+                Model* pModel = m_apUpdatedModels[uModelIndex];
+                const BoundingSphere boundingSphere = pModel->GetBoundingSphere();
+                pModel->SetAnimationLod(m_animationLodSelector.Select(boundingSphere));
+                pModel->SetMeshLod(m_meshLodSelector.Select(boundingSphere, pModel->GetMeshLod()));
+                pModel->Update(deltaTime);
+            }
+        );
+
+        QueryPerformanceCounter(&endTime);
+        reportModelUpdate(static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart));
+
+        // Crowds only advance their animation time
+        for (auto it = m_crowds.begin(); it != m_crowds.end(); ++it)
         {
             it->second->Update(deltaTime);
         }
@@ -482,6 +598,128 @@ namespace library
         m_skyBox->Update(deltaTime);
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetNumUpdateThreads
+
+      Summary:  Replaces the job system evaluating the model poses, a
+                single thread updates the models one after another on
+                the calling thread
+
+      Args:     UINT uNumThreads
+                  Number of threads including the calling thread
+
+      Modifies: [m_jobSystem, m_accumulatedModelUpdateTime,
+                 m_uNumModelUpdates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Scene::SetNumUpdateThreads(
+        _In_ UINT uNumThreads
+    )
+    {
+        m_jobSystem = std::make_unique<JobSystem>(uNumThreads);
+        m_accumulatedModelUpdateTime = 0.0f;
+        m_uNumModelUpdates = 0u;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetNumUpdateThreads
+
+      Summary:  Returns the number of threads evaluating the model
+                poses
+
+      Returns:  UINT
+                  Number of threads including the calling thread
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    UINT Scene::GetNumUpdateThreads() const
+    {
+        return m_jobSystem->GetNumThreads();
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetAnimationLodViewpoint
+
+      Summary:  Sets the camera the animation levels of detail of the
+                models are selected for
+
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                const XMMATRIX& view
+                  View matrix of the camera
+                const XMMATRIX& projection
+                  Perspective projection matrix of the camera
+
+      Modifies: [m_animationLodSelector].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Scene::SetAnimationLodViewpoint(
+        _In_ const XMVECTOR& eye,
+        _In_ const XMMATRIX& view,
+        _In_ const XMMATRIX& projection
+    )
+    {
+        m_animationLodSelector.SetViewpoint(eye, view, projection);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetMeshLodViewpoint
+
+      Summary:  Sets the camera the mesh levels of detail of the models
+                are selected for
+
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                const XMMATRIX& view
+                  View matrix of the camera
+                const XMMATRIX& projection
+                  Perspective projection matrix of the camera
+
+      Modifies: [m_meshLodSelector].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Scene::SetMeshLodViewpoint(
+        _In_ const XMVECTOR& eye,
+        _In_ const XMMATRIX& view,
+        _In_ const XMMATRIX& projection
+    )
+    {
+        m_meshLodSelector.SetViewpoint(eye, view, projection);
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::CullMeshlets
+
+      Summary:  Culls the meshlets of the models updated by the last
+                update for a camera. Every model writes its own index
+                ranges, so the models are culled as jobs.
+
+      Args:     const XMVECTOR& eye
+                  Position of the camera
+                const XMMATRIX& view
+                  View matrix of the camera
+                const XMMATRIX& projection
+                  Perspective projection matrix of the camera
+
+      Modifies: [m_meshletCuller].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Scene::CullMeshlets(
+        _In_ const XMVECTOR& eye,
+        _In_ const XMMATRIX& view,
+        _In_ const XMMATRIX& projection
+    )
+    {
+        m_meshletCuller.SetViewpoint(eye, view, projection);
+
+        m_jobSystem->ParallelFor(
+            static_cast<UINT>(m_apUpdatedModels.size()),
+            [this](UINT uModelIndex)
+            {
+                m_apUpdatedModels[uModelIndex]->CullMeshlets(m_meshletCuller);
+            }
+        );
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetVoxels
 
@@ -524,6 +762,20 @@ namespace library
         return m_models;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetCrowds
+
+      Summary:  Returns the crowds
+
+      Returns:  std::unordered_map<std::wstring, std::shared_ptr<Crowd>>&
+                  Crowds
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    std::unordered_map<std::wstring, std::shared_ptr<Crowd>>& Scene::GetCrowds()
+    {
+        return m_crowds;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetPointLight
 
@@ -590,6 +842,20 @@ namespace library
         return m_skyBox;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::GetHorizonMap
+
+      Summary:  Returns the horizon map of the voxel heightfield
+
+      Returns:  std::shared_ptr<HorizonMap>&
+                  Horizon map, null when the scene has no voxels
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    std::shared_ptr<HorizonMap>& Scene::GetHorizonMap()
+    {
+        return m_horizonMap;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::GetFilePath
 
@@ -730,6 +996,63 @@ namespace library
         return S_OK;
     }
 
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetVertexShaderOfCrowd
+
+      Summary:  Sets the vertex shader for a crowd, it has to read the
+                instance data and the baked palettes
+
+      Args:     PCWSTR pszCrowdName
+                  Key of the crowd
+                PCWSTR pszVertexShaderName
+                  Key of the vertex shader
+
+      Modifies: [m_crowds].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Scene::SetVertexShaderOfCrowd(_In_ PCWSTR pszCrowdName, _In_ PCWSTR pszVertexShaderName)
+    {
+        if (!m_crowds.contains(pszCrowdName) || !m_vertexShaders.contains(pszVertexShaderName))
+        {
+            return E_FAIL;
+        }
+
+        m_crowds[pszCrowdName]->SetVertexShader(m_vertexShaders[pszVertexShaderName]);
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::SetPixelShaderOfCrowd
+
+      Summary:  Sets the pixel shader for a crowd
+
+      Args:     PCWSTR pszCrowdName
+                  Key of the crowd
+                PCWSTR pszPixelShaderName
+                  Key of the pixel shader
+
+      Modifies: [m_crowds].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    HRESULT Scene::SetPixelShaderOfCrowd(_In_ PCWSTR pszCrowdName, _In_ PCWSTR pszPixelShaderName)
+    {
+        if (!m_crowds.contains(pszCrowdName) || !m_pixelShaders.contains(pszPixelShaderName))
+        {
+            return E_FAIL;
+        }
+
+        m_crowds[pszCrowdName]->SetPixelShader(m_pixelShaders[pszPixelShaderName]);
+
+        return S_OK;
+    }
+
     /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
       Method:   Scene::SetVertexShaderOfScene
 
@@ -843,4 +1166,43 @@ namespace library
     {
         return lerp(x, y, s * s * (3.0f - 2.0f * s));
     }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   Scene::reportModelUpdate
+
+      Summary:  Accumulates the wall clock time of the model updates of
+                a frame and periodically reports the average with the
+                number of threads, to measure how the update scales
+
+      Args:     FLOAT milliseconds
+                  Time spent updating the models of a frame
+
+      Modifies: [m_accumulatedModelUpdateTime, m_uNumModelUpdates].
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+
+    void Scene::reportModelUpdate(
+        _In_ FLOAT milliseconds
+    )
+    {
+        m_accumulatedModelUpdateTime += milliseconds;
+        ++m_uNumModelUpdates;
+
+        if (m_uNumModelUpdates < REPORT_INTERVAL)
+        {
+            return;
+        }
+
+        WCHAR szMessage[256];
+        swprintf_s(
+            szMessage,
+            L"Scene: updating %zu models on %u threads took %.4f ms per frame on average\n",
+            m_apUpdatedModels.size(),
+            m_jobSystem->GetNumThreads(),
+            m_accumulatedModelUpdateTime / static_cast<FLOAT>(m_uNumModelUpdates)
+        );
+        OutputDebugString(szMessage);
+
+        m_accumulatedModelUpdateTime = 0.0f;
+        m_uNumModelUpdates = 0u;
+    }
 }
\ No newline at end of file
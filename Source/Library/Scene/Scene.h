@@ -15,10 +15,16 @@
 
 #include <fstream>
 
+#include "Model/AnimationLod.h"
+#include "Model/Crowd.h"
+#include "Model/MeshLod.h"
+#include "Model/Meshlet.h"
 #include "Model/Model.h"
 #include "Light/PointLight.h"
 #include "Renderer/Skybox.h"
 #include "Renderer/Renderable.h"
+#include "Scene/HorizonMap.h"
+#include "Scene/JobSystem.h"
 #include "Scene/Voxel.h"
 
 namespace library
@@ -41,6 +47,7 @@ namespace library
         HRESULT AddVoxel(_In_ const std::shared_ptr<Voxel>& voxel);
         HRESULT AddRenderable(_In_ PCWSTR pszRenderableName, _In_ const std::shared_ptr<Renderable>& renderable);
         HRESULT AddModel(_In_ PCWSTR pszModelName, _In_ const std::shared_ptr<Model>& pModel);
+        HRESULT AddCrowd(_In_ PCWSTR pszCrowdName, _In_ const std::shared_ptr<Crowd>& pCrowd);
         HRESULT AddPointLight(_In_ size_t index, _In_ const std::shared_ptr<PointLight>& pPointLight);
         HRESULT AddVertexShader(_In_ PCWSTR pszVertexShaderName, _In_ const std::shared_ptr<VertexShader>& vertexShader);
         HRESULT AddPixelShader(_In_ PCWSTR pszPixelShaderName, _In_ const std::shared_ptr<PixelShader>& pixelShader);
@@ -48,15 +55,22 @@ namespace library
         HRESULT AddSkyBox(_In_ const std::shared_ptr<Skybox>& skybox);
 
         void Update(_In_ FLOAT deltaTime);
+        void SetNumUpdateThreads(_In_ UINT uNumThreads);
+        UINT GetNumUpdateThreads() const;
+        void SetAnimationLodViewpoint(_In_ const XMVECTOR& eye, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection);
+        void SetMeshLodViewpoint(_In_ const XMVECTOR& eye, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection);
+        void CullMeshlets(_In_ const XMVECTOR& eye, _In_ const XMMATRIX& view, _In_ const XMMATRIX& projection);
 
         std::vector<std::shared_ptr<Voxel>>& GetVoxels();
         std::unordered_map<std::wstring, std::shared_ptr<Renderable>>& GetRenderables();
         std::unordered_map<std::wstring, std::shared_ptr<Model>>& GetModels();
+        std::unordered_map<std::wstring, std::shared_ptr<Crowd>>& GetCrowds();
         std::shared_ptr<PointLight>& GetPointLight(_In_ size_t index);
         std::unordered_map<std::wstring, std::shared_ptr<VertexShader>>& GetVertexShaders();
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>>& GetPixelShaders();
         std::unordered_map<std::wstring, std::shared_ptr<Material>>& GetMaterials();
         std::shared_ptr<Skybox>& GetSkyBox();
+        std::shared_ptr<HorizonMap>& GetHorizonMap();
 
         const std::filesystem::path& GetFilePath() const;
         PCWSTR GetFileName() const;
@@ -67,6 +81,9 @@ namespace library
         HRESULT SetVertexShaderOfModel(_In_ PCWSTR pszModelName, _In_ PCWSTR pszVertexShaderName);
         HRESULT SetPixelShaderOfModel(_In_ PCWSTR pszModelName, _In_ PCWSTR pszPixelShaderName);
 
+        HRESULT SetVertexShaderOfCrowd(_In_ PCWSTR pszCrowdName, _In_ PCWSTR pszVertexShaderName);
+        HRESULT SetPixelShaderOfCrowd(_In_ PCWSTR pszCrowdName, _In_ PCWSTR pszPixelShaderName);
+
         HRESULT SetVertexShaderOfVoxel(_In_ PCWSTR pszVertexShaderName);
         HRESULT SetPixelShaderOfVoxel(_In_ PCWSTR pszPixelShaderName);
         HRESULT SetMaterialOfVoxel(_In_ PCWSTR pszMaterialName);
@@ -77,7 +94,11 @@ namespace library
         static FLOAT lerp(FLOAT x, FLOAT y, FLOAT s);
         static FLOAT smoothLerp(FLOAT x, FLOAT y, FLOAT s);
 
+        void reportModelUpdate(_In_ FLOAT milliseconds);
+
     private:
+        static constexpr const UINT REPORT_INTERVAL = 1000u;
+
         static constexpr const UINT ms_aHashes[] =
         {
             208,34,231,213,32,248,233,56,161,78,24,140,71,48,140,254,245,255,247,247,40,
@@ -99,10 +120,20 @@ namespace library
         std::vector<std::shared_ptr<Voxel>> m_voxels;
         std::unordered_map<std::wstring, std::shared_ptr<Renderable>> m_renderables;
         std::unordered_map<std::wstring, std::shared_ptr<Model>> m_models;
+        std::unordered_map<std::wstring, std::shared_ptr<Crowd>> m_crowds;
         std::shared_ptr<PointLight> m_aPointLights[NUM_LIGHTS];
         std::unordered_map<std::wstring, std::shared_ptr<VertexShader>> m_vertexShaders;
         std::unordered_map<std::wstring, std::shared_ptr<PixelShader>> m_pixelShaders;
         std::unordered_map<std::wstring, std::shared_ptr<Material>> m_materials;
         std::shared_ptr<Skybox> m_skyBox;
+        std::shared_ptr<HorizonMap> m_horizonMap;
+
+        std::unique_ptr<JobSystem> m_jobSystem;
+        std::vector<Model*> m_apUpdatedModels;
+        AnimationLodSelector m_animationLodSelector;
+        MeshLodSelector m_meshLodSelector;
+        MeshletCuller m_meshletCuller;
+        FLOAT m_accumulatedModelUpdateTime;
+        UINT m_uNumModelUpdates;
     };
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "Shader/CrowdVertexShader.h"
+
+namespace library
+{
+    CrowdVertexShader::CrowdVertexShader(
+        _In_ PCWSTR pszFileName,
+        _In_ PCSTR pszEntryPoint,
+        _In_ PCSTR pszShaderModel
+    )
+        : VertexShader(pszFileName, pszEntryPoint, pszShaderModel)
+    {
+    }
+
+    HRESULT CrowdVertexShader::Initialize(
+        _In_ ID3D11Device* pDevice
+    )
+    {
+        ComPtr<ID3DBlob> vsBlob;
+        HRESULT hr = compile(vsBlob.GetAddressOf());
+        if (FAILED(hr))
+        {
+            WCHAR szMessage[256];
+            swprintf_s(
+                szMessage,
+                L"The FX file %s cannot be compiled. Please run this executable from the directory that contains the FX file.",
+                m_pszFileName
+            );
+            MessageBox(
+                nullptr,
+                szMessage,
+                L"Error",
+                MB_OK
+            );
+            return hr;
+        }
+
+        hr = pDevice->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, m_vertexShader.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Define the input layout
+        D3D11_INPUT_ELEMENT_DESC aLayouts[] =
+        {
+            { "POSITION", 0u, DXGI_FORMAT_R16G16B16A16_SNORM, 0u, 0u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "TEXCOORD", 0u, DXGI_FORMAT_R16G16_FLOAT, 0u, 8u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "NORMAL", 0u, DXGI_FORMAT_R16G16_SNORM, 0u, 12u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "BONEINDICES", 0u, DXGI_FORMAT_R8G8B8A8_UINT, 1u, 0u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "BONEWEIGHTS", 0u, DXGI_FORMAT_R8G8B8A8_UNORM, 1u, 4u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "INSTANCE_TRANSFORM", 0u, DXGI_FORMAT_R32G32B32A32_FLOAT, 2u, 0u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+            { "INSTANCE_TRANSFORM", 1u, DXGI_FORMAT_R32G32B32A32_FLOAT, 2u, 16u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+            { "INSTANCE_TRANSFORM", 2u, DXGI_FORMAT_R32G32B32A32_FLOAT, 2u, 32u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+            { "INSTANCE_TRANSFORM", 3u, DXGI_FORMAT_R32G32B32A32_FLOAT, 2u, 48u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+            { "INSTANCE_TIMEOFFSET", 0u, DXGI_FORMAT_R32_FLOAT, 2u, 64u, D3D11_INPUT_PER_INSTANCE_DATA, 1u },
+            { "INSTANCE_CLIP", 0u, DXGI_FORMAT_R32_UINT, 2u, 68u, D3D11_INPUT_PER_INSTANCE_DATA, 1u }
+        };
+        UINT uNumElements = ARRAYSIZE(aLayouts);
+
+        // Create the input layout
+        hr = pDevice->CreateInputLayout(aLayouts, uNumElements, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), m_vertexLayout.GetAddressOf());
+
+        return hr;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+/*+===================================================================
+  File:      CROWDVERTEXSHADER.H
+
+  Summary:   CrowdVertexShader header file contains declarations of
+             CrowdVertexShader class that skins instanced crowds from
+             baked bone palettes.
+
+  Classes: CrowdVertexShader
+
+  2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Shader/VertexShader.h"
+
+namespace library
+{
+    class CrowdVertexShader : public VertexShader
+    {
+    public:
+        CrowdVertexShader() = delete;
+        CrowdVertexShader(_In_ PCWSTR pszFileName, _In_ PCSTR pszEntryPoint, _In_ PCSTR pszShaderModel);
+        CrowdVertexShader(const CrowdVertexShader& other) = delete;
+        CrowdVertexShader(CrowdVertexShader&& other) = delete;
+        CrowdVertexShader& operator=(const CrowdVertexShader& other) = delete;
+        CrowdVertexShader& operator=(CrowdVertexShader&& other) = delete;
+        virtual ~CrowdVertexShader() = default;
+
+        virtual HRESULT Initialize(_In_ ID3D11Device* pDevice) override;
+    };
+}
\ No newline at end of file
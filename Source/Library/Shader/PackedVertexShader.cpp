@@ -0,0 +1,58 @@
+#include "Shader/PackedVertexShader.h"
+
+namespace library
+{
+    PackedVertexShader::PackedVertexShader(
+        _In_ PCWSTR pszFileName,
+        _In_ PCSTR pszEntryPoint,
+        _In_ PCSTR pszShaderModel
+    )
+        : VertexShader(pszFileName, pszEntryPoint, pszShaderModel)
+    {
+    }
+
+    HRESULT PackedVertexShader::Initialize(
+        _In_ ID3D11Device* pDevice
+    )
+    {
+        ComPtr<ID3DBlob> vsBlob;
+        HRESULT hr = compile(vsBlob.GetAddressOf());
+        if (FAILED(hr))
+        {
+            WCHAR szMessage[256];
+            swprintf_s(
+                szMessage,
+                L"The FX file %s cannot be compiled. Please run this executable from the directory that contains the FX file.",
+                m_pszFileName
+            );
+            MessageBox(
+                nullptr,
+                szMessage,
+                L"Error",
+                MB_OK
+            );
+            return hr;
+        }
+
+        hr = pDevice->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, m_vertexShader.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        // Define the input layout of PackedVertex, the tangent frame replaces the normal buffer
+        D3D11_INPUT_ELEMENT_DESC aLayouts[] =
+        {
+            { "POSITION", 0u, DXGI_FORMAT_R16G16B16A16_SNORM, 0u, 0u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "TEXCOORD", 0u, DXGI_FORMAT_R16G16_FLOAT, 0u, 8u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "NORMAL", 0u, DXGI_FORMAT_R16G16_SNORM, 0u, 12u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "TANGENTFRAME", 0u, DXGI_FORMAT_R32_UINT, 0u, 16u, D3D11_INPUT_PER_VERTEX_DATA, 0u }
+        };
+        UINT uNumElements = ARRAYSIZE(aLayouts);
+
+        // Create the input layout
+        hr = pDevice->CreateInputLayout(aLayouts, uNumElements, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), m_vertexLayout.GetAddressOf());
+
+        return hr;
+    }
+}
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace library
         _In_ PCSTR pszShaderModel
     )
         : VertexShader(pszFileName, pszEntryPoint, pszShaderModel)
+        , m_packedVertexLayout(nullptr)
     {
     }
 
@@ -56,6 +57,19 @@ namespace library
             return hr;
         }
 
+        // Models stream packed vertices, their positions are decoded with the bounds in the constant buffer
+        aLayouts[0].Format = DXGI_FORMAT_R16G16B16A16_SNORM;
+        hr = pDevice->CreateInputLayout(aLayouts, uNumElements, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), m_packedVertexLayout.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
         return hr;
     }
+
+    ComPtr<ID3D11InputLayout>& ShadowVertexShader::GetPackedVertexLayout()
+    {
+        return m_packedVertexLayout;
+    }
 }
\ No newline at end of file
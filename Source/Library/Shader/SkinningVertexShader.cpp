@@ -43,11 +43,11 @@ namespace library
         // Define the input layout
         D3D11_INPUT_ELEMENT_DESC aLayouts[] =
         {
-            { "POSITION", 0u, DXGI_FORMAT_R32G32B32_FLOAT, 0u, 0u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
-            { "TEXCOORD", 0u, DXGI_FORMAT_R32G32_FLOAT, 0u, 12u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
-            { "NORMAL", 0u, DXGI_FORMAT_R32G32B32_FLOAT, 0u, 20u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
-            { "BONEINDICES", 0u, DXGI_FORMAT_R32G32B32A32_UINT, 1u, 0u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
-            { "BONEWEIGHTS", 0u, DXGI_FORMAT_R32G32B32A32_FLOAT, 1u, 16u, D3D11_INPUT_PER_VERTEX_DATA, 0u }
+            { "POSITION", 0u, DXGI_FORMAT_R16G16B16A16_SNORM, 0u, 0u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "TEXCOORD", 0u, DXGI_FORMAT_R16G16_FLOAT, 0u, 8u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "NORMAL", 0u, DXGI_FORMAT_R16G16_SNORM, 0u, 12u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "BONEINDICES", 0u, DXGI_FORMAT_R8G8B8A8_UINT, 1u, 0u, D3D11_INPUT_PER_VERTEX_DATA, 0u },
+            { "BONEWEIGHTS", 0u, DXGI_FORMAT_R8G8B8A8_UNORM, 1u, 4u, D3D11_INPUT_PER_VERTEX_DATA, 0u }
         };
         UINT uNumElements = ARRAYSIZE(aLayouts);
 
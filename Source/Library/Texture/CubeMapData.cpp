@@ -0,0 +1,733 @@
+#include "Texture/CubeMapData.h"
+
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <fstream>
+
+using namespace DirectX::PackedVector;
+
+namespace library
+{
+    // Subset of the DDS file layout needed to write cube maps, see DDSTextureLoader.cpp
+    static constexpr const UINT DDS_MAGIC = 0x20534444u;
+    static constexpr const UINT DDS_FOURCC = 0x00000004u;
+    static constexpr const UINT DDS_FOURCC_DX10 = 0x30315844u;
+    // DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PITCH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT
+    static constexpr const UINT DDS_HEADER_FLAGS = 0x0002100Fu;
+    // DDSCAPS_COMPLEX | DDSCAPS_TEXTURE | DDSCAPS_MIPMAP
+    static constexpr const UINT DDS_CAPS = 0x00401008u;
+    // DDSCAPS2_CUBEMAP and all six faces
+    static constexpr const UINT DDS_CAPS2_CUBEMAP_ALLFACES = 0x0000FE00u;
+
+#pragma pack(push, 1)
+    struct DDSPixelFormat
+    {
+        UINT uSize;
+        UINT uFlags;
+        UINT uFourCC;
+        UINT uRGBBitCount;
+        UINT uRBitMask;
+        UINT uGBitMask;
+        UINT uBBitMask;
+        UINT uABitMask;
+    };
+
+    struct DDSHeader
+    {
+        UINT uSize;
+        UINT uFlags;
+        UINT uHeight;
+        UINT uWidth;
+        UINT uPitchOrLinearSize;
+        UINT uDepth;
+        UINT uMipMapCount;
+        UINT auReserved1[11];
+        DDSPixelFormat pixelFormat;
+        UINT uCaps;
+        UINT uCaps2;
+        UINT uCaps3;
+        UINT uCaps4;
+        UINT uReserved2;
+    };
+
+    struct DDSHeaderDXT10
+    {
+        DXGI_FORMAT dxgiFormat;
+        UINT uResourceDimension;
+        UINT uMiscFlag;
+        UINT uArraySize;
+        UINT uMiscFlags2;
+    };
+#pragma pack(pop)
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: UnpackColor565
+
+      Summary:  Expands a 5:6:5 block color endpoint
+
+      Args:     UINT uColor
+                  Packed endpoint
+
+      Returns:  XMVECTOR
+                  Opaque color
+    -----------------------------------------------------------------F-F*/
+
+    static XMVECTOR UnpackColor565(
+        _In_ UINT uColor
+    )
+    {
+        return XMVectorSet(
+            static_cast<FLOAT>((uColor >> 11u) & 0x1Fu) / 31.0f,
+            static_cast<FLOAT>((uColor >> 5u) & 0x3Fu) / 63.0f,
+            static_cast<FLOAT>(uColor & 0x1Fu) / 31.0f,
+            1.0f
+        );
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: DecodeColorBlock
+
+      Summary:  Decodes the color half of a BC1, BC2 or BC3 block. The
+                alpha of BC2 and BC3 is not needed for lighting and is
+                left opaque.
+
+      Args:     const BYTE* pBlock
+                  8 bytes of color endpoints and indices
+                BOOL bAllowPunchThrough
+                  Whether the BC1 three color mode may be used
+                XMFLOAT4* aTexels
+                  4 x 4 decoded texels
+    -----------------------------------------------------------------F-F*/
+
+    static void DecodeColorBlock(
+        _In_reads_(8) const BYTE* pBlock,
+        _In_ BOOL bAllowPunchThrough,
+        _Out_writes_(16) XMFLOAT4* aTexels
+    )
+    {
+        const UINT uColor0 = static_cast<UINT>(pBlock[0]) | (static_cast<UINT>(pBlock[1]) << 8u);
+        const UINT uColor1 = static_cast<UINT>(pBlock[2]) | (static_cast<UINT>(pBlock[3]) << 8u);
+        const UINT uIndices = static_cast<UINT>(pBlock[4])
+            | (static_cast<UINT>(pBlock[5]) << 8u)
+            | (static_cast<UINT>(pBlock[6]) << 16u)
+            | (static_cast<UINT>(pBlock[7]) << 24u);
+
+        XMVECTOR aPalette[4];
+        aPalette[0] = UnpackColor565(uColor0);
+        aPalette[1] = UnpackColor565(uColor1);
+        if (!bAllowPunchThrough || uColor0 > uColor1)
+        {
+            aPalette[2] = XMVectorLerp(aPalette[0], aPalette[1], 1.0f / 3.0f);
+            aPalette[3] = XMVectorLerp(aPalette[0], aPalette[1], 2.0f / 3.0f);
+        }
+        else
+        {
+            aPalette[2] = XMVectorLerp(aPalette[0], aPalette[1], 0.5f);
+            aPalette[3] = XMVectorZero();
+        }
+
+        for (UINT i = 0u; i < 16u; ++i)
+        {
+            XMStoreFloat4(&aTexels[i], aPalette[(uIndices >> (2u * i)) & 0x3u]);
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: DecodeFace
+
+      Summary:  Converts a mapped face into linear RGBA texels
+
+      Args:     DXGI_FORMAT format
+                  Format of the face
+                const D3D11_MAPPED_SUBRESOURCE& mapped
+                  Mapped face
+                UINT uSize
+                  Width and height of the face
+                std::vector<XMFLOAT4>& aTexels
+                  Decoded texels
+
+      Returns:  HRESULT
+                  Status code, fails for formats that are not supported
+    -----------------------------------------------------------------F-F*/
+
+    static HRESULT DecodeFace(
+        _In_ DXGI_FORMAT format,
+        _In_ const D3D11_MAPPED_SUBRESOURCE& mapped,
+        _In_ UINT uSize,
+        _Out_ std::vector<XMFLOAT4>& aTexels
+    )
+    {
+        aTexels.resize(static_cast<size_t>(uSize) * uSize);
+
+        const BYTE* pData = static_cast<const BYTE*>(mapped.pData);
+        BOOL bIsSRGB = FALSE;
+
+        switch (format)
+        {
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+        case DXGI_FORMAT_BC2_UNORM_SRGB:
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+            bIsSRGB = TRUE;
+            [[fallthrough]];
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC2_UNORM:
+        case DXGI_FORMAT_BC3_UNORM:
+        {
+            const BOOL bIsBC1 = format == DXGI_FORMAT_BC1_UNORM || format == DXGI_FORMAT_BC1_UNORM_SRGB;
+            const UINT uBlockSize = bIsBC1 ? 8u : 16u;
+            const UINT uColorOffset = bIsBC1 ? 0u : 8u;
+            const UINT uNumBlocks = (uSize + 3u) / 4u;
+
+            XMFLOAT4 aBlock[16];
+            for (UINT blockY = 0u; blockY < uNumBlocks; ++blockY)
+            {
+                const BYTE* pRow = pData + static_cast<size_t>(blockY) * mapped.RowPitch;
+                for (UINT blockX = 0u; blockX < uNumBlocks; ++blockX)
+                {
+                    DecodeColorBlock(pRow + static_cast<size_t>(blockX) * uBlockSize + uColorOffset, bIsBC1, aBlock);
+
+                    for (UINT i = 0u; i < 16u; ++i)
+                    {
+                        const UINT x = blockX * 4u + (i & 0x3u);
+                        const UINT y = blockY * 4u + (i >> 2u);
+                        if (x < uSize && y < uSize)
+                        {
+                            aTexels[static_cast<size_t>(y) * uSize + x] = aBlock[i];
+                        }
+                    }
+                }
+            }
+            break;
+        }
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+            bIsSRGB = TRUE;
+            [[fallthrough]];
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R11G11B10_FLOAT:
+        case DXGI_FORMAT_R10G10B10A2_UNORM:
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8X8_UNORM:
+            for (UINT y = 0u; y < uSize; ++y)
+            {
+                const BYTE* pRow = pData + static_cast<size_t>(y) * mapped.RowPitch;
+                for (UINT x = 0u; x < uSize; ++x)
+                {
+                    XMVECTOR texel;
+                    switch (format)
+                    {
+                    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+                        texel = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(pRow) + x);
+                        break;
+                    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+                        texel = XMLoadHalf4(reinterpret_cast<const XMHALF4*>(pRow) + x);
+                        break;
+                    case DXGI_FORMAT_R11G11B10_FLOAT:
+                        texel = XMVectorSetW(XMLoadFloat3PK(reinterpret_cast<const XMFLOAT3PK*>(pRow) + x), 1.0f);
+                        break;
+                    case DXGI_FORMAT_R10G10B10A2_UNORM:
+                        texel = XMLoadUDecN4(reinterpret_cast<const XMUDECN4*>(pRow) + x);
+                        break;
+                    case DXGI_FORMAT_R8G8B8A8_UNORM:
+                    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+                        texel = XMLoadUByteN4(reinterpret_cast<const XMUBYTEN4*>(pRow) + x);
+                        break;
+                    case DXGI_FORMAT_B8G8R8X8_UNORM:
+                    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+                        texel = XMVectorSetW(XMLoadColor(reinterpret_cast<const XMCOLOR*>(pRow) + x), 1.0f);
+                        break;
+                    default:
+                        texel = XMLoadColor(reinterpret_cast<const XMCOLOR*>(pRow) + x);
+                        break;
+                    }
+                    XMStoreFloat4(&aTexels[static_cast<size_t>(y) * uSize + x], texel);
+                }
+            }
+            break;
+        default:
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+
+        // Sampling an sRGB texture returns linear values, match what the shaders see
+        if (bIsSRGB)
+        {
+            for (XMFLOAT4& texel : aTexels)
+            {
+                XMStoreFloat4(&texel, XMColorSRGBToRGB(XMLoadFloat4(&texel)));
+            }
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: ReadCubeMap
+
+      Summary:  Copies the top mip level of every face of a cube map
+                into a staging texture and decodes it on the CPU
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the staging texture
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to copy and map the faces
+                ID3D11ShaderResourceView* pCubeMapView
+                  Shader resource view of the cube map
+                CubeMapData& cubeMap
+                  Decoded faces
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+
+    HRESULT ReadCubeMap(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ ID3D11ShaderResourceView* pCubeMapView,
+        _Out_ CubeMapData& cubeMap
+    )
+    {
+        cubeMap.uSize = 0u;
+
+        ComPtr<ID3D11Resource> resource;
+        pCubeMapView->GetResource(resource.GetAddressOf());
+
+        ComPtr<ID3D11Texture2D> texture;
+        HRESULT hr = resource.As(&texture);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        D3D11_TEXTURE2D_DESC desc;
+        texture->GetDesc(&desc);
+        if (!(desc.MiscFlags & D3D11_RESOURCE_MISC_TEXTURECUBE) || desc.ArraySize < NUM_CUBE_FACES || desc.Width != desc.Height)
+        {
+            return E_INVALIDARG;
+        }
+
+        D3D11_TEXTURE2D_DESC stagingDesc =
+        {
+            .Width = desc.Width,
+            .Height = desc.Height,
+            .MipLevels = 1u,
+            .ArraySize = NUM_CUBE_FACES,
+            .Format = desc.Format,
+            .SampleDesc = {.Count = 1u },
+            .Usage = D3D11_USAGE_STAGING,
+            .BindFlags = 0u,
+            .CPUAccessFlags = D3D11_CPU_ACCESS_READ,
+            .MiscFlags = D3D11_RESOURCE_MISC_TEXTURECUBE
+        };
+        ComPtr<ID3D11Texture2D> staging;
+        hr = pDevice->CreateTexture2D(&stagingDesc, nullptr, staging.GetAddressOf());
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+        {
+            pImmediateContext->CopySubresourceRegion(
+                staging.Get(),
+                D3D11CalcSubresource(0u, uFace, 1u),
+                0u,
+                0u,
+                0u,
+                texture.Get(),
+                D3D11CalcSubresource(0u, uFace, desc.MipLevels),
+                nullptr
+            );
+        }
+
+        for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+        {
+            D3D11_MAPPED_SUBRESOURCE mapped;
+            hr = pImmediateContext->Map(staging.Get(), D3D11CalcSubresource(0u, uFace, 1u), D3D11_MAP_READ, 0u, &mapped);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+
+            hr = DecodeFace(desc.Format, mapped, desc.Width, cubeMap.aFaces[uFace]);
+            pImmediateContext->Unmap(staging.Get(), D3D11CalcSubresource(0u, uFace, 1u));
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        cubeMap.uSize = desc.Width;
+
+        return S_OK;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetCubeMapTexelDirection
+
+      Summary:  Returns the direction a cube map is sampled with to
+                reach a face position
+
+      Args:     UINT uFace
+                  Face index in the Direct3D order +X, -X, +Y, -Y,
+                  +Z, -Z
+                FLOAT u
+                  Horizontal texture coordinate in [0, 1]
+                FLOAT v
+                  Vertical texture coordinate in [0, 1]
+
+      Returns:  XMVECTOR
+                  Normalized direction
+    -----------------------------------------------------------------F-F*/
+
+    XMVECTOR GetCubeMapTexelDirection(
+        _In_ UINT uFace,
+        _In_ FLOAT u,
+        _In_ FLOAT v
+    )
+    {
+        const FLOAT s = 2.0f * u - 1.0f;
+        const FLOAT t = 2.0f * v - 1.0f;
+
+        XMVECTOR direction;
+        switch (uFace)
+        {
+        case 0u:
+            direction = XMVectorSet(1.0f, -t, -s, 0.0f);
+            break;
+        case 1u:
+            direction = XMVectorSet(-1.0f, -t, s, 0.0f);
+            break;
+        case 2u:
+            direction = XMVectorSet(s, 1.0f, t, 0.0f);
+            break;
+        case 3u:
+            direction = XMVectorSet(s, -1.0f, -t, 0.0f);
+            break;
+        case 4u:
+            direction = XMVectorSet(s, -t, 1.0f, 0.0f);
+            break;
+        default:
+            direction = XMVectorSet(-s, -t, -1.0f, 0.0f);
+            break;
+        }
+
+        return XMVector3Normalize(direction);
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetCubeMapTexelSolidAngle
+
+      Summary:  Returns the solid angle covered by a texel of a face,
+                from the projected area of its corners
+
+      Args:     UINT uSize
+                  Width and height of the face
+                UINT x
+                  Texel column
+                UINT y
+                  Texel row
+
+      Returns:  FLOAT
+                  Solid angle in steradians
+    -----------------------------------------------------------------F-F*/
+
+    FLOAT GetCubeMapTexelSolidAngle(
+        _In_ UINT uSize,
+        _In_ UINT x,
+        _In_ UINT y
+    )
+    {
+        const FLOAT texelSize = 2.0f / static_cast<FLOAT>(uSize);
+        const FLOAT x0 = static_cast<FLOAT>(x) * texelSize - 1.0f;
+        const FLOAT y0 = static_cast<FLOAT>(y) * texelSize - 1.0f;
+        const FLOAT x1 = x0 + texelSize;
+        const FLOAT y1 = y0 + texelSize;
+
+        auto areaElement = [](FLOAT s, FLOAT t)
+        {
+            return atan2f(s * t, sqrtf(s * s + t * t + 1.0f));
+        };
+
+        return areaElement(x0, y0) - areaElement(x0, y1) - areaElement(x1, y0) + areaElement(x1, y1);
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetCubeMapFaceCoordinates
+
+      Summary:  Finds the face and the texture coordinates a cube map
+                is sampled at for a direction, the inverse of
+                GetCubeMapTexelDirection
+
+      Args:     FXMVECTOR direction
+                  Direction, does not need to be normalized
+                UINT& uFace
+                  Face index in the Direct3D order
+                FLOAT& u
+                  Horizontal texture coordinate in [0, 1]
+                FLOAT& v
+                  Vertical texture coordinate in [0, 1]
+    -----------------------------------------------------------------F-F*/
+
+    void GetCubeMapFaceCoordinates(
+        _In_ FXMVECTOR direction,
+        _Out_ UINT& uFace,
+        _Out_ FLOAT& u,
+        _Out_ FLOAT& v
+    )
+    {
+        XMFLOAT3 d;
+        XMStoreFloat3(&d, direction);
+
+        const FLOAT absX = fabsf(d.x);
+        const FLOAT absY = fabsf(d.y);
+        const FLOAT absZ = fabsf(d.z);
+
+        FLOAT s = 0.0f;
+        FLOAT t = 0.0f;
+        if (absX >= absY && absX >= absZ)
+        {
+            uFace = d.x > 0.0f ? 0u : 1u;
+            s = (d.x > 0.0f ? -d.z : d.z) / absX;
+            t = -d.y / absX;
+        }
+        else if (absY >= absZ)
+        {
+            uFace = d.y > 0.0f ? 2u : 3u;
+            s = d.x / absY;
+            t = (d.y > 0.0f ? d.z : -d.z) / absY;
+        }
+        else
+        {
+            uFace = d.z > 0.0f ? 4u : 5u;
+            s = (d.z > 0.0f ? d.x : -d.x) / absZ;
+            t = -d.y / absZ;
+        }
+
+        u = 0.5f * (s + 1.0f);
+        v = 0.5f * (t + 1.0f);
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SampleCubeMap
+
+      Summary:  Bilinearly samples a cube map towards a direction. The
+                filter is clamped to the face, the seams are not
+                blended across faces.
+
+      Args:     const CubeMapData& cubeMap
+                  Decoded cube map
+                FXMVECTOR direction
+                  Direction, does not need to be normalized
+
+      Returns:  XMVECTOR
+                  Filtered texel
+    -----------------------------------------------------------------F-F*/
+
+    XMVECTOR SampleCubeMap(
+        _In_ const CubeMapData& cubeMap,
+        _In_ FXMVECTOR direction
+    )
+    {
+        UINT uFace = 0u;
+        FLOAT u = 0.0f;
+        FLOAT v = 0.0f;
+        GetCubeMapFaceCoordinates(direction, uFace, u, v);
+
+        const FLOAT maxCoordinate = static_cast<FLOAT>(cubeMap.uSize - 1u);
+        const FLOAT x = std::clamp(u * static_cast<FLOAT>(cubeMap.uSize) - 0.5f, 0.0f, maxCoordinate);
+        const FLOAT y = std::clamp(v * static_cast<FLOAT>(cubeMap.uSize) - 0.5f, 0.0f, maxCoordinate);
+
+        const UINT x0 = static_cast<UINT>(x);
+        const UINT y0 = static_cast<UINT>(y);
+        const UINT x1 = x0 + 1u < cubeMap.uSize ? x0 + 1u : x0;
+        const UINT y1 = y0 + 1u < cubeMap.uSize ? y0 + 1u : y0;
+        const FLOAT fractionX = x - static_cast<FLOAT>(x0);
+        const FLOAT fractionY = y - static_cast<FLOAT>(y0);
+
+        const std::vector<XMFLOAT4>& aTexels = cubeMap.aFaces[uFace];
+        const XMVECTOR top = XMVectorLerp(
+            XMLoadFloat4(&aTexels[static_cast<size_t>(y0) * cubeMap.uSize + x0]),
+            XMLoadFloat4(&aTexels[static_cast<size_t>(y0) * cubeMap.uSize + x1]),
+            fractionX
+        );
+        const XMVECTOR bottom = XMVectorLerp(
+            XMLoadFloat4(&aTexels[static_cast<size_t>(y1) * cubeMap.uSize + x0]),
+            XMLoadFloat4(&aTexels[static_cast<size_t>(y1) * cubeMap.uSize + x1]),
+            fractionX
+        );
+
+        return XMVectorLerp(top, bottom, fractionY);
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: DownsampleCubeMap
+
+      Summary:  Builds the next mip level of a cube map with a 2 x 2
+                box filter
+
+      Args:     const CubeMapData& source
+                  Cube map to downsample, at least 2 x 2 texels
+                CubeMapData& destination
+                  Half sized cube map
+    -----------------------------------------------------------------F-F*/
+
+    void DownsampleCubeMap(
+        _In_ const CubeMapData& source,
+        _Out_ CubeMapData& destination
+    )
+    {
+        destination.uSize = source.uSize / 2u;
+
+        for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+        {
+            const std::vector<XMFLOAT4>& aSource = source.aFaces[uFace];
+            std::vector<XMFLOAT4>& aDestination = destination.aFaces[uFace];
+            aDestination.resize(static_cast<size_t>(destination.uSize) * destination.uSize);
+
+            for (UINT y = 0u; y < destination.uSize; ++y)
+            {
+                const XMFLOAT4* pTopRow = &aSource[static_cast<size_t>(2u * y) * source.uSize];
+                const XMFLOAT4* pBottomRow = pTopRow + source.uSize;
+                for (UINT x = 0u; x < destination.uSize; ++x)
+                {
+                    XMVECTOR sum = XMVectorAdd(XMLoadFloat4(&pTopRow[2u * x]), XMLoadFloat4(&pTopRow[2u * x + 1u]));
+                    sum = XMVectorAdd(sum, XMLoadFloat4(&pBottomRow[2u * x]));
+                    sum = XMVectorAdd(sum, XMLoadFloat4(&pBottomRow[2u * x + 1u]));
+
+                    XMStoreFloat4(&aDestination[static_cast<size_t>(y) * destination.uSize + x], XMVectorScale(sum, 0.25f));
+                }
+            }
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SaveCubeMapToDDS
+
+      Summary:  Writes a cube map and its mip levels as a half float
+                DDS file with the DX10 header extension, the layout
+                CreateDDSTextureFromFile reads
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the DDS file
+                const std::vector<CubeMapData>& aMips
+                  Mip levels, each half the size of the previous one
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+
+    HRESULT SaveCubeMapToDDS(
+        _In_ const std::filesystem::path& filePath,
+        _In_ const std::vector<CubeMapData>& aMips
+    )
+    {
+        if (aMips.empty())
+        {
+            return E_INVALIDARG;
+        }
+
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return HRESULT_FROM_WIN32(ERROR_ACCESS_DENIED);
+        }
+
+        const UINT uSize = aMips[0].uSize;
+
+        DDSHeader header = {};
+        header.uSize = sizeof(DDSHeader);
+        header.uFlags = DDS_HEADER_FLAGS;
+        header.uHeight = uSize;
+        header.uWidth = uSize;
+        header.uPitchOrLinearSize = uSize * static_cast<UINT>(sizeof(XMHALF4));
+        header.uMipMapCount = static_cast<UINT>(aMips.size());
+        header.pixelFormat.uSize = sizeof(DDSPixelFormat);
+        header.pixelFormat.uFlags = DDS_FOURCC;
+        header.pixelFormat.uFourCC = DDS_FOURCC_DX10;
+        header.uCaps = DDS_CAPS;
+        header.uCaps2 = DDS_CAPS2_CUBEMAP_ALLFACES;
+
+        const DDSHeaderDXT10 headerDXT10 =
+        {
+            .dxgiFormat = DXGI_FORMAT_R16G16B16A16_FLOAT,
+            .uResourceDimension = D3D11_RESOURCE_DIMENSION_TEXTURE2D,
+            .uMiscFlag = D3D11_RESOURCE_MISC_TEXTURECUBE,
+            .uArraySize = 1u,
+            .uMiscFlags2 = 0u
+        };
+
+        const UINT uMagic = DDS_MAGIC;
+        file.write(reinterpret_cast<const CHAR*>(&uMagic), sizeof(uMagic));
+        file.write(reinterpret_cast<const CHAR*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const CHAR*>(&headerDXT10), sizeof(headerDXT10));
+
+        // Faces are stored one after another, each with its whole mip chain
+        std::vector<XMHALF4> aHalfTexels;
+        for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+        {
+            for (const CubeMapData& mip : aMips)
+            {
+                const std::vector<XMFLOAT4>& aTexels = mip.aFaces[uFace];
+                aHalfTexels.resize(aTexels.size());
+                for (size_t i = 0u; i < aTexels.size(); ++i)
+                {
+                    XMStoreHalf4(&aHalfTexels[i], XMLoadFloat4(&aTexels[i]));
+                }
+                file.write(reinterpret_cast<const CHAR*>(aHalfTexels.data()), static_cast<std::streamsize>(aHalfTexels.size() * sizeof(XMHALF4)));
+            }
+        }
+
+        if (!file)
+        {
+            return HRESULT_FROM_WIN32(ERROR_WRITE_FAULT);
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: ComputeFileHash
+
+      Summary:  Hashes the content of a file with 64 bit FNV-1a, used
+                to key the data baked from the file
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the file
+                UINT64& uHash
+                  Hash of the content
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+
+    HRESULT ComputeFileHash(
+        _In_ const std::filesystem::path& filePath,
+        _Out_ UINT64& uHash
+    )
+    {
+        uHash = 14695981039346656037ull;
+
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+        }
+
+        std::vector<CHAR> aBuffer(1u << 16u);
+        while (file)
+        {
+            file.read(aBuffer.data(), static_cast<std::streamsize>(aBuffer.size()));
+            const std::streamsize uNumRead = file.gcount();
+            for (std::streamsize i = 0; i < uNumRead; ++i)
+            {
+                uHash ^= static_cast<BYTE>(aBuffer[static_cast<size_t>(i)]);
+                uHash *= 1099511628211ull;
+            }
+        }
+
+        return S_OK;
+    }
+}
@@ -0,0 +1,52 @@
+/*+===================================================================
+  File:      CUBEMAPDATA.H
+
+  Summary:   CubeMapData header file contains declarations of the
+             functions that read a cube map texture back to the CPU,
+             walk over and sample its texels, and write cube maps
+             baked on the CPU as DDS files.
+
+  Functions: ReadCubeMap, GetCubeMapTexelDirection,
+             GetCubeMapTexelSolidAngle, GetCubeMapFaceCoordinates,
+             SampleCubeMap, DownsampleCubeMap, SaveCubeMapToDDS,
+             ComputeFileHash
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#define NUM_CUBE_FACES (6)
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   CubeMapData
+
+      Summary:  Linear RGBA texels of the top mip level of every face,
+                stored row by row in the Direct3D face order
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct CubeMapData
+    {
+        UINT uSize;
+        std::vector<XMFLOAT4> aFaces[NUM_CUBE_FACES];
+    };
+
+    HRESULT ReadCubeMap(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ ID3D11ShaderResourceView* pCubeMapView,
+        _Out_ CubeMapData& cubeMap
+    );
+
+    XMVECTOR GetCubeMapTexelDirection(_In_ UINT uFace, _In_ FLOAT u, _In_ FLOAT v);
+    FLOAT GetCubeMapTexelSolidAngle(_In_ UINT uSize, _In_ UINT x, _In_ UINT y);
+    void GetCubeMapFaceCoordinates(_In_ FXMVECTOR direction, _Out_ UINT& uFace, _Out_ FLOAT& u, _Out_ FLOAT& v);
+    XMVECTOR SampleCubeMap(_In_ const CubeMapData& cubeMap, _In_ FXMVECTOR direction);
+    void DownsampleCubeMap(_In_ const CubeMapData& source, _Out_ CubeMapData& destination);
+
+    HRESULT SaveCubeMapToDDS(_In_ const std::filesystem::path& filePath, _In_ const std::vector<CubeMapData>& aMips);
+
+    HRESULT ComputeFileHash(_In_ const std::filesystem::path& filePath, _Out_ UINT64& uHash);
+}
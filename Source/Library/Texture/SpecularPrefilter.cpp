@@ -0,0 +1,314 @@
+#include "Texture/SpecularPrefilter.h"
+
+#include <atomic>
+#include <thread>
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   PrefilterSample
+
+      Summary:  Light direction around the +z normal, its weight and
+                the source mip level it is fetched from
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PrefilterSample
+    {
+        XMFLOAT3 Direction;
+        FLOAT Weight;
+        FLOAT Lod;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   PrefilterRow
+
+      Summary:  Unit of work handed to the worker threads
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PrefilterRow
+    {
+        UINT uMip;
+        UINT uFace;
+        UINT uRow;
+    };
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: Hammersley
+
+      Summary:  Returns the i-th point of the Hammersley set
+
+      Args:     UINT i
+                  Index of the point
+                UINT uNumPoints
+                  Number of points in the set
+
+      Returns:  XMFLOAT2
+                  Point in [0, 1)^2
+    -----------------------------------------------------------------F-F*/
+
+    static XMFLOAT2 Hammersley(
+        _In_ UINT i,
+        _In_ UINT uNumPoints
+    )
+    {
+        UINT uBits = i;
+        uBits = (uBits << 16u) | (uBits >> 16u);
+        uBits = ((uBits & 0x55555555u) << 1u) | ((uBits & 0xAAAAAAAAu) >> 1u);
+        uBits = ((uBits & 0x33333333u) << 2u) | ((uBits & 0xCCCCCCCCu) >> 2u);
+        uBits = ((uBits & 0x0F0F0F0Fu) << 4u) | ((uBits & 0xF0F0F0F0u) >> 4u);
+        uBits = ((uBits & 0x00FF00FFu) << 8u) | ((uBits & 0xFF00FF00u) >> 8u);
+
+        return XMFLOAT2(
+            static_cast<FLOAT>(i) / static_cast<FLOAT>(uNumPoints),
+            static_cast<FLOAT>(uBits) * 2.3283064365386963e-10f
+        );
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: BuildPrefilterSamples
+
+      Summary:  Importance samples the GGX distribution around the +z
+                normal, assuming the view direction equals the normal.
+                Each sample reads the source mip whose texels cover
+                about the solid angle of the sample, which removes the
+                noise of sampling a sharp source with few rays.
+
+      Args:     FLOAT roughness
+                  Perceptual roughness, squared into the GGX alpha
+                UINT uNumSamples
+                  Number of samples to draw
+                UINT uSourceSize
+                  Width and height of the top source mip
+                std::vector<PrefilterSample>& aSamples
+                  Samples above the horizon
+
+      Modifies: [aSamples].
+    -----------------------------------------------------------------F-F*/
+
+    static void BuildPrefilterSamples(
+        _In_ FLOAT roughness,
+        _In_ UINT uNumSamples,
+        _In_ UINT uSourceSize,
+        _Out_ std::vector<PrefilterSample>& aSamples
+    )
+    {
+        const FLOAT alpha = roughness * roughness;
+        const FLOAT alphaSquared = alpha * alpha;
+        const FLOAT texelSolidAngle = 4.0f * XM_PI / (6.0f * static_cast<FLOAT>(uSourceSize) * static_cast<FLOAT>(uSourceSize));
+
+        aSamples.clear();
+        aSamples.reserve(uNumSamples);
+        for (UINT i = 0u; i < uNumSamples; ++i)
+        {
+            const XMFLOAT2 xi = Hammersley(i, uNumSamples);
+
+            const FLOAT phi = XM_2PI * xi.x;
+            const FLOAT cosTheta = sqrtf((1.0f - xi.y) / (1.0f + (alphaSquared - 1.0f) * xi.y));
+            const FLOAT sinTheta = sqrtf(1.0f - cosTheta * cosTheta);
+
+            // Reflect the normal around the half vector
+            const XMFLOAT3 halfVector(sinTheta * cosf(phi), sinTheta * sinf(phi), cosTheta);
+            const XMFLOAT3 direction(
+                2.0f * cosTheta * halfVector.x,
+                2.0f * cosTheta * halfVector.y,
+                2.0f * cosTheta * halfVector.z - 1.0f
+            );
+            if (direction.z <= 0.0f)
+            {
+                continue;
+            }
+
+            // With the view along the normal, the pdf of the light direction is D / 4
+            const FLOAT denominator = cosTheta * cosTheta * (alphaSquared - 1.0f) + 1.0f;
+            const FLOAT distribution = alphaSquared / (XM_PI * denominator * denominator);
+            const FLOAT sampleSolidAngle = 4.0f / (static_cast<FLOAT>(uNumSamples) * distribution + 1e-4f);
+
+            aSamples.push_back(
+                PrefilterSample
+                {
+                    .Direction = direction,
+                    .Weight = direction.z,
+                    .Lod = roughness > 0.0f ? fmaxf(0.5f * log2f(sampleSolidAngle / texelSolidAngle) + 1.0f, 0.0f) : 0.0f
+                }
+            );
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SampleSourceLod
+
+      Summary:  Trilinearly samples the source mip chain
+
+      Args:     const std::vector<CubeMapData>& aSourceMips
+                  Source mip chain
+                FXMVECTOR direction
+                  Sampling direction
+                FLOAT lod
+                  Fractional source mip level
+
+      Returns:  XMVECTOR
+                  Filtered texel
+    -----------------------------------------------------------------F-F*/
+
+    static XMVECTOR SampleSourceLod(
+        _In_ const std::vector<CubeMapData>& aSourceMips,
+        _In_ FXMVECTOR direction,
+        _In_ FLOAT lod
+    )
+    {
+        const FLOAT maxLod = static_cast<FLOAT>(aSourceMips.size() - 1u);
+        const FLOAT clampedLod = fminf(fmaxf(lod, 0.0f), maxLod);
+
+        const UINT uLowerMip = static_cast<UINT>(clampedLod);
+        const FLOAT fraction = clampedLod - static_cast<FLOAT>(uLowerMip);
+        if (fraction <= 0.0f || uLowerMip + 1u >= aSourceMips.size())
+        {
+            return SampleCubeMap(aSourceMips[uLowerMip], direction);
+        }
+
+        return XMVectorLerp(
+            SampleCubeMap(aSourceMips[uLowerMip], direction),
+            SampleCubeMap(aSourceMips[uLowerMip + 1u], direction),
+            fraction
+        );
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: PrefilterSpecularGGX
+
+      Summary:  Convolves the environment with the GGX lobe of an
+                increasing roughness for every mip level of the output.
+                The top level is a resampled copy of the source. The
+                rows of all faces and mips are handed out to the worker
+                threads from a shared counter, so the threads stay busy
+                even though the levels differ in size.
+
+      Args:     const std::vector<CubeMapData>& aSourceMips
+                  Box filtered mip chain of the environment
+                UINT uSize
+                  Width and height of the top output level
+                UINT uNumMips
+                  Number of output levels, the last one has a
+                  roughness of 1
+                UINT uNumSamples
+                  Number of importance samples per texel
+                UINT uNumThreads
+                  Number of worker threads
+                std::vector<CubeMapData>& aPrefilteredMips
+                  Prefiltered mip chain
+                PrefilterStats& stats
+                  Bake time and work of every thread
+    -----------------------------------------------------------------F-F*/
+
+    void PrefilterSpecularGGX(
+        _In_ const std::vector<CubeMapData>& aSourceMips,
+        _In_ UINT uSize,
+        _In_ UINT uNumMips,
+        _In_ UINT uNumSamples,
+        _In_ UINT uNumThreads,
+        _Out_ std::vector<CubeMapData>& aPrefilteredMips,
+        _Out_ PrefilterStats& stats
+    )
+    {
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        const UINT uSourceSize = aSourceMips[0].uSize;
+
+        std::vector<std::vector<PrefilterSample>> aMipSamples(uNumMips);
+        std::vector<PrefilterRow> aRows;
+        aPrefilteredMips.resize(uNumMips);
+        for (UINT uMip = 0u; uMip < uNumMips; ++uMip)
+        {
+            CubeMapData& mip = aPrefilteredMips[uMip];
+            mip.uSize = uSize >> uMip;
+            for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+            {
+                mip.aFaces[uFace].resize(static_cast<size_t>(mip.uSize) * mip.uSize);
+                for (UINT uRow = 0u; uRow < mip.uSize; ++uRow)
+                {
+                    aRows.push_back(PrefilterRow{ .uMip = uMip, .uFace = uFace, .uRow = uRow });
+                }
+            }
+
+            if (uMip > 0u)
+            {
+                const FLOAT roughness = static_cast<FLOAT>(uMip) / static_cast<FLOAT>(uNumMips - 1u);
+                BuildPrefilterSamples(roughness, uNumSamples, uSourceSize, aMipSamples[uMip]);
+            }
+        }
+
+        // The top level reads the source mip of the same resolution
+        const FLOAT topLod = log2f(static_cast<FLOAT>(uSourceSize) / static_cast<FLOAT>(uSize));
+
+        std::atomic<UINT> uNextRow = 0u;
+        stats.aThreads.assign(uNumThreads, PrefilterThreadStats{ .uNumRows = 0u, .uNumTexels = 0u, .busyTime = 0.0f });
+
+        auto worker = [&](UINT uThreadIndex)
+        {
+            LARGE_INTEGER threadStartTime;
+            LARGE_INTEGER threadEndTime;
+            QueryPerformanceCounter(&threadStartTime);
+
+            PrefilterThreadStats& threadStats = stats.aThreads[uThreadIndex];
+            for (UINT uRowIndex = uNextRow.fetch_add(1u); uRowIndex < aRows.size(); uRowIndex = uNextRow.fetch_add(1u))
+            {
+                const PrefilterRow& row = aRows[uRowIndex];
+                CubeMapData& mip = aPrefilteredMips[row.uMip];
+                const std::vector<PrefilterSample>& aSamples = aMipSamples[row.uMip];
+
+                const FLOAT invSize = 1.0f / static_cast<FLOAT>(mip.uSize);
+                XMFLOAT4* pTexel = &mip.aFaces[row.uFace][static_cast<size_t>(row.uRow) * mip.uSize];
+                for (UINT x = 0u; x < mip.uSize; ++x, ++pTexel)
+                {
+                    const XMVECTOR normal = GetCubeMapTexelDirection(row.uFace, (static_cast<FLOAT>(x) + 0.5f) * invSize, (static_cast<FLOAT>(row.uRow) + 0.5f) * invSize);
+
+                    if (row.uMip == 0u)
+                    {
+                        XMStoreFloat4(pTexel, SampleSourceLod(aSourceMips, normal, topLod));
+                        continue;
+                    }
+
+                    const XMVECTOR up = fabsf(XMVectorGetZ(normal)) < 0.999f ? g_XMIdentityR2 : g_XMIdentityR0;
+                    const XMVECTOR tangentX = XMVector3Normalize(XMVector3Cross(up, normal));
+                    const XMVECTOR tangentY = XMVector3Cross(normal, tangentX);
+
+                    XMVECTOR color = XMVectorZero();
+                    FLOAT weight = 0.0f;
+                    for (const PrefilterSample& sample : aSamples)
+                    {
+                        XMVECTOR direction = XMVectorScale(tangentX, sample.Direction.x);
+                        direction = XMVectorMultiplyAdd(tangentY, XMVectorReplicate(sample.Direction.y), direction);
+                        direction = XMVectorMultiplyAdd(normal, XMVectorReplicate(sample.Direction.z), direction);
+
+                        color = XMVectorMultiplyAdd(SampleSourceLod(aSourceMips, direction, sample.Lod), XMVectorReplicate(sample.Weight), color);
+                        weight += sample.Weight;
+                    }
+
+                    XMStoreFloat4(pTexel, weight > 0.0f ? XMVectorScale(color, 1.0f / weight) : SampleSourceLod(aSourceMips, normal, topLod));
+                }
+
+                ++threadStats.uNumRows;
+                threadStats.uNumTexels += mip.uSize;
+            }
+
+            QueryPerformanceCounter(&threadEndTime);
+            threadStats.busyTime = static_cast<FLOAT>(threadEndTime.QuadPart - threadStartTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+        };
+
+        std::vector<std::thread> aThreads;
+        aThreads.reserve(uNumThreads);
+        for (UINT i = 0u; i < uNumThreads; ++i)
+        {
+            aThreads.emplace_back(worker, i);
+        }
+        for (std::thread& thread : aThreads)
+        {
+            thread.join();
+        }
+
+        QueryPerformanceCounter(&endTime);
+        stats.bakeTime = static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+    }
+}
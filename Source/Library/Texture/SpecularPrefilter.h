@@ -0,0 +1,53 @@
+/*+===================================================================
+  File:      SPECULARPREFILTER.H
+
+  Summary:   SpecularPrefilter header file contains declarations of
+             the functions that bake the GGX prefiltered specular mip
+             chain of an environment cube map on the CPU.
+
+  Functions: PrefilterSpecularGGX
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Texture/CubeMapData.h"
+
+namespace library
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   PrefilterThreadStats
+
+      Summary:  Work done by a single worker thread of the bake
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PrefilterThreadStats
+    {
+        UINT uNumRows;
+        UINT uNumTexels;
+        FLOAT busyTime;
+    };
+
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   PrefilterStats
+
+      Summary:  Wall clock time of the bake in milliseconds and the
+                work of every worker thread
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct PrefilterStats
+    {
+        FLOAT bakeTime;
+        std::vector<PrefilterThreadStats> aThreads;
+    };
+
+    void PrefilterSpecularGGX(
+        _In_ const std::vector<CubeMapData>& aSourceMips,
+        _In_ UINT uSize,
+        _In_ UINT uNumMips,
+        _In_ UINT uNumSamples,
+        _In_ UINT uNumThreads,
+        _Out_ std::vector<CubeMapData>& aPrefilteredMips,
+        _Out_ PrefilterStats& stats
+    );
+}
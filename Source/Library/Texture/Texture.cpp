@@ -48,13 +48,18 @@ namespace library
         _In_ ID3D11DeviceContext* pImmediateContext
     )
     {
-        HRESULT hr = CreateWICTextureFromFile(
-            pDevice,
-            pImmediateContext,
-            m_filePath.c_str(),
-            nullptr,
-            m_textureRV.GetAddressOf()
-        );
+        // WIC can decode the first surface of a DDS file too, which drops the faces of cube maps
+        HRESULT hr = E_FAIL;
+        if (m_filePath.extension() != L".dds" && m_filePath.extension() != L".DDS")
+        {
+            hr = CreateWICTextureFromFile(
+                pDevice,
+                pImmediateContext,
+                m_filePath.c_str(),
+                nullptr,
+                m_textureRV.GetAddressOf()
+            );
+        }
         if (FAILED(hr))
         {
             hr = CreateDDSTextureFromFile(pDevice, m_filePath.c_str(), nullptr, m_textureRV.GetAddressOf());
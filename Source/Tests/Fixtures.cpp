@@ -0,0 +1,631 @@
+#include "Fixtures.h"
+
+#include "assimp/scene.h"
+
+namespace tests
+{
+    /*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+      Struct:   SkinnedSceneNode
+
+      Summary:  Bind pose of a node of the skinned scene, and whether
+                the node is a bone and has an animation channel
+    S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+    struct SkinnedSceneNode
+    {
+        PCSTR pszName;
+        INT iParent;
+        XMFLOAT3 Translation;
+        XMFLOAT3 Axis;
+        FLOAT Angle;
+        BOOL bBone;
+        BOOL bAnimated;
+    };
+
+    // Parents come before their children, in the depth first order of the hierarchy
+    static const SkinnedSceneNode SKINNED_SCENE_NODES[] =
+    {
+        { "Root", -1, XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 0.0f, 0.0f), -XM_PIDIV2, FALSE, FALSE },
+        { "Hips", 0, XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), 0.1f, TRUE, TRUE },
+        { "Spine", 1, XMFLOAT3(0.0f, 0.0f, 0.4f), XMFLOAT3(0.0f, 1.0f, 0.0f), 0.05f, TRUE, TRUE },
+        { "Neck", 2, XMFLOAT3(0.0f, 0.0f, 0.4f), XMFLOAT3(0.0f, 1.0f, 0.0f), -0.05f, TRUE, FALSE },
+        { "Head", 3, XMFLOAT3(0.0f, 0.0f, 0.2f), XMFLOAT3(0.0f, 0.0f, 1.0f), 0.2f, TRUE, TRUE },
+        { "LegL", 1, XMFLOAT3(-0.15f, 0.0f, -0.1f), XMFLOAT3(1.0f, 0.0f, 0.0f), XM_PI, TRUE, TRUE },
+        { "FootL", 5, XMFLOAT3(0.0f, 0.0f, 0.5f), XMFLOAT3(1.0f, 0.0f, 0.0f), 0.3f, TRUE, TRUE },
+        { "LegR", 1, XMFLOAT3(0.15f, 0.0f, -0.1f), XMFLOAT3(1.0f, 0.0f, 0.0f), XM_PI, TRUE, TRUE },
+        { "FootR", 7, XMFLOAT3(0.0f, 0.0f, 0.5f), XMFLOAT3(1.0f, 0.0f, 0.0f), 0.3f, TRUE, FALSE },
+    };
+
+    static constexpr const UINT NUM_SKINNED_SCENE_NODES = static_cast<UINT>(ARRAYSIZE(SKINNED_SCENE_NODES));
+    static constexpr const UINT NUM_SKINNED_SCENE_BONES = NUM_SKINNED_SCENE_NODES - 1u;
+    static constexpr const FLOAT SKINNED_SCENE_DURATION_TICKS = 48.0f;
+    static constexpr const FLOAT SKINNED_SCENE_TICKS_PER_SECOND = 24.0f;
+    static constexpr const UINT SKINNED_SCENE_ROTATION_KEY_TICKS = 6u;
+    static constexpr const FLOAT SKINNED_SCENE_POSITION_KEY_TICKS[] = { 0.0f, 12.0f, 30.0f, 48.0f };
+    static constexpr const FLOAT SKINNED_SCENE_SCALING_KEY_TICKS[] = { 0.0f, 24.0f, 48.0f };
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: ConvertToXMMatrix
+
+      Summary:  Converts an Assimp matrix, which transforms column
+                vectors, to a matrix that transforms row vectors
+
+      Args:     const aiMatrix4x4& matrix
+                  Assimp matrix
+
+      Returns:  XMMATRIX
+                  Transposed matrix
+    -----------------------------------------------------------------F-F*/
+    static XMMATRIX ConvertToXMMatrix(
+        _In_ const aiMatrix4x4& matrix
+    )
+    {
+        return XMMatrixTranspose(XMMATRIX(&matrix.a1));
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: ConvertToAiMatrix
+
+      Summary:  Converts a matrix that transforms row vectors to an
+                Assimp matrix, which transforms column vectors
+
+      Args:     const XMMATRIX& matrix
+                  Matrix to convert
+
+      Returns:  aiMatrix4x4
+                  Transposed matrix
+    -----------------------------------------------------------------F-F*/
+    static aiMatrix4x4 ConvertToAiMatrix(
+        _In_ const XMMATRIX& matrix
+    )
+    {
+        XMFLOAT4X4 transposed;
+        XMStoreFloat4x4(&transposed, XMMatrixTranspose(matrix));
+
+        return aiMatrix4x4(
+            transposed._11, transposed._12, transposed._13, transposed._14,
+            transposed._21, transposed._22, transposed._23, transposed._24,
+            transposed._31, transposed._32, transposed._33, transposed._34,
+            transposed._41, transposed._42, transposed._43, transposed._44
+        );
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TestModel::TestModel
+
+      Summary:  Constructor
+
+      Args:     library::eSkinningMode skinningMode
+                  How the bones of a vertex are blended
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TestModel::TestModel(
+        _In_opt_ library::eSkinningMode skinningMode
+    )
+        : library::Model(L"TestModel", skinningMode)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TestModel::TestModel
+
+      Summary:  Constructor of a model loaded by Initialize
+
+      Args:     const std::filesystem::path& filePath
+                  Path to the model file
+                library::eSkinningMode skinningMode
+                  How the bones of a vertex are blended
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    TestModel::TestModel(
+        _In_ const std::filesystem::path& filePath,
+        _In_opt_ library::eSkinningMode skinningMode
+    )
+        : library::Model(filePath, skinningMode)
+    {
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TestModel::InitializeFromScene
+
+      Summary:  Builds the asset of the model from an Assimp scene,
+                the way the importer path of the model does, without
+                sharing it nor writing it to the model cache
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload the buffers
+                const aiScene* pScene
+                  Scene to build the asset from
+
+      Modifies: [m_asset, m_aGlobalTransforms].
+
+      Returns:  HRESULT
+                  Status code
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    HRESULT TestModel::InitializeFromScene(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ const aiScene* pScene
+    )
+    {
+        m_asset = createAsset();
+
+        const XMMATRIX transform = ConvertToXMMatrix(pScene->mRootNode->mTransformation);
+        XMVECTOR det = XMMatrixDeterminant(transform);
+        m_asset->GlobalInverseTransform = XMMatrixInverse(&det, transform);
+
+        HRESULT hr = initFromScene(pDevice, pImmediateContext, pScene, m_filePath);
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        m_aGlobalTransforms.resize(m_asset->aSkeleton.size());
+
+        return S_OK;
+    }
+
+    /*M+M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M+++M
+      Method:   TestModel::GetAsset
+
+      Summary:  Returns the asset of the model
+
+      Returns:  const library::ModelAsset&
+                  Asset of the model
+    M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M---M-M*/
+    const library::ModelAsset& TestModel::GetAsset() const
+    {
+        return *m_asset;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CreateTestDevice
+
+      Summary:  Creates a WARP device, so the tests that upload buffers
+                and textures run without a GPU
+
+      Args:     ComPtr<ID3D11Device>& outDevice
+                  The created device
+                ComPtr<ID3D11DeviceContext>& outImmediateContext
+                  The immediate context of the device
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+    HRESULT CreateTestDevice(
+        _Out_ ComPtr<ID3D11Device>& outDevice,
+        _Out_ ComPtr<ID3D11DeviceContext>& outImmediateContext
+    )
+    {
+        D3D_FEATURE_LEVEL featureLevel = D3D_FEATURE_LEVEL_11_0;
+
+        return D3D11CreateDevice(
+            nullptr,
+            D3D_DRIVER_TYPE_WARP,
+            nullptr,
+            0u,
+            &featureLevel,
+            1u,
+            D3D11_SDK_VERSION,
+            outDevice.ReleaseAndGetAddressOf(),
+            nullptr,
+            outImmediateContext.ReleaseAndGetAddressOf()
+        );
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CreateSkyCubeMap
+
+      Summary:  Fills a cube map with a sky that brightens linearly
+                towards the zenith and a sun lobe. Without the sun the
+                radiance is linear in the direction, so its irradiance
+                is exactly represented by the first nine spherical
+                harmonics.
+
+      Args:     UINT uSize
+                  Width and height of every face
+                FLOAT sunIntensity
+                  Peak radiance of the sun lobe, 0 for no sun
+                library::CubeMapData& outCubeMap
+                  The created cube map
+    -----------------------------------------------------------------F-F*/
+    void CreateSkyCubeMap(
+        _In_ UINT uSize,
+        _In_ FLOAT sunIntensity,
+        _Out_ library::CubeMapData& outCubeMap
+    )
+    {
+        const XMVECTOR sunDirection = XMVector3Normalize(XMVectorSet(0.3f, 0.8f, 0.5f, 0.0f));
+        const XMVECTOR skyColor = XMVectorSet(0.3f, 0.4f, 0.6f, 0.0f);
+        const XMVECTOR sunColor = XMVectorSet(1.0f, 0.875f, 0.75f, 0.0f);
+
+        outCubeMap.uSize = uSize;
+        for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+        {
+            outCubeMap.aFaces[uFace].resize(static_cast<size_t>(uSize) * uSize);
+            for (UINT y = 0u; y < uSize; ++y)
+            {
+                for (UINT x = 0u; x < uSize; ++x)
+                {
+                    const XMVECTOR direction = library::GetCubeMapTexelDirection(
+                        uFace,
+                        (static_cast<FLOAT>(x) + 0.5f) / static_cast<FLOAT>(uSize),
+                        (static_cast<FLOAT>(y) + 0.5f) / static_cast<FLOAT>(uSize)
+                    );
+
+                    const FLOAT sky = 0.6f + 0.4f * XMVectorGetY(direction);
+                    const FLOAT sun = sunIntensity * powf(fmaxf(XMVectorGetX(XMVector3Dot(direction, sunDirection)), 0.0f), 8.0f);
+
+                    XMStoreFloat4(
+                        &outCubeMap.aFaces[uFace][static_cast<size_t>(y) * uSize + x],
+                        XMVectorMultiplyAdd(sunColor, XMVectorReplicate(sun), XMVectorScale(skyColor, sky))
+                    );
+                }
+            }
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CreateTorusMesh
+
+      Summary:  Builds a torus around the y axis with a major radius
+                of 1 and a tube radius of 0.4, indexed like an imported
+                mesh. The first and last ring and side are duplicated
+                on the texture seams, the triangles are clockwise seen
+                from outside and the tube occludes itself from the
+                side.
+
+      Args:     UINT uNumRings
+                  Number of segments around the y axis
+                UINT uNumSides
+                  Number of segments around the tube
+                std::vector<library::SimpleVertex>& outVertices
+                  Created vertices
+                std::vector<UINT>& outIndices
+                  Created triangles, three indices each
+    -----------------------------------------------------------------F-F*/
+    void CreateTorusMesh(
+        _In_ UINT uNumRings,
+        _In_ UINT uNumSides,
+        _Out_ std::vector<library::SimpleVertex>& outVertices,
+        _Out_ std::vector<UINT>& outIndices
+    )
+    {
+        constexpr const FLOAT MAJOR_RADIUS = 1.0f;
+        constexpr const FLOAT TUBE_RADIUS = 0.4f;
+
+        outVertices.clear();
+        outVertices.reserve(static_cast<size_t>(uNumRings + 1u) * (uNumSides + 1u));
+        for (UINT uRing = 0u; uRing <= uNumRings; ++uRing)
+        {
+            // The last ring and side take the angles of the first, so that the seams share their positions
+            const FLOAT u = static_cast<FLOAT>(uRing) / static_cast<FLOAT>(uNumRings);
+            const FLOAT ringAngle = XM_2PI * static_cast<FLOAT>(uRing % uNumRings) / static_cast<FLOAT>(uNumRings);
+
+            for (UINT uSide = 0u; uSide <= uNumSides; ++uSide)
+            {
+                const FLOAT v = static_cast<FLOAT>(uSide) / static_cast<FLOAT>(uNumSides);
+                const FLOAT sideAngle = XM_2PI * static_cast<FLOAT>(uSide % uNumSides) / static_cast<FLOAT>(uNumSides);
+                const XMFLOAT3 normal(cosf(sideAngle) * cosf(ringAngle), sinf(sideAngle), cosf(sideAngle) * sinf(ringAngle));
+
+                outVertices.push_back(
+                    {
+                        .Position = XMFLOAT3(
+                            MAJOR_RADIUS * cosf(ringAngle) + TUBE_RADIUS * normal.x,
+                            TUBE_RADIUS * normal.y,
+                            MAJOR_RADIUS * sinf(ringAngle) + TUBE_RADIUS * normal.z
+                        ),
+                        .TexCoord = XMFLOAT2(u, v),
+                        .Normal = normal
+                    }
+                );
+            }
+        }
+
+        outIndices.clear();
+        outIndices.reserve(static_cast<size_t>(uNumRings) * uNumSides * 6u);
+        for (UINT uRing = 0u; uRing < uNumRings; ++uRing)
+        {
+            for (UINT uSide = 0u; uSide < uNumSides; ++uSide)
+            {
+                const UINT a = uRing * (uNumSides + 1u) + uSide;
+                const UINT b = a + uNumSides + 1u;
+                const UINT c = b + 1u;
+                const UINT d = a + 1u;
+
+                outIndices.insert(outIndices.end(), { a, d, b, b, d, c });
+            }
+        }
+    }
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetContentPath
+
+      Summary:  Returns the path of a file in the content directory of
+                the Game project. The post-build step and the debugger
+                both run the tests from the project directory.
+
+      Args:     PCWSTR pszRelativePath
+                  Path of the file relative to the content directory
+
+      Returns:  std::filesystem::path
+                  Path of the file
+    -----------------------------------------------------------------F-F*/
+    std::filesystem::path GetContentPath(
+        _In_ PCWSTR pszRelativePath
+    )
+    {
+        return std::filesystem::path(L"../Game/Content") / pszRelativePath;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CreateModelInstances
+
+      Summary:  Creates and initializes instances of a model file of
+                the content directory. The first instance loads the
+                asset, the others share it.
+
+      Args:     ID3D11Device* pDevice
+                  The Direct3D device to create the buffers
+                ID3D11DeviceContext* pImmediateContext
+                  The Direct3D context to upload the buffers
+                PCWSTR pszRelativePath
+                  Path of the model file relative to the content
+                  directory
+                UINT uNumInstances
+                  Number of instances
+                library::eSkinningMode skinningMode
+                  How the bones of a vertex are blended
+                std::vector<std::unique_ptr<library::Model>>& outModels
+                  The initialized instances
+
+      Returns:  HRESULT
+                  Status code
+    -----------------------------------------------------------------F-F*/
+    HRESULT CreateModelInstances(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ PCWSTR pszRelativePath,
+        _In_ UINT uNumInstances,
+        _In_ library::eSkinningMode skinningMode,
+        _Out_ std::vector<std::unique_ptr<library::Model>>& outModels
+    )
+    {
+        const std::filesystem::path filePath = GetContentPath(pszRelativePath);
+
+        outModels.clear();
+        outModels.reserve(uNumInstances);
+        for (UINT i = 0u; i < uNumInstances; ++i)
+        {
+            outModels.push_back(std::make_unique<library::Model>(filePath, skinningMode));
+
+            HRESULT hr = outModels.back()->Initialize(pDevice, pImmediateContext);
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        return S_OK;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CreateSkinnedScene
+
+      Summary:  Builds in memory the scene an importer would return
+                for a small rigged character: a root node that turns
+                the z up skeleton to y up, a spine and two legs with a
+                static bone in each, and a looping clip whose
+                rotation, position and scaling keys are not aligned.
+                The mesh is a grid standing in the xy plane, every row
+                weighted to the two bones nearest to its height.
+
+      Args:     UINT uNumColumns
+                  Number of cells of the grid along x
+                UINT uNumRows
+                  Number of cells of the grid along y
+
+      Returns:  std::unique_ptr<aiScene>
+                  The created scene
+    -----------------------------------------------------------------F-F*/
+    std::unique_ptr<aiScene> CreateSkinnedScene(
+        _In_ UINT uNumColumns,
+        _In_ UINT uNumRows
+    )
+    {
+        std::unique_ptr<aiScene> pScene = std::make_unique<aiScene>();
+
+        // Hierarchy in the bind pose, with the global transforms the bone offsets invert
+        aiNode* apNodes[NUM_SKINNED_SCENE_NODES];
+        XMMATRIX aBindTransforms[NUM_SKINNED_SCENE_NODES];
+        for (UINT i = 0u; i < NUM_SKINNED_SCENE_NODES; ++i)
+        {
+            const SkinnedSceneNode& node = SKINNED_SCENE_NODES[i];
+            const XMMATRIX localTransform = XMMatrixRotationAxis(XMLoadFloat3(&node.Axis), node.Angle) * XMMatrixTranslationFromVector(XMLoadFloat3(&node.Translation));
+
+            apNodes[i] = new aiNode(node.pszName);
+            apNodes[i]->mTransformation = ConvertToAiMatrix(localTransform);
+
+            if (node.iParent >= 0)
+            {
+                apNodes[node.iParent]->addChildren(1u, &apNodes[i]);
+                aBindTransforms[i] = localTransform * aBindTransforms[node.iParent];
+            }
+            else
+            {
+                aBindTransforms[i] = localTransform;
+            }
+        }
+        pScene->mRootNode = apNodes[0];
+        pScene->mRootNode->mNumMeshes = 1u;
+        pScene->mRootNode->mMeshes = new UINT[1]{ 0u };
+
+        // Grid of the mesh
+        const UINT uNumVertexColumns = uNumColumns + 1u;
+        const UINT uNumVertices = uNumVertexColumns * (uNumRows + 1u);
+
+        aiMesh* pMesh = new aiMesh();
+        pMesh->mName = aiString(std::string("Grid"));
+        pMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        pMesh->mMaterialIndex = 0u;
+        pMesh->mNumVertices = uNumVertices;
+        pMesh->mVertices = new aiVector3D[uNumVertices];
+        pMesh->mNormals = new aiVector3D[uNumVertices];
+        pMesh->mTextureCoords[0] = new aiVector3D[uNumVertices];
+        pMesh->mNumUVComponents[0] = 2u;
+
+        std::vector<std::vector<aiVertexWeight>> aBoneWeights(NUM_SKINNED_SCENE_BONES);
+        for (UINT uRow = 0u; uRow <= uNumRows; ++uRow)
+        {
+            const FLOAT v = static_cast<FLOAT>(uRow) / static_cast<FLOAT>(uNumRows);
+
+            // Bones follow the nodes, without the root
+            const FLOAT bone = v * static_cast<FLOAT>(NUM_SKINNED_SCENE_BONES - 1u);
+            const UINT uBone = static_cast<UINT>(fminf(bone, static_cast<FLOAT>(NUM_SKINNED_SCENE_BONES - 2u)));
+            const FLOAT weight = bone - static_cast<FLOAT>(uBone);
+
+            for (UINT uColumn = 0u; uColumn <= uNumColumns; ++uColumn)
+            {
+                const FLOAT u = static_cast<FLOAT>(uColumn) / static_cast<FLOAT>(uNumColumns);
+                const UINT uVertex = uRow * uNumVertexColumns + uColumn;
+
+                pMesh->mVertices[uVertex] = aiVector3D(u - 0.5f, 2.0f * v, 0.0f);
+                pMesh->mNormals[uVertex] = aiVector3D(0.0f, 0.0f, -1.0f);
+                pMesh->mTextureCoords[0][uVertex] = aiVector3D(u, 1.0f - v, 0.0f);
+
+                if (weight < 1.0f)
+                {
+                    aBoneWeights[uBone].push_back(aiVertexWeight(uVertex, 1.0f - weight));
+                }
+                if (weight > 0.0f)
+                {
+                    aBoneWeights[uBone + 1u].push_back(aiVertexWeight(uVertex, weight));
+                }
+            }
+        }
+
+        pMesh->mNumFaces = 2u * uNumColumns * uNumRows;
+        pMesh->mFaces = new aiFace[pMesh->mNumFaces];
+        for (UINT uRow = 0u; uRow < uNumRows; ++uRow)
+        {
+            for (UINT uColumn = 0u; uColumn < uNumColumns; ++uColumn)
+            {
+                const UINT uVertex = uRow * uNumVertexColumns + uColumn;
+                const UINT aCorners[2][3] =
+                {
+                    { uVertex, uVertex + uNumVertexColumns, uVertex + 1u },
+                    { uVertex + 1u, uVertex + uNumVertexColumns, uVertex + uNumVertexColumns + 1u },
+                };
+
+                for (UINT uTriangle = 0u; uTriangle < 2u; ++uTriangle)
+                {
+                    aiFace& face = pMesh->mFaces[2u * (uRow * uNumColumns + uColumn) + uTriangle];
+                    face.mNumIndices = 3u;
+                    face.mIndices = new UINT[3];
+                    std::copy(aCorners[uTriangle], aCorners[uTriangle] + 3, face.mIndices);
+                }
+            }
+        }
+
+        pMesh->mNumBones = NUM_SKINNED_SCENE_BONES;
+        pMesh->mBones = new aiBone*[NUM_SKINNED_SCENE_BONES];
+        for (UINT i = 0u; i < NUM_SKINNED_SCENE_BONES; ++i)
+        {
+            const UINT uNode = i + 1u;
+            XMVECTOR det = XMMatrixDeterminant(aBindTransforms[uNode]);
+
+            aiBone* pBone = new aiBone();
+            pBone->mName = aiString(std::string(SKINNED_SCENE_NODES[uNode].pszName));
+            pBone->mOffsetMatrix = ConvertToAiMatrix(XMMatrixInverse(&det, aBindTransforms[uNode]));
+            pBone->mNumWeights = static_cast<UINT>(aBoneWeights[i].size());
+            pBone->mWeights = new aiVertexWeight[pBone->mNumWeights];
+            std::copy(aBoneWeights[i].begin(), aBoneWeights[i].end(), pBone->mWeights);
+            pMesh->mBones[i] = pBone;
+        }
+
+        pScene->mNumMeshes = 1u;
+        pScene->mMeshes = new aiMesh*[1]{ pMesh };
+        pScene->mNumMaterials = 1u;
+        pScene->mMaterials = new aiMaterial*[1]{ new aiMaterial() };
+
+        // Clip swaying every animated node around its bind pose, rotation keys every few ticks, the others apart
+        aiAnimation* pAnimation = new aiAnimation();
+        pAnimation->mName = aiString(std::string("Sway"));
+        pAnimation->mDuration = SKINNED_SCENE_DURATION_TICKS;
+        pAnimation->mTicksPerSecond = SKINNED_SCENE_TICKS_PER_SECOND;
+
+        std::vector<aiNodeAnim*> apChannels;
+        for (UINT i = 0u; i < NUM_SKINNED_SCENE_NODES; ++i)
+        {
+            const SkinnedSceneNode& node = SKINNED_SCENE_NODES[i];
+            if (!node.bAnimated)
+            {
+                continue;
+            }
+
+            const FLOAT phase = static_cast<FLOAT>(i);
+            const XMVECTOR bindRotation = XMQuaternionRotationAxis(XMLoadFloat3(&node.Axis), node.Angle);
+            const XMVECTOR swayAxis = i % 3u == 0u ? g_XMIdentityR0 : (i % 3u == 1u ? g_XMIdentityR1 : g_XMIdentityR2);
+
+            aiNodeAnim* pChannel = new aiNodeAnim();
+            pChannel->mNodeName = aiString(std::string(node.pszName));
+
+            pChannel->mNumRotationKeys = static_cast<UINT>(SKINNED_SCENE_DURATION_TICKS) / SKINNED_SCENE_ROTATION_KEY_TICKS + 1u;
+            pChannel->mRotationKeys = new aiQuatKey[pChannel->mNumRotationKeys];
+            for (UINT uKey = 0u; uKey < pChannel->mNumRotationKeys; ++uKey)
+            {
+                const FLOAT ticks = static_cast<FLOAT>(uKey * SKINNED_SCENE_ROTATION_KEY_TICKS);
+                const FLOAT sway = 0.25f * sinf(XM_2PI * ticks / SKINNED_SCENE_DURATION_TICKS + phase);
+
+                XMFLOAT4 rotation;
+                XMStoreFloat4(&rotation, XMQuaternionMultiply(XMQuaternionRotationAxis(swayAxis, sway), bindRotation));
+                pChannel->mRotationKeys[uKey] = aiQuatKey(ticks, aiQuaternion(rotation.w, rotation.x, rotation.y, rotation.z));
+            }
+
+            pChannel->mNumPositionKeys = static_cast<UINT>(ARRAYSIZE(SKINNED_SCENE_POSITION_KEY_TICKS));
+            pChannel->mPositionKeys = new aiVectorKey[pChannel->mNumPositionKeys];
+            for (UINT uKey = 0u; uKey < pChannel->mNumPositionKeys; ++uKey)
+            {
+                const FLOAT ticks = SKINNED_SCENE_POSITION_KEY_TICKS[uKey];
+
+                pChannel->mPositionKeys[uKey] = aiVectorKey(
+                    ticks,
+                    aiVector3D(
+                        node.Translation.x + 0.05f * sinf(0.13f * ticks + phase),
+                        node.Translation.y + 0.05f * cosf(0.11f * ticks + phase),
+                        node.Translation.z + 0.05f * sinf(0.07f * ticks + phase)
+                    )
+                );
+            }
+
+            // The clip loops, the last key goes back to the first
+            pChannel->mPositionKeys[pChannel->mNumPositionKeys - 1u].mValue = pChannel->mPositionKeys[0].mValue;
+
+            // Only the spine stretches, the other nodes hold a single key
+            if (i == 2u)
+            {
+                pChannel->mNumScalingKeys = static_cast<UINT>(ARRAYSIZE(SKINNED_SCENE_SCALING_KEY_TICKS));
+                pChannel->mScalingKeys = new aiVectorKey[pChannel->mNumScalingKeys];
+                for (UINT uKey = 0u; uKey < pChannel->mNumScalingKeys; ++uKey)
+                {
+                    const FLOAT stretch = uKey == 1u ? 0.2f : 0.0f;
+                    pChannel->mScalingKeys[uKey] = aiVectorKey(SKINNED_SCENE_SCALING_KEY_TICKS[uKey], aiVector3D(1.0f, 1.0f - 0.5f * stretch, 1.0f + stretch));
+                }
+            }
+            else
+            {
+                pChannel->mNumScalingKeys = 1u;
+                pChannel->mScalingKeys = new aiVectorKey[1]{ aiVectorKey(0.0, aiVector3D(1.0f, 1.0f, 1.0f)) };
+            }
+
+            apChannels.push_back(pChannel);
+        }
+
+        pAnimation->mNumChannels = static_cast<UINT>(apChannels.size());
+        pAnimation->mChannels = new aiNodeAnim*[pAnimation->mNumChannels];
+        std::copy(apChannels.begin(), apChannels.end(), pAnimation->mChannels);
+
+        pScene->mNumAnimations = 1u;
+        pScene->mAnimations = new aiAnimation*[1]{ pAnimation };
+
+        return pScene;
+    }
+}
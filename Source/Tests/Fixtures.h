@@ -0,0 +1,80 @@
+/*+===================================================================
+  File:      FIXTURES.H
+
+  Summary:   Fixtures header file contains declarations of the helpers
+             that create the device and the data the tests run on.
+
+  Classes:   TestModel
+
+  Functions: CreateTestDevice, CreateSkyCubeMap, CreateTorusMesh,
+             GetContentPath, CreateModelInstances,
+             CreateSkinnedScene
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include "Model/Model.h"
+#include "Renderer/DataTypes.h"
+#include "Texture/CubeMapData.h"
+
+struct aiScene;
+
+namespace tests
+{
+    /*C+C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C+++C
+      Class:    TestModel
+
+      Summary:  Model built from a scene created in memory or loaded
+                from a model file, which opens the internals of the
+                model to the tests
+
+      Methods:  InitializeFromScene
+                  Builds the asset of the model from an Assimp scene
+                GetAsset
+                  Returns the asset of the model
+    C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C---C-C*/
+    class TestModel : public library::Model
+    {
+    public:
+        TestModel(_In_opt_ library::eSkinningMode skinningMode = library::eSkinningMode::LINEAR_BLEND);
+        TestModel(_In_ const std::filesystem::path& filePath, _In_opt_ library::eSkinningMode skinningMode = library::eSkinningMode::LINEAR_BLEND);
+        TestModel(const TestModel& other) = delete;
+        TestModel(TestModel&& other) = delete;
+        TestModel& operator=(const TestModel& other) = delete;
+        TestModel& operator=(TestModel&& other) = delete;
+        virtual ~TestModel() = default;
+
+        HRESULT InitializeFromScene(_In_ ID3D11Device* pDevice, _In_ ID3D11DeviceContext* pImmediateContext, _In_ const aiScene* pScene);
+        const library::ModelAsset& GetAsset() const;
+
+        using library::Model::appendIndex;
+        using library::Model::bakeAnimation;
+        using library::Model::countVerticesAndIndices;
+        using library::Model::createAsset;
+        using library::Model::evaluateGlobalTransforms;
+        using library::Model::evaluatePose;
+        using library::Model::loadDualQuaternion;
+        using library::Model::readIndex;
+        using library::Model::storeDualQuaternion;
+        using library::Model::writeIndex;
+        using library::Model::m_aMeshes;
+        using library::Model::m_asset;
+    };
+
+    HRESULT CreateTestDevice(_Out_ ComPtr<ID3D11Device>& outDevice, _Out_ ComPtr<ID3D11DeviceContext>& outImmediateContext);
+    void CreateSkyCubeMap(_In_ UINT uSize, _In_ FLOAT sunIntensity, _Out_ library::CubeMapData& outCubeMap);
+    void CreateTorusMesh(_In_ UINT uNumRings, _In_ UINT uNumSides, _Out_ std::vector<library::SimpleVertex>& outVertices, _Out_ std::vector<UINT>& outIndices);
+    std::filesystem::path GetContentPath(_In_ PCWSTR pszRelativePath);
+    HRESULT CreateModelInstances(
+        _In_ ID3D11Device* pDevice,
+        _In_ ID3D11DeviceContext* pImmediateContext,
+        _In_ PCWSTR pszRelativePath,
+        _In_ UINT uNumInstances,
+        _In_ library::eSkinningMode skinningMode,
+        _Out_ std::vector<std::unique_ptr<library::Model>>& outModels
+    );
+    std::unique_ptr<aiScene> CreateSkinnedScene(_In_ UINT uNumColumns, _In_ UINT uNumRows);
+}
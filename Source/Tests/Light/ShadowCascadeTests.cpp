@@ -0,0 +1,70 @@
+#include "Tests.h"
+
+#include "Light/ShadowCascade.h"
+#include "Renderer/DataTypes.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestCascadeStability
+
+      Summary:  Moves and turns the camera in steps smaller than a
+                shadow texel and fits the cascades again after every
+                step. The texel size of a cascade has to stay the same
+                and its light space origin may only move by whole
+                texels, otherwise the shadow edges shimmer.
+
+      Returns:  BOOL
+                  Whether every cascade stayed on its texel grid
+    -----------------------------------------------------------------F-F*/
+    BOOL TestCascadeStability()
+    {
+        constexpr const UINT RESOLUTION = 2048u;
+        constexpr const UINT NUM_STEPS = 256u;
+        // Rounding of the light space positions, in texels
+        constexpr const FLOAT TEXEL_TOLERANCE = 0.01f;
+
+        const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 1000.0f);
+        const XMVECTOR lightDirection = XMVector3Normalize(XMVectorSet(-0.4f, -1.0f, 0.3f, 0.0f));
+        const XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+
+        FLOAT aSplits[NUM_CASCADES + 1];
+        library::ComputeCascadeSplits(projection, 0.75f, 100.0f, NUM_CASCADES, aSplits);
+
+        for (UINT i = 0u; i < NUM_CASCADES; ++i)
+        {
+            const XMVECTOR eye = XMVectorSet(2.0f, 3.0f, -4.0f, 1.0f);
+            const XMVECTOR forward = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+
+            library::ShadowCascade reference;
+            library::FitShadowCascade(XMMatrixLookToLH(eye, forward, up), projection, aSplits[i], aSplits[i + 1], lightDirection, RESOLUTION, reference);
+
+            const FLOAT size = reference.BoundsMax.x - reference.BoundsMin.x;
+            const FLOAT texelSize = size / static_cast<FLOAT>(RESOLUTION);
+
+            for (UINT uStep = 1u; uStep <= NUM_STEPS; ++uStep)
+            {
+                const FLOAT step = static_cast<FLOAT>(uStep);
+
+                // Irrational fractions of a texel so that the moves do not add up to whole texels
+                const XMVECTOR movedEye = XMVectorAdd(eye, XMVectorScale(XMVectorSet(0.381966f, 0.236068f, 0.145898f, 0.0f), step * texelSize));
+                const XMMATRIX rotation = XMMatrixRotationRollPitchYaw(step * 0.0007f, step * 0.0013f, 0.0f);
+                const XMVECTOR movedForward = XMVector3TransformNormal(forward, rotation);
+
+                library::ShadowCascade cascade;
+                library::FitShadowCascade(XMMatrixLookToLH(movedEye, movedForward, up), projection, aSplits[i], aSplits[i + 1], lightDirection, RESOLUTION, cascade);
+
+                TEST_CHECK(fabsf(cascade.BoundsMax.x - cascade.BoundsMin.x - size) < TEXEL_TOLERANCE * texelSize);
+                TEST_CHECK(fabsf(cascade.BoundsMax.y - cascade.BoundsMin.y - size) < TEXEL_TOLERANCE * texelSize);
+
+                const FLOAT texelsX = (cascade.BoundsMin.x - reference.BoundsMin.x) / texelSize;
+                const FLOAT texelsY = (cascade.BoundsMin.y - reference.BoundsMin.y) / texelSize;
+
+                TEST_CHECK(fabsf(texelsX - roundf(texelsX)) < TEXEL_TOLERANCE);
+                TEST_CHECK(fabsf(texelsY - roundf(texelsY)) < TEXEL_TOLERANCE);
+            }
+        }
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,90 @@
+#include "Tests.h"
+
+#include "Fixtures.h"
+#include "Light/SphericalHarmonics.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: MeasureIrradianceError
+
+      Summary:  Compares the projected irradiance of a cube map with
+                brute force integration towards the axes, the corners
+                of the cube and the sun
+
+      Args:     const library::CubeMapData& cubeMap
+                  Cube map to project
+
+      Returns:  FLOAT
+                  Largest error relative to the integrated irradiance
+    -----------------------------------------------------------------F-F*/
+    static FLOAT MeasureIrradianceError(
+        _In_ const library::CubeMapData& cubeMap
+    )
+    {
+        const FLOAT corner = 1.0f / sqrtf(3.0f);
+        XMFLOAT3 aNormals[] =
+        {
+            XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(-1.0f, 0.0f, 0.0f),
+            XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT3(0.0f, -1.0f, 0.0f),
+            XMFLOAT3(0.0f, 0.0f, 1.0f), XMFLOAT3(0.0f, 0.0f, -1.0f),
+            XMFLOAT3(corner, corner, corner), XMFLOAT3(-corner, corner, corner),
+            XMFLOAT3(corner, -corner, corner), XMFLOAT3(-corner, -corner, corner),
+            XMFLOAT3(corner, corner, -corner), XMFLOAT3(-corner, corner, -corner),
+            XMFLOAT3(corner, -corner, -corner), XMFLOAT3(-corner, -corner, -corner),
+            XMFLOAT3(0.3f, 0.8f, 0.5f),
+        };
+        XMStoreFloat3(&aNormals[ARRAYSIZE(aNormals) - 1], XMVector3Normalize(XMLoadFloat3(&aNormals[ARRAYSIZE(aNormals) - 1])));
+
+        XMFLOAT4 aCoefficients[NUM_SH_COEFFICIENTS];
+        library::ProjectIrradianceSH9(cubeMap, aCoefficients);
+
+        XMFLOAT3 aReference[ARRAYSIZE(aNormals)];
+        library::IntegrateIrradiance(cubeMap, aNormals, ARRAYSIZE(aNormals), aReference);
+
+        FLOAT maxError = 0.0f;
+        for (UINT i = 0u; i < ARRAYSIZE(aNormals); ++i)
+        {
+            const XMVECTOR reference = XMLoadFloat3(&aReference[i]);
+            const XMVECTOR projected = library::EvaluateIrradianceSH9(aCoefficients, XMLoadFloat3(&aNormals[i]));
+            const FLOAT error = XMVectorGetX(XMVector3Length(XMVectorSubtract(projected, reference)))
+                / fmaxf(XMVectorGetX(XMVector3Length(reference)), 1e-4f);
+            maxError = fmaxf(maxError, error);
+        }
+
+        return maxError;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestIrradianceSH9
+
+      Summary:  Projects two sky cube maps and compares them with brute
+                force integration. The irradiance of the linear sky is
+                exactly represented, so only the discretization error
+                is allowed. The sun lobe has higher frequencies that
+                the nine coefficients cut off, which stays within the
+                error bound of order 2 irradiance.
+
+      Returns:  BOOL
+                  Whether both projections are within their bounds
+    -----------------------------------------------------------------F-F*/
+    BOOL TestIrradianceSH9()
+    {
+        constexpr const UINT CUBE_MAP_SIZE = 32u;
+
+        library::CubeMapData linearSky;
+        CreateSkyCubeMap(CUBE_MAP_SIZE, 0.0f, linearSky);
+        const FLOAT linearError = MeasureIrradianceError(linearSky);
+
+        library::CubeMapData sunSky;
+        CreateSkyCubeMap(CUBE_MAP_SIZE, 4.0f, sunSky);
+        const FLOAT sunError = MeasureIrradianceError(sunSky);
+
+        wprintf(L"  largest error %.3f%% without the sun, %.2f%% with the sun\n", linearError * 100.0f, sunError * 100.0f);
+
+        TEST_CHECK(linearError < 0.005f);
+        TEST_CHECK(sunError < 0.08f);
+
+        return TRUE;
+    }
+}
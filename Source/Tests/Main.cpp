@@ -0,0 +1,89 @@
+/*+===================================================================
+  File:      MAIN.CPP
+
+  Summary:   This application runs the checks of the Library project
+             on fixture data and returns the number of failed checks,
+             so the build fails when one of them does not hold.
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+
+#include "Tests.h"
+
+/*S+S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S+++S
+  Struct:   TestEntry
+
+  Summary:  Name of a test and the function that runs it
+S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S---S-S*/
+struct TestEntry
+{
+    PCWSTR pszName;
+    BOOL (*pfnTest)();
+};
+
+/*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+  Function: wmain
+
+  Summary:  Entry point to the program. Runs every test and prints
+            whether it passed. COM is initialized first, the model
+            tests load their textures through WIC.
+
+  Returns:  INT
+              Number of failed tests.
+-----------------------------------------------------------------F-F*/
+INT wmain()
+{
+    if (FAILED(CoInitializeEx(nullptr, COINIT_MULTITHREADED)))
+    {
+        wprintf(L"COM could not be initialized\n");
+        return 1;
+    }
+
+    const std::vector<TestEntry> aTests =
+    {
+        { L"CascadeStability", tests::TestCascadeStability },
+        { L"HorizonMapUpdate", tests::TestHorizonMapUpdate },
+        { L"IrradianceSH9", tests::TestIrradianceSH9 },
+        { L"PrefilterEnergy", tests::TestPrefilterEnergy },
+        { L"CpuSkinning", tests::TestCpuSkinning },
+        { L"BoneWeightPacking", tests::TestBoneWeightPacking },
+        { L"AnimationLodSelection", tests::TestAnimationLodSelection },
+        { L"ModelCacheRoundTrip", tests::TestModelCacheRoundTrip },
+        { L"MeshOptimizer", tests::TestMeshOptimizer },
+        { L"VertexPacking", tests::TestVertexPacking },
+        { L"MeshSimplifier", tests::TestMeshSimplifier },
+        { L"MeshletCones", tests::TestMeshletCones },
+        { L"TangentGeneration", tests::TestTangentGeneration },
+        { L"ModelUpdate", tests::TestModelUpdate },
+        { L"SkeletonEvaluation", tests::TestSkeletonEvaluation },
+        { L"ParallelModelUpdate", tests::TestParallelModelUpdate },
+        { L"BakedAnimation", tests::TestBakedAnimation },
+        { L"DualQuaternionSkinning", tests::TestDualQuaternionSkinning },
+        { L"AnimationLodCrowd", tests::TestAnimationLodCrowd },
+        { L"ConcurrentModelLoad", tests::TestConcurrentModelLoad },
+        { L"LargeIndexBuffer", tests::TestLargeIndexBuffer },
+        { L"ModelMeshlets", tests::TestModelMeshlets },
+    };
+
+    INT iNumFailed = 0;
+    for (const TestEntry& test : aTests)
+    {
+        wprintf(L"%s\n", test.pszName);
+
+        if (test.pfnTest())
+        {
+            wprintf(L"  passed\n");
+        }
+        else
+        {
+            wprintf(L"  FAILED\n");
+            ++iNumFailed;
+        }
+    }
+
+    wprintf(L"%d of %u tests failed\n", iNumFailed, static_cast<UINT>(aTests.size()));
+
+    CoUninitialize();
+
+    return iNumFailed;
+}
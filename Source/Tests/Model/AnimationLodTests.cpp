@@ -0,0 +1,75 @@
+#include "Tests.h"
+
+#include "Model/AnimationLod.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestAnimationLodSelection
+
+      Summary:  Selects the level of spheres in front of, around and
+                behind a camera. A sphere may only lose detail as it
+                moves away, spheres behind the camera are frozen and
+                the camera inside a sphere keeps it at full rate.
+                Benchmarks the selection of a field of spheres around
+                the camera.
+
+      Returns:  BOOL
+                  Whether every sphere got the expected level
+    -----------------------------------------------------------------F-F*/
+    BOOL TestAnimationLodSelection()
+    {
+        constexpr const UINT NUM_STEPS = 1000u;
+        constexpr const UINT NUM_RINGS = 100u;
+        constexpr const UINT NUM_SPHERES_PER_RING = 100u;
+        constexpr const UINT NUM_ITERATIONS = 100u;
+
+        library::AnimationLodSelector selector;
+        TEST_CHECK(selector.Select(BoundingSphere(XMFLOAT3(0.0f, 0.0f, 1000.0f), 1.0f)).Level == library::eAnimationLod::FULL);
+
+        const XMVECTOR eye = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+        const XMMATRIX view = XMMatrixLookToLH(eye, XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 1000.0f);
+        selector.SetViewpoint(eye, view, projection);
+
+        TEST_CHECK(selector.Select(BoundingSphere(XMFLOAT3(0.0f, 0.0f, 0.5f), 1.0f)).Level == library::eAnimationLod::FULL);
+        TEST_CHECK(selector.Select(BoundingSphere(XMFLOAT3(0.0f, 0.0f, 2.0f), 1.0f)).Level == library::eAnimationLod::FULL);
+        TEST_CHECK(selector.Select(BoundingSphere(XMFLOAT3(0.0f, 0.0f, 500.0f), 1.0f)).Level == library::eAnimationLod::QUARTER_RATE_NO_LEAVES);
+        TEST_CHECK(selector.Select(BoundingSphere(XMFLOAT3(0.0f, 0.0f, -10.0f), 1.0f)).Level == library::eAnimationLod::FROZEN);
+
+        library::eAnimationLod previousLevel = library::eAnimationLod::FULL;
+        for (UINT uStep = 0u; uStep < NUM_STEPS; ++uStep)
+        {
+            const BoundingSphere boundingSphere(XMFLOAT3(0.3f, -0.2f, 2.0f + static_cast<FLOAT>(uStep) * 0.5f), 1.0f);
+            const library::AnimationLod& lod = selector.Select(boundingSphere);
+
+            TEST_CHECK(lod.Level >= previousLevel);
+            TEST_CHECK(lod.Level != library::eAnimationLod::FROZEN);
+            TEST_CHECK(&lod == &library::AnimationLodSelector::GetLod(lod.Level));
+            previousLevel = lod.Level;
+        }
+        TEST_CHECK(previousLevel == library::eAnimationLod::QUARTER_RATE_NO_LEAVES);
+
+        // Reduced rates have to step at least every few frames, only frozen models never step
+        for (UINT uLevel = 0u; uLevel < static_cast<UINT>(library::eAnimationLod::FROZEN); ++uLevel)
+        {
+            TEST_CHECK(library::AnimationLodSelector::GetLod(static_cast<library::eAnimationLod>(uLevel)).uUpdateInterval > 0u);
+        }
+        TEST_CHECK(library::AnimationLodSelector::GetLod(library::eAnimationLod::FROZEN).uUpdateInterval == 0u);
+
+        std::vector<BoundingSphere> aBoundingSpheres;
+        aBoundingSpheres.reserve(static_cast<size_t>(NUM_RINGS) * NUM_SPHERES_PER_RING);
+        for (UINT uRing = 0u; uRing < NUM_RINGS; ++uRing)
+        {
+            const FLOAT radius = 2.0f + static_cast<FLOAT>(uRing) * 2.0f;
+            for (UINT i = 0u; i < NUM_SPHERES_PER_RING; ++i)
+            {
+                const FLOAT angle = XM_2PI * static_cast<FLOAT>(i) / static_cast<FLOAT>(NUM_SPHERES_PER_RING);
+                aBoundingSpheres.push_back(BoundingSphere(XMFLOAT3(radius * cosf(angle), 0.0f, radius * sinf(angle)), 1.0f));
+            }
+        }
+        selector.Benchmark(aBoundingSpheres, NUM_ITERATIONS);
+
+        return TRUE;
+    }
+}
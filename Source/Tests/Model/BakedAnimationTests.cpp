@@ -0,0 +1,151 @@
+#include "Tests.h"
+
+#include "Fixtures.h"
+
+#include "assimp/scene.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetPaletteError
+
+      Summary:  Measures the largest difference between the bones of a
+                palette and the matching transposed bone transforms,
+                relative to the size of the expected values
+
+      Args:     const XMMATRIX* aBoneTransforms
+                  Transposed bone transforms to check
+                const XMFLOAT3X4A* aReferenceTransforms
+                  Expected bone transforms, as evaluatePose writes them
+                UINT uNumBones
+                  Number of bones
+
+      Returns:  FLOAT
+                  Largest relative error
+    -----------------------------------------------------------------F-F*/
+    static FLOAT GetPaletteError(
+        _In_ const XMMATRIX* aBoneTransforms,
+        _In_ const XMFLOAT3X4A* aReferenceTransforms,
+        _In_ UINT uNumBones
+    )
+    {
+        FLOAT maxError = 0.0f;
+        for (UINT uBone = 0u; uBone < uNumBones; ++uBone)
+        {
+            const XMMATRIX reference = XMMatrixTranspose(XMLoadFloat3x4A(&aReferenceTransforms[uBone]));
+            for (UINT uRow = 0u; uRow < 4u; ++uRow)
+            {
+                XMFLOAT4 error;
+                XMStoreFloat4(
+                    &error,
+                    XMVectorDivide(
+                        XMVectorAbs(XMVectorSubtract(aBoneTransforms[uBone].r[uRow], reference.r[uRow])),
+                        XMVectorAdd(g_XMOne, XMVectorAbs(reference.r[uRow]))
+                    )
+                );
+                maxError = fmaxf(maxError, fmaxf(fmaxf(error.x, error.y), fmaxf(error.z, error.w)));
+            }
+        }
+
+        return maxError;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestBakedAnimation
+
+      Summary:  Bakes the clip of a small synthetic character at the
+                frame rate of the crowds. Every baked frame has to hold
+                the pose evaluatePose computes at its time. Between
+                frames, the palettes are blended the way the crowd
+                vertex shader does, for instances whose time is
+                shifted by the offset the game gives them, and have to
+                stay close to the pose evaluated at the same time.
+
+      Returns:  BOOL
+                  Whether the baked palettes matched the evaluated poses
+    -----------------------------------------------------------------F-F*/
+    BOOL TestBakedAnimation()
+    {
+        // Rate of the crowds, with the offsets the game gives its instances
+        constexpr const FLOAT FRAME_RATE = 30.0f;
+        constexpr const UINT NUM_INSTANCES = 64u;
+        constexpr const FLOAT INSTANCE_TIME_OFFSET = 0.37f;
+        constexpr const FLOAT ANIMATION_TIME = 1.234f;
+        constexpr const FLOAT FRAME_TOLERANCE = 1e-6f;
+        constexpr const FLOAT BLEND_TOLERANCE = 2e-3f;
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        std::unique_ptr<aiScene> pScene = CreateSkinnedScene(4u, 16u);
+
+        TestModel model;
+        TEST_CHECK(SUCCEEDED(model.InitializeFromScene(device.Get(), immediateContext.Get(), pScene.get())));
+        TEST_CHECK(SUCCEEDED(model.bakeAnimation(device.Get(), FRAME_RATE)));
+
+        const library::ModelAsset& asset = model.GetAsset();
+        TEST_CHECK(asset.pBakedAnimation);
+
+        const library::BakedAnimation& bakedAnimation = *asset.pBakedAnimation;
+        const library::BakedClip& clip = bakedAnimation.GetClip(0u);
+        const UINT uNumBones = bakedAnimation.GetNumBones();
+        TEST_CHECK(uNumBones == static_cast<UINT>(asset.boneNameToIndexMap.size()));
+        TEST_CHECK(clip.uNumFrames == static_cast<UINT>(ceilf(asset.DurationTicks / asset.TicksPerSecond * FRAME_RATE)));
+
+        std::vector<XMMATRIX> aGlobalTransforms(asset.aSkeleton.size());
+        std::vector<XMFLOAT3X4A> aReferenceTransforms(uNumBones);
+        std::vector<XMMATRIX> aBoneTransforms(uNumBones);
+
+        // Every frame holds the pose at its own time
+        FLOAT maxFrameError = 0.0f;
+        for (UINT uFrame = 0u; uFrame < clip.uNumFrames; ++uFrame)
+        {
+            const FLOAT animationTimeTicks = fminf(static_cast<FLOAT>(uFrame) / FRAME_RATE * asset.TicksPerSecond, asset.DurationTicks);
+            model.evaluatePose(animationTimeTicks, FALSE, aGlobalTransforms, aReferenceTransforms.data());
+
+            for (UINT uBone = 0u; uBone < uNumBones; ++uBone)
+            {
+                aBoneTransforms[uBone] = bakedAnimation.GetBoneTransform(0u, uFrame, uBone);
+            }
+            maxFrameError = fmaxf(maxFrameError, GetPaletteError(aBoneTransforms.data(), aReferenceTransforms.data(), uNumBones));
+        }
+        TEST_CHECK(maxFrameError <= FRAME_TOLERANCE);
+
+        // Instances between two frames blend them, the last frame blends into the first as the clip loops
+        FLOAT maxBlendError = 0.0f;
+        for (UINT uInstance = 0u; uInstance < NUM_INSTANCES; ++uInstance)
+        {
+            const FLOAT time = ANIMATION_TIME + INSTANCE_TIME_OFFSET * static_cast<FLOAT>(uInstance);
+            const FLOAT frame = time * FRAME_RATE;
+            const FLOAT factor = frame - floorf(frame);
+            const UINT uFrame0 = static_cast<UINT>(frame) % clip.uNumFrames;
+            const UINT uFrame1 = (static_cast<UINT>(frame) + 1u) % clip.uNumFrames;
+
+            for (UINT uBone = 0u; uBone < uNumBones; ++uBone)
+            {
+                const XMMATRIX boneTransform0 = bakedAnimation.GetBoneTransform(0u, uFrame0, uBone);
+                const XMMATRIX boneTransform1 = bakedAnimation.GetBoneTransform(0u, uFrame1, uBone);
+                for (UINT uRow = 0u; uRow < 4u; ++uRow)
+                {
+                    aBoneTransforms[uBone].r[uRow] = XMVectorLerp(boneTransform0.r[uRow], boneTransform1.r[uRow], factor);
+                }
+            }
+
+            model.evaluatePose(fmodf(time * asset.TicksPerSecond, asset.DurationTicks), FALSE, aGlobalTransforms, aReferenceTransforms.data());
+            maxBlendError = fmaxf(maxBlendError, GetPaletteError(aBoneTransforms.data(), aReferenceTransforms.data(), uNumBones));
+        }
+
+        wprintf(
+            L"  %u frames of %u bones, largest error %.7f on the frames, %.6f between them\n",
+            clip.uNumFrames,
+            uNumBones,
+            maxFrameError,
+            maxBlendError
+        );
+
+        TEST_CHECK(maxBlendError <= BLEND_TOLERANCE);
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,142 @@
+#include "Tests.h"
+
+#include <algorithm>
+#include <random>
+
+#include "Model/BoneWeightPacker.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CheckPackedBoneData
+
+      Summary:  Packs the influences of a vertex and compares the result
+                with the influences sorted by weight. The packed bones
+                have to be the heaviest ones, their bytes have to sum to
+                255 and every byte has to be within one step of its
+                renormalised weight.
+
+      Args:     const library::VertexBoneData& boneData
+                  Influences of the vertex
+                FLOAT& outQuantizationError
+                  Largest difference between a renormalised weight and
+                  its quantized value
+
+      Returns:  BOOL
+                  Whether the packed influences hold
+    -----------------------------------------------------------------F-F*/
+    static BOOL CheckPackedBoneData(
+        _In_ const library::VertexBoneData& boneData,
+        _Out_ FLOAT& outQuantizationError
+    )
+    {
+        constexpr const UINT NUM_PACKED_INFLUENCES = library::BoneWeightPacker::NUM_PACKED_INFLUENCES;
+
+        FLOAT droppedWeight = 0.0f;
+        const library::AnimationData packed = library::BoneWeightPacker::PackBoneData(boneData, droppedWeight, outQuantizationError);
+
+        UINT aOrder[MAX_NUM_BONES_PER_VERTEX];
+        FLOAT totalWeight = 0.0f;
+        for (UINT i = 0u; i < boneData.uNumBones; ++i)
+        {
+            aOrder[i] = i;
+            totalWeight += boneData.aWeights[i];
+        }
+        std::stable_sort(
+            aOrder,
+            aOrder + boneData.uNumBones,
+            [&boneData](UINT uLeft, UINT uRight) { return boneData.aWeights[uLeft] > boneData.aWeights[uRight]; }
+        );
+
+        const UINT uNumPacked = boneData.uNumBones < NUM_PACKED_INFLUENCES ? boneData.uNumBones : NUM_PACKED_INFLUENCES;
+        FLOAT packedWeight = 0.0f;
+        for (UINT k = 0u; k < uNumPacked; ++k)
+        {
+            packedWeight += boneData.aWeights[aOrder[k]];
+        }
+
+        const UINT aBoneIndices[NUM_PACKED_INFLUENCES] = { packed.aBoneIndices.x, packed.aBoneIndices.y, packed.aBoneIndices.z, packed.aBoneIndices.w };
+        const UINT aWeights[NUM_PACKED_INFLUENCES] = { packed.aBoneWeights.x, packed.aBoneWeights.y, packed.aBoneWeights.z, packed.aBoneWeights.w };
+
+        TEST_CHECK(aWeights[0] + aWeights[1] + aWeights[2] + aWeights[3] == 255u);
+        TEST_CHECK(fabsf(droppedWeight - (totalWeight - packedWeight) / totalWeight) < 1e-5f);
+        TEST_CHECK(outQuantizationError <= 1.0f / 255.0f);
+
+        for (UINT k = 0u; k < NUM_PACKED_INFLUENCES; ++k)
+        {
+            if (k < uNumPacked)
+            {
+                TEST_CHECK(aBoneIndices[k] == boneData.aBoneIds[aOrder[k]]);
+
+                const FLOAT renormalisedWeight = boneData.aWeights[aOrder[k]] / packedWeight;
+                TEST_CHECK(fabsf(static_cast<FLOAT>(aWeights[k]) / 255.0f - renormalisedWeight) <= outQuantizationError + 1e-6f);
+            }
+            else
+            {
+                TEST_CHECK(aWeights[k] == 0u);
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestBoneWeightPacking
+
+      Summary:  Packs a single influence, an even split that does not
+                divide 255 and many vertices with between one and
+                sixteen random influences. Prints the largest
+                quantization error.
+
+      Returns:  BOOL
+                  Whether every packed vertex held
+    -----------------------------------------------------------------F-F*/
+    BOOL TestBoneWeightPacking()
+    {
+        constexpr const UINT NUM_VERTICES = 10000u;
+
+        FLOAT quantizationError = 0.0f;
+        FLOAT maxQuantizationError = 0.0f;
+
+        library::VertexBoneData single;
+        single.aBoneIds[0] = 17u;
+        single.aWeights[0] = 0.5f;
+        single.uNumBones = 1u;
+        TEST_CHECK(CheckPackedBoneData(single, quantizationError));
+        TEST_CHECK(quantizationError == 0.0f);
+
+        // 255 / 4 rounds down on every weight, the three missing steps go to the first three
+        library::VertexBoneData even;
+        for (UINT i = 0u; i < 4u; ++i)
+        {
+            even.aBoneIds[i] = i;
+            even.aWeights[i] = 0.25f;
+        }
+        even.uNumBones = 4u;
+        TEST_CHECK(CheckPackedBoneData(even, quantizationError));
+        maxQuantizationError = fmaxf(maxQuantizationError, quantizationError);
+
+        std::mt19937 generator(39u);
+        std::uniform_int_distribution<UINT> numBones(1u, MAX_NUM_BONES_PER_VERTEX);
+        std::uniform_int_distribution<UINT> boneId(0u, 255u);
+        std::uniform_real_distribution<FLOAT> weight(0.001f, 1.0f);
+
+        for (UINT i = 0u; i < NUM_VERTICES; ++i)
+        {
+            library::VertexBoneData boneData;
+            boneData.uNumBones = numBones(generator);
+            for (UINT k = 0u; k < boneData.uNumBones; ++k)
+            {
+                boneData.aBoneIds[k] = boneId(generator);
+                boneData.aWeights[k] = weight(generator);
+            }
+
+            TEST_CHECK(CheckPackedBoneData(boneData, quantizationError));
+            maxQuantizationError = fmaxf(maxQuantizationError, quantizationError);
+        }
+
+        wprintf(L"  largest quantization error %g, %g of a step\n", maxQuantizationError, maxQuantizationError * 255.0f);
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,143 @@
+#include "Tests.h"
+
+#include <random>
+
+#include "Model/CpuSkinning.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CreateSkinnedVertices
+
+      Summary:  Scatters vertices with unit normals in a box and binds
+                each of them to four random bones with 8 bit weights
+                that sum to one
+
+      Args:     UINT uNumVertices
+                  Number of vertices to create
+                UINT uNumBones
+                  Number of bones the vertices are bound to
+                std::mt19937& generator
+                  Random number generator
+                std::vector<library::SimpleVertex>& outVertices
+                  Created vertices
+                std::vector<library::AnimationData>& outAnimationData
+                  Created bone influences
+    -----------------------------------------------------------------F-F*/
+    static void CreateSkinnedVertices(
+        _In_ UINT uNumVertices,
+        _In_ UINT uNumBones,
+        _Inout_ std::mt19937& generator,
+        _Out_ std::vector<library::SimpleVertex>& outVertices,
+        _Out_ std::vector<library::AnimationData>& outAnimationData
+    )
+    {
+        std::uniform_real_distribution<FLOAT> coordinate(-10.0f, 10.0f);
+        std::uniform_real_distribution<FLOAT> weight(0.0f, 1.0f);
+        std::uniform_int_distribution<UINT> bone(0u, uNumBones - 1u);
+
+        outVertices.resize(uNumVertices);
+        outAnimationData.resize(uNumVertices);
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            outVertices[i].Position = XMFLOAT3(coordinate(generator), coordinate(generator), coordinate(generator));
+            outVertices[i].TexCoord = XMFLOAT2(0.0f, 0.0f);
+            XMStoreFloat3(&outVertices[i].Normal, XMVector3Normalize(XMVectorSet(coordinate(generator), coordinate(generator), coordinate(generator) + 0.01f, 0.0f)));
+
+            FLOAT aWeights[4];
+            FLOAT totalWeight = 0.0f;
+            for (FLOAT& w : aWeights)
+            {
+                w = weight(generator) + 0.01f;
+                totalWeight += w;
+            }
+
+            // Rounding down leaves the missing steps to the first weight, so that the bytes sum to 255
+            UINT aQuantizedWeights[4];
+            UINT uSum = 0u;
+            for (UINT k = 0u; k < 4u; ++k)
+            {
+                aQuantizedWeights[k] = static_cast<UINT>(aWeights[k] / totalWeight * 255.0f);
+                uSum += aQuantizedWeights[k];
+            }
+            aQuantizedWeights[0] += 255u - uSum;
+
+            outAnimationData[i].aBoneIndices = PackedVector::XMUBYTE4(
+                static_cast<uint8_t>(bone(generator)),
+                static_cast<uint8_t>(bone(generator)),
+                static_cast<uint8_t>(bone(generator)),
+                static_cast<uint8_t>(bone(generator))
+            );
+            outAnimationData[i].aBoneWeights = PackedVector::XMUBYTEN4(
+                static_cast<uint8_t>(aQuantizedWeights[0]),
+                static_cast<uint8_t>(aQuantizedWeights[1]),
+                static_cast<uint8_t>(aQuantizedWeights[2]),
+                static_cast<uint8_t>(aQuantizedWeights[3])
+            );
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestCpuSkinning
+
+      Summary:  Skins a cloud of vertices, whose count is not a multiple
+                of the SIMD width or of the job ranges, with a palette
+                of random rotations, scales and translations. The SIMD
+                kernel on the job system and on the calling thread has
+                to match the scalar reference up to float rounding.
+                Prints the throughput of the kernels.
+
+      Returns:  BOOL
+                  Whether the SIMD kernel matched the reference
+    -----------------------------------------------------------------F-F*/
+    BOOL TestCpuSkinning()
+    {
+        constexpr const UINT NUM_VERTICES = 100003u;
+        constexpr const UINT NUM_BONES = 60u;
+        constexpr const UINT NUM_ITERATIONS = 20u;
+        constexpr const UINT NUM_THREADS = 4u;
+        // Float rounding of a 3x4 transform blend on coordinates up to 10
+        constexpr const FLOAT TOLERANCE = 1e-4f;
+
+        std::mt19937 generator(38u);
+
+        std::vector<library::SimpleVertex> aVertices;
+        std::vector<library::AnimationData> aAnimationData;
+        CreateSkinnedVertices(NUM_VERTICES, NUM_BONES, generator, aVertices, aAnimationData);
+
+        std::uniform_real_distribution<FLOAT> angle(-XM_PI, XM_PI);
+        std::uniform_real_distribution<FLOAT> scale(0.5f, 1.5f);
+        std::uniform_real_distribution<FLOAT> offset(-5.0f, 5.0f);
+
+        std::vector<XMFLOAT3X4A> aBoneTransforms(NUM_BONES);
+        for (XMFLOAT3X4A& boneTransform : aBoneTransforms)
+        {
+            const XMMATRIX transform = XMMatrixScaling(scale(generator), scale(generator), scale(generator))
+                * XMMatrixRotationRollPitchYaw(angle(generator), angle(generator), angle(generator))
+                * XMMatrixTranslation(offset(generator), offset(generator), offset(generator));
+
+            // The palette is stored transposed, one row per output component
+            XMStoreFloat3x4A(&boneTransform, transform);
+        }
+
+        library::CpuSkinning skinning(aVertices, aAnimationData);
+        TEST_CHECK(skinning.GetNumVertices() == NUM_VERTICES);
+
+        library::JobSystem jobSystem(NUM_THREADS);
+
+        const FLOAT benchmarkError = skinning.Benchmark(aBoneTransforms.data(), NUM_ITERATIONS, &jobSystem);
+
+        library::SkinnedVertices reference;
+        library::SkinnedVertices serial;
+        skinning.SkinReference(aBoneTransforms.data(), reference);
+        skinning.Skin(aBoneTransforms.data(), serial, nullptr);
+        const FLOAT serialError = library::CpuSkinning::MeasureError(serial, reference);
+
+        wprintf(L"  %s kernel, largest error %g on the job system and %g on one thread\n", skinning.HasAvx2() ? L"AVX2" : L"SSE", benchmarkError, serialError);
+
+        TEST_CHECK(benchmarkError < TOLERANCE);
+        TEST_CHECK(serialError < TOLERANCE);
+
+        return TRUE;
+    }
+}
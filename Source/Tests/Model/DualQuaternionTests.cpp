@@ -0,0 +1,152 @@
+#include "Tests.h"
+
+#include <random>
+
+#include "Fixtures.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetTransformError
+
+      Summary:  Measures the largest difference between the elements of
+                two transforms, relative to the size of the expected
+                values
+
+      Args:     const XMMATRIX& transform
+                  Transform to check
+                const XMMATRIX& reference
+                  Expected transform
+
+      Returns:  FLOAT
+                  Largest relative error
+    -----------------------------------------------------------------F-F*/
+    static FLOAT GetTransformError(
+        _In_ const XMMATRIX& transform,
+        _In_ const XMMATRIX& reference
+    )
+    {
+        FLOAT maxError = 0.0f;
+        for (UINT uRow = 0u; uRow < 4u; ++uRow)
+        {
+            XMFLOAT4 error;
+            XMStoreFloat4(
+                &error,
+                XMVectorDivide(
+                    XMVectorAbs(XMVectorSubtract(transform.r[uRow], reference.r[uRow])),
+                    XMVectorAdd(g_XMOne, XMVectorAbs(reference.r[uRow]))
+                )
+            );
+            maxError = fmaxf(maxError, fmaxf(fmaxf(error.x, error.y), fmaxf(error.z, error.w)));
+        }
+
+        return maxError;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestDualQuaternionSkinning
+
+      Summary:  Converts random rigid transforms to dual quaternions and
+                back, also with both quaternions negated, which the
+                vertex shader blends as the same transform. The poses
+                of the animated guard evaluated as dual quaternions
+                then have to rebuild the bone matrices evaluated at the
+                same times, spread over the clip, and every dual
+                quaternion has to stay a unit one.
+
+      Returns:  BOOL
+                  Whether the dual quaternions matched the matrices
+    -----------------------------------------------------------------F-F*/
+    BOOL TestDualQuaternionSkinning()
+    {
+        constexpr const UINT NUM_TRANSFORMS = 10000u;
+        constexpr const UINT NUM_POSES = 97u;
+        constexpr const FLOAT ROUND_TRIP_TOLERANCE = 1e-4f;
+        constexpr const FLOAT POSE_TOLERANCE = 1e-3f;
+        constexpr const FLOAT UNIT_TOLERANCE = 1e-4f;
+
+        std::mt19937 generator(41u);
+        std::uniform_real_distribution<FLOAT> coordinate(-1.0f, 1.0f);
+        std::uniform_real_distribution<FLOAT> angle(-XM_PI, XM_PI);
+        std::uniform_real_distribution<FLOAT> offset(-50.0f, 50.0f);
+
+        FLOAT maxRoundTripError = 0.0f;
+        for (UINT i = 0u; i < NUM_TRANSFORMS; ++i)
+        {
+            XMVECTOR axis = XMVectorSet(coordinate(generator), coordinate(generator), coordinate(generator), 0.0f);
+            if (XMVectorGetX(XMVector3LengthSq(axis)) < 1e-4f)
+            {
+                axis = g_XMIdentityR1;
+            }
+
+            const XMMATRIX transform = XMMatrixRotationAxis(XMVector3Normalize(axis), angle(generator))
+                * XMMatrixTranslation(offset(generator), offset(generator), offset(generator));
+
+            library::DualQuaternion dualQuaternion;
+            TestModel::storeDualQuaternion(dualQuaternion, transform);
+            maxRoundTripError = fmaxf(maxRoundTripError, GetTransformError(TestModel::loadDualQuaternion(dualQuaternion), transform));
+
+            const library::DualQuaternion negated =
+            {
+                .Real = XMFLOAT4(-dualQuaternion.Real.x, -dualQuaternion.Real.y, -dualQuaternion.Real.z, -dualQuaternion.Real.w),
+                .Dual = XMFLOAT4(-dualQuaternion.Dual.x, -dualQuaternion.Dual.y, -dualQuaternion.Dual.z, -dualQuaternion.Dual.w)
+            };
+            maxRoundTripError = fmaxf(maxRoundTripError, GetTransformError(TestModel::loadDualQuaternion(negated), transform));
+        }
+        TEST_CHECK(maxRoundTripError <= ROUND_TRIP_TOLERANCE);
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        TestModel model(GetContentPath(L"BobLampClean/boblampclean.md5mesh"), library::eSkinningMode::DUAL_QUATERNION);
+        TEST_CHECK(SUCCEEDED(model.Initialize(device.Get(), immediateContext.Get())));
+
+        const library::ModelAsset& asset = model.GetAsset();
+        TEST_CHECK(asset.bHasAnimation);
+
+        const UINT uNumBones = static_cast<UINT>(asset.boneNameToIndexMap.size());
+        TEST_CHECK(uNumBones > 1u);
+
+        std::vector<XMMATRIX> aGlobalTransforms(asset.aSkeleton.size());
+        std::vector<XMFLOAT3X4A> aBoneTransforms(uNumBones);
+        std::vector<library::DualQuaternion> aBoneDualQuaternions(uNumBones);
+
+        FLOAT maxPoseError = 0.0f;
+        FLOAT maxUnitError = 0.0f;
+        for (UINT uPose = 0u; uPose < NUM_POSES; ++uPose)
+        {
+            const FLOAT animationTimeTicks = asset.DurationTicks * static_cast<FLOAT>(uPose) / static_cast<FLOAT>(NUM_POSES - 1u);
+
+            model.evaluatePose(animationTimeTicks, FALSE, aGlobalTransforms, aBoneTransforms.data());
+            model.evaluatePose(animationTimeTicks, FALSE, aGlobalTransforms, aBoneDualQuaternions.data());
+
+            for (UINT uBone = 0u; uBone < uNumBones; ++uBone)
+            {
+                const library::DualQuaternion& dualQuaternion = aBoneDualQuaternions[uBone];
+                maxPoseError = fmaxf(maxPoseError, GetTransformError(TestModel::loadDualQuaternion(dualQuaternion), XMLoadFloat3x4A(&aBoneTransforms[uBone])));
+
+                // A unit dual quaternion has a unit real part orthogonal to its dual part
+                const XMVECTOR real = XMLoadFloat4(&dualQuaternion.Real);
+                const XMVECTOR dual = XMLoadFloat4(&dualQuaternion.Dual);
+                maxUnitError = fmaxf(maxUnitError, fabsf(XMVectorGetX(XMVector4Length(real)) - 1.0f));
+                maxUnitError = fmaxf(maxUnitError, fabsf(XMVectorGetX(XMVector4Dot(real, dual))) / (1.0f + XMVectorGetX(XMVector4Length(dual))));
+            }
+        }
+
+        wprintf(
+            L"  largest error %.7f over %u round trips, %.6f over %u poses of %u bones, %.7f off unit\n",
+            maxRoundTripError,
+            NUM_TRANSFORMS,
+            maxPoseError,
+            NUM_POSES,
+            uNumBones,
+            maxUnitError
+        );
+
+        TEST_CHECK(maxPoseError <= POSE_TOLERANCE);
+        TEST_CHECK(maxUnitError <= UNIT_TOLERANCE);
+
+        return TRUE;
+    }
+}
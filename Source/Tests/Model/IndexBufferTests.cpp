@@ -0,0 +1,264 @@
+#include "Tests.h"
+
+#include <algorithm>
+
+#include "Fixtures.h"
+
+#include "assimp/scene.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetIndexValue
+
+      Summary:  Picks an index of a mesh that spreads over all of its
+                vertices, so the indices of large meshes need their
+                upper 16 bits
+
+      Args:     UINT uIndex
+                  Position of the index in the mesh
+                UINT uNumVertices
+                  Number of vertices of the mesh
+
+      Returns:  UINT
+                  Vertex index
+    -----------------------------------------------------------------F-F*/
+    static UINT GetIndexValue(
+        _In_ UINT uIndex,
+        _In_ UINT uNumVertices
+    )
+    {
+        return static_cast<UINT>((static_cast<UINT64>(uIndex) * 7919u + 13u) % uNumVertices);
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CheckIndexRanges
+
+      Summary:  Checks that every mesh and every simplified level of a
+                model lies inside the index stream, that the 32 bit
+                ones start on a 4 byte boundary, that no two of them
+                overlap and that every index stays inside its mesh
+
+      Args:     const TestModel& model
+                  Initialized model
+
+      Returns:  BOOL
+                  Whether the index stream was laid out right
+    -----------------------------------------------------------------F-F*/
+    static BOOL CheckIndexRanges(
+        _In_ const TestModel& model
+    )
+    {
+        const library::ModelAsset& asset = model.GetAsset();
+        const size_t uNumMeshes = model.m_aMeshes.size();
+
+        std::vector<std::pair<size_t, size_t>> aWordRanges;
+        for (size_t i = 0u; i < uNumMeshes; ++i)
+        {
+            const size_t uEndVertex = i + 1u < uNumMeshes ? model.m_aMeshes[i + 1u].uBaseVertex : asset.aVertices.size();
+            const UINT uNumVertices = static_cast<UINT>(uEndVertex - model.m_aMeshes[i].uBaseVertex);
+
+            for (size_t uLod = 0u; uLod < library::MeshLodSelector::NUM_LODS; ++uLod)
+            {
+                const library::Renderable::BasicMeshEntry& mesh = uLod == 0u ? model.m_aMeshes[i] : asset.aLodMeshes[(uLod - 1u) * uNumMeshes + i];
+                TEST_CHECK(mesh.IndexFormat == model.m_aMeshes[i].IndexFormat);
+
+                // uBaseIndex counts 32 bit indices for the 32 bit meshes, so it is in words doubled
+                const size_t uWordSize = mesh.IndexFormat == DXGI_FORMAT_R32_UINT ? 2u : 1u;
+                const size_t uFirstWord = static_cast<size_t>(mesh.uBaseIndex) * uWordSize;
+                const size_t uEndWord = uFirstWord + static_cast<size_t>(mesh.uNumIndices) * uWordSize;
+                TEST_CHECK(uEndWord <= asset.aIndices.size());
+                TEST_CHECK((uFirstWord * sizeof(WORD)) % (uWordSize * sizeof(WORD)) == 0u);
+
+                if (mesh.uNumIndices > 0u)
+                {
+                    aWordRanges.push_back(std::make_pair(uFirstWord, uEndWord));
+                }
+
+                for (UINT j = 0u; j < mesh.uNumIndices; ++j)
+                {
+                    TEST_CHECK(TestModel::readIndex(asset.aIndices, mesh, j) < uNumVertices);
+                }
+            }
+        }
+
+        // The levels that were not simplified further share the range of the level before
+        std::sort(aWordRanges.begin(), aWordRanges.end());
+        aWordRanges.erase(std::unique(aWordRanges.begin(), aWordRanges.end()), aWordRanges.end());
+        for (size_t i = 1u; i < aWordRanges.size(); ++i)
+        {
+            TEST_CHECK(aWordRanges[i - 1u].second <= aWordRanges[i].first);
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestLargeIndexBuffer
+
+      Summary:  Lays out the index stream of meshes of a million
+                vertices between small ones. The large meshes have to
+                switch to 32 bit indices on a 4 byte boundary, and
+                every index appended or written has to read back. Then
+                imports a skinned grid of a million vertices after a
+                small mesh with an odd number of indices, and checks
+                that the simplified levels are appended in the units
+                of their format.
+
+      Returns:  BOOL
+                  Whether every index stream was laid out right
+    -----------------------------------------------------------------F-F*/
+    BOOL TestLargeIndexBuffer()
+    {
+        constexpr const UINT NUM_LARGE_MESH_VERTICES = 1u << 20u;
+        constexpr const UINT NUM_GRID_CELLS = 1023u;
+        constexpr const UINT NUM_MESH_VERTICES[] = { 5u, NUM_LARGE_MESH_VERTICES, 7u, NUM_LARGE_MESH_VERTICES + 1u, 0x10000u };
+        constexpr const UINT NUM_MESH_FACES[] = { 3u, 4001u, 5u, 3000u, 1001u };
+        constexpr const UINT NUM_MESHES = ARRAYSIZE(NUM_MESH_VERTICES);
+
+        // Only the sizes of the meshes are read to lay the stream out
+        aiScene scene;
+        scene.mNumMeshes = NUM_MESHES;
+        scene.mMeshes = new aiMesh*[NUM_MESHES];
+        for (UINT i = 0u; i < NUM_MESHES; ++i)
+        {
+            scene.mMeshes[i] = new aiMesh();
+            scene.mMeshes[i]->mNumVertices = NUM_MESH_VERTICES[i];
+            scene.mMeshes[i]->mNumFaces = NUM_MESH_FACES[i];
+        }
+
+        TestModel model;
+        model.m_asset = TestModel::createAsset();
+
+        UINT uNumVertices = 0u;
+        UINT uNumWords = 0u;
+        model.countVerticesAndIndices(uNumVertices, uNumWords, &scene);
+
+        TEST_CHECK(model.m_aMeshes.size() == NUM_MESHES);
+        for (UINT i = 0u; i < NUM_MESHES; ++i)
+        {
+            const library::Renderable::BasicMeshEntry& mesh = model.m_aMeshes[i];
+            TEST_CHECK(mesh.uNumIndices == NUM_MESH_FACES[i] * 3u);
+            TEST_CHECK(mesh.IndexFormat == (NUM_MESH_VERTICES[i] > 0x10000u ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT));
+        }
+
+        for (UINT i = 0u; i < NUM_MESHES; ++i)
+        {
+            for (UINT j = 0u; j < model.m_aMeshes[i].uNumIndices; ++j)
+            {
+                model.appendIndex(i, GetIndexValue(j, NUM_MESH_VERTICES[i]));
+            }
+        }
+
+        // The counted stream holds the padding appendIndex inserted
+        std::vector<WORD>& aIndices = model.m_asset->aIndices;
+        TEST_CHECK(aIndices.size() == uNumWords);
+
+        UINT uNumPaddingWords = 0u;
+        size_t uEndWord = 0u;
+        for (UINT i = 0u; i < NUM_MESHES; ++i)
+        {
+            const library::Renderable::BasicMeshEntry& mesh = model.m_aMeshes[i];
+            if (mesh.IndexFormat == DXGI_FORMAT_R32_UINT)
+            {
+                const size_t uFirstWord = static_cast<size_t>(mesh.uBaseIndex) * 2u;
+                TEST_CHECK((uFirstWord * sizeof(WORD)) % sizeof(UINT) == 0u);
+                TEST_CHECK(uFirstWord == uEndWord + (uEndWord & 1u));
+                for (size_t uWord = uEndWord; uWord < uFirstWord; ++uWord)
+                {
+                    TEST_CHECK(aIndices[uWord] == 0u);
+                    ++uNumPaddingWords;
+                }
+                uEndWord = uFirstWord + static_cast<size_t>(mesh.uNumIndices) * 2u;
+            }
+            else
+            {
+                TEST_CHECK(mesh.uBaseIndex == uEndWord);
+                uEndWord = static_cast<size_t>(mesh.uBaseIndex) + mesh.uNumIndices;
+            }
+
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
+            {
+                TEST_CHECK(TestModel::readIndex(aIndices, mesh, j) == GetIndexValue(j, NUM_MESH_VERTICES[i]));
+            }
+        }
+        TEST_CHECK(uEndWord == uNumWords);
+        TEST_CHECK(uNumPaddingWords > 0u);
+
+        // Written back in reverse, every mesh has to read its own indices and leave its neighbors alone
+        for (UINT i = 0u; i < NUM_MESHES; ++i)
+        {
+            const library::Renderable::BasicMeshEntry& mesh = model.m_aMeshes[i];
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
+            {
+                TestModel::writeIndex(aIndices, mesh, j, NUM_MESH_VERTICES[i] - 1u - GetIndexValue(j, NUM_MESH_VERTICES[i]));
+            }
+        }
+        for (UINT i = 0u; i < NUM_MESHES; ++i)
+        {
+            const library::Renderable::BasicMeshEntry& mesh = model.m_aMeshes[i];
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
+            {
+                TEST_CHECK(TestModel::readIndex(aIndices, mesh, j) == NUM_MESH_VERTICES[i] - 1u - GetIndexValue(j, NUM_MESH_VERTICES[i]));
+            }
+        }
+        TEST_CHECK(aIndices.size() == uNumWords);
+
+        wprintf(
+            L"  %u meshes of up to %u vertices in %u words, %u of them padding\n",
+            NUM_MESHES,
+            NUM_LARGE_MESH_VERTICES + 1u,
+            uNumWords,
+            uNumPaddingWords
+        );
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        // A small mesh with an odd number of indices comes first, so the large mesh needs padding
+        std::unique_ptr<aiScene> pScene = CreateSkinnedScene(NUM_GRID_CELLS, NUM_GRID_CELLS);
+        std::unique_ptr<aiScene> pSmallScene = CreateSkinnedScene(2u, 2u);
+        aiMesh* pSmallMesh = pSmallScene->mMeshes[0];
+        pSmallScene->mMeshes[0] = nullptr;
+        --pSmallMesh->mNumFaces;
+
+        aiMesh** apMeshes = new aiMesh*[2]{ pSmallMesh, pScene->mMeshes[0] };
+        delete[] pScene->mMeshes;
+        pScene->mMeshes = apMeshes;
+        pScene->mNumMeshes = 2u;
+        TEST_CHECK(pScene->mMeshes[1]->mNumVertices == NUM_LARGE_MESH_VERTICES);
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&startTime);
+
+        TestModel gridModel;
+        TEST_CHECK(SUCCEEDED(gridModel.InitializeFromScene(device.Get(), immediateContext.Get(), pScene.get())));
+
+        QueryPerformanceCounter(&endTime);
+
+        TEST_CHECK(gridModel.m_aMeshes.size() == 2u);
+        TEST_CHECK(gridModel.m_aMeshes[0].IndexFormat == DXGI_FORMAT_R16_UINT);
+        TEST_CHECK(gridModel.m_aMeshes[0].uNumIndices % 2u == 1u);
+        TEST_CHECK(gridModel.m_aMeshes[1].IndexFormat == DXGI_FORMAT_R32_UINT);
+        TEST_CHECK(gridModel.m_aMeshes[1].uBaseIndex * 2u == gridModel.m_aMeshes[0].uNumIndices + 1u);
+
+        const library::ModelAsset& asset = gridModel.GetAsset();
+        TEST_CHECK(asset.aLodMeshes.size() == (library::MeshLodSelector::NUM_LODS - 1u) * 2u);
+        TEST_CHECK(asset.aLodMeshes[(library::MeshLodSelector::NUM_LODS - 2u) * 2u + 1u].uNumIndices < gridModel.m_aMeshes[1].uNumIndices);
+        TEST_CHECK(CheckIndexRanges(gridModel));
+
+        wprintf(
+            L"  grid of %u vertices imported in %.3f ms, %zu words of indices, coarsest level %u triangles\n",
+            NUM_LARGE_MESH_VERTICES,
+            static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart),
+            asset.aIndices.size(),
+            asset.aLodMeshes[(library::MeshLodSelector::NUM_LODS - 2u) * 2u + 1u].uNumIndices / 3u
+        );
+
+        return TRUE;
+    }
+}
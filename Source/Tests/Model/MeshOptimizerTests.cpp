@@ -0,0 +1,248 @@
+#include "Tests.h"
+
+#include <algorithm>
+#include <random>
+
+#include "Fixtures.h"
+#include "Model/MeshOptimizer.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: MeasureOverdraw
+
+      Summary:  Rasterizes the triangles in their order into a depth
+                buffer from the six axis directions, culling those that
+                face away. Overdraw is the number of pixels that passed
+                the depth test over the number of pixels covered.
+
+      Args:     const std::vector<library::SimpleVertex>& aVertices
+                  Vertices of the mesh
+                const std::vector<UINT>& aIndices
+                  Triangles of the mesh in draw order
+
+      Returns:  FLOAT
+                  Overdraw, 1 at best
+    -----------------------------------------------------------------F-F*/
+    static FLOAT MeasureOverdraw(
+        _In_ const std::vector<library::SimpleVertex>& aVertices,
+        _In_ const std::vector<UINT>& aIndices
+    )
+    {
+        constexpr const UINT RESOLUTION = 256u;
+
+        BoundingBox bounds;
+        BoundingBox::CreateFromPoints(bounds, aVertices.size(), &aVertices[0].Position, sizeof(library::SimpleVertex));
+        const FLOAT scale = static_cast<FLOAT>(RESOLUTION - 1u) / (2.0f * fmaxf(bounds.Extents.x, fmaxf(bounds.Extents.y, bounds.Extents.z)));
+        const XMVECTOR minCorner = XMVectorSubtract(XMLoadFloat3(&bounds.Center), XMLoadFloat3(&bounds.Extents));
+
+        std::vector<FLOAT> aDepths(static_cast<size_t>(RESOLUTION) * RESOLUTION);
+        UINT64 uNumShaded = 0u;
+        UINT64 uNumCovered = 0u;
+        for (UINT uView = 0u; uView < 6u; ++uView)
+        {
+            // Looks along the axis uView / 2, towards the positive end for even views, and
+            // projects onto the two other axes
+            const UINT uAxis = uView / 2u;
+            const FLOAT sign = uView % 2u == 0u ? 1.0f : -1.0f;
+            const XMVECTOR viewDirection = XMVectorSetByIndex(XMVectorZero(), sign, uAxis);
+
+            std::fill(aDepths.begin(), aDepths.end(), FLT_MAX);
+            for (size_t i = 0u; i < aIndices.size(); i += 3u)
+            {
+                XMVECTOR aCorners[3];
+                for (UINT k = 0u; k < 3u; ++k)
+                {
+                    aCorners[k] = XMVectorScale(XMVectorSubtract(XMLoadFloat3(&aVertices[aIndices[i + k]].Position), minCorner), scale);
+                }
+
+                const XMVECTOR faceNormal = XMVector3Cross(XMVectorSubtract(aCorners[1], aCorners[0]), XMVectorSubtract(aCorners[2], aCorners[0]));
+                if (XMVectorGetX(XMVector3Dot(faceNormal, viewDirection)) >= 0.0f)
+                {
+                    continue;
+                }
+
+                FLOAT aX[3];
+                FLOAT aY[3];
+                FLOAT aZ[3];
+                for (UINT k = 0u; k < 3u; ++k)
+                {
+                    aX[k] = XMVectorGetByIndex(aCorners[k], (uAxis + 1u) % 3u);
+                    aY[k] = XMVectorGetByIndex(aCorners[k], (uAxis + 2u) % 3u);
+                    aZ[k] = sign * XMVectorGetByIndex(aCorners[k], uAxis);
+                }
+
+                const FLOAT area = (aX[1] - aX[0]) * (aY[2] - aY[0]) - (aX[2] - aX[0]) * (aY[1] - aY[0]);
+                if (area == 0.0f)
+                {
+                    continue;
+                }
+
+                const UINT uMinX = static_cast<UINT>(fmaxf(floorf(fminf(aX[0], fminf(aX[1], aX[2]))), 0.0f));
+                const UINT uMinY = static_cast<UINT>(fmaxf(floorf(fminf(aY[0], fminf(aY[1], aY[2]))), 0.0f));
+                const UINT uMaxX = static_cast<UINT>(fminf(ceilf(fmaxf(aX[0], fmaxf(aX[1], aX[2]))), static_cast<FLOAT>(RESOLUTION - 1u)));
+                const UINT uMaxY = static_cast<UINT>(fminf(ceilf(fmaxf(aY[0], fmaxf(aY[1], aY[2]))), static_cast<FLOAT>(RESOLUTION - 1u)));
+                for (UINT y = uMinY; y <= uMaxY; ++y)
+                {
+                    for (UINT x = uMinX; x <= uMaxX; ++x)
+                    {
+                        const FLOAT pixelX = static_cast<FLOAT>(x) + 0.5f;
+                        const FLOAT pixelY = static_cast<FLOAT>(y) + 0.5f;
+
+                        // Barycentric weights of the corners, all positive inside whatever the winding
+                        const FLOAT w0 = ((aX[1] - pixelX) * (aY[2] - pixelY) - (aX[2] - pixelX) * (aY[1] - pixelY)) / area;
+                        const FLOAT w1 = ((aX[2] - pixelX) * (aY[0] - pixelY) - (aX[0] - pixelX) * (aY[2] - pixelY)) / area;
+                        const FLOAT w2 = 1.0f - w0 - w1;
+                        if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                        {
+                            continue;
+                        }
+
+                        const FLOAT depth = w0 * aZ[0] + w1 * aZ[1] + w2 * aZ[2];
+                        FLOAT& bufferDepth = aDepths[static_cast<size_t>(y) * RESOLUTION + x];
+                        if (depth < bufferDepth)
+                        {
+                            bufferDepth = depth;
+                            ++uNumShaded;
+                        }
+                    }
+                }
+            }
+
+            uNumCovered += static_cast<UINT64>(std::count_if(aDepths.begin(), aDepths.end(), [](FLOAT depth) { return depth < FLT_MAX; }));
+        }
+
+        return static_cast<FLOAT>(uNumShaded) / static_cast<FLOAT>(uNumCovered);
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SortTriangles
+
+      Summary:  Rotates every triangle so that it starts on its lowest
+                index, which keeps its winding, and sorts the triangles
+
+      Args:     const std::vector<UINT>& aIndices
+                  Triangles, three indices each
+
+      Returns:  std::vector<UINT64>
+                  Sorted triangles, 21 bits per index
+    -----------------------------------------------------------------F-F*/
+    static std::vector<UINT64> SortTriangles(
+        _In_ const std::vector<UINT>& aIndices
+    )
+    {
+        std::vector<UINT64> aTriangles;
+        aTriangles.reserve(aIndices.size() / 3u);
+        for (size_t i = 0u; i < aIndices.size(); i += 3u)
+        {
+            UINT aCorners[3] = { aIndices[i], aIndices[i + 1u], aIndices[i + 2u] };
+            std::rotate(aCorners, std::min_element(aCorners, aCorners + 3), aCorners + 3);
+
+            aTriangles.push_back((static_cast<UINT64>(aCorners[0]) << 42u) | (static_cast<UINT64>(aCorners[1]) << 21u) | aCorners[2]);
+        }
+        std::sort(aTriangles.begin(), aTriangles.end());
+
+        return aTriangles;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestMeshOptimizer
+
+      Summary:  Shuffles the triangles of a torus, then runs the vertex
+                cache, overdraw and vertex fetch passes on them. Every
+                pass has to keep the triangles and their winding. The
+                vertex cache pass has to cut the ACMR, the overdraw
+                pass has to cut the overdraw without giving back the
+                ACMR, and the vertex fetch pass has to leave the ACMR
+                as it is while using the vertices in order. Prints the
+                ACMR and overdraw before and after.
+
+      Returns:  BOOL
+                  Whether every pass held
+    -----------------------------------------------------------------F-F*/
+    BOOL TestMeshOptimizer()
+    {
+        constexpr const UINT NUM_RINGS = 96u;
+        constexpr const UINT NUM_SIDES = 48u;
+
+        std::vector<library::SimpleVertex> aVertices;
+        std::vector<UINT> aIndices;
+        CreateTorusMesh(NUM_RINGS, NUM_SIDES, aVertices, aIndices);
+        const UINT uNumVertices = static_cast<UINT>(aVertices.size());
+
+        // An imported mesh in no particular order. The shuffle is spelled out, as std::shuffle
+        // may differ between standard libraries
+        std::vector<UINT> aTriangleOrder(aIndices.size() / 3u);
+        for (UINT i = 0u; i < static_cast<UINT>(aTriangleOrder.size()); ++i)
+        {
+            aTriangleOrder[i] = i;
+        }
+        std::mt19937 generator(46u);
+        for (UINT i = static_cast<UINT>(aTriangleOrder.size()) - 1u; i > 0u; --i)
+        {
+            std::swap(aTriangleOrder[i], aTriangleOrder[generator() % (i + 1u)]);
+        }
+
+        std::vector<UINT> aShuffledIndices;
+        aShuffledIndices.reserve(aIndices.size());
+        for (UINT uTriangle : aTriangleOrder)
+        {
+            aShuffledIndices.insert(aShuffledIndices.end(), aIndices.begin() + uTriangle * 3u, aIndices.begin() + uTriangle * 3u + 3u);
+        }
+        const std::vector<UINT64> aTriangles = SortTriangles(aShuffledIndices);
+
+        const library::VertexCacheStats shuffled = library::MeshOptimizer::AnalyzeVertexCache(aShuffledIndices, uNumVertices);
+        const FLOAT shuffledOverdraw = MeasureOverdraw(aVertices, aShuffledIndices);
+
+        library::MeshOptimizer optimizer;
+        aIndices = aShuffledIndices;
+        optimizer.OptimizeVertexCache(aIndices, uNumVertices);
+        TEST_CHECK(SortTriangles(aIndices) == aTriangles);
+        const library::VertexCacheStats cacheOptimized = library::MeshOptimizer::AnalyzeVertexCache(aIndices, uNumVertices);
+        const FLOAT cacheOptimizedOverdraw = MeasureOverdraw(aVertices, aIndices);
+
+        optimizer.OptimizeOverdraw(aIndices, aVertices.data(), uNumVertices);
+        TEST_CHECK(SortTriangles(aIndices) == aTriangles);
+        const library::VertexCacheStats overdrawOptimized = library::MeshOptimizer::AnalyzeVertexCache(aIndices, uNumVertices);
+        const FLOAT overdrawOptimizedOverdraw = MeasureOverdraw(aVertices, aIndices);
+
+        std::vector<UINT> aRemap;
+        const std::vector<UINT> aUnfetchedIndices = aIndices;
+        optimizer.OptimizeVertexFetch(aIndices, uNumVertices, aRemap);
+        const library::VertexCacheStats fetchOptimized = library::MeshOptimizer::AnalyzeVertexCache(aIndices, uNumVertices);
+
+        const FLOAT numTriangles = static_cast<FLOAT>(shuffled.uNumTriangles);
+        wprintf(
+            L"  ACMR %.3f shuffled, %.3f vertex cache, %.3f overdraw, %.3f vertex fetch, overdraw %.3f shuffled, %.3f vertex cache, %.3f overdraw\n",
+            static_cast<FLOAT>(shuffled.uNumMisses) / numTriangles,
+            static_cast<FLOAT>(cacheOptimized.uNumMisses) / numTriangles,
+            static_cast<FLOAT>(overdrawOptimized.uNumMisses) / numTriangles,
+            static_cast<FLOAT>(fetchOptimized.uNumMisses) / numTriangles,
+            shuffledOverdraw,
+            cacheOptimizedOverdraw,
+            overdrawOptimizedOverdraw
+        );
+
+        // A vertex shared by six triangles is transformed at least once, so 0.5 is the ideal ACMR
+        TEST_CHECK(cacheOptimized.uNumMisses * 2u < shuffled.uNumMisses);
+        TEST_CHECK(static_cast<FLOAT>(cacheOptimized.uNumMisses) / numTriangles < 0.8f);
+        TEST_CHECK(overdrawOptimizedOverdraw < cacheOptimizedOverdraw);
+        TEST_CHECK(static_cast<FLOAT>(overdrawOptimized.uNumMisses) < static_cast<FLOAT>(cacheOptimized.uNumMisses) * 1.05f);
+        TEST_CHECK(fetchOptimized.uNumMisses == overdrawOptimized.uNumMisses);
+
+        // The renumbered indices are the same triangles, and every vertex is used after the ones before it
+        TEST_CHECK(aRemap.size() == uNumVertices);
+        UINT uNextVertex = 0u;
+        for (size_t i = 0u; i < aIndices.size(); ++i)
+        {
+            TEST_CHECK(aIndices[i] == aRemap[aUnfetchedIndices[i]]);
+            TEST_CHECK(aIndices[i] <= uNextVertex);
+            if (aIndices[i] + 1u > uNextVertex)
+            {
+                uNextVertex = aIndices[i] + 1u;
+            }
+        }
+
+        return TRUE;
+    }
+}
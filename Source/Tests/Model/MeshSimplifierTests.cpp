@@ -0,0 +1,275 @@
+#include "Tests.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+#include "Fixtures.h"
+#include "Model/MeshSimplifier.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: MeasureDeviation
+
+      Summary:  Measures how far the simplified surface moved away from
+                the vertices of the original one. The simplifier keeps
+                a subset of the vertices, so the vertices it removed
+                are the ones that can end up off the surface.
+
+      Args:     const std::vector<library::SimpleVertex>& aVertices
+                  Vertices of the mesh
+                const std::vector<UINT>& aSimplifiedIndices
+                  Triangles of the simplified mesh
+
+      Returns:  FLOAT
+                  Largest distance of a vertex to its closest simplified
+                  triangle, as a fraction of the largest extent of the
+                  mesh
+    -----------------------------------------------------------------F-F*/
+    static FLOAT MeasureDeviation(
+        _In_ const std::vector<library::SimpleVertex>& aVertices,
+        _In_ const std::vector<UINT>& aSimplifiedIndices
+    )
+    {
+        BoundingBox bounds;
+        BoundingBox::CreateFromPoints(bounds, aVertices.size(), &aVertices[0].Position, sizeof(library::SimpleVertex));
+        const FLOAT extent = 2.0f * fmaxf(bounds.Extents.x, fmaxf(bounds.Extents.y, bounds.Extents.z));
+
+        FLOAT maxSquaredDistance = 0.0f;
+        for (const library::SimpleVertex& vertex : aVertices)
+        {
+            const XMVECTOR point = XMLoadFloat3(&vertex.Position);
+
+            FLOAT minSquaredDistance = FLT_MAX;
+            for (size_t i = 0u; i < aSimplifiedIndices.size() && minSquaredDistance > 0.0f; i += 3u)
+            {
+                const XMVECTOR a = XMLoadFloat3(&aVertices[aSimplifiedIndices[i]].Position);
+                const XMVECTOR b = XMLoadFloat3(&aVertices[aSimplifiedIndices[i + 1u]].Position);
+                const XMVECTOR c = XMLoadFloat3(&aVertices[aSimplifiedIndices[i + 2u]].Position);
+                const XMVECTOR ab = XMVectorSubtract(b, a);
+                const XMVECTOR ac = XMVectorSubtract(c, a);
+
+                // Closest point inside the triangle, or else on the closest of its edges
+                XMVECTOR closest = XMVectorZero();
+                const XMVECTOR normal = XMVector3Cross(ab, ac);
+                const FLOAT normalLengthSq = XMVectorGetX(XMVector3LengthSq(normal));
+                BOOL bInside = FALSE;
+                if (normalLengthSq > 0.0f)
+                {
+                    const XMVECTOR ap = XMVectorSubtract(point, a);
+                    const FLOAT v = XMVectorGetX(XMVector3Dot(XMVector3Cross(ap, ac), normal)) / normalLengthSq;
+                    const FLOAT w = XMVectorGetX(XMVector3Dot(XMVector3Cross(ab, ap), normal)) / normalLengthSq;
+                    if (v >= 0.0f && w >= 0.0f && v + w <= 1.0f)
+                    {
+                        closest = XMVectorAdd(a, XMVectorAdd(XMVectorScale(ab, v), XMVectorScale(ac, w)));
+                        bInside = TRUE;
+                    }
+                }
+
+                if (!bInside)
+                {
+                    FLOAT minEdgeDistance = FLT_MAX;
+                    const XMVECTOR aStarts[3] = { a, b, c };
+                    const XMVECTOR aEnds[3] = { b, c, a };
+                    for (UINT k = 0u; k < 3u; ++k)
+                    {
+                        const XMVECTOR edge = XMVectorSubtract(aEnds[k], aStarts[k]);
+                        const FLOAT edgeLengthSq = XMVectorGetX(XMVector3LengthSq(edge));
+                        const FLOAT t = edgeLengthSq > 0.0f
+                            ? std::clamp(XMVectorGetX(XMVector3Dot(XMVectorSubtract(point, aStarts[k]), edge)) / edgeLengthSq, 0.0f, 1.0f)
+                            : 0.0f;
+                        const XMVECTOR edgePoint = XMVectorAdd(aStarts[k], XMVectorScale(edge, t));
+                        const FLOAT edgeDistance = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(point, edgePoint)));
+                        if (edgeDistance < minEdgeDistance)
+                        {
+                            minEdgeDistance = edgeDistance;
+                            closest = edgePoint;
+                        }
+                    }
+                }
+
+                minSquaredDistance = fminf(minSquaredDistance, XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(point, closest))));
+            }
+
+            maxSquaredDistance = fmaxf(maxSquaredDistance, minSquaredDistance);
+        }
+
+        return sqrtf(maxSquaredDistance) / extent;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CheckClosedTorus
+
+      Summary:  Checks that the simplified torus is still closed and
+                faces out. Vertices on the seams are welded by their
+                position, every edge then has to be shared by exactly
+                one triangle in each direction, and every triangle has
+                to face away from the circle the tube runs around.
+
+      Args:     const std::vector<library::SimpleVertex>& aVertices
+                  Vertices of the torus
+                const std::vector<UINT>& aIndices
+                  Triangles of the simplified torus
+
+      Returns:  BOOL
+                  Whether the torus is closed and faces out
+    -----------------------------------------------------------------F-F*/
+    static BOOL CheckClosedTorus(
+        _In_ const std::vector<library::SimpleVertex>& aVertices,
+        _In_ const std::vector<UINT>& aIndices
+    )
+    {
+        std::map<std::tuple<FLOAT, FLOAT, FLOAT>, UINT> positions;
+        std::vector<UINT> aWeldedVertices(aVertices.size());
+        for (UINT i = 0u; i < static_cast<UINT>(aVertices.size()); ++i)
+        {
+            const XMFLOAT3& position = aVertices[i].Position;
+            aWeldedVertices[i] = positions.try_emplace(std::make_tuple(position.x, position.y, position.z), i).first->second;
+        }
+
+        std::map<std::pair<UINT, UINT>, UINT> edges;
+        for (size_t i = 0u; i < aIndices.size(); i += 3u)
+        {
+            for (UINT k = 0u; k < 3u; ++k)
+            {
+                TEST_CHECK(aIndices[i + k] < aVertices.size());
+                ++edges[std::make_pair(aWeldedVertices[aIndices[i + k]], aWeldedVertices[aIndices[i + (k + 1u) % 3u]])];
+            }
+
+            const XMVECTOR a = XMLoadFloat3(&aVertices[aIndices[i]].Position);
+            const XMVECTOR b = XMLoadFloat3(&aVertices[aIndices[i + 1u]].Position);
+            const XMVECTOR c = XMLoadFloat3(&aVertices[aIndices[i + 2u]].Position);
+            const XMVECTOR centroid = XMVectorScale(XMVectorAdd(a, XMVectorAdd(b, c)), 1.0f / 3.0f);
+
+            // The triangles are clockwise seen from outside, and the tube runs around the unit circle
+            const XMVECTOR tubeCenter = XMVector3Normalize(XMVectorSetY(centroid, 0.0f));
+            const XMVECTOR faceNormal = XMVector3Cross(XMVectorSubtract(b, a), XMVectorSubtract(c, a));
+            TEST_CHECK(XMVectorGetX(XMVector3Dot(faceNormal, XMVectorSubtract(centroid, tubeCenter))) > 0.0f);
+        }
+
+        for (const auto& [edge, uNumUses] : edges)
+        {
+            const auto opposite = edges.find(std::make_pair(edge.second, edge.first));
+            TEST_CHECK(uNumUses == 1u && opposite != edges.end() && opposite->second == 1u);
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestMeshSimplifier
+
+      Summary:  Simplifies a torus through the levels of detail Model
+                builds, each from the one before with the error Model
+                allows it. Every level has to report an error within
+                its bound, stay within a small multiple of it from the
+                original vertices, and stay closed and facing out.
+                Simplifies a flat grid without any error, which has to
+                keep the area and the border of the grid. Prints the
+                triangles and errors of every level.
+
+      Returns:  BOOL
+                  Whether every level held
+    -----------------------------------------------------------------F-F*/
+    BOOL TestMeshSimplifier()
+    {
+        constexpr const UINT NUM_RINGS = 64u;
+        constexpr const UINT NUM_SIDES = 32u;
+        constexpr const UINT NUM_LODS = 3u;
+        // The errors Model allows its levels of detail
+        constexpr const FLOAT MAX_ERRORS[NUM_LODS] = { 0.01f, 0.02f, 0.04f };
+        // The reported error averages the planes around a vertex, a single plane may be further off
+        constexpr const FLOAT DEVIATION_FACTOR = 2.0f;
+        constexpr const UINT GRID_SIZE = 32u;
+
+        std::vector<library::SimpleVertex> aVertices;
+        std::vector<UINT> aIndices;
+        CreateTorusMesh(NUM_RINGS, NUM_SIDES, aVertices, aIndices);
+        const UINT uNumVertices = static_cast<UINT>(aVertices.size());
+        const size_t uNumIndices = aIndices.size();
+
+        library::MeshSimplifier simplifier;
+        for (UINT uLod = 1u; uLod <= NUM_LODS; ++uLod)
+        {
+            const size_t uPreviousNumIndices = aIndices.size();
+            const UINT uTargetNumIndices = static_cast<UINT>(uNumIndices >> uLod) / 3u * 3u;
+
+            const FLOAT error = simplifier.Simplify(aIndices, aVertices.data(), nullptr, uNumVertices, uTargetNumIndices, MAX_ERRORS[uLod - 1u]);
+            const FLOAT deviation = MeasureDeviation(aVertices, aIndices);
+
+            wprintf(
+                L"  level %u: %zu of %zu triangles, error %.4f of %.4f, deviation %.4f\n",
+                uLod,
+                aIndices.size() / 3u,
+                uNumIndices / 3u,
+                error,
+                MAX_ERRORS[uLod - 1u],
+                deviation
+            );
+
+            TEST_CHECK(aIndices.size() % 3u == 0u && aIndices.size() < uPreviousNumIndices);
+            TEST_CHECK(error <= MAX_ERRORS[uLod - 1u]);
+            TEST_CHECK(deviation <= MAX_ERRORS[uLod - 1u] * DEVIATION_FACTOR);
+            TEST_CHECK(CheckClosedTorus(aVertices, aIndices));
+        }
+
+        // A flat grid loses its inside and the middle of its border edges at no error at all
+        std::vector<library::SimpleVertex> aGridVertices;
+        std::vector<UINT> aGridIndices;
+        for (UINT y = 0u; y <= GRID_SIZE; ++y)
+        {
+            for (UINT x = 0u; x <= GRID_SIZE; ++x)
+            {
+                aGridVertices.push_back(
+                    {
+                        .Position = XMFLOAT3(static_cast<FLOAT>(x), static_cast<FLOAT>(y), 0.0f),
+                        .TexCoord = XMFLOAT2(static_cast<FLOAT>(x) / GRID_SIZE, static_cast<FLOAT>(y) / GRID_SIZE),
+                        .Normal = XMFLOAT3(0.0f, 0.0f, -1.0f)
+                    }
+                );
+            }
+        }
+        for (UINT y = 0u; y < GRID_SIZE; ++y)
+        {
+            for (UINT x = 0u; x < GRID_SIZE; ++x)
+            {
+                const UINT a = y * (GRID_SIZE + 1u) + x;
+                aGridIndices.insert(aGridIndices.end(), { a, a + GRID_SIZE + 1u, a + 1u, a + 1u, a + GRID_SIZE + 1u, a + GRID_SIZE + 2u });
+            }
+        }
+        const size_t uNumGridIndices = aGridIndices.size();
+
+        const FLOAT gridError = simplifier.Simplify(aGridIndices, aGridVertices.data(), nullptr, static_cast<UINT>(aGridVertices.size()), 0u, 0.0f);
+        wprintf(L"  grid: %zu of %zu triangles, error %g\n", aGridIndices.size() / 3u, uNumGridIndices / 3u, gridError);
+
+        TEST_CHECK(gridError == 0.0f);
+        TEST_CHECK(aGridIndices.size() * 8u < uNumGridIndices);
+
+        // Every triangle keeps facing the same way, so the signed areas add up to the grid
+        FLOAT area = 0.0f;
+        XMFLOAT2 minCorner(FLT_MAX, FLT_MAX);
+        XMFLOAT2 maxCorner(-FLT_MAX, -FLT_MAX);
+        for (size_t i = 0u; i < aGridIndices.size(); i += 3u)
+        {
+            const XMFLOAT3& a = aGridVertices[aGridIndices[i]].Position;
+            const XMFLOAT3& b = aGridVertices[aGridIndices[i + 1u]].Position;
+            const XMFLOAT3& c = aGridVertices[aGridIndices[i + 2u]].Position;
+
+            const FLOAT triangleArea = 0.5f * ((c.x - a.x) * (b.y - a.y) - (b.x - a.x) * (c.y - a.y));
+            TEST_CHECK(triangleArea > 0.0f);
+            area += triangleArea;
+
+            for (const XMFLOAT3* pCorner : { &a, &b, &c })
+            {
+                minCorner = XMFLOAT2(fminf(minCorner.x, pCorner->x), fminf(minCorner.y, pCorner->y));
+                maxCorner = XMFLOAT2(fmaxf(maxCorner.x, pCorner->x), fmaxf(maxCorner.y, pCorner->y));
+            }
+        }
+        TEST_CHECK(fabsf(area - static_cast<FLOAT>(GRID_SIZE * GRID_SIZE)) < 1e-3f);
+        TEST_CHECK(minCorner.x == 0.0f && minCorner.y == 0.0f);
+        TEST_CHECK(maxCorner.x == static_cast<FLOAT>(GRID_SIZE) && maxCorner.y == static_cast<FLOAT>(GRID_SIZE));
+
+        return TRUE;
+    }
+}
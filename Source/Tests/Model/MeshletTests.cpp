@@ -0,0 +1,263 @@
+#include "Tests.h"
+
+#include <random>
+
+#include "Fixtures.h"
+#include "Model/MeshOptimizer.h"
+#include "Model/Meshlet.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CheckMeshletCones
+
+      Summary:  Checks the bounds of every meshlet on its own. The
+                sphere has to hold the corners of the triangles and the
+                cone has to hold their normals. Then views the meshlets
+                from random points around the mesh, and every triangle
+                of a meshlet the cone test culls has to face away from
+                the point.
+
+      Args:     const std::vector<library::Meshlet>& aMeshlets
+                  Meshlets of the mesh
+                const std::vector<UINT>& aIndices
+                  Indices of the mesh
+                const std::vector<library::SimpleVertex>& aVertices
+                  Vertices of the mesh
+                UINT& uOutNumCulledTriangles
+                  Number of triangles culled over all the points
+
+      Returns:  BOOL
+                  Whether every bound held
+    -----------------------------------------------------------------F-F*/
+    static BOOL CheckMeshletCones(
+        _In_ const std::vector<library::Meshlet>& aMeshlets,
+        _In_ const std::vector<UINT>& aIndices,
+        _In_ const std::vector<library::SimpleVertex>& aVertices,
+        _Out_ UINT& uOutNumCulledTriangles
+    )
+    {
+        constexpr const UINT NUM_VIEWPOINTS = 64u;
+        constexpr const FLOAT TOLERANCE = 1e-4f;
+
+        uOutNumCulledTriangles = 0u;
+
+        for (const library::Meshlet& meshlet : aMeshlets)
+        {
+            const XMVECTOR center = XMLoadFloat3(&meshlet.Center);
+            const XMVECTOR axis = XMLoadFloat3(&meshlet.ConeAxis);
+            TEST_CHECK(meshlet.ConeCutoff >= 0.0f && meshlet.ConeCutoff <= 1.0f);
+            TEST_CHECK(meshlet.ConeCutoff == 1.0f || fabsf(XMVectorGetX(XMVector3Length(axis)) - 1.0f) < TOLERANCE);
+
+            // The cone holds a normal when the angle to the axis is at most the half angle of the cone
+            const FLOAT minCosine = sqrtf(1.0f - meshlet.ConeCutoff * meshlet.ConeCutoff);
+            for (UINT i = meshlet.uFirstIndex; i < meshlet.uFirstIndex + meshlet.uNumIndices; i += 3u)
+            {
+                const XMVECTOR p0 = XMLoadFloat3(&aVertices[aIndices[i]].Position);
+                const XMVECTOR p1 = XMLoadFloat3(&aVertices[aIndices[i + 1u]].Position);
+                const XMVECTOR p2 = XMLoadFloat3(&aVertices[aIndices[i + 2u]].Position);
+                for (const XMVECTOR& corner : { p0, p1, p2 })
+                {
+                    TEST_CHECK(XMVectorGetX(XMVector3Length(XMVectorSubtract(corner, center))) <= meshlet.Radius + TOLERANCE);
+                }
+
+                if (meshlet.ConeCutoff < 1.0f)
+                {
+                    const XMVECTOR normal = XMVector3Normalize(XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0)));
+                    TEST_CHECK(XMVectorGetX(XMVector3Dot(normal, axis)) >= minCosine - TOLERANCE);
+                }
+            }
+        }
+
+        BoundingBox bounds;
+        BoundingBox::CreateFromPoints(bounds, aVertices.size(), &aVertices[0].Position, sizeof(library::SimpleVertex));
+        const FLOAT distance = XMVectorGetX(XMVector3Length(XMLoadFloat3(&bounds.Extents))) * 2.0f;
+
+        std::mt19937 generator(49u);
+        std::uniform_real_distribution<FLOAT> direction(-1.0f, 1.0f);
+        for (UINT v = 0u; v < NUM_VIEWPOINTS; ++v)
+        {
+            XMVECTOR offset;
+            do
+            {
+                offset = XMVectorSet(direction(generator), direction(generator), direction(generator), 0.0f);
+            } while (XMVectorGetX(XMVector3LengthSq(offset)) < 1e-2f);
+            const XMVECTOR eye = XMVectorAdd(XMLoadFloat3(&bounds.Center), XMVectorScale(XMVector3Normalize(offset), distance));
+
+            for (const library::Meshlet& meshlet : aMeshlets)
+            {
+                if (!library::MeshletCuller::IsBackFacing(meshlet, eye))
+                {
+                    continue;
+                }
+
+                for (UINT i = meshlet.uFirstIndex; i < meshlet.uFirstIndex + meshlet.uNumIndices; i += 3u)
+                {
+                    const XMVECTOR p0 = XMLoadFloat3(&aVertices[aIndices[i]].Position);
+                    const XMVECTOR p1 = XMLoadFloat3(&aVertices[aIndices[i + 1u]].Position);
+                    const XMVECTOR p2 = XMLoadFloat3(&aVertices[aIndices[i + 2u]].Position);
+                    const XMVECTOR normal = XMVector3Normalize(XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0)));
+
+                    // Front faces wind clockwise in the left handed space, their normal points to the eye
+                    TEST_CHECK(XMVectorGetX(XMVector3Dot(normal, XMVector3Normalize(XMVectorSubtract(p0, eye)))) >= -TOLERANCE);
+                    ++uOutNumCulledTriangles;
+                }
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestMeshletCones
+
+      Summary:  Splits a torus sorted for the vertex cache into
+                meshlets, like Model does. The meshlets have to cover
+                the mesh within their limits, their cones have to hold
+                the normals of their triangles and cull no triangle
+                that faces the camera, while still culling some.
+                Meshlets with their cones turned around have to fail
+                the checks of the builder. Prints the meshlets and the
+                share of the culled triangles.
+
+      Returns:  BOOL
+                  Whether every meshlet held
+    -----------------------------------------------------------------F-F*/
+    BOOL TestMeshletCones()
+    {
+        constexpr const UINT NUM_RINGS = 96u;
+        constexpr const UINT NUM_SIDES = 48u;
+
+        std::vector<library::SimpleVertex> aVertices;
+        std::vector<UINT> aIndices;
+        CreateTorusMesh(NUM_RINGS, NUM_SIDES, aVertices, aIndices);
+        const UINT uNumVertices = static_cast<UINT>(aVertices.size());
+
+        library::MeshOptimizer optimizer;
+        optimizer.OptimizeVertexCache(aIndices, uNumVertices);
+
+        library::MeshletBuilder builder;
+        std::vector<library::Meshlet> aMeshlets;
+        builder.Build(aIndices, aVertices.data(), uNumVertices, aMeshlets);
+        TEST_CHECK(!aMeshlets.empty());
+
+        library::MeshletStats stats = {};
+        TEST_CHECK(builder.Analyze(aMeshlets.data(), static_cast<UINT>(aMeshlets.size()), aIndices, aVertices.data(), uNumVertices, stats));
+
+        UINT uNumCulledTriangles = 0u;
+        TEST_CHECK(CheckMeshletCones(aMeshlets, aIndices, aVertices, uNumCulledTriangles));
+
+        wprintf(
+            L"  %u meshlets, %.1f vertices and %.1f triangles each, %u with a cone, %.1f%% of the triangles culled along the axes\n",
+            stats.uNumMeshlets,
+            static_cast<FLOAT>(stats.uNumVertices) / static_cast<FLOAT>(stats.uNumMeshlets),
+            static_cast<FLOAT>(stats.uNumTriangles) / static_cast<FLOAT>(stats.uNumMeshlets),
+            stats.uNumCones,
+            100.0f * static_cast<FLOAT>(stats.uNumCulledTriangles) / static_cast<FLOAT>(stats.uNumViewedTriangles)
+        );
+
+        TEST_CHECK(stats.uNumMeshlets == aMeshlets.size());
+        TEST_CHECK(stats.uNumTriangles * 3u == aIndices.size());
+        TEST_CHECK(stats.uNumCones > 0u);
+        TEST_CHECK(stats.uNumCulledTriangles > 0u);
+        TEST_CHECK(stats.uNumWronglyCulledTriangles == 0u);
+        TEST_CHECK(uNumCulledTriangles > 0u);
+
+        // Cones pointing the wrong way hold none of the normals
+        std::vector<library::Meshlet> aFlippedMeshlets = aMeshlets;
+        for (library::Meshlet& meshlet : aFlippedMeshlets)
+        {
+            XMStoreFloat3(&meshlet.ConeAxis, XMVectorNegate(XMLoadFloat3(&meshlet.ConeAxis)));
+        }
+        library::MeshletStats flippedStats = {};
+        TEST_CHECK(!builder.Analyze(aFlippedMeshlets.data(), static_cast<UINT>(aFlippedMeshlets.size()), aIndices, aVertices.data(), uNumVertices, flippedStats));
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestModelMeshlets
+
+      Summary:  Splits every mesh of the animated guard into meshlets
+                again, from its indices as the model stores them. The
+                meshlets have to pass the checks of the builder, cover
+                the indices of their mesh in order and match the
+                meshlets the model built when it was loaded. Prints
+                the meshlets and the share of the culled triangles.
+
+      Returns:  BOOL
+                  Whether every meshlet of the guard held
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelMeshlets()
+    {
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        TestModel model(GetContentPath(L"BobLampClean/boblampclean.md5mesh"));
+        TEST_CHECK(SUCCEEDED(model.Initialize(device.Get(), immediateContext.Get())));
+
+        const library::ModelAsset& asset = model.GetAsset();
+        const UINT uNumMeshes = static_cast<UINT>(model.m_aMeshes.size());
+        TEST_CHECK(uNumMeshes > 0u);
+        TEST_CHECK(asset.aMeshletOffsets.size() == uNumMeshes + 1u);
+
+        library::MeshletBuilder builder;
+        library::MeshletStats stats = {};
+        std::vector<library::Meshlet> aMeshlets;
+        std::vector<UINT> aIndices;
+        UINT uNumIndices = 0u;
+        for (UINT i = 0u; i < uNumMeshes; ++i)
+        {
+            const library::Renderable::BasicMeshEntry& mesh = model.m_aMeshes[i];
+            const UINT uEndVertex = i + 1u < uNumMeshes ? model.m_aMeshes[i + 1u].uBaseVertex : static_cast<UINT>(asset.aVertices.size());
+            const UINT uNumVertices = uEndVertex - mesh.uBaseVertex;
+            TEST_CHECK(uNumVertices > 0u);
+
+            aIndices.resize(mesh.uNumIndices);
+            for (UINT j = 0u; j < mesh.uNumIndices; ++j)
+            {
+                aIndices[j] = TestModel::readIndex(asset.aIndices, mesh, j);
+            }
+            uNumIndices += mesh.uNumIndices;
+
+            aMeshlets.clear();
+            builder.Build(aIndices, &asset.aVertices[mesh.uBaseVertex], uNumVertices, aMeshlets);
+            TEST_CHECK(builder.Analyze(aMeshlets.data(), static_cast<UINT>(aMeshlets.size()), aIndices, &asset.aVertices[mesh.uBaseVertex], uNumVertices, stats));
+
+            // Every meshlet is the range of the indices right after the one before
+            UINT uNextIndex = 0u;
+            for (const library::Meshlet& meshlet : aMeshlets)
+            {
+                TEST_CHECK(meshlet.uFirstIndex == uNextIndex);
+                TEST_CHECK(meshlet.uNumIndices > 0u && meshlet.uNumIndices <= library::MeshletBuilder::MAX_TRIANGLES * 3u);
+                uNextIndex += meshlet.uNumIndices;
+            }
+            TEST_CHECK(uNextIndex == mesh.uNumIndices);
+
+            const UINT uFirstMeshlet = asset.aMeshletOffsets[i];
+            TEST_CHECK(asset.aMeshletOffsets[i + 1u] - uFirstMeshlet == aMeshlets.size());
+            for (size_t j = 0u; j < aMeshlets.size(); ++j)
+            {
+                TEST_CHECK(asset.aMeshlets[uFirstMeshlet + j].uFirstIndex == aMeshlets[j].uFirstIndex);
+                TEST_CHECK(asset.aMeshlets[uFirstMeshlet + j].uNumIndices == aMeshlets[j].uNumIndices);
+            }
+        }
+
+        wprintf(
+            L"  %u meshes, %u meshlets, %.1f vertices and %.1f triangles each, %u with a cone, %.1f%% of the triangles culled along the axes\n",
+            uNumMeshes,
+            stats.uNumMeshlets,
+            static_cast<FLOAT>(stats.uNumVertices) / static_cast<FLOAT>(stats.uNumMeshlets),
+            static_cast<FLOAT>(stats.uNumTriangles) / static_cast<FLOAT>(stats.uNumMeshlets),
+            stats.uNumCones,
+            100.0f * static_cast<FLOAT>(stats.uNumCulledTriangles) / static_cast<FLOAT>(stats.uNumViewedTriangles > 0u ? stats.uNumViewedTriangles : 1u)
+        );
+
+        TEST_CHECK(stats.uNumMeshlets == asset.aMeshlets.size());
+        TEST_CHECK(stats.uNumTriangles * 3u == uNumIndices);
+        TEST_CHECK(stats.uNumWronglyCulledTriangles == 0u);
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,158 @@
+#include "Tests.h"
+
+#include <fstream>
+
+#include "Model/ModelCache.h"
+#include "Renderer/DataTypes.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: WriteSourceFile
+
+      Summary:  Writes a stand-in for a model file, the cache only
+                looks at its size and write time
+
+      Args:     const std::filesystem::path& sourcePath
+                  Path to the file
+                size_t uNumBytes
+                  Size of the file
+
+      Returns:  BOOL
+                  Whether the file was written
+    -----------------------------------------------------------------F-F*/
+    static BOOL WriteSourceFile(
+        _In_ const std::filesystem::path& sourcePath,
+        _In_ size_t uNumBytes
+    )
+    {
+        std::ofstream sourceFile(sourcePath, std::ios::binary | std::ios::trunc);
+        const std::string szContents(uNumBytes, 'm');
+        sourceFile.write(szContents.data(), static_cast<std::streamsize>(szContents.size()));
+
+        return static_cast<BOOL>(sourceFile.good());
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: RoundTripCache
+
+      Summary:  Saves values, arrays of vertices and indices and strings
+                behind a header, maps them back and compares them. The
+                arrays viewed in place have to be aligned, a read past
+                the end has to fail for good, and a different layout or
+                a changed source file has to make the cache stale.
+
+      Args:     const std::filesystem::path& directory
+                  Directory the source and cache files are written to
+
+      Returns:  BOOL
+                  Whether everything read back was written
+    -----------------------------------------------------------------F-F*/
+    static BOOL RoundTripCache(
+        _In_ const std::filesystem::path& directory
+    )
+    {
+        constexpr const UINT LAYOUT = 0x1234u;
+        constexpr const UINT NUM_VERTICES = 1001u;
+
+        const std::filesystem::path sourcePath = directory / L"Source.model";
+        const std::filesystem::path cachePath = directory / L"Source.modelcache";
+        TEST_CHECK(WriteSourceFile(sourcePath, 4096u));
+
+        std::vector<library::SimpleVertex> aVertices(NUM_VERTICES);
+        std::vector<WORD> aIndices(NUM_VERTICES * 3u);
+        for (UINT i = 0u; i < NUM_VERTICES; ++i)
+        {
+            const FLOAT value = static_cast<FLOAT>(i);
+            aVertices[i] = { XMFLOAT3(value, -value, value * 0.5f), XMFLOAT2(value / NUM_VERTICES, 1.0f), XMFLOAT3(0.0f, 1.0f, 0.0f) };
+            aIndices[i * 3u] = static_cast<WORD>(i);
+            aIndices[i * 3u + 1u] = static_cast<WORD>((i + 1u) % NUM_VERTICES);
+            aIndices[i * 3u + 2u] = static_cast<WORD>((i + 2u) % NUM_VERTICES);
+        }
+        const std::vector<UINT> aEmpty;
+        const std::string szName = "Armature|Walk";
+        const XMFLOAT4X4 transform(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f);
+
+        {
+            library::ModelCacheWriter writer;
+            writer.Write(static_cast<BYTE>(7u));
+            writer.WriteArray(aVertices);
+            writer.WriteString(szName);
+            writer.WriteArray(aIndices);
+            writer.WriteArray(aEmpty);
+            writer.Write(transform);
+            writer.WriteString(std::string());
+            TEST_CHECK(SUCCEEDED(writer.Save(cachePath, sourcePath, LAYOUT)) && std::filesystem::exists(cachePath));
+        }
+
+        {
+            library::ModelCacheReader reader;
+            TEST_CHECK(reader.Open(cachePath, sourcePath, LAYOUT) == S_OK);
+
+            BYTE uByte = 0u;
+            TEST_CHECK(reader.Read(uByte) && uByte == 7u);
+
+            size_t uNumVertices = 0u;
+            const library::SimpleVertex* pVertices = reader.ViewArray<library::SimpleVertex>(uNumVertices);
+            TEST_CHECK(pVertices && uNumVertices == NUM_VERTICES);
+            TEST_CHECK(reinterpret_cast<uintptr_t>(pVertices) % library::ModelCacheWriter::ALIGNMENT == 0u);
+            TEST_CHECK(memcmp(pVertices, aVertices.data(), aVertices.size() * sizeof(library::SimpleVertex)) == 0);
+
+            std::string szReadName;
+            TEST_CHECK(reader.ReadString(szReadName) && szReadName == szName);
+
+            std::vector<WORD> aReadIndices;
+            TEST_CHECK(reader.ReadArray(aReadIndices) && aReadIndices == aIndices);
+
+            std::vector<UINT> aReadEmpty(3u);
+            TEST_CHECK(reader.ReadArray(aReadEmpty) && aReadEmpty.empty());
+
+            XMFLOAT4X4 readTransform;
+            TEST_CHECK(reader.Read(readTransform) && memcmp(&readTransform, &transform, sizeof(transform)) == 0);
+
+            std::string szReadEmpty = "stale";
+            TEST_CHECK(reader.ReadString(szReadEmpty) && szReadEmpty.empty());
+            TEST_CHECK(!reader.HasFailed());
+
+            // Everything was read, a further read runs past the end and every read after it fails
+            UINT uPastEnd = 0u;
+            TEST_CHECK(!reader.Read(uPastEnd));
+            TEST_CHECK(reader.HasFailed());
+            TEST_CHECK(!reader.Read(uByte));
+        }
+
+        library::ModelCacheReader reader;
+        TEST_CHECK(reader.Open(cachePath, sourcePath, LAYOUT + 1u) == S_FALSE);
+        TEST_CHECK(reader.Open(directory / L"Missing.modelcache", sourcePath, LAYOUT) == S_FALSE);
+        TEST_CHECK(FAILED(reader.Open(cachePath, directory / L"Missing.model", LAYOUT)));
+
+        TEST_CHECK(WriteSourceFile(sourcePath, 4097u));
+        TEST_CHECK(reader.Open(cachePath, sourcePath, LAYOUT) == S_FALSE);
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestModelCacheRoundTrip
+
+      Summary:  Round trips a cache in a directory of its own under the
+                temporary directory and removes the directory after
+
+      Returns:  BOOL
+                  Whether the cache read back what was written
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelCacheRoundTrip()
+    {
+        std::error_code error;
+        const std::filesystem::path directory = std::filesystem::temp_directory_path(error) / L"LibraryTests";
+        TEST_CHECK(!error);
+        std::filesystem::remove_all(directory, error);
+        TEST_CHECK(std::filesystem::create_directories(directory, error));
+
+        const BOOL bPassed = RoundTripCache(directory);
+
+        std::filesystem::remove_all(directory, error);
+
+        return bPassed;
+    }
+}
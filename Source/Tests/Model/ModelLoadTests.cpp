@@ -0,0 +1,78 @@
+#include "Tests.h"
+
+#include "Fixtures.h"
+
+#include "Scene/JobSystem.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestConcurrentModelLoad
+
+      Summary:  Initializes instances of the animated guard from every
+                thread of a job system at once. They all have to share
+                the asset of the one instance that loaded it. Once the
+                last of them is released, the asset has expired and
+                the next round loads it again.
+
+      Returns:  BOOL
+                  Whether every round shared a single asset
+    -----------------------------------------------------------------F-F*/
+    BOOL TestConcurrentModelLoad()
+    {
+        constexpr const UINT NUM_INSTANCES = 64u;
+        constexpr const UINT NUM_ROUNDS = 3u;
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        const UINT uNumHardwareThreads = std::thread::hardware_concurrency() > 0u ? std::thread::hardware_concurrency() : 1u;
+        library::JobSystem jobSystem(uNumHardwareThreads);
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+
+        std::weak_ptr<library::ModelAsset> previousAsset;
+        for (UINT uRound = 0u; uRound < NUM_ROUNDS; ++uRound)
+        {
+            std::vector<std::unique_ptr<TestModel>> aModels(NUM_INSTANCES);
+            std::vector<HRESULT> aResults(NUM_INSTANCES, E_FAIL);
+
+            QueryPerformanceCounter(&startTime);
+
+            jobSystem.ParallelFor(
+                NUM_INSTANCES,
+                [&aModels, &aResults, &device, &immediateContext](UINT uModelIndex)
+                {
+                    aModels[uModelIndex] = std::make_unique<TestModel>(GetContentPath(L"BobLampClean/boblampclean.md5mesh"));
+                    aResults[uModelIndex] = aModels[uModelIndex]->Initialize(device.Get(), immediateContext.Get());
+                }
+            );
+
+            QueryPerformanceCounter(&endTime);
+
+            for (UINT i = 0u; i < NUM_INSTANCES; ++i)
+            {
+                TEST_CHECK(SUCCEEDED(aResults[i]));
+                TEST_CHECK(&aModels[i]->GetAsset() == &aModels[0]->GetAsset());
+            }
+
+            // The instances of the previous round are gone, so this round had to load its own asset
+            TEST_CHECK(previousAsset.expired());
+            previousAsset = aModels[0]->m_asset;
+
+            wprintf(
+                L"  round %u: %u instances on %u threads in %.3f ms\n",
+                uRound,
+                NUM_INSTANCES,
+                jobSystem.GetNumThreads(),
+                static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart)
+            );
+        }
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,397 @@
+#include "Tests.h"
+
+#include "Fixtures.h"
+
+#include "Model/AnimationLod.h"
+#include "Scene/JobSystem.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: IsSamePose
+
+      Summary:  Compares the palettes of two instances of a model
+                bit for bit
+
+      Args:     const library::Model& model
+                  Instance to check
+                const library::Model& reference
+                  Instance holding the expected palette
+
+      Returns:  BOOL
+                  Whether both instances hold the same palette
+    -----------------------------------------------------------------F-F*/
+    static BOOL IsSamePose(
+        _In_ const library::Model& model,
+        _In_ const library::Model& reference
+    )
+    {
+        const std::vector<XMFLOAT3X4A>& aBoneTransforms = model.GetBoneTransforms();
+        const std::vector<XMFLOAT3X4A>& aReferenceTransforms = reference.GetBoneTransforms();
+
+        return aBoneTransforms.size() == aReferenceTransforms.size()
+            && memcmp(aBoneTransforms.data(), aReferenceTransforms.data(), aBoneTransforms.size() * sizeof(XMFLOAT3X4A)) == 0;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetPoseError
+
+      Summary:  Measures the largest difference between the palettes of
+                two instances of a model, relative to the size of the
+                expected values
+
+      Args:     const library::Model& model
+                  Instance to check
+                const library::Model& reference
+                  Instance holding the expected palette
+
+      Returns:  FLOAT
+                  Largest relative error
+    -----------------------------------------------------------------F-F*/
+    static FLOAT GetPoseError(
+        _In_ const library::Model& model,
+        _In_ const library::Model& reference
+    )
+    {
+        const std::vector<XMFLOAT3X4A>& aBoneTransforms = model.GetBoneTransforms();
+        const std::vector<XMFLOAT3X4A>& aReferenceTransforms = reference.GetBoneTransforms();
+
+        FLOAT maxError = 0.0f;
+        for (size_t i = 0u; i < aBoneTransforms.size(); ++i)
+        {
+            const XMMATRIX transform = XMLoadFloat3x4A(&aBoneTransforms[i]);
+            const XMMATRIX referenceTransform = XMLoadFloat3x4A(&aReferenceTransforms[i]);
+            for (UINT uRow = 0u; uRow < 3u; ++uRow)
+            {
+                XMFLOAT4 error;
+                XMStoreFloat4(
+                    &error,
+                    XMVectorDivide(
+                        XMVectorAbs(XMVectorSubtract(transform.r[uRow], referenceTransform.r[uRow])),
+                        XMVectorAdd(g_XMOne, XMVectorAbs(referenceTransform.r[uRow]))
+                    )
+                );
+                maxError = fmaxf(maxError, fmaxf(fmaxf(error.x, error.y), fmaxf(error.z, error.w)));
+            }
+        }
+
+        return maxError;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestModelUpdate
+
+      Summary:  Loads instances of the animated guard of the game and
+                benchmarks their updates at full rate, one instance
+                after another. Every instance has to evaluate a pose
+                each frame, and instances that started together have
+                to hold the same pose.
+
+      Returns:  BOOL
+                  Whether every instance animated in step
+    -----------------------------------------------------------------F-F*/
+    BOOL TestModelUpdate()
+    {
+        constexpr const UINT NUM_INSTANCES = 256u;
+        constexpr const UINT NUM_FRAMES = 120u;
+        constexpr const FLOAT FRAME_TIME = 1.0f / 60.0f;
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        std::vector<std::unique_ptr<library::Model>> aModels;
+        TEST_CHECK(SUCCEEDED(CreateModelInstances(device.Get(), immediateContext.Get(), L"BobLampClean/boblampclean.md5mesh", NUM_INSTANCES, library::eSkinningMode::LINEAR_BLEND, aModels)));
+
+        const UINT64 uFirstVersion = aModels[0]->GetBoneTransformsVersion();
+        const std::vector<XMFLOAT3X4A> aBindPose = aModels[0]->GetBoneTransforms();
+        TEST_CHECK(aBindPose.size() > 1u);
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+
+        FLOAT totalMilliseconds = 0.0f;
+        FLOAT slowestMilliseconds = 0.0f;
+        for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+        {
+            QueryPerformanceCounter(&startTime);
+
+            for (std::unique_ptr<library::Model>& model : aModels)
+            {
+                model->Update(FRAME_TIME);
+            }
+
+            QueryPerformanceCounter(&endTime);
+
+            const FLOAT milliseconds = static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+            totalMilliseconds += milliseconds;
+            slowestMilliseconds = fmaxf(slowestMilliseconds, milliseconds);
+        }
+
+        wprintf(
+            L"  %u instances of %u bones, %.3f ms per frame, %.3f ms slowest frame, %.2f us per update\n",
+            NUM_INSTANCES,
+            static_cast<UINT>(aBindPose.size()),
+            totalMilliseconds / static_cast<FLOAT>(NUM_FRAMES),
+            slowestMilliseconds,
+            totalMilliseconds * 1000.0f / static_cast<FLOAT>(NUM_FRAMES * NUM_INSTANCES)
+        );
+
+        // The clip moves the guard, so the palette left the bind pose
+        TEST_CHECK(memcmp(aBindPose.data(), aModels[0]->GetBoneTransforms().data(), aBindPose.size() * sizeof(XMFLOAT3X4A)) != 0);
+
+        for (const std::unique_ptr<library::Model>& model : aModels)
+        {
+            TEST_CHECK(model->GetBoneTransformsVersion() == uFirstVersion + NUM_FRAMES);
+            TEST_CHECK(IsSamePose(*model, *aModels[0]));
+        }
+
+        for (const XMFLOAT3X4A& boneTransform : aModels[0]->GetBoneTransforms())
+        {
+            const XMMATRIX transform = XMLoadFloat3x4A(&boneTransform);
+            for (UINT uRow = 0u; uRow < 4u; ++uRow)
+            {
+                TEST_CHECK(!XMVector4IsNaN(transform.r[uRow]) && !XMVector4IsInfinite(transform.r[uRow]));
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestParallelModelUpdate
+
+      Summary:  Benchmarks the updates of instances of the animated
+                guard spread over job systems of one thread up to the
+                hardware threads, the way the scene updates its models.
+                After every run each instance has to hold the pose of
+                an instance updated alone on the main thread.
+
+      Returns:  BOOL
+                  Whether the parallel updates matched the serial one
+    -----------------------------------------------------------------F-F*/
+    BOOL TestParallelModelUpdate()
+    {
+        constexpr const UINT NUM_INSTANCES = 512u;
+        constexpr const UINT NUM_FRAMES = 60u;
+        constexpr const FLOAT FRAME_TIME = 1.0f / 60.0f;
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        // The last instance is the reference, updated on the main thread only
+        std::vector<std::unique_ptr<library::Model>> aModels;
+        TEST_CHECK(SUCCEEDED(CreateModelInstances(device.Get(), immediateContext.Get(), L"BobLampClean/boblampclean.md5mesh", NUM_INSTANCES + 1u, library::eSkinningMode::LINEAR_BLEND, aModels)));
+
+        std::unique_ptr<library::Model> reference = std::move(aModels.back());
+        aModels.pop_back();
+
+        std::vector<UINT> aThreadCounts;
+        const UINT uNumHardwareThreads = std::thread::hardware_concurrency() > 0u ? std::thread::hardware_concurrency() : 1u;
+        for (UINT uNumThreads = 1u; uNumThreads < uNumHardwareThreads; uNumThreads *= 2u)
+        {
+            aThreadCounts.push_back(uNumThreads);
+        }
+        aThreadCounts.push_back(uNumHardwareThreads);
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+
+        FLOAT singleThreadMilliseconds = 0.0f;
+        for (UINT uNumThreads : aThreadCounts)
+        {
+            library::JobSystem jobSystem(uNumThreads);
+            TEST_CHECK(jobSystem.GetNumThreads() == uNumThreads);
+
+            const UINT64 uFirstVersion = aModels[0]->GetBoneTransformsVersion();
+
+            FLOAT totalMilliseconds = 0.0f;
+            for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+            {
+                QueryPerformanceCounter(&startTime);
+
+                jobSystem.ParallelFor(
+                    NUM_INSTANCES,
+                    [&aModels](UINT uModelIndex)
+                    {
+                        aModels[uModelIndex]->Update(FRAME_TIME);
+                    }
+                );
+
+                QueryPerformanceCounter(&endTime);
+                totalMilliseconds += static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+
+                reference->Update(FRAME_TIME);
+            }
+
+            const FLOAT milliseconds = totalMilliseconds / static_cast<FLOAT>(NUM_FRAMES);
+            if (uNumThreads == 1u)
+            {
+                singleThreadMilliseconds = milliseconds;
+            }
+
+            wprintf(
+                L"  %u threads: %u instances in %.3f ms per frame, %.2fx the single thread\n",
+                uNumThreads,
+                NUM_INSTANCES,
+                milliseconds,
+                singleThreadMilliseconds / fmaxf(milliseconds, 1e-6f)
+            );
+
+            for (const std::unique_ptr<library::Model>& model : aModels)
+            {
+                TEST_CHECK(model->GetBoneTransformsVersion() == uFirstVersion + NUM_FRAMES);
+                TEST_CHECK(IsSamePose(*model, *reference));
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestAnimationLodCrowd
+
+      Summary:  Lays a large crowd of animated guards out on a grid in
+                front of a camera and benchmarks their updates at full
+                rate against the levels the scene would select. Every
+                instance that is not frozen has to produce a new pose
+                each frame, blended or evaluated. A guard at half rate
+                then has to stay close to a guard updated at full rate
+                and move on every frame.
+
+      Returns:  BOOL
+                  Whether the crowd animated at its selected levels
+    -----------------------------------------------------------------F-F*/
+    BOOL TestAnimationLodCrowd()
+    {
+        constexpr const UINT NUM_COLUMNS = 40u;
+        constexpr const UINT NUM_ROWS = 50u;
+        constexpr const UINT NUM_INSTANCES = NUM_COLUMNS * NUM_ROWS;
+        constexpr const UINT NUM_FRAMES = 60u;
+        constexpr const FLOAT FRAME_TIME = 1.0f / 60.0f;
+        constexpr const FLOAT SPACING = 4.0f;
+        constexpr const FLOAT BLEND_TOLERANCE = 2e-2f;
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        // The last two instances compare the half rate with the full rate
+        std::vector<std::unique_ptr<library::Model>> aModels;
+        TEST_CHECK(SUCCEEDED(CreateModelInstances(device.Get(), immediateContext.Get(), L"BobLampClean/boblampclean.md5mesh", NUM_INSTANCES + 2u, library::eSkinningMode::LINEAR_BLEND, aModels)));
+
+        std::unique_ptr<library::Model> reference = std::move(aModels.back());
+        aModels.pop_back();
+        std::unique_ptr<library::Model> halfRate = std::move(aModels.back());
+        aModels.pop_back();
+
+        // Placed the way the game places the guard, the rows run away from the camera
+        for (UINT uRow = 0u; uRow < NUM_ROWS; ++uRow)
+        {
+            for (UINT uColumn = 0u; uColumn < NUM_COLUMNS; ++uColumn)
+            {
+                library::Model* pModel = aModels[uRow * NUM_COLUMNS + uColumn].get();
+                pModel->RotateX(-XM_PIDIV2);
+                pModel->Scale(0.2f, 0.2f, 0.2f);
+                pModel->Translate(XMVectorSet((static_cast<FLOAT>(uColumn) - 0.5f * static_cast<FLOAT>(NUM_COLUMNS)) * SPACING, 0.0f, static_cast<FLOAT>(uRow) * SPACING, 0.0f));
+            }
+        }
+
+        library::AnimationLodSelector selector;
+        const XMVECTOR eye = XMVectorSet(0.0f, 8.0f, -12.0f, 1.0f);
+        const XMMATRIX view = XMMatrixLookAtLH(eye, XMVectorSet(0.0f, 0.0f, 40.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 1000.0f);
+        selector.SetViewpoint(eye, view, projection);
+
+        UINT auNumInstances[static_cast<size_t>(library::eAnimationLod::COUNT)] = { 0u, };
+        for (const std::unique_ptr<library::Model>& model : aModels)
+        {
+            ++auNumInstances[static_cast<size_t>(selector.Select(model->GetBoundingSphere()).Level)];
+        }
+
+        // Some of the crowd has to be left at full rate, and some of it reduced or frozen
+        TEST_CHECK(auNumInstances[static_cast<size_t>(library::eAnimationLod::FULL)] > 0u);
+        TEST_CHECK(auNumInstances[static_cast<size_t>(library::eAnimationLod::FULL)] < NUM_INSTANCES);
+
+        LARGE_INTEGER frequency;
+        LARGE_INTEGER startTime;
+        LARGE_INTEGER endTime;
+        QueryPerformanceFrequency(&frequency);
+
+        FLOAT afMilliseconds[2] = { 0.0f, 0.0f };
+        std::vector<UINT64> aFirstVersions(NUM_INSTANCES);
+        for (UINT uPass = 0u; uPass < 2u; ++uPass)
+        {
+            const BOOL bSelect = uPass == 1u;
+            for (UINT i = 0u; i < NUM_INSTANCES; ++i)
+            {
+                aFirstVersions[i] = aModels[i]->GetBoneTransformsVersion();
+            }
+
+            for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+            {
+                QueryPerformanceCounter(&startTime);
+
+                for (std::unique_ptr<library::Model>& model : aModels)
+                {
+                    model->SetAnimationLod(bSelect ? selector.Select(model->GetBoundingSphere()) : library::AnimationLodSelector::GetLod(library::eAnimationLod::FULL));
+                    model->Update(FRAME_TIME);
+                }
+
+                QueryPerformanceCounter(&endTime);
+                afMilliseconds[uPass] += static_cast<FLOAT>(endTime.QuadPart - startTime.QuadPart) * 1000.0f / static_cast<FLOAT>(frequency.QuadPart);
+            }
+
+            for (UINT i = 0u; i < NUM_INSTANCES; ++i)
+            {
+                const BOOL bFrozen = aModels[i]->GetAnimationLod().uUpdateInterval == 0u;
+                TEST_CHECK(aModels[i]->GetBoneTransformsVersion() == aFirstVersions[i] + (bFrozen ? 0u : NUM_FRAMES));
+            }
+        }
+
+        wprintf(
+            L"  %u instances: %.3f ms per frame at full rate, %.3f ms at the selected levels (%.2fx)\n",
+            NUM_INSTANCES,
+            afMilliseconds[0] / static_cast<FLOAT>(NUM_FRAMES),
+            afMilliseconds[1] / static_cast<FLOAT>(NUM_FRAMES),
+            afMilliseconds[0] / fmaxf(afMilliseconds[1], 1e-6f)
+        );
+        wprintf(
+            L"  %u full, %u half rate, %u quarter rate, %u quarter rate without leaves, %u frozen\n",
+            auNumInstances[static_cast<size_t>(library::eAnimationLod::FULL)],
+            auNumInstances[static_cast<size_t>(library::eAnimationLod::HALF_RATE)],
+            auNumInstances[static_cast<size_t>(library::eAnimationLod::QUARTER_RATE)],
+            auNumInstances[static_cast<size_t>(library::eAnimationLod::QUARTER_RATE_NO_LEAVES)],
+            auNumInstances[static_cast<size_t>(library::eAnimationLod::FROZEN)]
+        );
+
+        halfRate->SetAnimationLod(library::AnimationLodSelector::GetLod(library::eAnimationLod::HALF_RATE));
+        reference->SetAnimationLod(library::AnimationLodSelector::GetLod(library::eAnimationLod::FULL));
+
+        FLOAT maxError = 0.0f;
+        std::vector<XMFLOAT3X4A> aPreviousPose = halfRate->GetBoneTransforms();
+        for (UINT uFrame = 0u; uFrame < NUM_FRAMES; ++uFrame)
+        {
+            halfRate->Update(FRAME_TIME);
+            reference->Update(FRAME_TIME);
+
+            // The blend starts from the pose on screen, there is none before the first frame
+            if (uFrame > 0u)
+            {
+                TEST_CHECK(memcmp(aPreviousPose.data(), halfRate->GetBoneTransforms().data(), aPreviousPose.size() * sizeof(XMFLOAT3X4A)) != 0);
+                maxError = fmaxf(maxError, GetPoseError(*halfRate, *reference));
+            }
+            aPreviousPose = halfRate->GetBoneTransforms();
+        }
+
+        wprintf(L"  half rate blended within %.6f of the full rate over %u frames\n", maxError, NUM_FRAMES);
+        TEST_CHECK(maxError <= BLEND_TOLERANCE);
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,280 @@
+#include "Tests.h"
+
+#include "Fixtures.h"
+
+#include "assimp/scene.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SampleVectorKeys
+
+      Summary:  Interpolates linearly between the keys around a time,
+                clamped to the first and the last key
+
+      Args:     const aiVectorKey* aKeys
+                  Keys sorted by time
+                UINT uNumKeys
+                  Number of keys
+                FLOAT animationTimeTicks
+                  Animation time
+
+      Returns:  XMVECTOR
+                  Interpolated value
+    -----------------------------------------------------------------F-F*/
+    static XMVECTOR SampleVectorKeys(
+        _In_ const aiVectorKey* aKeys,
+        _In_ UINT uNumKeys,
+        _In_ FLOAT animationTimeTicks
+    )
+    {
+        UINT uNextKey = 0u;
+        while (uNextKey < uNumKeys && static_cast<FLOAT>(aKeys[uNextKey].mTime) < animationTimeTicks)
+        {
+            ++uNextKey;
+        }
+
+        if (uNextKey == 0u || uNextKey == uNumKeys)
+        {
+            const aiVector3D& value = aKeys[uNextKey == 0u ? 0u : uNumKeys - 1u].mValue;
+            return XMVectorSet(value.x, value.y, value.z, 0.0f);
+        }
+
+        const aiVectorKey& previous = aKeys[uNextKey - 1u];
+        const aiVectorKey& next = aKeys[uNextKey];
+        const FLOAT factor = (animationTimeTicks - static_cast<FLOAT>(previous.mTime)) / static_cast<FLOAT>(next.mTime - previous.mTime);
+
+        return XMVectorLerp(
+            XMVectorSet(previous.mValue.x, previous.mValue.y, previous.mValue.z, 0.0f),
+            XMVectorSet(next.mValue.x, next.mValue.y, next.mValue.z, 0.0f),
+            factor
+        );
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: SampleQuaternionKeys
+
+      Summary:  Interpolates spherically between the keys around a
+                time, clamped to the first and the last key
+
+      Args:     const aiQuatKey* aKeys
+                  Keys sorted by time
+                UINT uNumKeys
+                  Number of keys
+                FLOAT animationTimeTicks
+                  Animation time
+
+      Returns:  XMVECTOR
+                  Interpolated rotation quaternion
+    -----------------------------------------------------------------F-F*/
+    static XMVECTOR SampleQuaternionKeys(
+        _In_ const aiQuatKey* aKeys,
+        _In_ UINT uNumKeys,
+        _In_ FLOAT animationTimeTicks
+    )
+    {
+        UINT uNextKey = 0u;
+        while (uNextKey < uNumKeys && static_cast<FLOAT>(aKeys[uNextKey].mTime) < animationTimeTicks)
+        {
+            ++uNextKey;
+        }
+
+        if (uNextKey == 0u || uNextKey == uNumKeys)
+        {
+            const aiQuaternion& value = aKeys[uNextKey == 0u ? 0u : uNumKeys - 1u].mValue;
+            return XMVectorSet(value.x, value.y, value.z, value.w);
+        }
+
+        const aiQuatKey& previous = aKeys[uNextKey - 1u];
+        const aiQuatKey& next = aKeys[uNextKey];
+        const FLOAT factor = (animationTimeTicks - static_cast<FLOAT>(previous.mTime)) / static_cast<FLOAT>(next.mTime - previous.mTime);
+
+        return XMQuaternionSlerp(
+            XMVectorSet(previous.mValue.x, previous.mValue.y, previous.mValue.z, previous.mValue.w),
+            XMVectorSet(next.mValue.x, next.mValue.y, next.mValue.z, next.mValue.w),
+            factor
+        );
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: GetNodeHeight
+
+      Summary:  Counts the levels of the deepest branch below a node
+
+      Args:     const aiNode* pNode
+                  Node of the hierarchy
+
+      Returns:  UINT
+                  Height of the node, 0 for a leaf
+    -----------------------------------------------------------------F-F*/
+    static UINT GetNodeHeight(
+        _In_ const aiNode* pNode
+    )
+    {
+        UINT uHeight = 0u;
+        for (UINT i = 0u; i < pNode->mNumChildren; ++i)
+        {
+            const UINT uChildHeight = GetNodeHeight(pNode->mChildren[i]) + 1u;
+            if (uChildHeight > uHeight)
+            {
+                uHeight = uChildHeight;
+            }
+        }
+
+        return uHeight;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: EvaluateNode
+
+      Summary:  Walks the hierarchy of the scene recursively, sampling
+                the source keys of the animated nodes, and appends the
+                global transform of every node in depth first order.
+                With the leaf bones skipped, the nodes less than two
+                levels above a leaf keep their bind pose.
+
+      Args:     const aiAnimation* pAnimation
+                  Animation of the scene
+                const aiNode* pNode
+                  Node to evaluate with its descendants
+                FLOAT animationTimeTicks
+                  Animation time
+                BOOL bSkipLeafBones
+                  Whether the leaf bones are collapsed onto their parent
+                const XMMATRIX& parentTransform
+                  Global transform of the parent of the node
+                std::vector<XMMATRIX>& aGlobalTransforms
+                  Global transforms the node and its descendants are
+                  appended to
+    -----------------------------------------------------------------F-F*/
+    static void EvaluateNode(
+        _In_ const aiAnimation* pAnimation,
+        _In_ const aiNode* pNode,
+        _In_ FLOAT animationTimeTicks,
+        _In_ BOOL bSkipLeafBones,
+        _In_ const XMMATRIX& parentTransform,
+        _Inout_ std::vector<XMMATRIX>& aGlobalTransforms
+    )
+    {
+        XMMATRIX localTransform = XMMatrixTranspose(XMMATRIX(&pNode->mTransformation.a1));
+
+        for (UINT i = 0u; i < pAnimation->mNumChannels; ++i)
+        {
+            const aiNodeAnim* pChannel = pAnimation->mChannels[i];
+            if (pChannel->mNodeName == pNode->mName && (!bSkipLeafBones || GetNodeHeight(pNode) >= 2u))
+            {
+                localTransform = XMMatrixAffineTransformation(
+                    SampleVectorKeys(pChannel->mScalingKeys, pChannel->mNumScalingKeys, animationTimeTicks),
+                    g_XMZero,
+                    SampleQuaternionKeys(pChannel->mRotationKeys, pChannel->mNumRotationKeys, animationTimeTicks),
+                    SampleVectorKeys(pChannel->mPositionKeys, pChannel->mNumPositionKeys, animationTimeTicks)
+                );
+                break;
+            }
+        }
+
+        const XMMATRIX globalTransform = localTransform * parentTransform;
+        aGlobalTransforms.push_back(globalTransform);
+
+        for (UINT i = 0u; i < pNode->mNumChildren; ++i)
+        {
+            EvaluateNode(pAnimation, pNode->mChildren[i], animationTimeTicks, bSkipLeafBones, globalTransform, aGlobalTransforms);
+        }
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestSkeletonEvaluation
+
+      Summary:  Evaluates the flattened skeleton of a small synthetic
+                character over its clip, on the keys and between them,
+                and compares every global transform with a recursive
+                walk of the scene that samples the source keys. The
+                resampled and quantized clip has to stay within a
+                small tolerance of the source keys, with the leaf
+                bones evaluated and skipped.
+
+      Returns:  BOOL
+                  Whether the flattened skeleton matched the walk
+    -----------------------------------------------------------------F-F*/
+    BOOL TestSkeletonEvaluation()
+    {
+        constexpr const FLOAT STEP_TICKS = 1.5f;
+        constexpr const FLOAT TOLERANCE = 1e-3f;
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        std::unique_ptr<aiScene> pScene = CreateSkinnedScene(4u, 16u);
+        const aiAnimation* pAnimation = pScene->mAnimations[0];
+
+        TestModel model;
+        TEST_CHECK(SUCCEEDED(model.InitializeFromScene(device.Get(), immediateContext.Get(), pScene.get())));
+
+        const library::ModelAsset& asset = model.GetAsset();
+        TEST_CHECK(asset.bHasAnimation);
+        TEST_CHECK(asset.DurationTicks == static_cast<FLOAT>(pAnimation->mDuration));
+
+        // The skeleton has animated leaves, the skipped evaluation has to leave some of them out
+        UINT uNumSkippedNodes = 0u;
+        for (const library::SkeletonNode& node : asset.aSkeleton)
+        {
+            if (node.uChannelIndex != library::Model::INVALID_INDEX && node.uHeight < 2u)
+            {
+                ++uNumSkippedNodes;
+            }
+        }
+        TEST_CHECK(uNumSkippedNodes > 0u);
+
+        std::vector<XMMATRIX> aGlobalTransforms(asset.aSkeleton.size());
+        std::vector<XMMATRIX> aReferenceTransforms;
+        aReferenceTransforms.reserve(asset.aSkeleton.size());
+
+        const UINT uNumSteps = static_cast<UINT>(asset.DurationTicks / STEP_TICKS);
+        for (UINT uSkipLeafBones = 0u; uSkipLeafBones < 2u; ++uSkipLeafBones)
+        {
+            FLOAT maxError = 0.0f;
+
+            for (UINT uStep = 0u; uStep <= uNumSteps; ++uStep)
+            {
+                const FLOAT animationTimeTicks = static_cast<FLOAT>(uStep) * STEP_TICKS;
+
+                model.evaluateGlobalTransforms(animationTimeTicks, uSkipLeafBones != 0u, aGlobalTransforms);
+
+                aReferenceTransforms.clear();
+                EvaluateNode(pAnimation, pScene->mRootNode, animationTimeTicks, uSkipLeafBones != 0u, XMMatrixIdentity(), aReferenceTransforms);
+                TEST_CHECK(aReferenceTransforms.size() == aGlobalTransforms.size());
+
+                for (size_t i = 0u; i < aGlobalTransforms.size(); ++i)
+                {
+                    XMFLOAT4X4 globalTransform;
+                    XMFLOAT4X4 referenceTransform;
+                    XMStoreFloat4x4(&globalTransform, aGlobalTransforms[i]);
+                    XMStoreFloat4x4(&referenceTransform, aReferenceTransforms[i]);
+
+                    for (UINT uRow = 0u; uRow < 4u; ++uRow)
+                    {
+                        for (UINT uColumn = 0u; uColumn < 4u; ++uColumn)
+                        {
+                            const FLOAT reference = referenceTransform.m[uRow][uColumn];
+                            const FLOAT error = fabsf(globalTransform.m[uRow][uColumn] - reference);
+
+                            TEST_CHECK(error <= TOLERANCE * (1.0f + fabsf(reference)));
+                            maxError = fmaxf(maxError, error);
+                        }
+                    }
+                }
+            }
+
+            wprintf(
+                L"  %s leaf bones: %zu nodes over %u times, largest error %.6f\n",
+                uSkipLeafBones != 0u ? L"skipped" : L"evaluated",
+                asset.aSkeleton.size(),
+                uNumSteps + 1u,
+                maxError
+            );
+        }
+
+        return TRUE;
+    }
+}
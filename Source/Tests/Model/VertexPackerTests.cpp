@@ -0,0 +1,124 @@
+#include "Tests.h"
+
+#include <random>
+
+#include "Model/VertexPacker.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestVertexPacking
+
+      Summary:  Packs random vertices in a flat box, with random tangent
+                frames of both handedness, and the corners of the box
+                and the axis aligned normals, where the octahedral
+                mapping folds. Every decoded vertex has to stay within
+                the quantization steps of its formats and keep the
+                handedness of its bitangent. Prints the largest errors.
+
+      Returns:  BOOL
+                  Whether every vertex was within the bounds
+    -----------------------------------------------------------------F-F*/
+    BOOL TestVertexPacking()
+    {
+        constexpr const UINT NUM_RANDOM_VERTICES = 100000u;
+        // Half floats have 10 bits of mantissa, so a coordinate within [-2, 2] is off by 2^-11 at most
+        constexpr const FLOAT MAX_TEX_COORD_ERROR = 1e-3f;
+        // Degrees, the bounds Model checks its packed vertices against
+        constexpr const FLOAT MAX_NORMAL_ANGLE = 0.05f;
+        constexpr const FLOAT MAX_TANGENT_ANGLE = 0.5f;
+
+        const XMFLOAT3 minCorner(-3.0f, -0.25f, -1.0f);
+        const XMFLOAT3 maxCorner(5.0f, 0.25f, 2.0f);
+
+        std::mt19937 generator(47u);
+        std::uniform_real_distribution<FLOAT> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<FLOAT> direction(-1.0f, 1.0f);
+        std::uniform_real_distribution<FLOAT> texCoord(-2.0f, 2.0f);
+
+        std::vector<library::SimpleVertex> aVertices;
+        std::vector<library::NormalData> aNormalData;
+        const auto addVertex = [&aVertices, &aNormalData](const XMFLOAT3& position, const XMFLOAT2& texCoord, FXMVECTOR normal, FXMVECTOR tangent, BOOL bFlipped)
+        {
+            library::SimpleVertex vertex = { .Position = position, .TexCoord = texCoord };
+            library::NormalData normalData;
+            XMStoreFloat3(&vertex.Normal, normal);
+            XMStoreFloat3(&normalData.Tangent, tangent);
+
+            const XMVECTOR bitangent = XMVector3Cross(normal, XMVector3Normalize(XMVectorSubtract(tangent, XMVectorScale(normal, XMVectorGetX(XMVector3Dot(normal, tangent))))));
+            XMStoreFloat3(&normalData.Bitangent, bFlipped ? XMVectorNegate(bitangent) : bitangent);
+
+            aVertices.push_back(vertex);
+            aNormalData.push_back(normalData);
+        };
+
+        for (UINT i = 0u; i < NUM_RANDOM_VERTICES; ++i)
+        {
+            XMVECTOR normal;
+            XMVECTOR tangent;
+            do
+            {
+                normal = XMVectorSet(direction(generator), direction(generator), direction(generator), 0.0f);
+                tangent = XMVector3Cross(normal, XMVectorSet(direction(generator), direction(generator), direction(generator), 0.0f));
+            } while (XMVectorGetX(XMVector3LengthSq(normal)) < 1e-4f || XMVectorGetX(XMVector3LengthSq(tangent)) < 1e-4f);
+
+            addVertex(
+                XMFLOAT3(
+                    minCorner.x + (maxCorner.x - minCorner.x) * unit(generator),
+                    minCorner.y + (maxCorner.y - minCorner.y) * unit(generator),
+                    minCorner.z + (maxCorner.z - minCorner.z) * unit(generator)
+                ),
+                XMFLOAT2(texCoord(generator), texCoord(generator)),
+                XMVector3Normalize(normal),
+                XMVector3Normalize(tangent),
+                i % 2u
+            );
+        }
+
+        // The axis aligned normals, with tangents along another axis, on the corners of the box
+        for (UINT uAxis = 0u; uAxis < 6u; ++uAxis)
+        {
+            const XMVECTOR normal = XMVectorSetByIndex(XMVectorZero(), uAxis % 2u == 0u ? 1.0f : -1.0f, uAxis / 2u);
+            const XMVECTOR tangent = XMVectorSetByIndex(XMVectorZero(), 1.0f, (uAxis / 2u + 1u) % 3u);
+
+            addVertex(uAxis % 2u == 0u ? minCorner : maxCorner, XMFLOAT2(0.0f, 1.0f), normal, tangent, uAxis % 3u == 0u);
+        }
+
+        BoundingBox bounds;
+        BoundingBox::CreateFromPoints(bounds, aVertices.size(), &aVertices[0].Position, sizeof(library::SimpleVertex));
+        const library::VertexPacker packer(bounds);
+
+        std::vector<library::PackedVertex> aPackedVertices;
+        const library::VertexPackingError error = packer.PackVertices(aVertices.data(), aNormalData.data(), static_cast<UINT>(aVertices.size()), aPackedVertices);
+        TEST_CHECK(aPackedVertices.size() == aVertices.size());
+
+        // Half a step of the 16 bit grid on every axis, a whole step leaves room for rounding
+        const FLOAT maxPositionError = XMVectorGetX(XMVector3Length(XMLoadFloat4(&packer.GetPositionScale()))) / 32767.0f;
+
+        wprintf(
+            L"  largest errors: position %g of %g, texture coordinate %g, normal %.4f, tangent %.4f degrees\n",
+            error.MaxPositionError,
+            maxPositionError,
+            error.MaxTexCoordError,
+            error.MaxNormalAngle,
+            error.MaxTangentAngle
+        );
+
+        TEST_CHECK(error.MaxPositionError <= maxPositionError);
+        TEST_CHECK(error.MaxTexCoordError <= MAX_TEX_COORD_ERROR);
+        TEST_CHECK(error.MaxNormalAngle <= MAX_NORMAL_ANGLE);
+        TEST_CHECK(error.MaxTangentAngle <= MAX_TANGENT_ANGLE);
+
+        for (size_t i = 0u; i < aVertices.size(); ++i)
+        {
+            library::SimpleVertex vertex;
+            library::NormalData normalData;
+            packer.UnpackVertex(aPackedVertices[i], vertex, normalData);
+
+            TEST_CHECK(XMVectorGetX(XMVector3Dot(XMLoadFloat3(&normalData.Bitangent), XMLoadFloat3(&aNormalData[i].Bitangent))) > 0.99f);
+            TEST_CHECK(fabsf(XMVectorGetX(XMVector3Length(XMLoadFloat3(&vertex.Normal))) - 1.0f) < 1e-3f);
+        }
+
+        return TRUE;
+    }
+}
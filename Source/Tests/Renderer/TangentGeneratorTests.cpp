@@ -0,0 +1,155 @@
+#include "Tests.h"
+
+#include "Fixtures.h"
+#include "Renderer/TangentGenerator.h"
+#include "Scene/JobSystem.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: CheckMirroredSeam
+
+      Summary:  Generates the frames of a flat strip whose texture is
+                mirrored along its middle column. The vertices on the
+                column are shared by both halves, they have to keep a
+                tangent along the texture axis of one half instead of
+                the cancelled out sum of both. Every other vertex has
+                to keep the tangent and the handedness of its half.
+
+      Args:     TangentGenerator& generator
+                  Generator to run
+
+      Returns:  BOOL
+                  Whether every frame held
+    -----------------------------------------------------------------F-F*/
+    static BOOL CheckMirroredSeam(
+        _In_ library::TangentGenerator& generator
+    )
+    {
+        constexpr const UINT NUM_COLUMNS = 8u;
+        constexpr const UINT NUM_ROWS = 4u;
+        constexpr const UINT SEAM_COLUMN = NUM_COLUMNS / 2u;
+
+        // The strip lies in the yz plane, facing along x, so that no fallback axis is along its tangent
+        std::vector<library::SimpleVertex> aVertices;
+        for (UINT uRow = 0u; uRow <= NUM_ROWS; ++uRow)
+        {
+            for (UINT uColumn = 0u; uColumn <= NUM_COLUMNS; ++uColumn)
+            {
+                const FLOAT z = static_cast<FLOAT>(uColumn) - static_cast<FLOAT>(SEAM_COLUMN);
+                aVertices.push_back(
+                    {
+                        .Position = XMFLOAT3(0.0f, static_cast<FLOAT>(uRow), z),
+                        .TexCoord = XMFLOAT2(fabsf(z) / NUM_COLUMNS, static_cast<FLOAT>(uRow) / NUM_ROWS),
+                        .Normal = XMFLOAT3(1.0f, 0.0f, 0.0f)
+                    }
+                );
+            }
+        }
+
+        std::vector<UINT> aIndices;
+        for (UINT uRow = 0u; uRow < NUM_ROWS; ++uRow)
+        {
+            for (UINT uColumn = 0u; uColumn < NUM_COLUMNS; ++uColumn)
+            {
+                const UINT a = uRow * (NUM_COLUMNS + 1u) + uColumn;
+                aIndices.insert(aIndices.end(), { a, a + NUM_COLUMNS + 1u, a + 1u, a + 1u, a + NUM_COLUMNS + 1u, a + NUM_COLUMNS + 2u });
+            }
+        }
+
+        std::vector<library::NormalData> aNormalData(aVertices.size());
+        generator.Generate(aIndices.data(), static_cast<UINT>(aIndices.size()), aVertices.data(), static_cast<UINT>(aVertices.size()), aNormalData.data(), nullptr);
+
+        for (UINT i = 0u; i < static_cast<UINT>(aVertices.size()); ++i)
+        {
+            const UINT uColumn = i % (NUM_COLUMNS + 1u);
+            const XMVECTOR tangent = XMLoadFloat3(&aNormalData[i].Tangent);
+            const XMVECTOR bitangent = XMLoadFloat3(&aNormalData[i].Bitangent);
+            const FLOAT tangentZ = XMVectorGetZ(tangent);
+
+            TEST_CHECK(fabsf(fabsf(tangentZ) - 1.0f) < 1e-4f);
+            TEST_CHECK(XMVectorGetY(bitangent) > 1.0f - 1e-4f);
+            if (uColumn > SEAM_COLUMN)
+            {
+                TEST_CHECK(tangentZ > 0.0f);
+            }
+            else if (uColumn < SEAM_COLUMN)
+            {
+                TEST_CHECK(tangentZ < 0.0f);
+            }
+        }
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestTangentGeneration
+
+      Summary:  Generates the frames of a torus large enough to be
+                spread over a job system, on the calling thread and in
+                parallel. Both have to give the same frames, which
+                have to be orthonormal and follow the texture axes of
+                the torus. Checks the frames on a mirrored seam and
+                benchmarks the generation on a wavy grid, whose largest
+                tangent error is bounded too.
+
+      Returns:  BOOL
+                  Whether every frame held
+    -----------------------------------------------------------------F-F*/
+    BOOL TestTangentGeneration()
+    {
+        constexpr const UINT NUM_RINGS = 256u;
+        constexpr const UINT NUM_SIDES = 128u;
+        constexpr const UINT NUM_THREADS = 4u;
+        constexpr const UINT NUM_BENCHMARK_TRIANGLES = 1u << 20u;
+        constexpr const UINT NUM_BENCHMARK_ITERATIONS = 4u;
+        // Radians, the triangles of the grid are flat while its normals are not
+        constexpr const FLOAT MAX_BENCHMARK_ANGLE = 0.01f;
+
+        std::vector<library::SimpleVertex> aVertices;
+        std::vector<UINT> aIndices;
+        CreateTorusMesh(NUM_RINGS, NUM_SIDES, aVertices, aIndices);
+        const UINT uNumVertices = static_cast<UINT>(aVertices.size());
+        const UINT uNumIndices = static_cast<UINT>(aIndices.size());
+        TEST_CHECK(uNumIndices / 3u >= library::TangentGenerator::MIN_PARALLEL_TRIANGLES);
+
+        library::JobSystem jobSystem(NUM_THREADS);
+        const library::TangentGenerator::ParallelFor parallelFor = [&jobSystem](UINT uNumJobs, const std::function<void(UINT)>& job)
+        {
+            jobSystem.ParallelFor(uNumJobs, job);
+        };
+
+        library::TangentGenerator generator;
+        std::vector<library::NormalData> aSerialNormalData(uNumVertices);
+        std::vector<library::NormalData> aParallelNormalData(uNumVertices);
+        generator.Generate(aIndices.data(), uNumIndices, aVertices.data(), uNumVertices, aSerialNormalData.data(), nullptr);
+        generator.Generate(aIndices.data(), uNumIndices, aVertices.data(), uNumVertices, aParallelNormalData.data(), parallelFor);
+        TEST_CHECK(memcmp(aSerialNormalData.data(), aParallelNormalData.data(), sizeof(library::NormalData) * uNumVertices) == 0);
+
+        // The texture u runs around the y axis and v around the tube, both counterclockwise seen from above and outside
+        for (UINT i = 0u; i < uNumVertices; ++i)
+        {
+            const XMVECTOR normal = XMLoadFloat3(&aVertices[i].Normal);
+            const XMVECTOR tangent = XMLoadFloat3(&aSerialNormalData[i].Tangent);
+            const XMVECTOR bitangent = XMLoadFloat3(&aSerialNormalData[i].Bitangent);
+
+            TEST_CHECK(fabsf(XMVectorGetX(XMVector3Length(tangent)) - 1.0f) < 1e-4f);
+            TEST_CHECK(fabsf(XMVectorGetX(XMVector3Dot(tangent, normal))) < 1e-4f);
+            TEST_CHECK(XMVector3NearEqual(bitangent, XMVector3Cross(normal, tangent), XMVectorReplicate(1e-4f))
+                || XMVector3NearEqual(bitangent, XMVectorNegate(XMVector3Cross(normal, tangent)), XMVectorReplicate(1e-4f)));
+
+            const XMFLOAT3& position = aVertices[i].Position;
+            const XMVECTOR ringDirection = XMVector3Normalize(XMVectorSet(-position.z, 0.0f, position.x, 0.0f));
+            TEST_CHECK(XMVectorGetX(XMVector3Dot(tangent, ringDirection)) > 0.999f);
+            TEST_CHECK(XMVectorGetX(XMVector3Dot(bitangent, XMVector3Cross(ringDirection, normal))) > 0.99f);
+        }
+
+        TEST_CHECK(CheckMirroredSeam(generator));
+
+        const FLOAT maxAngle = generator.Benchmark(NUM_BENCHMARK_TRIANGLES, NUM_BENCHMARK_ITERATIONS, parallelFor);
+        wprintf(L"  largest tangent error of the benchmark grid %.5f rad\n", maxAngle);
+        TEST_CHECK(maxAngle < MAX_BENCHMARK_ANGLE);
+
+        return TRUE;
+    }
+}
@@ -0,0 +1,87 @@
+#include "Tests.h"
+
+#include "Fixtures.h"
+#include "Scene/HorizonMap.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestHorizonMapUpdate
+
+      Summary:  Turns and raises the light in small steps over a hilly
+                heightfield. After every step the incremental update of
+                one horizon map has to give the same visibility as a
+                full resolve of a second one, while resolving fewer
+                columns. Prints the average cost of both.
+
+      Returns:  BOOL
+                  Whether the incremental updates matched the full
+                  resolves
+    -----------------------------------------------------------------F-F*/
+    BOOL TestHorizonMapUpdate()
+    {
+        constexpr const UINT WIDTH = 128u;
+        constexpr const UINT DEPTH = 128u;
+        constexpr const UINT NUM_STEPS = 2000u;
+
+        ComPtr<ID3D11Device> device;
+        ComPtr<ID3D11DeviceContext> immediateContext;
+        TEST_CHECK(SUCCEEDED(CreateTestDevice(device, immediateContext)));
+
+        std::vector<FLOAT> aHeights(static_cast<size_t>(WIDTH) * DEPTH);
+        for (UINT z = 0u; z < DEPTH; ++z)
+        {
+            for (UINT x = 0u; x < WIDTH; ++x)
+            {
+                aHeights[static_cast<size_t>(z) * WIDTH + x] = 8.0f * sinf(static_cast<FLOAT>(x) * 0.11f) * cosf(static_cast<FLOAT>(z) * 0.07f)
+                    + 2.0f * sinf(static_cast<FLOAT>(x * 7u + z * 13u));
+            }
+        }
+        std::vector<FLOAT> aReferenceHeights = aHeights;
+
+        library::HorizonMap incremental(WIDTH, DEPTH, 2.0f, XMFLOAT2(0.0f, 0.0f), std::move(aHeights));
+        library::HorizonMap reference(WIDTH, DEPTH, 2.0f, XMFLOAT2(0.0f, 0.0f), std::move(aReferenceHeights));
+        TEST_CHECK(SUCCEEDED(incremental.Initialize(device.Get(), immediateContext.Get())));
+        TEST_CHECK(SUCCEEDED(reference.Initialize(device.Get(), immediateContext.Get())));
+
+        UINT64 uIncrementalColumns = 0u;
+        UINT64 uFullColumns = 0u;
+        FLOAT incrementalTime = 0.0f;
+        FLOAT fullTime = 0.0f;
+        for (UINT uStep = 0u; uStep < NUM_STEPS; ++uStep)
+        {
+            const FLOAT azimuth = static_cast<FLOAT>(uStep) * 0.005f;
+            const FLOAT elevation = 0.35f + 0.3f * sinf(azimuth * 0.7f);
+            const XMVECTOR lightDirection = XMVectorSet(
+                -cosf(elevation) * cosf(azimuth),
+                -sinf(elevation),
+                -cosf(elevation) * sinf(azimuth),
+                0.0f
+            );
+
+            incremental.Update(immediateContext.Get(), lightDirection);
+            reference.Invalidate();
+            reference.Update(immediateContext.Get(), lightDirection);
+
+            TEST_CHECK(incremental.GetVisibility() == reference.GetVisibility());
+
+            uIncrementalColumns += incremental.GetNumResolvedColumns();
+            uFullColumns += reference.GetNumResolvedColumns();
+            incrementalTime += incremental.GetIncrementalUpdateTime();
+            fullTime += reference.GetIncrementalUpdateTime();
+        }
+
+        wprintf(
+            L"  build %.3f ms, incremental update %.4f ms and %llu columns, full resolve %.4f ms and %llu columns on average\n",
+            incremental.GetFullRebuildTime(),
+            incrementalTime / static_cast<FLOAT>(NUM_STEPS),
+            uIncrementalColumns / NUM_STEPS,
+            fullTime / static_cast<FLOAT>(NUM_STEPS),
+            uFullColumns / NUM_STEPS
+        );
+
+        TEST_CHECK(uIncrementalColumns < uFullColumns);
+
+        return TRUE;
+    }
+}
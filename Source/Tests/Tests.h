@@ -0,0 +1,63 @@
+/*+===================================================================
+  File:      TESTS.H
+
+  Summary:   Tests header file contains declarations of the checks the
+             Tests application runs on the Library project and the
+             macro that reports a failed check.
+
+  Functions: TestCascadeStability, TestHorizonMapUpdate,
+             TestIrradianceSH9, TestPrefilterEnergy,
+             TestCpuSkinning, TestBoneWeightPacking,
+             TestAnimationLodSelection, TestModelCacheRoundTrip,
+             TestMeshOptimizer, TestVertexPacking,
+             TestMeshSimplifier, TestMeshletCones,
+             TestTangentGeneration, TestModelUpdate,
+             TestSkeletonEvaluation, TestParallelModelUpdate,
+             TestBakedAnimation, TestDualQuaternionSkinning,
+             TestAnimationLodCrowd, TestConcurrentModelLoad,
+             TestLargeIndexBuffer, TestModelMeshlets
+
+  ?2022 Kyung Hee University
+===================================================================+*/
+#pragma once
+
+#include "Common.h"
+
+#include <cstdio>
+
+// Prints the failed condition with its location and makes the test return FALSE
+#define TEST_CHECK(bCondition)                                                                      \
+    do                                                                                              \
+    {                                                                                               \
+        if (!(bCondition))                                                                          \
+        {                                                                                           \
+            wprintf(L"  %s(%d): check failed: %s\n", __FILEW__, __LINE__, _CRT_WIDE(#bCondition)); \
+            return FALSE;                                                                           \
+        }                                                                                           \
+    } while (0)
+
+namespace tests
+{
+    BOOL TestCascadeStability();
+    BOOL TestHorizonMapUpdate();
+    BOOL TestIrradianceSH9();
+    BOOL TestPrefilterEnergy();
+    BOOL TestCpuSkinning();
+    BOOL TestBoneWeightPacking();
+    BOOL TestAnimationLodSelection();
+    BOOL TestModelCacheRoundTrip();
+    BOOL TestMeshOptimizer();
+    BOOL TestVertexPacking();
+    BOOL TestMeshSimplifier();
+    BOOL TestMeshletCones();
+    BOOL TestTangentGeneration();
+    BOOL TestModelUpdate();
+    BOOL TestSkeletonEvaluation();
+    BOOL TestParallelModelUpdate();
+    BOOL TestBakedAnimation();
+    BOOL TestDualQuaternionSkinning();
+    BOOL TestAnimationLodCrowd();
+    BOOL TestConcurrentModelLoad();
+    BOOL TestLargeIndexBuffer();
+    BOOL TestModelMeshlets();
+}
@@ -0,0 +1,141 @@
+#include "Tests.h"
+
+#include "Fixtures.h"
+#include "Texture/SpecularPrefilter.h"
+
+namespace tests
+{
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: MeasureRadiance
+
+      Summary:  Integrates the radiance of a cube map over the sphere
+                and finds its brightest texel, both on the average of
+                the color channels
+
+      Args:     const library::CubeMapData& cubeMap
+                  Cube map to measure
+                FLOAT& meanRadiance
+                  Radiance averaged over the solid angle
+                FLOAT& peakRadiance
+                  Radiance of the brightest texel
+    -----------------------------------------------------------------F-F*/
+    static void MeasureRadiance(
+        _In_ const library::CubeMapData& cubeMap,
+        _Out_ FLOAT& meanRadiance,
+        _Out_ FLOAT& peakRadiance
+    )
+    {
+        const XMVECTOR channelAverage = XMVectorReplicate(1.0f / 3.0f);
+
+        DOUBLE radiance = 0.0;
+        DOUBLE solidAngle = 0.0;
+        peakRadiance = 0.0f;
+        for (UINT uFace = 0u; uFace < NUM_CUBE_FACES; ++uFace)
+        {
+            for (UINT y = 0u; y < cubeMap.uSize; ++y)
+            {
+                for (UINT x = 0u; x < cubeMap.uSize; ++x)
+                {
+                    const FLOAT texelRadiance = XMVectorGetX(XMVector3Dot(XMLoadFloat4(&cubeMap.aFaces[uFace][static_cast<size_t>(y) * cubeMap.uSize + x]), channelAverage));
+                    const FLOAT texelSolidAngle = library::GetCubeMapTexelSolidAngle(cubeMap.uSize, x, y);
+
+                    radiance += static_cast<DOUBLE>(texelRadiance) * texelSolidAngle;
+                    solidAngle += texelSolidAngle;
+                    peakRadiance = fmaxf(peakRadiance, texelRadiance);
+                }
+            }
+        }
+
+        meanRadiance = static_cast<FLOAT>(radiance / solidAngle);
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: PrefilterSky
+
+      Summary:  Builds the box filtered mip chain of a sky cube map and
+                bakes its prefiltered specular mips. Checks that every
+                level keeps the energy of the source within a tolerance
+                and that the brightest texel only gets dimmer as the
+                roughness grows.
+
+      Args:     FLOAT sunIntensity
+                  Brightness of the sun of the sky
+                FLOAT tolerance
+                  Largest allowed change of the mean radiance, relative
+                  to the source
+
+      Returns:  BOOL
+                  Whether every level is within the tolerance
+    -----------------------------------------------------------------F-F*/
+    static BOOL PrefilterSky(
+        _In_ FLOAT sunIntensity,
+        _In_ FLOAT tolerance
+    )
+    {
+        constexpr const UINT SOURCE_SIZE = 64u;
+        constexpr const UINT PREFILTERED_SIZE = 32u;
+        constexpr const UINT NUM_MIPS = 6u;
+        constexpr const UINT NUM_SAMPLES = 256u;
+        constexpr const UINT NUM_THREADS = 4u;
+
+        std::vector<library::CubeMapData> aSourceMips(1u);
+        CreateSkyCubeMap(SOURCE_SIZE, sunIntensity, aSourceMips[0]);
+        while (aSourceMips.back().uSize > 1u)
+        {
+            library::CubeMapData mip;
+            library::DownsampleCubeMap(aSourceMips.back(), mip);
+            aSourceMips.push_back(std::move(mip));
+        }
+
+        std::vector<library::CubeMapData> aPrefilteredMips;
+        library::PrefilterStats stats;
+        library::PrefilterSpecularGGX(aSourceMips, PREFILTERED_SIZE, NUM_MIPS, NUM_SAMPLES, NUM_THREADS, aPrefilteredMips, stats);
+        TEST_CHECK(aPrefilteredMips.size() == NUM_MIPS);
+
+        FLOAT sourceRadiance = 0.0f;
+        FLOAT previousPeak = 0.0f;
+        MeasureRadiance(aSourceMips[0], sourceRadiance, previousPeak);
+
+        wprintf(L"  sun %.1f, bake %.2f ms, energy of the mips:", sunIntensity, stats.bakeTime);
+        FLOAT maxError = 0.0f;
+        for (const library::CubeMapData& mip : aPrefilteredMips)
+        {
+            FLOAT meanRadiance = 0.0f;
+            FLOAT peakRadiance = 0.0f;
+            MeasureRadiance(mip, meanRadiance, peakRadiance);
+            wprintf(L" %.4f", meanRadiance / sourceRadiance);
+
+            // A blur never creates a brighter texel, the small slack is the bilinear resampling
+            TEST_CHECK(peakRadiance <= previousPeak * 1.001f);
+            previousPeak = peakRadiance;
+
+            maxError = fmaxf(maxError, fabsf(meanRadiance / sourceRadiance - 1.0f));
+        }
+        wprintf(L"\n");
+
+        TEST_CHECK(maxError < tolerance);
+
+        return TRUE;
+    }
+
+    /*F+F+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+      Function: TestPrefilterEnergy
+
+      Summary:  Prefilters a sky without and with a sun. The GGX lobe
+                is normalized, so the convolution only moves radiance
+                around the sphere. The linear sky has to keep its
+                energy up to rounding. With the sun the importance
+                sampling of the sharp lobe and the coarse quadrature of
+                the smallest mips are allowed a few percent.
+
+      Returns:  BOOL
+                  Whether both bakes kept their energy
+    -----------------------------------------------------------------F-F*/
+    BOOL TestPrefilterEnergy()
+    {
+        TEST_CHECK(PrefilterSky(0.0f, 0.001f));
+        TEST_CHECK(PrefilterSky(4.0f, 0.05f));
+
+        return TRUE;
+    }
+}